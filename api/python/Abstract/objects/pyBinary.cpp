@@ -180,10 +180,17 @@ void create<Binary>(py::module& m) {
         "Constructor functions that are called prior any other functions")
 
     .def("xref",
-        &Binary::xref,
+        static_cast<std::vector<uint64_t> (Binary::*)(uint64_t) const>(&Binary::xref),
         "Return all **virtual addresses** that *use* the ``address`` given in parameter",
         "virtual_address"_a)
 
+    .def("xref",
+        static_cast<std::map<uint64_t, std::vector<uint64_t>> (Binary::*)(const std::vector<uint64_t>&, size_t) const>(&Binary::xref),
+        "Batched version of :meth:`~lief.Binary.xref`: the sections are scanned only once for all the ``addresses``.\n\n"
+        "Return a ``dict`` that maps each address to the **virtual addresses** that *use* it.\n\n"
+        "The sections can be scanned by ``nb_threads`` threads (0: number of cores)",
+        "addresses"_a, "nb_threads"_a = 1)
+
     .def("offset_to_virtual_address", &Binary::offset_to_virtual_address,
         "Convert an offset into a virtual address.",
         "offset"_a, "slide"_a = 0)
@@ -16,6 +16,8 @@
 #include "pyAbstract.hpp"
 
 #include "LIEF/Abstract/Parser.hpp"
+#include "LIEF/Abstract/BatchParser.hpp"
+#include "LIEF/Abstract/Binary.hpp"
 
 #include <string>
 #include <stdexcept>
@@ -24,28 +26,59 @@ namespace LIEF {
 template<>
 void create<Parser>(py::module& m) {
 
+  py::class_<BatchConfig>(m, "BatchConfig",
+      "Configuration of :func:`lief.parse_many`")
+    .def(py::init<>())
+    .def_readwrite("elf", &BatchConfig::elf,
+        "Configuration (" RST_CLASS_REF(lief.ELF.ParserConfig) ") used for the ELF binaries")
+    .def_readwrite("pe", &BatchConfig::pe,
+        "Configuration (" RST_CLASS_REF(lief.PE.ParserConfig) ") used for the PE binaries")
+    .def_readwrite("macho", &BatchConfig::macho,
+        "Configuration (" RST_CLASS_REF(lief.MachO.ParserConfig) ") used for the Mach-O binaries");
+
+  m.def("parse_many",
+      [] (const std::vector<std::string>& paths, const BatchConfig& config, size_t nb_threads) {
+        std::vector<std::unique_ptr<Binary>> binaries;
+        std::exception_ptr ep;
+        Py_BEGIN_ALLOW_THREADS
+        try {
+          binaries = parse_many(paths, config, nb_threads);
+        } catch (...) {
+          ep = std::current_exception();
+        }
+        Py_END_ALLOW_THREADS
+        if (ep) std::rethrow_exception(ep);
+        return binaries;
+      },
+      R"delim(
+      Parse the given files with a pool of ``nb_threads`` threads (0 for the number of cores)
+      and return a list of :class:`lief.Binary` in the order of ``paths``.
+
+      Files that can't be parsed are reported as ``None`` and don't stop the batch.
+      )delim",
+      "paths"_a, "config"_a = BatchConfig{}, "nb_threads"_a = 0);
+
   m.def("parse",
-      [] (py::bytes bytes, const std::string& name) {
-        std::string raw_str = bytes;
-        std::vector<uint8_t> raw = {
-          std::make_move_iterator(std::begin(raw_str)),
-          std::make_move_iterator(std::end(raw_str))
-        };
+      [] (py::buffer buffer, const std::string& name) {
+        py::memoryview view = export_buffer(buffer);
+        const span<const uint8_t> raw = as_span(view);
         std::unique_ptr<Binary> binary;
         std::exception_ptr ep;
         Py_BEGIN_ALLOW_THREADS
         try {
-          binary = Parser::parse(std::move(raw), name);
+          binary = Parser::parse(raw, name);
         } catch (...) {
           ep = std::current_exception();
         }
         Py_END_ALLOW_THREADS
         if (ep) std::rethrow_exception(ep);
-        return binary;
+        // ELF binaries read their content from the buffer
+        return keep_buffer(py::cast(std::move(binary)), view);
       },
-      "Parse the given binary and return a " RST_CLASS_REF(lief.Binary) " object",
-      "raw"_a, "name"_a = "",
-      py::return_value_policy::take_ownership);
+      "Parse the given buffer (``bytes``, ``bytearray``, ``mmap``, ``numpy`` array, ...) without copying it "
+      "and return a " RST_CLASS_REF(lief.Binary) " object.\n\n"
+      "The buffer is locked (it can't be resized or closed) while the binary is alive",
+      "raw"_a, "name"_a = "");
 
   m.def("parse",
       [] (const std::string& name) {
@@ -86,51 +119,22 @@ void create<Parser>(py::module& m) {
 
 
   m.def("parse",
-      [] (py::object byteio, const std::string& name) {
-        auto&& io = py::module::import("io");
-        auto&& RawIOBase = io.attr("RawIOBase");
-        auto&& BufferedIOBase = io.attr("BufferedIOBase");
-        auto&& TextIOBase = io.attr("TextIOBase");
-
-        py::object rawio;
-
-
-        if (py::isinstance(byteio, RawIOBase)) {
-          rawio = byteio;
-        }
-
-        else if (py::isinstance(byteio, BufferedIOBase)) {
-          rawio = byteio.attr("raw");
-        }
-
-        else if (py::isinstance(byteio, TextIOBase)) {
-          rawio = byteio.attr("buffer").attr("raw");
-        }
-
-        else {
-          throw py::type_error(py::repr(byteio).cast<std::string>().c_str());
-        }
-
-        std::string raw_str = static_cast<py::bytes>(rawio.attr("readall")());
-        std::vector<uint8_t> raw = {
-          std::make_move_iterator(std::begin(raw_str)),
-          std::make_move_iterator(std::end(raw_str))
-        };
-
+      [] (py::object io, const std::string& name) {
+        py::memoryview view = export_io(io);
+        const span<const uint8_t> raw = as_span(view);
         std::unique_ptr<Binary> binary;
         std::exception_ptr ep;
         Py_BEGIN_ALLOW_THREADS
         try {
-          binary = Parser::parse(std::move(raw), name);
+          binary = Parser::parse(raw, name);
         } catch (...) {
           ep = std::current_exception();
         }
         Py_END_ALLOW_THREADS
         if (ep) std::rethrow_exception(ep);
-        return binary;
+        return keep_buffer(py::cast(std::move(binary)), view);
       },
       "io"_a,
-      "name"_a = "",
-      py::return_value_policy::take_ownership);
+      "name"_a = "");
 }
 }
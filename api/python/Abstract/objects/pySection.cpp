@@ -61,10 +61,32 @@ void create<Section>(py::module& m) {
         static_cast<setter_t<const std::vector<uint8_t>&>>(&Section::content),
         "Section's content")
 
+    .def_property_readonly("content_view",
+        [] (py::object self) {
+          const Section& obj = self.cast<const Section&>();
+          return to_memoryview(self, obj.content_view(), [&obj] { return obj.content(); });
+        },
+        "Read-only ``memoryview`` on the section's content which keeps the binary alive. "
+        "Contrary to :attr:`~lief.Section.content`, it doesn't copy the content when "
+        "the binary borrows it from the buffer given to the parser.\n\n"
+        "The view is a snapshot: it is not affected by the modifications of the section")
+
     .def_property_readonly("entropy",
         &Section::entropy,
         "Section's entropy")
 
+    .def("histogram",
+        &Section::histogram,
+        "Number of occurrences of each byte value (``list`` of 256 integers).\n\n"
+        "Large sections can be processed by ``nb_threads`` threads (0: number of cores)",
+        "nb_threads"_a = 1)
+
+    .def("entropy_curve",
+        &Section::entropy_curve,
+        "Entropy of the windows of ``block_size`` bytes of the section, every ``step`` bytes "
+        "(``step = 0`` means consecutive blocks)",
+        "block_size"_a, "step"_a = 0)
+
     .def("search",
         static_cast<size_t (Section::*)(uint64_t, size_t, size_t) const>(&Section::search),
         "Look for **integer** within the current section",
@@ -85,6 +107,12 @@ void create<Section>(py::module& m) {
         "Look for all **strings** within the current section",
         "str"_a)
 
+    .def("search_all",
+        static_cast<std::vector<std::vector<size_t>> (Section::*)(const std::vector<std::vector<uint8_t>>&) const>(&Section::search_all),
+        "Look for all the occurrences of several byte ``patterns`` with a single scan of the section.\n\n"
+        "Return the offsets of the occurrences for each pattern (in the order of ``patterns``)",
+        "patterns"_a)
+
     .def("__str__",
         [] (const Section& section)
         {
@@ -68,5 +68,16 @@ void init_enums(py::module& m) {
     .value(PY_ENUM(ENDIANNESS::ENDIAN_NONE))
     .value(PY_ENUM(ENDIANNESS::ENDIAN_BIG))
     .value(PY_ENUM(ENDIANNESS::ENDIAN_LITTLE));
+
+  py::enum_<FILE_FORMATS>(m, "FILE_FORMATS")
+    .value(PY_ENUM(FILE_FORMATS::UNKNOWN))
+    .value(PY_ENUM(FILE_FORMATS::ELF))
+    .value(PY_ENUM(FILE_FORMATS::OAT))
+    .value(PY_ENUM(FILE_FORMATS::PE))
+    .value(PY_ENUM(FILE_FORMATS::MACHO))
+    .value(PY_ENUM(FILE_FORMATS::MACHO_FAT))
+    .value(PY_ENUM(FILE_FORMATS::DEX))
+    .value(PY_ENUM(FILE_FORMATS::VDEX))
+    .value(PY_ENUM(FILE_FORMATS::ART));
 }
 }
@@ -448,6 +448,38 @@ void create<Binary>(py::module& m) {
         "symbol_name"_a,
         py::return_value_policy::reference)
 
+    .def("load_all",
+        &Binary::load_all,
+        "Parse all the tables whose parsing has been deferred (see: " RST_CLASS_REF(lief.ELF.ParserConfig) ")")
+
+    .def("lookup_dynamic_symbol",
+        static_cast<const Symbol* (Binary::*)(const std::string&) const>(&Binary::lookup_dynamic_symbol),
+        "Resolve the symbol ``name`` as the loader does: through the ``.gnu.hash`` "
+        "or the ``.hash`` table of the binary.\n\n"
+        "Only a symbol **defined** by the binary can be returned (imports, local symbols "
+        "and hidden versions are skipped). Return ``None`` if the binary doesn't define ``name``",
+        "symbol_name"_a,
+        py::return_value_policy::reference)
+
+    .def("lookup_dynamic_symbol",
+        static_cast<const Symbol* (Binary::*)(const std::string&, const std::string&) const>(&Binary::lookup_dynamic_symbol),
+        "Resolve the reference to ``name`` with the given ``version`` (e.g. ``GLIBC_2.2.5``) "
+        "as required by a ``DT_VERNEED`` entry.\n\n"
+        "A definition matches if it has this version or if it is not versioned",
+        "symbol_name"_a, "version"_a,
+        py::return_value_policy::reference)
+
+    .def_static("lookup_dynamic_symbols",
+        static_cast<std::vector<std::pair<const Binary*, const Symbol*>>(*)(const std::vector<const Binary*>&,
+          const std::vector<std::string>&, const std::vector<std::string>&)>(&Binary::lookup_dynamic_symbols),
+        "Resolve the given ``names`` in the lookup ``scope`` (list of " RST_CLASS_REF(lief.ELF.Binary) ") "
+        "as the loader does: the first binary that defines a name wins.\n\n"
+        "``versions`` optionally gives the version required for each name (an empty string for "
+        "an unversioned reference).\n\n"
+        "Return, for each name, a tuple ``(binary, symbol)`` or ``(None, None)``",
+        "scope"_a, "names"_a, "versions"_a = std::vector<std::string>{},
+        py::return_value_policy::reference)
+
     .def("has_static_symbol",
         &Binary::has_static_symbol,
         "Check if the symbol with the given ``name`` exists in the **static** symbol table",
@@ -536,6 +568,25 @@ void create<Binary>(py::module& m) {
         static_cast<setter_t<Binary::overlay_t>>(&Binary::overlay),
         "Overlay data that are not a part of the ELF format")
 
+    .def_property_readonly("overlay_view",
+        [] (py::object self) {
+          return to_memoryview(self, self.cast<const Binary&>().overlay());
+        },
+        "Read-only ``memoryview`` on the overlay which keeps the binary alive. "
+        "Contrary to :attr:`~lief.ELF.Binary.overlay`, it doesn't copy the overlay when "
+        "the binary borrows it from the buffer given to the parser.\n\n"
+        "The view is a snapshot: it is not affected by the modifications of the binary")
+
+    .def_property_readonly("overlay_entropy",
+        &Binary::overlay_entropy,
+        "Entropy of the overlay")
+
+    .def("overlay_entropy_curve",
+        &Binary::overlay_entropy_curve,
+        "Entropy of the windows of ``block_size`` bytes of the overlay, every ``step`` bytes "
+        "(``step = 0`` means consecutive blocks)",
+        "block_size"_a, "step"_a = 0)
+
 
 
     .def(py::self += Segment())
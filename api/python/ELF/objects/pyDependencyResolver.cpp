@@ -0,0 +1,114 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+
+#include "LIEF/ELF/DependencyResolver.hpp"
+#include "LIEF/ELF/Binary.hpp"
+
+#include "pyELF.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+template<>
+void create<DependencyResolver>(py::module& m) {
+
+  py::class_<DependencyResolver> resolver(m, "DependencyResolver",
+      "Resolve the ``DT_NEEDED`` closure of an ELF binary as the loader (``ld.so``) does.\n\n"
+      "The parsed libraries are stored in a process-wide LRU cache keyed by the device, "
+      "the inode and the modification time of the files");
+
+  py::class_<DependencyResolver::library_t>(resolver, "library", "A library of the closure")
+    .def_readonly("name", &DependencyResolver::library_t::name,
+        "Name from the ``DT_NEEDED`` entry (path of the main binary)")
+
+    .def_readonly("path", &DependencyResolver::library_t::path,
+        "Path of the library in the :attr:`~lief.ELF.DependencyResolver.sysroot`")
+
+    .def_property_readonly("binary",
+        [] (const DependencyResolver::library_t& lib) {
+          return lib.binary.get();
+        },
+        "Parsed " RST_CLASS_REF(lief.ELF.Binary) "",
+        py::return_value_policy::reference_internal);
+
+  py::class_<DependencyResolver::binding_t>(resolver, "binding", "Binding of an imported symbol")
+    .def_readonly("binary", &DependencyResolver::binding_t::binary,
+        "Binary that imports the symbol",
+        py::return_value_policy::reference)
+
+    .def_readonly("symbol", &DependencyResolver::binding_t::symbol,
+        "Imported " RST_CLASS_REF(lief.ELF.Symbol) "",
+        py::return_value_policy::reference)
+
+    .def_readonly("provider", &DependencyResolver::binding_t::provider,
+        "Binary that defines the symbol (``None`` if not resolved)",
+        py::return_value_policy::reference)
+
+    .def_readonly("definition", &DependencyResolver::binding_t::definition,
+        "Definition of the symbol (``None`` if not resolved)",
+        py::return_value_policy::reference);
+
+  py::class_<DependencyResolver::closure_t>(resolver, "closure", "Closure of a binary")
+    .def_readonly("libraries", &DependencyResolver::closure_t::libraries,
+        "Libraries in the load order: the main binary followed by its dependencies in breadth-first order")
+
+    .def_readonly("missing", &DependencyResolver::closure_t::missing,
+        "``DT_NEEDED`` names that have not been found")
+
+    .def_readonly("bindings", &DependencyResolver::closure_t::bindings,
+        "Bindings of the imported symbols of all the libraries");
+
+  resolver
+    .def(py::init<>())
+
+    .def_property("sysroot",
+        static_cast<const std::string& (DependencyResolver::*)() const>(&DependencyResolver::sysroot),
+        [] (DependencyResolver& self, const std::string& root) { self.sysroot(root); },
+        "Directory in which the absolute paths are resolved (e.g. the root of a container image)")
+
+    .def_property("library_paths",
+        static_cast<const std::vector<std::string>& (DependencyResolver::*)() const>(&DependencyResolver::library_paths),
+        [] (DependencyResolver& self, const std::vector<std::string>& paths) { self.library_paths(paths); },
+        "Directories searched before the ``DT_RUNPATH`` (as ``LD_LIBRARY_PATH`` does)")
+
+    .def_property("default_paths",
+        static_cast<const std::vector<std::string>& (DependencyResolver::*)() const>(&DependencyResolver::default_paths),
+        [] (DependencyResolver& self, const std::vector<std::string>& paths) { self.default_paths(paths); },
+        "Directories searched at the end")
+
+    .def_property("bind_symbols",
+        static_cast<bool (DependencyResolver::*)() const>(&DependencyResolver::bind_symbols),
+        [] (DependencyResolver& self, bool flag) { self.bind_symbols(flag); },
+        "Whether the imported symbols must be bound")
+
+    .def("resolve",
+        &DependencyResolver::resolve,
+        "Resolve the closure of the binary located at ``path`` in the sysroot",
+        "path"_a)
+
+    .def_property_static("cache_size",
+        [] (py::object /* self */) { return DependencyResolver::cache_size(); },
+        [] (py::object /* self */, size_t size) { DependencyResolver::cache_size(size); },
+        "Maximum number of libraries kept in the process-wide cache")
+
+    .def_static("clear_cache",
+        &DependencyResolver::clear_cache,
+        "Remove all the libraries from the process-wide cache");
+}
+
+}
+}
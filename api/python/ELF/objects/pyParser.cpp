@@ -26,6 +26,24 @@ template<>
 void create<Parser>(py::module& m) {
 
   // Parser (Parser)
+  // The buffer overload must be registered before the overloads that take a list,
+  // otherwise a bytearray would be converted into a std::vector
+  m.def("parse",
+      [] (py::buffer buffer, const std::string& name, const ParserConfig& config) {
+        py::memoryview view = export_buffer(buffer);
+        std::unique_ptr<Binary> binary;
+        {
+          py::gil_scoped_release release;
+          binary = Parser::parse(as_span(view), name, config);
+        }
+        // The binary reads its content from the buffer
+        return keep_buffer(py::cast(std::move(binary)), view);
+      },
+      "Parse the given buffer (``bytes``, ``bytearray``, ``mmap``, ``numpy`` array, ...) without copying it "
+      "and return a " RST_CLASS_REF(lief.ELF.Binary) " object.\n\n"
+      "The buffer is locked (it can't be resized or closed) while the binary is alive",
+      "raw"_a, "name"_a = "", "config"_a = ParserConfig::deep());
+
   m.def("parse",
     static_cast<std::unique_ptr<Binary> (*) (const std::string&, DYNSYM_COUNT_METHODS)>(&Parser::parse),
     "Parse the given binary and return a " RST_CLASS_REF(lief.ELF.Binary) " object\n\n"
@@ -42,43 +60,33 @@ void create<Parser>(py::module& m) {
     "raw"_a, py::arg("name") = "", py::arg("dynsym_count_method") = DYNSYM_COUNT_METHODS::COUNT_AUTO,
     py::return_value_policy::take_ownership);
 
-
   m.def("parse",
-      [] (py::object byteio, const std::string& name) {
-        auto&& io = py::module::import("io");
-        auto&& RawIOBase = io.attr("RawIOBase");
-        auto&& BufferedIOBase = io.attr("BufferedIOBase");
-        auto&& TextIOBase = io.attr("TextIOBase");
-
-        py::object rawio;
-
-
-        if (py::isinstance(byteio, RawIOBase)) {
-          rawio = byteio;
-        }
+    static_cast<std::unique_ptr<Binary> (*) (const std::string&, const ParserConfig&)>(&Parser::parse),
+    "Parse the given binary with the given " RST_CLASS_REF(lief.ELF.ParserConfig) " and return a "
+    RST_CLASS_REF(lief.ELF.Binary) " object",
+    "filename"_a, "config"_a,
+    py::return_value_policy::take_ownership);
 
-        else if (py::isinstance(byteio, BufferedIOBase)) {
-          rawio = byteio.attr("raw");
-        }
+  m.def("parse",
+    static_cast<std::unique_ptr<Binary> (*) (const std::vector<uint8_t>&, const std::string&, const ParserConfig&)>(&Parser::parse),
+    "Parse the given binary with the given " RST_CLASS_REF(lief.ELF.ParserConfig) " and return a "
+    RST_CLASS_REF(lief.ELF.Binary) " object",
+    "raw"_a, "name"_a, "config"_a,
+    py::return_value_policy::take_ownership);
 
-        else if (py::isinstance(byteio, TextIOBase)) {
-          rawio = byteio.attr("buffer").attr("raw");
-        }
 
-        else {
-          throw py::type_error(py::repr(byteio).cast<std::string>().c_str());
+  m.def("parse",
+      [] (py::object io, const std::string& name, const ParserConfig& config) {
+        py::memoryview view = export_io(io);
+        std::unique_ptr<Binary> binary;
+        {
+          py::gil_scoped_release release;
+          binary = Parser::parse(as_span(view), name, config);
         }
-
-        std::string raw_str = static_cast<py::bytes>(rawio.attr("readall")());
-        std::vector<uint8_t> raw = {
-          std::make_move_iterator(std::begin(raw_str)),
-          std::make_move_iterator(std::end(raw_str))};
-
-        return LIEF::ELF::Parser::parse(std::move(raw), name);
+        return keep_buffer(py::cast(std::move(binary)), view);
       },
       "io"_a,
-      "name"_a = "",
-      py::return_value_policy::take_ownership);
+      "name"_a = "", "config"_a = ParserConfig::deep());
 }
 }
 }
@@ -0,0 +1,55 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+
+#include "LIEF/ELF/ParserConfig.hpp"
+
+#include "pyELF.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+template<>
+void create<ParserConfig>(py::module& m) {
+
+  py::class_<ParserConfig>(m, "ParserConfig",
+      "Configuration of the ELF parser\n\n"
+      "The tables set as *lazy* are parsed the first time they are accessed")
+    .def(py::init<>())
+    .def_readwrite("lazy_static_symbols",  &ParserConfig::lazy_static_symbols)
+    .def_readwrite("lazy_relocations",     &ParserConfig::lazy_relocations)
+    .def_readwrite("lazy_symbol_versions", &ParserConfig::lazy_symbol_versions)
+    .def_readwrite("lazy_hash_tables",     &ParserConfig::lazy_hash_tables)
+    .def_readwrite("lazy_notes",           &ParserConfig::lazy_notes)
+    .def_readwrite("lazy_overlay",         &ParserConfig::lazy_overlay)
+    .def_readwrite("dynsym_count_method",  &ParserConfig::count_mtd)
+
+    .def("lazy", &ParserConfig::lazy,
+        "Set all the ``lazy_*`` attributes to the given value",
+        "flag"_a,
+        py::return_value_policy::reference)
+
+    .def_property_readonly_static("deep",
+      [] (py::object /* self */) { return ParserConfig::deep(); },
+      "")
+
+    .def_property_readonly_static("quick",
+      [] (py::object /* self */) { return ParserConfig::quick(); },
+      "");
+}
+
+}
+}
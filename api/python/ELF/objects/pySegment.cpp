@@ -94,6 +94,32 @@ void create<Segment>(py::module& m) {
         static_cast<setter_t<const std::vector<uint8_t>&>>(&Segment::content),
         "Segment's raw data")
 
+    .def_property_readonly("content_view",
+        [] (py::object self) {
+          const Segment& obj = self.cast<const Segment&>();
+          return to_memoryview(self, obj.content_view(), [&obj] { return obj.content(); });
+        },
+        "Read-only ``memoryview`` on the segment's content which keeps the binary alive. "
+        "Contrary to :attr:`~lief.ELF.Segment.content`, it doesn't copy the content when "
+        "the binary borrows it from the buffer given to the parser.\n\n"
+        "The view is a snapshot: it is not affected by the modifications of the segment")
+
+    .def_property_readonly("entropy",
+        &Segment::entropy,
+        "Segment's entropy")
+
+    .def("histogram",
+        &Segment::histogram,
+        "Number of occurrences of each byte value (``list`` of 256 integers).\n\n"
+        "Large segments can be processed by ``nb_threads`` threads (0: number of cores)",
+        "nb_threads"_a = 1)
+
+    .def("entropy_curve",
+        &Segment::entropy_curve,
+        "Entropy of the windows of ``block_size`` bytes of the segment, every ``step`` bytes "
+        "(``step = 0`` means consecutive blocks)",
+        "block_size"_a, "step"_a = 0)
+
     .def("add",
         &Segment::add,
         "Add the given " RST_CLASS_REF(lief.ELF.SEGMENT_FLAGS) " to the list of "
@@ -32,6 +32,7 @@ void init_python_module(py::module& m) {
 }
 
 void init_objects(py::module& m) {
+  CREATE(ParserConfig, m);
   CREATE(Parser, m);
   CREATE(SymbolVersion, m);
   CREATE(Binary, m);
@@ -54,6 +55,7 @@ void init_objects(py::module& m) {
   CREATE(GnuHash, m);
   CREATE(SysvHash, m);
   CREATE(Builder, m);
+  CREATE(DependencyResolver, m);
   CREATE(Note, m);
   CREATE(NoteDetails, m);
   CREATE(AndroidNote, m);
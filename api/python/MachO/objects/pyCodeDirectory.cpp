@@ -0,0 +1,123 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <sstream>
+
+#include "LIEF/MachO/CodeDirectory.hpp"
+#include "LIEF/MachO/EnumToString.hpp"
+
+#include "enums_wrapper.hpp"
+
+#include "pyMachO.hpp"
+
+#define PY_ENUM(x) LIEF::MachO::to_string(x), x
+
+namespace LIEF {
+namespace MachO {
+
+template<class T>
+using getter_t = T (CodeDirectory::*)(void) const;
+
+
+template<>
+void create<CodeDirectory>(py::module& m) {
+
+  py::class_<CodeDirectory> cls(m, "CodeDirectory",
+      "Blob of the code signature that holds the hashes of the pages and of the special slots");
+
+  cls
+    .def_property_readonly("slot_type",
+        static_cast<getter_t<uint32_t>>(&CodeDirectory::slot_type),
+        "Type of the slot in the SuperBlob (``0`` or ``0x1000+`` for the alternate directories)")
+
+    .def_property_readonly("version",
+        static_cast<getter_t<uint32_t>>(&CodeDirectory::version))
+
+    .def_property_readonly("flags",
+        static_cast<getter_t<uint32_t>>(&CodeDirectory::flags))
+
+    .def_property_readonly("hash_type",
+        static_cast<getter_t<CodeDirectory::HASH_TYPES>>(&CodeDirectory::hash_type),
+        "Hash algorithm (" RST_CLASS_REF(lief.MachO.CodeDirectory.HASH_TYPES) ")")
+
+    .def_property_readonly("hash_size",
+        static_cast<getter_t<uint8_t>>(&CodeDirectory::hash_size),
+        "Size of the hashes in bytes")
+
+    .def_property_readonly("page_size",
+        static_cast<getter_t<uint32_t>>(&CodeDirectory::page_size),
+        "Size of the hashed pages in bytes (``0`` if the code is hashed in one piece)")
+
+    .def_property_readonly("code_limit",
+        static_cast<getter_t<uint64_t>>(&CodeDirectory::code_limit),
+        "Number of bytes of the binary covered by the code slots")
+
+    .def_property_readonly("identifier",
+        &CodeDirectory::identifier,
+        "Signing identifier")
+
+    .def_property_readonly("team_id",
+        &CodeDirectory::team_id,
+        "Team identifier")
+
+    .def_property_readonly("code_hashes",
+        [] (const CodeDirectory& cd) {
+          py::list hashes;
+          for (size_t i = 0; i < cd.nb_code_slots(); ++i) {
+            span<const uint8_t> hash = cd.code_hash(i);
+            hashes.append(py::bytes(reinterpret_cast<const char*>(hash.data()), hash.size()));
+          }
+          return hashes;
+        },
+        "Hashes of the pages")
+
+    .def_property_readonly("special_hashes",
+        [] (const CodeDirectory& cd) {
+          py::list hashes;
+          for (size_t slot = 1; slot <= cd.nb_special_slots(); ++slot) {
+            span<const uint8_t> hash = cd.special_hash(slot);
+            hashes.append(py::bytes(reinterpret_cast<const char*>(hash.data()), hash.size()));
+          }
+          return hashes;
+        },
+        "Hashes of the special slots ``-1``, ``-2``, ...")
+
+    .def("page_range",
+        &CodeDirectory::page_range,
+        "Range ``(start, end)`` of the binary hashed by the given code slot",
+        "index"_a)
+
+    .def("__str__",
+        [] (const CodeDirectory& cd)
+        {
+          std::ostringstream stream;
+          stream << cd;
+          std::string str = stream.str();
+          return str;
+        });
+
+
+  LIEF::enum_<CodeDirectory::HASH_TYPES>(cls, "HASH_TYPES")
+    .value(PY_ENUM(CodeDirectory::HASH_TYPES::NONE))
+    .value(PY_ENUM(CodeDirectory::HASH_TYPES::SHA1))
+    .value(PY_ENUM(CodeDirectory::HASH_TYPES::SHA256))
+    .value(PY_ENUM(CodeDirectory::HASH_TYPES::SHA256_TRUNCATED))
+    .value(PY_ENUM(CodeDirectory::HASH_TYPES::SHA384));
+
+}
+
+}
+}
@@ -18,6 +18,9 @@
 #include <string>
 #include <sstream>
 
+#include <pybind11/chrono.h>
+#include <pybind11/stl.h>
+
 #include "LIEF/MachO/hash.hpp"
 #include "LIEF/MachO/CodeSignature.hpp"
 
@@ -36,7 +39,45 @@ using setter_t = void (CodeSignature::*)(T);
 template<>
 void create<CodeSignature>(py::module& m) {
 
-  py::class_<CodeSignature, LoadCommand>(m, "CodeSignature")
+  init_ref_iterator<CodeSignature::it_const_code_directories>(m);
+
+  py::class_<CodeSignature, LoadCommand> cls(m, "CodeSignature");
+
+  py::class_<CodeSignature::directory_verification_t>(cls, "DirectoryVerification",
+      "Outcome of the verification of a " RST_CLASS_REF(lief.MachO.CodeDirectory) "")
+    .def_readonly("index",
+        &CodeSignature::directory_verification_t::index,
+        "Index of the directory in " RST_ATTR_REF(lief.MachO.CodeSignature.code_directories) "")
+
+    .def_readonly("nb_pages",
+        &CodeSignature::directory_verification_t::nb_pages,
+        "Number of pages that have been hashed")
+
+    .def_readonly("mismatched_pages",
+        &CodeSignature::directory_verification_t::mismatched_pages,
+        "Indexes of the pages whose hash doesn't match the code slot")
+
+    .def_readonly("mismatched_special_slots",
+        &CodeSignature::directory_verification_t::mismatched_special_slots,
+        "Special slots whose blob doesn't match the hash")
+
+    .def_readonly("missing_special_slots",
+        &CodeSignature::directory_verification_t::missing_special_slots,
+        "Special slots which are set but whose blob is not in the signature")
+
+    .def_readonly("uncovered_size",
+        &CodeSignature::directory_verification_t::uncovered_size,
+        "Size of the code (up to " RST_ATTR_REF(lief.MachO.CodeDirectory.code_limit) ") "
+        "which is not covered by the code slots")
+
+    .def_readonly("elapsed",
+        &CodeSignature::directory_verification_t::elapsed,
+        "Time spent on this directory")
+
+    .def_property_readonly("is_valid",
+        &CodeSignature::directory_verification_t::is_valid);
+
+  cls
 
     .def_property("data_offset",
         static_cast<getter_t<uint32_t>>(&CodeSignature::data_offset),
@@ -48,6 +89,39 @@ void create<CodeSignature>(py::module& m) {
         static_cast<setter_t<uint32_t>>(&CodeSignature::data_size),
         "Size of the raw signature")
 
+    .def_property_readonly("content",
+        [] (const CodeSignature& sig) {
+          const std::vector<uint8_t>& content = sig.content();
+          return py::bytes(reinterpret_cast<const char*>(content.data()), content.size());
+        },
+        "Raw content of the signature (i.e. the SuperBlob)")
+
+    .def_property_readonly("code_directories",
+        &CodeSignature::code_directories,
+        "Iterator over the " RST_CLASS_REF(lief.MachO.CodeDirectory) " of the signature",
+        py::return_value_policy::reference_internal)
+
+    .def("verify",
+        [] (const CodeSignature& sig, const std::string& filename, size_t nb_threads) {
+          py::gil_scoped_release release;
+          return sig.verify(filename, nb_threads);
+        },
+        "Recompute the page hashes against the given file (the slice that embeds the signature "
+        "for a FAT binary) and check the special slots.\n\n"
+        "The pages are hashed with ``nb_threads`` threads (0: number of hardware threads).",
+        "filename"_a, "nb_threads"_a = 0)
+
+    .def("verify",
+        [] (const CodeSignature& sig, const py::bytes& raw, size_t nb_threads) {
+          // The bytes are immutable: hash them in place
+          const auto* data = reinterpret_cast<const uint8_t*>(PyBytes_AS_STRING(raw.ptr()));
+          const size_t size = PyBytes_GET_SIZE(raw.ptr());
+          py::gil_scoped_release release;
+          return sig.verify(span<const uint8_t>{data, size}, nb_threads);
+        },
+        "Recompute the page hashes against the raw content of the Mach-O binary",
+        "raw"_a, "nb_threads"_a = 0)
+
     .def("__eq__", &CodeSignature::operator==)
     .def("__ne__", &CodeSignature::operator!=)
     .def("__hash__",
@@ -27,6 +27,19 @@ template<>
 void create<Parser>(py::module& m) {
 
   // Parser (Parser)
+  // The buffer overload must be registered before the overloads that take a list,
+  // otherwise a bytearray would be converted into a std::vector
+  m.def("parse",
+      [] (py::buffer buffer, const std::string& name, const ParserConfig& config) {
+        py::memoryview view = export_buffer(buffer);
+        py::gil_scoped_release release;
+        return Parser::parse(as_span(view), name, config);
+      },
+      "Parse the given buffer (``bytes``, ``bytearray``, ``mmap``, ``numpy`` array, ...) without copying it "
+      "and return a " RST_CLASS_REF(lief.MachO.FatBinary) " object",
+      "raw"_a, "name"_a = "", "config"_a = ParserConfig::quick(),
+      py::return_value_policy::take_ownership);
+
   m.def("parse",
     static_cast<std::unique_ptr<FatBinary> (*) (const std::string&, const ParserConfig&)>(&LIEF::MachO::Parser::parse),
     "Parse the given binary and return a " RST_CLASS_REF(lief.MachO.FatBinary) " object\n\n"
@@ -48,38 +61,11 @@ void create<Parser>(py::module& m) {
     py::return_value_policy::take_ownership);
 
 
-    m.def("parse",
-      [] (py::object byteio, std::string name, const ParserConfig& config) {
-        auto&& io = py::module::import("io");
-        auto&& RawIOBase = io.attr("RawIOBase");
-        auto&& BufferedIOBase = io.attr("BufferedIOBase");
-        auto&& TextIOBase = io.attr("TextIOBase");
-
-        py::object rawio;
-
-
-        if (py::isinstance(byteio, RawIOBase)) {
-          rawio = byteio;
-        }
-
-        else if (py::isinstance(byteio, BufferedIOBase)) {
-          rawio = byteio.attr("raw");
-        }
-
-        else if (py::isinstance(byteio, TextIOBase)) {
-          rawio = byteio.attr("buffer").attr("raw");
-        }
-
-        else {
-          throw py::type_error(py::repr(byteio).cast<std::string>().c_str());
-        }
-
-        std::string raw_str = static_cast<py::bytes>(rawio.attr("readall")());
-        std::vector<uint8_t> raw = {
-          std::make_move_iterator(std::begin(raw_str)),
-          std::make_move_iterator(std::end(raw_str))};
-
-        return LIEF::MachO::Parser::parse(std::move(raw), name, config);
+  m.def("parse",
+      [] (py::object io, const std::string& name, const ParserConfig& config) {
+        py::memoryview view = export_io(io);
+        py::gil_scoped_release release;
+        return Parser::parse(as_span(view), name, config);
       },
       "io"_a,
       "name"_a = "",
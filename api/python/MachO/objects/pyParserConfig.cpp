@@ -30,6 +30,9 @@ void create<ParserConfig>(py::module& m) {
     .def_readwrite("parse_dyld_exports",  &ParserConfig::parse_dyld_exports)
     .def_readwrite("parse_dyld_bindings", &ParserConfig::parse_dyld_bindings)
     .def_readwrite("parse_dyld_rebases",  &ParserConfig::parse_dyld_rebases)
+    .def_readwrite("nb_threads",          &ParserConfig::nb_threads,
+        "Number of threads used to parse the slices of a FAT binary and the fileset entries "
+        "(0: number of hardware threads)")
 
     .def("full_dyldinfo",  &ParserConfig::full_dyldinfo)
 
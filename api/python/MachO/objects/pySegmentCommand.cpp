@@ -111,6 +111,15 @@ void create<SegmentCommand>(py::module& m) {
         "Segment's content"
         )
 
+    .def_property_readonly("content_view",
+        [] (py::object self) {
+          return to_memoryview(self, self.cast<const SegmentCommand&>().content());
+        },
+        "Read-only ``memoryview`` on the segment's content which keeps the binary alive. "
+        "Contrary to :attr:`~lief.MachO.SegmentCommand.content`, it is returned as a bytes-like object "
+        "instead of a list.\n\n"
+        "The view is a snapshot: it is not affected by the modifications of the segment")
+
 
     .def_property("flags",
         static_cast<getter_t<uint32_t>>(&SegmentCommand::flags),
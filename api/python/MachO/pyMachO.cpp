@@ -56,6 +56,7 @@ void init_objects(py::module& m) {
   CREATE(BindingInfo, m);
   CREATE(ExportInfo, m);
   CREATE(FunctionStarts, m);
+  CREATE(CodeDirectory, m);
   CREATE(CodeSignature, m);
   CREATE(DataInCode, m);
   CREATE(DataCodeEntry, m);
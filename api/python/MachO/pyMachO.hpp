@@ -69,6 +69,7 @@ SPECIALIZE_CREATE(RelocationDyld);
 SPECIALIZE_CREATE(BindingInfo);
 SPECIALIZE_CREATE(ExportInfo);
 SPECIALIZE_CREATE(FunctionStarts);
+SPECIALIZE_CREATE(CodeDirectory);
 SPECIALIZE_CREATE(CodeSignature);
 SPECIALIZE_CREATE(DataInCode);
 SPECIALIZE_CREATE(DataCodeEntry);
@@ -135,6 +135,14 @@ void create<Binary>(py::module& m) {
     .def_property_readonly("has_signatures", &Binary::has_signatures,
         "``True`` if the binary has signatures (" RST_CLASS_REF(lief.PE.Signature) ")")
 
+    .def_property_readonly("skipped", &Binary::skipped,
+        "Structures (" RST_CLASS_REF(lief.PE.SkippedStructures) ") which are present in the input "
+        "but which have been skipped by the parser.\n\n"
+        "For instance, ``skipped.signature`` is ``True`` if the input is signed but the "
+        "signatures are not parsed. The " RST_CLASS_REF(lief.PE.Builder) " fails if the overlay "
+        "has been skipped.",
+        py::return_value_policy::reference_internal)
+
     .def_property_readonly("is_reproducible_build", &Binary::is_reproducible_build,
         "``True`` if the binary was compiled with a reproducible build directive (" RST_CLASS_REF(lief.PE.Debug) ")")
 
@@ -165,8 +173,22 @@ void create<Binary>(py::module& m) {
         "given in the first parameter",
         "algorithm"_a)
 
+    .def("authentihashes",
+        [] (const Binary& bin, const std::vector<ALGORITHMS>& algos) {
+          py::dict result;
+          for (auto&& p : bin.authentihash(algos)) {
+            const std::vector<uint8_t>& data = p.second;
+            result[py::cast(p.first)] = py::bytes(reinterpret_cast<const char*>(data.data()), data.size());
+          }
+          return result;
+        },
+        "Compute the authentihashes for the list of " RST_CLASS_REF(lief.PE.ALGORITHMS) " "
+        "given in the first parameter with a single traversal of the binary.\n\n"
+        "Return a ``dict`` ``algorithm -> digest``",
+        "algorithms"_a)
+
     .def("verify_signature",
-        static_cast<Signature::VERIFICATION_FLAGS(Binary::*)(Signature::VERIFICATION_CHECKS) const>(&Binary::verify_signature),
+        static_cast<Signature::VERIFICATION_FLAGS(Binary::*)(Signature::VERIFICATION_CHECKS, size_t) const>(&Binary::verify_signature),
         R"delim(
         Verify the binary against the embedded signature(s) (if any)
         Firstly, it checks that the embedded signatures are correct (c.f. :meth:`lief.PE.Signature.check`)
@@ -174,11 +196,14 @@ void create<Binary>(py::module& m) {
 
         One can tweak the verification process with the :class:`lief.PE.Signature.VERIFICATION_CHECKS` flags
 
+        The signatures are checked by ``nb_threads`` threads (0: number of hardware threads)
+
         .. seealso::
 
             :meth:`lief.PE.Signature.check`
         )delim",
-        "checks"_a = Signature::VERIFICATION_CHECKS::DEFAULT)
+        "checks"_a = Signature::VERIFICATION_CHECKS::DEFAULT,
+        "nb_threads"_a = 0)
 
     .def("verify_signature",
         static_cast<Signature::VERIFICATION_FLAGS(Binary::*)(const Signature&, Signature::VERIFICATION_CHECKS) const>(&Binary::verify_signature),
@@ -315,6 +340,25 @@ void create<Binary>(py::module& m) {
         "Return the overlay content as a ``list`` of bytes",
         py::return_value_policy::reference)
 
+    .def_property_readonly("overlay_view",
+        [] (py::object self) {
+          return to_memoryview(self, self.cast<const Binary&>().overlay());
+        },
+        "Read-only ``memoryview`` on the overlay which keeps the binary alive. "
+        "Contrary to :attr:`~lief.PE.Binary.overlay`, it is returned as a bytes-like object "
+        "instead of a list.\n\n"
+        "The view is a snapshot: it is not affected by the modifications of the binary")
+
+    .def_property_readonly("overlay_entropy",
+        &Binary::overlay_entropy,
+        "Entropy of the overlay")
+
+    .def("overlay_entropy_curve",
+        &Binary::overlay_entropy_curve,
+        "Entropy of the windows of ``block_size`` bytes of the overlay, every ``step`` bytes "
+        "(``step = 0`` means consecutive blocks)",
+        "block_size"_a, "step"_a = 0)
+
     .def_property("dos_stub",
         static_cast<getter_t<const std::vector<uint8_t>&>>(&Binary::dos_stub),
         static_cast<setter_t<const std::vector<uint8_t>&>>(&Binary::dos_stub),
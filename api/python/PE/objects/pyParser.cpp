@@ -25,54 +25,43 @@ namespace PE {
 template<>
 void create<Parser>(py::module& m) {
 
+    // The buffer overload must be registered before the overloads that take a list,
+    // otherwise a bytearray would be converted into a std::vector
     m.def("parse",
-    static_cast<std::unique_ptr<Binary> (*) (const std::string&)>(&Parser::parse),
-    "Parse the given binary and return a " RST_CLASS_REF(lief.PE.Binary) " object",
-    py::arg("filename"),
-    py::return_value_policy::take_ownership);
+      [] (py::buffer buffer, const std::string& name, const ParserConfig& config) {
+        py::memoryview view = export_buffer(buffer);
+        py::gil_scoped_release release;
+        return Parser::parse(as_span(view), name, config);
+      },
+      "Parse the given buffer (``bytes``, ``bytearray``, ``mmap``, ``numpy`` array, ...) without copying it "
+      "and return a " RST_CLASS_REF(lief.PE.Binary) " object",
+      "raw"_a, "name"_a = "", "config"_a = ParserConfig::deep(),
+      py::return_value_policy::take_ownership);
 
     m.def("parse",
-    static_cast<std::unique_ptr<Binary> (*) (const std::vector<uint8_t>&, const std::string&)>(&Parser::parse),
-    "Parse the given binary and return a " RST_CLASS_REF(lief.PE.Binary) " object",
-    py::arg("raw"), py::arg("name") = "",
+    static_cast<std::unique_ptr<Binary> (*) (const std::string&, const ParserConfig&)>(&Parser::parse),
+    "Parse the given binary and return a " RST_CLASS_REF(lief.PE.Binary) " object\n\n"
+    "One can configure the parsing with the ``config`` parameter. See " RST_CLASS_REF(lief.PE.ParserConfig) "",
+    py::arg("filename"), py::arg("config") = ParserConfig::deep(),
     py::return_value_policy::take_ownership);
 
-
     m.def("parse",
-      [] (py::object byteio, const std::string& name) {
-        auto&& io = py::module::import("io");
-        auto&& RawIOBase = io.attr("RawIOBase");
-        auto&& BufferedIOBase = io.attr("BufferedIOBase");
-        auto&& TextIOBase = io.attr("TextIOBase");
-
-        py::object rawio;
-
-
-        if (py::isinstance(byteio, RawIOBase)) {
-          rawio = byteio;
-        }
-
-        else if (py::isinstance(byteio, BufferedIOBase)) {
-          rawio = byteio.attr("raw");
-        }
-
-        else if (py::isinstance(byteio, TextIOBase)) {
-          rawio = byteio.attr("buffer").attr("raw");
-        }
-
-        else {
-          throw py::type_error(py::repr(byteio).cast<std::string>().c_str());
-        }
+    static_cast<std::unique_ptr<Binary> (*) (const std::vector<uint8_t>&, const std::string&, const ParserConfig&)>(&Parser::parse),
+    "Parse the given binary and return a " RST_CLASS_REF(lief.PE.Binary) " object\n\n"
+    "One can configure the parsing with the ``config`` parameter. See " RST_CLASS_REF(lief.PE.ParserConfig) "",
+    py::arg("raw"), py::arg("name") = "", py::arg("config") = ParserConfig::deep(),
+    py::return_value_policy::take_ownership);
 
-        std::string raw_str = static_cast<py::bytes>(rawio.attr("readall")());
-        std::vector<uint8_t> raw = {
-          std::make_move_iterator(std::begin(raw_str)),
-          std::make_move_iterator(std::end(raw_str))};
 
-        return LIEF::PE::Parser::parse(std::move(raw), name);
+    m.def("parse",
+      [] (py::object io, const std::string& name, const ParserConfig& config) {
+        py::memoryview view = export_io(io);
+        py::gil_scoped_release release;
+        return Parser::parse(as_span(view), name, config);
       },
       "io"_a,
       "name"_a = "",
+      "config"_a = ParserConfig::deep(),
       py::return_value_policy::take_ownership);
 }
 
@@ -0,0 +1,71 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+
+#include "LIEF/PE/ParserConfig.hpp"
+
+#include "pyPE.hpp"
+
+namespace LIEF {
+namespace PE {
+
+template<>
+void create<ParserConfig>(py::module& m) {
+
+  py::class_<ParserConfig>(m, "ParserConfig", "Configuration of the PE parser")
+    .def(py::init<>())
+    .def_readwrite("parse_rich_header", &ParserConfig::parse_rich_header)
+    .def_readwrite("parse_imports",     &ParserConfig::parse_imports)
+    .def_readwrite("parse_exports",     &ParserConfig::parse_exports)
+    .def_readwrite("parse_relocations", &ParserConfig::parse_relocations)
+    .def_readwrite("parse_resources",   &ParserConfig::parse_resources)
+    .def_readwrite("parse_debug",       &ParserConfig::parse_debug)
+    .def_readwrite("parse_tls",         &ParserConfig::parse_tls)
+    .def_readwrite("parse_load_config", &ParserConfig::parse_load_config)
+    .def_readwrite("parse_signature",   &ParserConfig::parse_signature)
+    .def_readwrite("parse_symbols",     &ParserConfig::parse_symbols)
+    .def_readwrite("parse_overlay",     &ParserConfig::parse_overlay)
+
+    .def_property_readonly_static("deep",
+      [] (py::object /* self */) { return ParserConfig::deep(); },
+      "")
+
+    .def_property_readonly_static("quick",
+      [] (py::object /* self */) { return ParserConfig::quick(); },
+      "")
+
+    .def_property_readonly_static("none",
+      [] (py::object /* self */) { return ParserConfig::none(); },
+      "Only parse the headers, the sections and the data directories");
+
+  py::class_<SkippedStructures>(m, "SkippedStructures",
+      "Structures which are present in the input but which have not been parsed "
+      "because of the " RST_CLASS_REF(lief.PE.ParserConfig) " (see: " RST_ATTR_REF(lief.PE.Binary.skipped) ")")
+    .def_readonly("rich_header", &SkippedStructures::rich_header)
+    .def_readonly("imports",     &SkippedStructures::imports)
+    .def_readonly("exports",     &SkippedStructures::exports)
+    .def_readonly("relocations", &SkippedStructures::relocations)
+    .def_readonly("resources",   &SkippedStructures::resources)
+    .def_readonly("debug",       &SkippedStructures::debug)
+    .def_readonly("tls",         &SkippedStructures::tls)
+    .def_readonly("load_config", &SkippedStructures::load_config)
+    .def_readonly("signature",   &SkippedStructures::signature)
+    .def_readonly("symbols",     &SkippedStructures::symbols)
+    .def_readonly("overlay",     &SkippedStructures::overlay);
+}
+
+}
+}
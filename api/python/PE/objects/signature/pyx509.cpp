@@ -39,6 +39,18 @@ void create<x509>(py::module& m) {
 
   py::class_<x509, LIEF::Object> cls_x509(m, "x509", "Interface over a x509 certificate");
 
+  py::class_<x509::cache_stats_t>(cls_x509, "cache_stats_t",
+      "Statistics of the cache used by " RST_METH_REF(lief.PE.x509.verify) " and "
+      RST_METH_REF(lief.PE.x509.is_trusted_by) "")
+    .def_readonly("hits",        &x509::cache_stats_t::hits,
+        "Verifications whose result comes from the cache")
+    .def_readonly("misses",      &x509::cache_stats_t::misses,
+        "Verifications done by mbedtls")
+    .def_readonly("nb_ca_lists", &x509::cache_stats_t::nb_ca_lists,
+        "CA lists in the cache")
+    .def_readonly("nb_results",  &x509::cache_stats_t::nb_results,
+        "Verification results in the cache");
+
   LIEF::enum_<x509::VERIFICATION_FLAGS>(cls_x509, "VERIFICATION_FLAGS", py::arithmetic(),
       "Verification flags associated with " RST_METH_REF(lief.PE.x509.verify) "")
     .value("OK",                    x509::VERIFICATION_FLAGS::OK,                    "The verification succeed")
@@ -200,9 +212,24 @@ void create<x509>(py::module& m) {
             signer = binary.signatures[0].signers[0]
             microsoft_ca_bundle  lief.PE.x509.parse("bundle.pem")
             print(signer.cert.is_trusted_by(microsoft_ca_bundle))
+
+        The CA list is parsed once and kept in a process-wide cache along with the verification results
+        (see :meth:`~lief.PE.x509.clear_cache`). The results that depend on the current time
+        (e.g. :attr:`~lief.PE.x509.VERIFICATION_FLAGS.BADCERT_EXPIRED`) are not cached.
         )delim",
         "ca_list"_a)
 
+    .def_static("clear_cache",
+        &x509::clear_cache,
+        "Clear the cache of the CA lists and of the verification results used by "
+        ":meth:`~lief.PE.x509.verify` and :meth:`~lief.PE.x509.is_trusted_by`")
+
+    .def_static("cache_stats",
+        &x509::cache_stats,
+        "Statistics (" RST_CLASS_REF(lief.PE.x509.cache_stats_t) ") of the cache used by "
+        ":meth:`~lief.PE.x509.verify` and :meth:`~lief.PE.x509.is_trusted_by` since the last "
+        ":meth:`~lief.PE.x509.clear_cache`")
+
     .def("__hash__",
         [] (const x509& obj) {
           return Hash::hash(obj);
@@ -45,6 +45,7 @@ void init_enums(py::module&);
 void init_utils(py::module&);
 
 SPECIALIZE_CREATE(Parser);
+SPECIALIZE_CREATE(ParserConfig);
 
 SPECIALIZE_CREATE(Binary);
 SPECIALIZE_CREATE(DosHeader);
@@ -0,0 +1,155 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+
+#include "pyBuffer.hpp"
+
+//! Read-only buffer (exported through the buffer protocol) on the
+//! content of a LIEF object
+struct content_buffer {
+  py::object owner;
+  py::object input;           // Input buffer that contains ``data`` (zero-copy)
+  std::vector<uint8_t> copy;  // Copy of the content otherwise
+  LIEF::span<const uint8_t> data;
+};
+
+//! Python buffers borrowed by the parsed binaries: ``[start, end)`` and a weak reference
+//! on the memoryview that exports them, indexed by this memoryview.
+//! The entries are removed when the memoryview is released.
+struct input_buffer {
+  uintptr_t start;
+  uintptr_t end;
+  py::weakref view;
+};
+using input_buffers_t = std::map<const void*, input_buffer>;
+
+static input_buffers_t& input_buffers() {
+  // Not destroyed such as no weak reference is released after the interpreter
+  static auto* buffers = new input_buffers_t{};
+  return *buffers;
+}
+
+//! Memoryview of an input buffer which contains ``data`` or None
+static py::object find_input(LIEF::span<const uint8_t> data) {
+  if (data.empty()) {
+    return py::none();
+  }
+  const auto start = reinterpret_cast<uintptr_t>(data.data());
+  const auto end   = start + data.size();
+  for (const auto& p : input_buffers()) {
+    const input_buffer& input = p.second;
+    if (input.start <= start and end <= input.end) {
+      return input.view();
+    }
+  }
+  return py::none();
+}
+
+
+py::memoryview export_buffer(py::handle obj) {
+  py::memoryview view = py::reinterpret_steal<py::memoryview>(PyMemoryView_FromObject(obj.ptr()));
+  if (not view) {
+    throw py::error_already_set();
+  }
+  if (not PyBuffer_IsContiguous(PyMemoryView_GET_BUFFER(view.ptr()), 'C')) {
+    throw py::value_error("The buffer must be C-contiguous");
+  }
+  return view;
+}
+
+
+py::memoryview export_io(py::handle io_obj) {
+  auto&& io = py::module::import("io");
+  auto&& RawIOBase      = io.attr("RawIOBase");
+  auto&& BufferedIOBase = io.attr("BufferedIOBase");
+  auto&& TextIOBase     = io.attr("TextIOBase");
+
+  if (py::hasattr(io_obj, "getbuffer")) {
+    return export_buffer(io_obj.attr("getbuffer")());
+  }
+
+  py::object rawio;
+  if (py::isinstance(io_obj, RawIOBase)) {
+    rawio = py::reinterpret_borrow<py::object>(io_obj);
+  }
+
+  else if (py::isinstance(io_obj, BufferedIOBase)) {
+    rawio = io_obj.attr("raw");
+  }
+
+  else if (py::isinstance(io_obj, TextIOBase)) {
+    rawio = io_obj.attr("buffer").attr("raw");
+  }
+
+  else {
+    throw py::type_error(py::repr(io_obj).cast<std::string>().c_str());
+  }
+
+  // The bytes object is owned by the view
+  return export_buffer(rawio.attr("readall")());
+}
+
+
+LIEF::span<const uint8_t> as_span(const py::memoryview& view) {
+  const Py_buffer* buffer = PyMemoryView_GET_BUFFER(view.ptr());
+  return {reinterpret_cast<const uint8_t*>(buffer->buf), static_cast<size_t>(buffer->len)};
+}
+
+
+py::object keep_buffer(py::object binary, const py::memoryview& view) {
+  py::detail::keep_alive_impl(binary, view);
+
+  LIEF::span<const uint8_t> data = as_span(view);
+  if (not data.empty()) {
+    const void* key = view.ptr();
+    py::cpp_function release{[key] (py::handle) { input_buffers().erase(key); }};
+    const auto start = reinterpret_cast<uintptr_t>(data.data());
+    input_buffers()[key] = {start, start + data.size(), py::weakref(view, release)};
+  }
+  return binary;
+}
+
+
+py::memoryview to_memoryview(py::handle owner, LIEF::span<const uint8_t> data,
+                             const std::function<std::vector<uint8_t>()>& content) {
+  content_buffer buffer;
+  buffer.owner = py::reinterpret_borrow<py::object>(owner);
+  buffer.input = find_input(data);
+  if (not buffer.input.is_none()) {
+    buffer.data = data;
+  } else {
+    // The memory of the object can be released or moved by a modification
+    // (e.g. when the content borrowed from the input is copied)
+    buffer.copy = content ? content() : std::vector<uint8_t>{std::begin(data), std::end(data)};
+    buffer.data = buffer.copy;
+  }
+  if (buffer.data.empty()) {
+    return export_buffer(py::bytes());
+  }
+  return export_buffer(py::cast(std::move(buffer)));
+}
+
+
+void init_LIEF_buffers(py::module& m) {
+  py::class_<content_buffer>(m, "_ContentBuffer", py::buffer_protocol())
+    .def_buffer([] (content_buffer& buffer) {
+        return py::buffer_info(
+            const_cast<uint8_t*>(buffer.data.data()),
+            sizeof(uint8_t), py::format_descriptor<uint8_t>::format(),
+            1, {static_cast<py::ssize_t>(buffer.data.size())}, {sizeof(uint8_t)},
+            /* readonly */ true);
+    });
+}
@@ -0,0 +1,55 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PY_LIEF_BUFFER_H_
+#define PY_LIEF_BUFFER_H_
+#include <pybind11/pybind11.h>
+
+#include <functional>
+#include <vector>
+
+#include "LIEF/span.hpp"
+
+namespace py = pybind11;
+
+//! Export the buffer of ``obj`` (``bytes``, ``bytearray``, ``mmap``, ``numpy`` arrays, ...)
+//! without copying it.
+//!
+//! The buffer is locked (it can't be resized or closed) as long as the memoryview is alive.
+py::memoryview export_buffer(py::handle obj);
+
+//! Export the content of a file-like object: ``getbuffer()`` for ``io.BytesIO``
+//! (no copy), ``readall()`` for the other objects
+py::memoryview export_io(py::handle io);
+
+//! Memory exported by the given memoryview
+LIEF::span<const uint8_t> as_span(const py::memoryview& view);
+
+//! Keep ``view`` (and thus the exported buffer) alive as long as ``binary`` is alive
+py::object keep_buffer(py::object binary, const py::memoryview& view);
+
+//! Read-only memoryview on the content of ``owner``, which it keeps alive.
+//!
+//! The view does not copy ``data`` if it lies in a buffer passed to ``keep_buffer``:
+//! this buffer is never modified by LIEF and stays valid as long as the view.
+//! Otherwise, the view owns a copy of the content returned by ``content``
+//! (or of ``data`` if it is not set) such as it remains valid when the
+//! owner is modified.
+py::memoryview to_memoryview(py::handle owner, LIEF::span<const uint8_t> data,
+                             const std::function<std::vector<uint8_t>()>& content = nullptr);
+
+void init_LIEF_buffers(py::module&);
+
+#endif
@@ -13,7 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fstream>
+
 #include "LIEF/config.h"
+#include "LIEF/exception.hpp"
 #include "LIEF/to_json.hpp"
 
 #include "pyLIEF.hpp"
@@ -21,4 +24,26 @@
 void init_json_functions(py::module& m) {
   m.def("to_json", &LIEF::to_json_str);
   m.def("to_json_from_abstract", &LIEF::to_json_str_from_abstract);
+
+  py::enum_<LIEF::JsonStream::FORMAT>(m, "JSON_FORMAT")
+    .value("JSON",   LIEF::JsonStream::FORMAT::JSON)
+    .value("NDJSON", LIEF::JsonStream::FORMAT::NDJSON)
+    .value("CBOR",   LIEF::JsonStream::FORMAT::CBOR);
+
+  m.def("to_json_file",
+      [] (const LIEF::Object& obj, const std::string& filename, LIEF::JsonStream::FORMAT format) {
+        std::ofstream output{filename, std::ios::out | std::ios::binary | std::ios::trunc};
+        if (not output) {
+          throw LIEF::bad_file("Unable to open " + filename);
+        }
+        LIEF::to_json(obj, output, format);
+      },
+      R"delim(
+      Write the JSON representation of the given object in ``filename``.
+
+      Binaries are written incrementally instead of building the whole
+      JSON document in memory.
+      )delim",
+      "obj"_a, "filename"_a, "format"_a = LIEF::JsonStream::FORMAT::JSON,
+      py::call_guard<py::gil_scoped_release>());
 }
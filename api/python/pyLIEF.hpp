@@ -27,6 +27,7 @@
 
 #include "pyIterators.hpp"
 #include "pyErr.hpp"
+#include "pyBuffer.hpp"
 
 #define RST_CLASS_REF(X) ":class:`~"#X"`"
 #define RST_CLASS_REF_FULL(X) ":class:`"#X"`"
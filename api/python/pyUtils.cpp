@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "LIEF/Abstract/identify.hpp"
 #include "LIEF/PE/utils.hpp"
 #include "LIEF/MachO/utils.hpp"
 #include "LIEF/ELF/utils.hpp"
@@ -62,6 +63,18 @@ void init_utils_functions(py::module& m) {
       },
       "Trigger 'pdb.set_trace()'");
 
+  m.def("identify",
+      static_cast<LIEF::FILE_FORMATS (*)(const std::string&)>(&LIEF::identify),
+      "Return the " RST_CLASS_REF(lief.FILE_FORMATS) " of the given file from its header",
+      "filename"_a);
+
+  m.def("identify",
+      [] (const std::vector<uint8_t>& raw) {
+        return LIEF::identify(LIEF::span<const uint8_t>{raw});
+      },
+      "Return the " RST_CLASS_REF(lief.FILE_FORMATS) " of the given raw data from its header",
+      "raw"_a);
+
 #if defined(LIEF_PE_SUPPORT)
     m.def("is_pe",
         static_cast<bool (*)(const std::string&)>(&LIEF::PE::is_pe),
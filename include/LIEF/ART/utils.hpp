@@ -24,6 +24,7 @@
 #include "LIEF/platforms/android.hpp"
 
 #include "LIEF/types.hpp"
+#include "LIEF/span.hpp"
 #include "LIEF/visibility.h"
 
 namespace LIEF {
@@ -35,6 +36,9 @@ LIEF_API bool is_art(const std::string& file);
 //! @brief Check if the given raw data is an ART one.
 LIEF_API bool is_art(const std::vector<uint8_t>& raw);
 
+//! @brief Check if the given buffer is an ART one.
+LIEF_API bool is_art(span<const uint8_t> raw);
+
 //! @brief Return the ART version of the given file
 LIEF_API art_version_t version(const std::string& file);
 
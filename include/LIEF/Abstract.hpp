@@ -20,6 +20,8 @@
 #include <LIEF/Abstract/enums.hpp>
 #include <LIEF/Abstract/EnumToString.hpp>
 #include <LIEF/Abstract/Parser.hpp>
+#include <LIEF/Abstract/BatchParser.hpp>
+#include <LIEF/Abstract/identify.hpp>
 #include <LIEF/Abstract/Relocation.hpp>
 #include <LIEF/Abstract/Function.hpp>
 #include <LIEF/Abstract/Symbol.hpp>
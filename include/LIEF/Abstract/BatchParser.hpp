@@ -0,0 +1,74 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ABSTRACT_BATCH_PARSER_H_
+#define LIEF_ABSTRACT_BATCH_PARSER_H_
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "LIEF/visibility.h"
+#include "LIEF/types.hpp"
+
+#include "LIEF/ELF/ParserConfig.hpp"
+#include "LIEF/PE/ParserConfig.hpp"
+#include "LIEF/MachO/ParserConfig.hpp"
+
+namespace LIEF {
+class Binary;
+
+//! Configuration of LIEF::parse_many
+struct LIEF_API BatchConfig {
+  //! Configuration used for the ELF binaries
+  ELF::ParserConfig   elf;
+
+  //! Configuration used for the PE binaries
+  PE::ParserConfig    pe;
+
+  //! Configuration used for the Mach-O binaries
+  //!
+  //! As for LIEF::Parser::parse, the **last** binary of a FAT Mach-O is returned
+  MachO::ParserConfig macho;
+};
+
+//! Function called by LIEF::parse_many for each file with the index of the file
+//! and the parsed binary (``nullptr`` if the file can't be parsed)
+using batch_callback_t = std::function<void(size_t index, std::unique_ptr<Binary> binary)>;
+
+//! Parse the given files with a pool of ``nb_threads`` threads (0 for the number of cores)
+//! and call ``callback`` as soon as a file is parsed.
+//!
+//! Errors are isolated per file: a file that can't be parsed (unknown format,
+//! exception raised by the parser, ...) is reported with a ``nullptr`` binary
+//! and doesn't stop the batch. An exception raised by ``callback`` stops the batch
+//! and is re-thrown once the workers are done.
+//!
+//! @warning ``callback`` is called concurrently from the worker threads
+LIEF_API void parse_many(const std::vector<std::string>& paths, const batch_callback_t& callback,
+                         const BatchConfig& config = BatchConfig{}, size_t nb_threads = 0);
+
+//! Parse the given files with a pool of ``nb_threads`` threads (0 for the number of cores)
+//! and return the binaries in the order of ``paths``.
+//!
+//! @see LIEF::parse_many
+LIEF_API std::vector<std::unique_ptr<Binary>> parse_many(const std::vector<std::string>& paths,
+                                                         const BatchConfig& config = BatchConfig{},
+                                                         size_t nb_threads = 0);
+
+}
+
+#endif
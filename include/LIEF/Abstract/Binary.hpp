@@ -17,11 +17,13 @@
 #define LIEF_ABSTRACT_BINARY_H_
 
 #include <vector>
+#include <map>
 #include <memory>
 
 #include "LIEF/types.hpp"
 #include "LIEF/visibility.h"
 #include "LIEF/Object.hpp"
+#include "LIEF/index_version.hpp"
 
 #include "LIEF/Abstract/type_traits.hpp"
 #include "LIEF/Abstract/Header.hpp"
@@ -110,6 +112,23 @@ class LIEF_API Binary : public Object {
 
   std::vector<uint64_t> xref(uint64_t address) const;
 
+  //! Batched version of Binary::xref: the sections are scanned only once for all the ``addresses``
+  //!
+  //! @param[in] addresses  Addresses to look for. They are encoded as in Section::search_all
+  //! @param[in] nb_threads Number of threads used to scan the sections (0: number of cores)
+  //!
+  //! @return The **virtual addresses** that *use* each address
+  std::map<uint64_t, std::vector<uint64_t>> xref(const std::vector<uint64_t>& addresses, size_t nb_threads = 1) const;
+
+  //! Search all the occurrences of the given ``patterns`` in the sections
+  //! with a single scan of each section
+  //!
+  //! @param[in] patterns   Byte patterns to look for
+  //! @param[in] nb_threads Number of threads used to scan the sections (0: number of cores)
+  //!
+  //! @return The **virtual addresses** of the occurrences of each pattern
+  std::map<std::vector<uint8_t>, std::vector<uint64_t>> search_all(const std::vector<std::vector<uint8_t>>& patterns, size_t nb_threads = 1) const;
+
   //! @brief Patch the content at virtual address @p address with @p patch_value
   //!
   //! @param[in] address Address to patch
@@ -167,11 +186,22 @@ class LIEF_API Binary : public Object {
 
   uint64_t original_size_;
 
+  //! Incremented when a section or a segment of this binary is modified,
+  //! added or removed (see: RangeIndex)
+  IndexVersion layout_version_;
+
+  //! Incremented when a symbol of this binary is renamed (see: NameIndex)
+  IndexVersion symbols_version_;
+
   virtual Header                    get_abstract_header() const = 0;
   virtual symbols_t                 get_abstract_symbols()      = 0;
   virtual sections_t                get_abstract_sections()     = 0;
   virtual relocations_t             get_abstract_relocations()  = 0;
 
+  //! Return the first symbol of get_abstract_symbols() with the given name
+  //! or a nullptr. The formats override it to use their symbols index.
+  virtual const Symbol*             get_abstract_symbol(const std::string& name) const;
+
   virtual functions_t  get_abstract_exported_functions() const = 0;
   virtual functions_t  get_abstract_imported_functions() const = 0;
   virtual std::vector<std::string>  get_abstract_imported_libraries() const = 0;
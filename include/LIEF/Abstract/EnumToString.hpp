@@ -26,6 +26,7 @@ LIEF_API const char* to_string(ARCHITECTURES e);
 LIEF_API const char* to_string(OBJECT_TYPES e);
 LIEF_API const char* to_string(MODES e);
 LIEF_API const char* to_string(ENDIANNESS e);
+LIEF_API const char* to_string(FILE_FORMATS e);
 LIEF_API const char* to_string(Binary::VA_TYPES e);
 LIEF_API const char* to_string(Function::FLAGS e);
 } // namespace LIEF
@@ -21,11 +21,13 @@
 #include <vector>
 
 #include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
 
 struct Profiler;
 
 namespace LIEF {
 class Binary;
+struct BatchConfig;
 class LIEF_API Parser {
   public:
   friend struct ::Profiler;
@@ -36,6 +38,13 @@ class LIEF_API Parser {
   //! @see LIEF::MachO::Parser::parse
   static std::unique_ptr<Binary> parse(const std::string& filename);
 
+  //! @brief Construct an LIEF::Binary from the given filename with the
+  //! configuration of the parser of its format
+  //!
+  //! @warning If the target file is a FAT Mach0, it will
+  //! return the **last** one
+  //! @see LIEF::parse_many
+  static std::unique_ptr<Binary> parse(const std::string& filename, const BatchConfig& config);
 
   //! @brief Construct an LIEF::Binary from the given raw data
   //!
@@ -44,6 +53,14 @@ class LIEF_API Parser {
   //! @see LIEF::MachO::Parser::parse
   static std::unique_ptr<Binary> parse(const std::vector<uint8_t>& raw, const std::string& name = "");
 
+  //! @brief Construct an LIEF::Binary from a buffer owned by the caller, without copying it
+  //!
+  //! @warning If the target file is a FAT Mach0, it will
+  //! return the **last** one
+  //! @warning An ELF (or OAT) binary reads its content from ``raw``: the buffer must outlive the binary
+  //! @see LIEF::ELF::Parser::parse
+  static std::unique_ptr<Binary> parse(span<const uint8_t> raw, const std::string& name = "");
+
   protected:
   Parser(const std::string& file);
   uint64_t    binary_size_;
@@ -21,11 +21,15 @@
 #include <iostream>
 
 #include "LIEF/types.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/entropy.hpp"
 #include "LIEF/Object.hpp"
+#include "LIEF/hash.hpp"
+#include "LIEF/index_version.hpp"
 #include "LIEF/visibility.h"
 
 namespace LIEF {
-class LIEF_API Section : public Object {
+class LIEF_API Section : public Object, public Indexed {
   public:
   static constexpr size_t npos = -1;
 
@@ -43,6 +47,17 @@ class LIEF_API Section : public Object {
   //! @brief section's content
   virtual std::vector<uint8_t> content() const;
 
+  //! Read-only view on the section's content, without copying it.
+  //!
+  //! The view is empty if the content can't be borrowed as a whole (in this case,
+  //! use Section::content) and it is invalidated when the section or the binary is modified.
+  virtual span<const uint8_t> content_view() const;
+
+  //! Digest of the section's content (see: Hash::hash)
+  //!
+  //! The digest is cached and it is computed again only when the content changes
+  size_t content_digest() const;
+
   //! @brief section's size (size in the binary)
   virtual void size(uint64_t size);
 
@@ -68,6 +83,17 @@ class LIEF_API Section : public Object {
   //! @brief Section's entropy
   double entropy() const;
 
+  //! Histogram of the section's bytes (see: LIEF::histogram)
+  histogram_t histogram(size_t nb_threads = 1) const;
+
+  //! Entropy of the windows of ``block_size`` bytes of the section,
+  //! every ``step`` bytes (see: LIEF::entropy_curve)
+  std::vector<double> entropy_curve(size_t block_size, size_t step = 0) const;
+
+  //! Return the bytes used to search ``integer`` (encoded on ``size`` bytes
+  //! or on the smallest integer type that fits if ``size`` is 0)
+  static std::vector<uint8_t> integer_pattern(uint64_t integer, size_t size);
+
   // Search functions
   // ================
   size_t search(uint64_t integer, size_t pos, size_t size) const;
@@ -83,6 +109,11 @@ class LIEF_API Section : public Object {
 
   std::vector<size_t> search_all(const std::string& v) const;
 
+  //! Search all the occurrences of several patterns with a single scan of the content
+  //!
+  //! @return The offsets of the occurrences of each pattern (in the order of ``patterns``)
+  std::vector<std::vector<size_t>> search_all(const std::vector<std::vector<uint8_t>>& patterns) const;
+
   //! @brief Method so that the ``visitor`` can visit us
   virtual void accept(Visitor& visitor) const override;
 
@@ -92,15 +123,32 @@ class LIEF_API Section : public Object {
   LIEF_API friend std::ostream& operator<<(std::ostream& os, const Section& entry);
 
   protected:
+  //! Key of the cached digest (see: Section::content_digest). By default,
+  //! it depends on the size of the section and on the number of modifications
+  //! of its content (see: Section::content_changed)
+  virtual DigestCache::key_t digest_key() const;
+
+  //! Must be called when the content owned by the section is modified
+  void content_changed();
+
   std::string name_;
   uint64_t    virtual_address_ = 0;
   uint64_t    size_ = 0;
   uint64_t    offset_ = 0;
+  uint64_t    content_version_ = 0;
 
   private:
   template<typename T>
   std::vector<size_t> search_all_(const T& v) const;
 
+  //! Return a view on the content. If the content can't be borrowed,
+  //! it is copied in ``buffer``
+  span<const uint8_t> view_or_copy(std::vector<uint8_t>& buffer) const;
+
+  static size_t find(span<const uint8_t> content, const std::vector<uint8_t>& pattern, size_t pos);
+  static std::vector<size_t> find_all(span<const uint8_t> content, const std::vector<uint8_t>& pattern);
+
+  DigestCache digest_;
 
 };
 }
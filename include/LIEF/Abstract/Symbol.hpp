@@ -19,10 +19,11 @@
 #include <string>
 
 #include "LIEF/Object.hpp"
+#include "LIEF/index_version.hpp"
 #include "LIEF/visibility.h"
 
 namespace LIEF {
-class LIEF_API Symbol : public Object {
+class LIEF_API Symbol : public Object, public Indexed {
   public:
   Symbol();
   Symbol(const std::string& name);
@@ -37,6 +38,11 @@ class LIEF_API Symbol : public Object {
   //! @brief Return symbol name
   virtual const std::string& name() const;
 
+  //! @brief Return a mutable reference on the symbol name
+  //!
+  //! @deprecated Use Symbol::name(const std::string&) to rename the symbol.
+  //! The indexes of the binary are invalidated when this accessor is called
+  //! so the name must not be modified through a reference kept after a lookup.
   virtual std::string& name();
 
   //! @brief Set symbol name
@@ -74,6 +74,19 @@ enum ENDIANNESS {
   ENDIAN_LITTLE = 2,
 };
 
+//! Formats recognized by LIEF::identify
+enum class FILE_FORMATS {
+  UNKNOWN = 0,
+  ELF,
+  OAT,       ///< ELF file with the ``oatdata`` symbol
+  PE,
+  MACHO,
+  MACHO_FAT,
+  DEX,
+  VDEX,
+  ART,
+};
+
 
 
 
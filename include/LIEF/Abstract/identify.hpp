@@ -0,0 +1,43 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ABSTRACT_IDENTIFY_H_
+#define LIEF_ABSTRACT_IDENTIFY_H_
+
+#include <string>
+
+#include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
+#include "LIEF/Abstract/enums.hpp"
+
+namespace LIEF {
+class BinaryStream;
+
+//! Identify the format of the given stream from its first bytes
+//!
+//! Only the header of the file is read, as well as the ``.dynsym`` section
+//! of the ELF files to tell OAT files apart (see: LIEF::OAT::is_oat(BinaryStream&)).
+//! The stream can then be given to the parser of the format.
+LIEF_API FILE_FORMATS identify(BinaryStream& stream);
+
+//! Identify the format of the given buffer
+LIEF_API FILE_FORMATS identify(span<const uint8_t> raw);
+
+//! Identify the format of the given file
+LIEF_API FILE_FORMATS identify(const std::string& filename);
+
+}
+
+#endif
@@ -36,12 +36,20 @@ class BinaryStream {
     UNKNOWN = 0,
     FILE,
     MEMORY,
+    MMAP,
+    SPAN,
   };
 
   BinaryStream();
   virtual ~BinaryStream();
   virtual uint64_t size() const = 0;
 
+  //! Open the given file as a stream.
+  //!
+  //! The file is memory-mapped (MmapStream) when the platform supports it,
+  //! otherwise it is fully loaded in memory (VectorStream).
+  static std::unique_ptr<BinaryStream> from_file(const std::string& filename);
+
   virtual STREAM_TYPE type() const = 0;
 
   uint64_t read_uleb128() const;
@@ -122,6 +130,11 @@ class BinaryStream {
 
   void set_endian_swap(bool swap);
 
+  //! Whether the values read with the ``*_conv`` functions are byte-swapped
+  inline bool endian_swap() const {
+    return this->endian_swap_;
+  }
+
   /* ASN.1 & X509 parsing functions */
   virtual result<size_t>                             asn1_read_tag(int tag);
   virtual result<size_t>                             asn1_read_len();
@@ -0,0 +1,107 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_MMAP_BINARY_STREAM_H
+#define LIEF_MMAP_BINARY_STREAM_H
+
+#include <vector>
+#include <string>
+#include <memory>
+
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+
+namespace LIEF {
+
+//! Read-only stream over a memory-mapped file.
+//!
+//! Contrary to VectorStream, the file is not loaded upfront: only
+//! the pages that are accessed by the parser are faulted in.
+class MmapStream : public BinaryStream {
+  public:
+  //! Access pattern hint forwarded to the kernel (``madvise``)
+  enum class ADVICE {
+    NORMAL = 0,
+    SEQUENTIAL,
+    RANDOM,
+    WILLNEED,
+  };
+
+  MmapStream(const std::string& filename);
+  ~MmapStream();
+
+  MmapStream& operator=(const MmapStream&) = delete;
+  MmapStream(const MmapStream&) = delete;
+
+  //! Whether memory-mapped streams are supported on this platform
+  static bool is_supported();
+
+  inline STREAM_TYPE type() const override {
+    return STREAM_TYPE::MMAP;
+  }
+
+  virtual uint64_t size() const override;
+
+  //! Hint the kernel about how the given range will be accessed
+  void advise(ADVICE advice, uint64_t offset = 0, uint64_t size = -1llu) const;
+
+  //! Copy the whole mapping in a buffer
+  std::vector<uint8_t> content() const;
+
+  //! Map the file again in a new, writable, stream.
+  //!
+  //! The pages are mapped *copy-on-write*: the file is never modified and
+  //! only the pages that are written get a private copy. The writes are not
+  //! visible through this stream. It returns a nullptr if the file can't be
+  //! mapped again.
+  std::unique_ptr<MmapStream> private_copy() const;
+
+  //! Writable pointer on the mapping of a stream created by
+  //! MmapStream::private_copy or a nullptr for a read-only stream
+  uint8_t* cow_start();
+
+  //! File descriptor of the mapped file or -1 if it is not available.
+  //!
+  //! It can be used to copy the unchanged regions of the file
+  //! without going through the mapping (see: file_ostream::copy_from)
+  inline int fd() const {
+    return this->fd_;
+  }
+
+  inline const uint8_t* p() const {
+    return this->start() + this->pos();
+  }
+
+  inline const uint8_t* start() const {
+    return this->data_;
+  }
+
+  inline const uint8_t* end() const {
+    return this->data_ + this->size_;
+  }
+
+  protected:
+  MmapStream() = default;
+  virtual const void* read_at(uint64_t offset, uint64_t size, bool throw_error = true) const override;
+  const uint8_t* data_ = nullptr;
+  uint64_t       size_ = 0;
+  bool           writable_ = false;
+  int            fd_       = -1;
+  #if defined(_WIN32)
+  void*          mapping_ = nullptr;
+  #endif
+};
+}
+
+#endif
@@ -0,0 +1,62 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_SPAN_BINARY_STREAM_H
+#define LIEF_SPAN_BINARY_STREAM_H
+
+#include <vector>
+
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+
+//! Read-only stream over a buffer owned by the caller.
+//!
+//! Contrary to VectorStream, the buffer is not copied.
+//!
+//! @warning The buffer must outlive the stream
+class SpanStream : public BinaryStream {
+  public:
+  SpanStream(span<const uint8_t> data);
+
+  inline STREAM_TYPE type() const override {
+    return STREAM_TYPE::SPAN;
+  }
+
+  virtual uint64_t size() const override;
+
+  //! Copy the buffer in a std::vector
+  std::vector<uint8_t> content() const;
+
+  inline const uint8_t* p() const {
+    return this->start() + this->pos();
+  }
+
+  inline const uint8_t* start() const {
+    return this->data_.data();
+  }
+
+  inline const uint8_t* end() const {
+    return this->data_.data() + this->data_.size();
+  }
+
+  protected:
+  virtual const void* read_at(uint64_t offset, uint64_t size, bool throw_error = true) const override;
+  span<const uint8_t> data_;
+};
+}
+
+#endif
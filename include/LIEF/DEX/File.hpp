@@ -16,7 +16,10 @@
 #ifndef LIEF_DEX_FILE_H_
 #define LIEF_DEX_FILE_H_
 
+#include <memory>
+
 #include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
 #include "LIEF/Object.hpp"
 
 #include "LIEF/DEX/type_traits.hpp"
@@ -30,6 +33,8 @@
 #include "LIEF/DEX/MapList.hpp"
 
 namespace LIEF {
+class BinaryStream;
+
 namespace DEX {
 class Parser;
 
@@ -131,6 +136,9 @@ class LIEF_API File : public Object {
 
   void add_class(Class* cls);
 
+  //! Content of the file as it has been parsed
+  span<const uint8_t> original_data() const;
+
   static void deoptimize_nop(uint8_t* inst_ptr, uint32_t value);
   static void deoptimize_return(uint8_t* inst_ptr, uint32_t value);
   static void deoptimize_invoke_virtual(uint8_t* inst_ptr, uint32_t value, OPCODES new_inst);
@@ -149,7 +157,9 @@ class LIEF_API File : public Object {
   MapList      map_;
   std::vector<Class*> class_list_;
 
-  std::vector<uint8_t> original_data_;
+  //! Stream of the parsed file. It is kept instead of a copy of its content
+  //! so that a memory-mapped file is not read entirely.
+  std::unique_ptr<BinaryStream> stream_;
 };
 
 }
@@ -22,6 +22,7 @@
 #include "LIEF/DEX/type_traits.hpp"
 
 #include "LIEF/types.hpp"
+#include "LIEF/span.hpp"
 #include "LIEF/visibility.h"
 
 namespace LIEF {
@@ -33,6 +34,9 @@ LIEF_API bool is_dex(const std::string& file);
 //! @brief Check if the given raw data is an DEX one.
 LIEF_API bool is_dex(const std::vector<uint8_t>& raw);
 
+//! @brief Check if the given buffer is an DEX one.
+LIEF_API bool is_dex(span<const uint8_t> raw);
+
 //! @brief Return the DEX version of the given file
 LIEF_API dex_version_t version(const std::string& file);
 
@@ -23,11 +23,13 @@
 #include "LIEF/ELF/enums.hpp"
 
 #include "LIEF/ELF/Parser.hpp"
+#include "LIEF/ELF/ParserConfig.hpp"
 #include "LIEF/ELF/Header.hpp"
 #include "LIEF/ELF/Section.hpp"
 #include "LIEF/ELF/Binary.hpp"
 #include "LIEF/ELF/Segment.hpp"
 #include "LIEF/ELF/Builder.hpp"
+#include "LIEF/ELF/DependencyResolver.hpp"
 #include "LIEF/ELF/EnumToString.hpp"
 #include "LIEF/ELF/Relocation.hpp"
 #include "LIEF/ELF/DynamicEntryArray.hpp"
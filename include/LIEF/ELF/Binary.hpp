@@ -18,10 +18,16 @@
 
 #include <vector>
 #include <memory>
+#include <array>
+#include <functional>
+#include <atomic>
+#include <mutex>
 
 #include "LIEF/visibility.h"
 
 #include "LIEF/iterators.hpp"
+#include "LIEF/range_index.hpp"
+#include "LIEF/name_index.hpp"
 
 #include "LIEF/Abstract/Binary.hpp"
 
@@ -278,6 +284,55 @@ class LIEF_API Binary : public LIEF::Binary {
 
   Symbol& get_dynamic_symbol(const std::string& name);
 
+  //! Parse all the tables whose parsing has been deferred (see: ParserConfig)
+  //!
+  //! The lazy tables are parsed on their first access which is not synchronized:
+  //! this function must be called before sharing a binary parsed lazily with several threads.
+  void load_all() const;
+
+  //! Resolve the symbol ``name`` as the loader (``ld.so``) does, that is to say
+  //! through the ``.gnu.hash`` table (bloom filter, bucket then chain) or through
+  //! the ``.hash`` table of the binary.
+  //!
+  //! Contrary to get_dynamic_symbol, only a symbol **defined** by this binary
+  //! can be returned: imports, local symbols and hidden versions are skipped.
+  //!
+  //! If the binary doesn't have a hash table or if the dynamic symbols have been
+  //! modified since the parsing, the lookup falls back on the name index of the
+  //! dynamic symbols.
+  //!
+  //! @return The symbol that defines ``name`` or a nullptr
+  const Symbol* lookup_dynamic_symbol(const std::string& name) const;
+
+  //! Resolve the reference to ``name`` with the given ``version`` (e.g. ``GLIBC_2.2.5``)
+  //! as required by a ``DT_VERNEED`` entry of an importer.
+  //!
+  //! A definition matches if it has this version or if it is not versioned
+  //! (the binary has no version table, or the symbol has the local/global index and is not hidden).
+  //! An empty ``version`` is the same as lookup_dynamic_symbol without version.
+  const Symbol* lookup_dynamic_symbol(const std::string& name, const std::string& version) const;
+
+  //! Same as lookup_dynamic_symbol with the GNU hash (dl_new_hash) and the SYSV hash (hash32)
+  //! of ``name`` already computed
+  const Symbol* lookup_dynamic_symbol(const std::string& name, uint32_t gnu_hash, uint32_t sysv_hash,
+                                      const std::string& version) const;
+
+  //! Resolve the given ``names`` in the lookup ``scope`` (e.g. an executable followed by the
+  //! libraries of its ``DT_NEEDED`` closure in breadth-first order) as the loader does:
+  //! the first binary of the scope that defines a name wins.
+  //!
+  //! The hashes of a name are computed once for all the binaries of the scope.
+  //!
+  //! @return For each name, the binary and the symbol that define it, or a pair of nullptr
+  static std::vector<std::pair<const Binary*, const Symbol*>>
+  lookup_dynamic_symbols(const std::vector<const Binary*>& scope, const std::vector<std::string>& names);
+
+  //! Same as lookup_dynamic_symbols where ``versions[i]`` is the version required
+  //! for ``names[i]`` (an empty string for an unversioned reference)
+  static std::vector<std::pair<const Binary*, const Symbol*>>
+  lookup_dynamic_symbols(const std::vector<const Binary*>& scope, const std::vector<std::string>& names,
+                         const std::vector<std::string>& versions);
+
   //! Check if the symbol with the given ``name`` exists in the static symbol table
   bool has_static_symbol(const std::string& name) const;
 
@@ -529,6 +584,13 @@ class LIEF_API Binary : public LIEF::Binary {
 
   void overlay(overlay_t overlay);
 
+  //! Entropy of the overlay
+  double overlay_entropy() const;
+
+  //! Entropy of the windows of ``block_size`` bytes of the overlay,
+  //! every ``step`` bytes (see: LIEF::entropy_curve)
+  std::vector<double> overlay_entropy_curve(size_t block_size, size_t step = 0) const;
+
   size_t hash(const std::string& name);
 
   virtual ~Binary();
@@ -579,6 +641,7 @@ class LIEF_API Binary : public LIEF::Binary {
   virtual std::vector<std::string> get_abstract_imported_libraries() const override;
   virtual LIEF::symbols_t          get_abstract_symbols() override;
   virtual LIEF::relocations_t      get_abstract_relocations() override;
+  virtual const LIEF::Symbol*      get_abstract_symbol(const std::string& name) const override;
 
   template<ELF::ARCH ARCH>
   void patch_relocations(uint64_t from, uint64_t shift);
@@ -617,6 +680,43 @@ class LIEF_API Binary : public LIEF::Binary {
 
   LIEF::Binary::functions_t tor_functions(DYNAMIC_TAGS tag) const;
 
+  //! Tables whose parsing can be deferred (see: ParserConfig)
+  enum class LAZY_TABLES : size_t {
+    STATIC_SYMBOLS = 0,
+    RELOCATIONS,
+    SYMBOL_VERSIONS,
+    HASH_TABLES,
+    NOTES,
+    OVERLAY,
+
+    _NB_TABLES_,
+  };
+
+  using lazy_steps_t = std::vector<std::function<void()>>;
+
+  //! Run the ``steps`` that parse the given table now or, if ``lazy`` is set,
+  //! the first time the table is accessed
+  void parse_table(LAZY_TABLES table, bool lazy, lazy_steps_t steps);
+
+  //! Parse the given table if its parsing has been deferred
+  //!
+  //! @warning The deferred parsing is not synchronized: a binary parsed lazily which is
+  //! shared by several threads must be fully loaded first (see: Binary::load_all)
+  void load(LAZY_TABLES table) const;
+
+  //! Whether some tables still have to be parsed
+  bool has_deferred_tables() const;
+
+  //! Mark the hash tables as describing the current dynamic symbols (``sync = true``) or not
+  void hash_tables_sync(bool sync);
+
+  //! Whether the hash tables can be used to resolve the dynamic symbols
+  bool hash_tables_sync() const;
+
+  //! Whether gnu_hash_ (resp. sysv_hash_) is consistent with the number of dynamic symbols
+  bool is_gnu_hash_usable() const;
+  bool is_sysv_hash_usable() const;
+
   ELF_CLASS type_;
   Header header_;
   sections_t sections_;
@@ -636,6 +736,26 @@ class LIEF_API Binary : public LIEF::Binary {
 
   std::string interpreter_;
   overlay_t overlay_;
+
+  // Lazy indexes used by the *_from_offset / *_from_virtual_address lookups
+  RangeIndex<Segment> segments_va_index_{layout_version_};
+  RangeIndex<Segment> load_segments_va_index_{layout_version_};
+  RangeIndex<Section> sections_offset_index_{layout_version_};
+  RangeIndex<Section> all_sections_offset_index_{layout_version_};
+
+  // Name -> Symbol indexes of the static and dynamic symbol tables
+  NameIndex<Symbol> static_symbols_index_{symbols_version_};
+  NameIndex<Symbol> dynamic_symbols_index_{symbols_version_};
+
+  // Whether gnu_hash_ and sysv_hash_ still describe dynamic_symbols_ (see: lookup_dynamic_symbol)
+  // and the value of symbols_version_ when it has been checked
+  mutable std::atomic<bool>     hash_tables_sync_{false};
+  mutable std::atomic<uint64_t> hash_tables_version_{0};
+  mutable std::mutex            hash_tables_mutex_;
+
+  // Deferred parsing steps of the lazy tables and the parser that runs them
+  mutable std::array<lazy_steps_t, static_cast<size_t>(LAZY_TABLES::_NB_TABLES_)> lazy_tables_;
+  Parser* parser_{nullptr};
 };
 
 }
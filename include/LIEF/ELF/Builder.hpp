@@ -33,6 +33,7 @@
 struct Profiler;
 
 namespace LIEF {
+class file_ostream;
 namespace ELF {
 class Binary;
 class Layout;
@@ -66,6 +67,14 @@ class LIEF_API Builder {
   //! Perform the build of the provided ELF binary
   void build();
 
+  //! Perform the build and write the binary in ``output`` instead
+  //! of assembling it in memory.
+  //!
+  //! If the binary has been parsed from a memory-mapped file, the regions
+  //! that are not modified are copied from the input file to ``output`` by
+  //! the kernel (see: file_ostream::copy_from).
+  void build(file_ostream& output);
+
   //! Tweak the ELF builder with the provided config parameter
   inline Builder& set_config(config_t conf) {
     config_ = std::move(conf);
@@ -159,11 +168,6 @@ class LIEF_API Builder {
   template<typename ELF_T>
   void build_symbol_definition();
 
-  template<typename T, typename HANDLER>
-  static std::vector<std::string> optimize(const HANDLER& e,
-                                    std::function<std::string(const typename HANDLER::value_type)> getter,
-                                    size_t& offset_counter,
-                                    std::unordered_map<std::string, size_t> *of_map_p=nullptr);
   template<typename ELF_T>
   void build_symbol_version();
 
@@ -186,10 +190,22 @@ class LIEF_API Builder {
   template<class ELF_T>
   void process_object_relocations();
 
+  //! Write ``data`` at ``offset`` in the output (file or memory)
+  void write_at(uint64_t offset, const uint8_t* data, size_t size);
+  void write_at(uint64_t offset, const std::vector<uint8_t>& data);
+
+  template<typename T>
+  void write_conv_at(uint64_t offset, const T& t);
+
+  //! Write the content of a Section or a Segment located at ``offset``
+  template<class T>
+  void write_content(const T& object, uint64_t offset, uint64_t size);
+
   static Section& array_section(Binary& bin, uint64_t addr);
   build_opt_t build_opt_;
   config_t config_;
   mutable vector_iostream ios_;
+  file_ostream* output_{nullptr};
   Binary* binary_{nullptr};
   std::unique_ptr<Layout> layout_;
 
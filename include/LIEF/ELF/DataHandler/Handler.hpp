@@ -16,6 +16,9 @@
 #ifndef ELF_DATA_HANDLER_HANDLER_H_
 #define ELF_DATA_HANDLER_HANDLER_H_
 #include <vector>
+#include <deque>
+#include <array>
+#include <memory>
 
 #include "LIEF/visibility.h"
 #include "LIEF/utils.hpp"
@@ -24,21 +27,66 @@
 
 namespace LIEF {
 class BinaryStream;
+class MmapStream;
 namespace ELF {
 namespace DataHandler {
 
+//! Handle the raw content of an ELF binary.
+//!
+//! When it is created from a shared BinaryStream, the handler *borrows*
+//! the stream's buffer (e.g. a memory-mapped file) instead of duplicating it.
+//! The bytes are copied in a private buffer only when the layout of the
+//! binary changes (Handler::make_hole, Handler::content). In-place writes
+//! (Handler::writable) go in a private copy-on-write mapping when the stream
+//! is a memory-mapped file and in a private copy otherwise: the input stream
+//! is never modified.
+//!
+//! The nodes are allocated in an arena and indexed per Node::Type with
+//! a vector sorted by ``(offset, size)`` such as lookups are done in
+//! ``O(log n)``.
 class LIEF_API Handler {
   public:
   static constexpr size_t MAX_SIZE = 1_GB;
   Handler(const std::vector<uint8_t>& content);
   Handler(std::vector<uint8_t>&& content);
   Handler(BinaryStream& stream);
+  Handler(std::shared_ptr<BinaryStream> stream);
   ~Handler();
 
   Handler& operator=(const Handler&);
   Handler(const Handler&);
 
-  const std::vector<uint8_t>& content() const;
+  //! Size of the content, including the reserved bytes
+  uint64_t size() const;
+
+  //! Read-only pointer on ``size`` bytes at ``offset`` or a nullptr
+  //! if this range is not backed by actual data.
+  const uint8_t* view(uint64_t offset, uint64_t size) const;
+
+  //! Copy ``size`` bytes at ``offset``. Reserved bytes that are
+  //! not backed by actual data are read as 0.
+  std::vector<uint8_t> read(uint64_t offset, uint64_t size) const;
+
+  //! Writable pointer on ``size`` bytes at ``offset``. The range is
+  //! reserved if needed.
+  uint8_t* writable(uint64_t offset, uint64_t size);
+
+  //! Number of times the content has been (potentially) modified. It changes
+  //! each time a writable access is given (Handler::writable, Handler::content)
+  uint64_t version() const;
+
+  //! Whether the handler still borrows the data of the input stream
+  bool is_borrowed() const;
+
+  //! File descriptor of the input file if the bytes ``[offset, offset + size)``
+  //! are still those of the file at the same offset, -1 otherwise.
+  //!
+  //! The builder uses it to copy the unchanged regions from file to file.
+  int source_fd(uint64_t offset, uint64_t size) const;
+
+  //! Full content of the binary.
+  //!
+  //! @warning It forces a private copy of the data
   std::vector<uint8_t>& content();
 
   Node& add(const Node& node);
@@ -51,14 +99,56 @@ class LIEF_API Handler {
 
   void remove(uint64_t offset, uint64_t size, Node::Type type);
 
+  //! Change the offset and the size of a node owned by this handler.
+  //!
+  //! @warning Nodes must not be modified with Node::offset / Node::size
+  //! as it would break the index
+  void move(Node& node, uint64_t offset, uint64_t size);
+
+  //! Add ``shift`` to the offset of the nodes of the given type
+  //! whose offset is greater or equal to ``from``
+  void shift(uint64_t from, uint64_t shift, Node::Type type);
+
+  //! Nodes of the given type which intersect ``[offset, offset + size)``
+  std::vector<Node*> overlapping(uint64_t offset, uint64_t size, Node::Type type);
+
   void make_hole(uint64_t offset, uint64_t size);
 
   void reserve(uint64_t offset, uint64_t size);
 
   private:
+  //! Nodes of a given type, sorted by ``(offset, size)``
+  struct Index {
+    std::vector<Node*> nodes;
+    uint64_t max_size = 0; // Upper bound on the size of the nodes
+  };
+  using it_index_t = std::vector<Node*>::iterator;
+
   Handler();
+  void materialize();
+
+  Index& index(Node::Type type);
+  it_index_t lookup(Index& idx, uint64_t offset, uint64_t size);
+  Node& insert(const Node& node);
+
   std::vector<uint8_t> data_;
-  std::vector<Node*> nodes_;
+
+  std::deque<Node>   arena_;
+  std::vector<Node*> free_nodes_;
+  std::array<Index, 3> indexes_;
+
+  // Borrowed mode
+  std::shared_ptr<BinaryStream> stream_;
+  std::unique_ptr<MmapStream>   cow_stream_; // Private mapping that receives the writes
+  const uint8_t* raw_      = nullptr;
+  uint8_t*       cow_      = nullptr;
+  uint64_t       raw_size_ = 0;
+  uint64_t       size_     = 0;
+
+  // Ranges ``(offset, end)`` modified through the copy-on-write pages
+  std::vector<std::pair<uint64_t, uint64_t>> dirty_;
+
+  uint64_t version_ = 0;
 };
 } // namespace DataHandler
 } // namespace ELF
@@ -0,0 +1,135 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ELF_DEPENDENCY_RESOLVER_H_
+#define LIEF_ELF_DEPENDENCY_RESOLVER_H_
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/types.hpp"
+
+namespace LIEF {
+namespace ELF {
+class Binary;
+class Symbol;
+
+//! Resolve the ``DT_NEEDED`` closure of an ELF binary as the loader (``ld.so``) does
+//!
+//! A library is searched in:
+//!
+//! 1. The ``DT_RPATH`` of the binary that needs it and of its loaders (only if it
+//!    doesn't have a ``DT_RUNPATH``)
+//! 2. The library_paths (i.e. ``LD_LIBRARY_PATH``)
+//! 3. The ``DT_RUNPATH`` of the binary that needs it
+//! 4. The directories listed in ``/etc/ld.so.conf`` (instead of ``/etc/ld.so.cache``)
+//! 5. The default_paths (e.g. ``/lib``, ``/usr/lib``)
+//!
+//! ``$ORIGIN`` and ``$LIB`` are expanded and a candidate is skipped if its class or its
+//! architecture doesn't match the ones of the main binary.
+//! All the paths are resolved in the sysroot (e.g. the root directory of a container image).
+//!
+//! The parsed libraries are stored in a process-wide LRU cache keyed by the device,
+//! the inode and the modification time of the files such as the libraries shared by
+//! several binaries (``libc.so.6``, ``libstdc++.so.6``, ...) are parsed only once.
+class LIEF_API DependencyResolver {
+  public:
+  //! A library of the closure
+  struct LIEF_API library_t {
+    //! Name from the ``DT_NEEDED`` entry (path of the main binary)
+    std::string name;
+
+    //! Path of the library in the sysroot
+    std::string path;
+
+    //! Parsed library, shared with the cache
+    std::shared_ptr<const Binary> binary;
+  };
+
+  //! Binding of an imported symbol
+  struct LIEF_API binding_t {
+    //! Binary that imports the symbol and the imported symbol
+    const Binary* binary = nullptr;
+    const Symbol* symbol = nullptr;
+
+    //! Binary that defines the symbol and its definition, or nullptr
+    //! if the symbol is not resolved (e.g. an undefined weak symbol)
+    const Binary* provider   = nullptr;
+    const Symbol* definition = nullptr;
+  };
+
+  //! Closure of a binary
+  struct LIEF_API closure_t {
+    //! Binaries in the load order: the main binary followed by its
+    //! dependencies in breadth-first order
+    std::vector<library_t> libraries;
+
+    //! ``DT_NEEDED`` names that have not been found
+    std::vector<std::string> missing;
+
+    //! Bindings of the imported symbols of all the libraries
+    //! (the lookup scope is the load order)
+    std::vector<binding_t> bindings;
+  };
+
+  DependencyResolver();
+  ~DependencyResolver();
+
+  //! Directory in which the absolute paths are resolved (default: ``/``)
+  DependencyResolver& sysroot(const std::string& root);
+  const std::string& sysroot() const;
+
+  //! Directories searched before the ``DT_RUNPATH`` (as ``LD_LIBRARY_PATH`` does)
+  DependencyResolver& library_paths(const std::vector<std::string>& paths);
+  const std::vector<std::string>& library_paths() const;
+
+  //! Directories searched at the end (default: ``/lib``, ``/usr/lib`` and the ``64`` variants)
+  DependencyResolver& default_paths(const std::vector<std::string>& paths);
+  const std::vector<std::string>& default_paths() const;
+
+  //! Whether the imported symbols must be bound (default: ``true``)
+  DependencyResolver& bind_symbols(bool flag);
+  bool bind_symbols() const;
+
+  //! Resolve the closure of the binary located at ``path`` in the sysroot
+  //!
+  //! @throw LIEF::bad_file if ``path`` is not an ELF binary
+  closure_t resolve(const std::string& path) const;
+
+  //! Maximum number of libraries kept in the process-wide cache (default: 256)
+  static void   cache_size(size_t size);
+  static size_t cache_size();
+
+  //! Remove all the libraries from the process-wide cache
+  static void clear_cache();
+
+  private:
+  std::string host_path(const std::string& path) const;
+  const std::vector<std::string>& ld_so_conf_paths() const;
+
+  std::string              sysroot_;
+  std::vector<std::string> library_paths_;
+  std::vector<std::string> default_paths_;
+  bool                     bind_symbols_ = true;
+
+  // Directories from <sysroot>/etc/ld.so.conf (lazily read)
+  mutable std::vector<std::string> ld_so_conf_paths_;
+  mutable bool                     ld_so_conf_read_ = false;
+};
+
+}
+}
+#endif
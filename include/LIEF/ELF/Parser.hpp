@@ -18,10 +18,12 @@
 
 #include "LIEF/visibility.h"
 #include "LIEF/utils.hpp"
+#include "LIEF/span.hpp"
 
 #include "LIEF/Abstract/Parser.hpp"
 
 #include "LIEF/ELF/enums.hpp"
+#include "LIEF/ELF/ParserConfig.hpp"
 
 struct Profiler;
 
@@ -40,6 +42,7 @@ class Binary;
 //! Class which parse an ELF file and transform into a ELF::Binary
 class LIEF_API Parser : public LIEF::Parser {
   friend class OAT::Parser;
+  friend class Binary;
   public:
   friend struct ::Profiler;
 
@@ -78,6 +81,49 @@ class LIEF_API Parser : public LIEF::Parser {
   //! @return LIEF::ELF::Binary
   static std::unique_ptr<Binary> parse(const std::vector<uint8_t>& data, const std::string& name = "", DYNSYM_COUNT_METHODS count_mtd = DYNSYM_COUNT_METHODS::COUNT_AUTO);
 
+  //! Parse an ELF file with the given configuration
+  //!
+  //! With a LIEF::ELF::ParserConfig that defers the parsing of some tables (e.g. ParserConfig::quick),
+  //! these tables are parsed the first time they are accessed through the LIEF::ELF::Binary API.
+  //!
+  //! @param[in] file   Path to the ELF binary
+  //! @param[in] config Parser configuration
+  //!
+  //! @return LIEF::ELF::Binary
+  static std::unique_ptr<Binary> parse(const std::string& file, const ParserConfig& config);
+
+  //! Parse the given raw data as an ELF binary with the given configuration
+  //!
+  //! @param[in] data   Raw ELF
+  //! @param[in] name   Binary name
+  //! @param[in] config Parser configuration
+  //!
+  //! @return LIEF::ELF::Binary
+  static std::unique_ptr<Binary> parse(const std::vector<uint8_t>& data, const std::string& name, const ParserConfig& config);
+
+  //! Parse a buffer owned by the caller as an ELF binary, without copying it
+  //!
+  //! @param[in] data   Raw ELF
+  //! @param[in] name   Binary name
+  //! @param[in] config Parser configuration
+  //!
+  //! @warning The content of the binary is read from ``data`` until it is modified,
+  //! so ``data`` must outlive the returned LIEF::ELF::Binary
+  //!
+  //! @return LIEF::ELF::Binary
+  static std::unique_ptr<Binary> parse(span<const uint8_t> data, const std::string& name = "",
+                                       const ParserConfig& config = ParserConfig::deep());
+
+  //! Parse an ELF binary from a stream that is already opened (e.g. by LIEF::Parser::parse)
+  //!
+  //! @param[in] stream Stream on the ELF binary. The binary takes its ownership
+  //! @param[in] name   Binary name
+  //! @param[in] config Parser configuration
+  //!
+  //! @return LIEF::ELF::Binary
+  static std::unique_ptr<Binary> parse(std::unique_ptr<BinaryStream> stream, const std::string& name = "",
+                                       const ParserConfig& config = ParserConfig::deep());
+
   Parser& operator=(const Parser&) = delete;
   Parser(const Parser&)            = delete;
 
@@ -85,8 +131,16 @@ class LIEF_API Parser : public LIEF::Parser {
   Parser();
   Parser(const std::string& file, DYNSYM_COUNT_METHODS count_mtd = DYNSYM_COUNT_METHODS::COUNT_AUTO, Binary* output = nullptr);
   Parser(const std::vector<uint8_t>& data, const std::string& name, DYNSYM_COUNT_METHODS count_mtd = DYNSYM_COUNT_METHODS::COUNT_AUTO, Binary* output = nullptr);
+  Parser(const std::string& file, const ParserConfig& config, Binary* output = nullptr);
+  Parser(const std::vector<uint8_t>& data, const std::string& name, const ParserConfig& config, Binary* output = nullptr);
+  Parser(span<const uint8_t> data, const std::string& name, const ParserConfig& config, Binary* output = nullptr);
+  Parser(std::unique_ptr<BinaryStream> stream, const std::string& name, const ParserConfig& config, Binary* output = nullptr);
   ~Parser();
 
+  //! Return the parsed binary. If some tables are deferred,
+  //! the binary takes the ownership of the parser.
+  static std::unique_ptr<Binary> release(Parser* parser);
+
   void init(const std::string& name = "");
 
   bool should_swap() const;
@@ -222,15 +276,15 @@ class LIEF_API Parser : public LIEF::Parser {
   //! Parse Symbols's SYSV hash
   void parse_symbol_sysv_hash(uint64_t offset);
 
-  void parse_overlay();
+  void parse_overlay(uint64_t offset);
 
   template<typename ELF_T, typename REL_T>
   uint32_t max_relocation_index(uint64_t relocations_offset, uint64_t size) const;
 
-  std::unique_ptr<BinaryStream> stream_;
+  std::shared_ptr<BinaryStream> stream_;
   Binary*                       binary_{nullptr};
   ELF_CLASS                     type_;
-  DYNSYM_COUNT_METHODS          count_mtd_;
+  ParserConfig                  config_;
 };
 
 
@@ -0,0 +1,71 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ELF_PARSER_CONFIG_H_
+#define LIEF_ELF_PARSER_CONFIG_H_
+#include "LIEF/visibility.h"
+#include "LIEF/types.hpp"
+#include "LIEF/ELF/enums.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+//! Configuration of the ELF parser
+//!
+//! The headers, the sections, the segments, the dynamic entries and the dynamic symbols
+//! are always parsed. The other tables can be parsed when the binary is parsed (*eager*)
+//! or the first time they are accessed through the LIEF::ELF::Binary API (*lazy*).
+//!
+//! @warning The first access to a lazy table modifies the binary, even through a
+//! ``const`` accessor: it must not happen concurrently from several threads.
+struct LIEF_API ParserConfig {
+  //! Return a configuration so that all the tables are parsed eagerly
+  //!
+  //! With this configuration all the ``lazy_*`` attributes are set to ``false``
+  static ParserConfig deep();
+
+  //! Return a configuration so that the parsing is quick
+  //!
+  //! With this configuration all the ``lazy_*`` attributes are set to ``true``
+  static ParserConfig quick();
+
+  //! Set all the ``lazy_*`` attributes to ``flag``
+  ParserConfig& lazy(bool flag);
+
+  //! Static symbols (``.symtab``)
+  bool lazy_static_symbols  = false;
+
+  //! Dynamic, PLT/GOT and sections' relocations
+  bool lazy_relocations     = false;
+
+  //! Symbol versions, version requirements and version definitions
+  bool lazy_symbol_versions = false;
+
+  //! GNU and SYSV hash tables
+  bool lazy_hash_tables     = false;
+
+  //! Notes (from the segments and the sections)
+  bool lazy_notes           = false;
+
+  //! Overlay data
+  bool lazy_overlay         = false;
+
+  //! Method used to count the dynamic symbols
+  DYNSYM_COUNT_METHODS count_mtd = DYNSYM_COUNT_METHODS::COUNT_AUTO;
+};
+
+}
+}
+#endif
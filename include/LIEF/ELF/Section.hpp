@@ -79,6 +79,14 @@ class LIEF_API Section : public LIEF::Section {
   //! @brief Section's content
   virtual std::vector<uint8_t> content() const override;
 
+  //! Section's content without copy.
+  //!
+  //! The view is empty, while Section::content is not, if the content can't be
+  //! borrowed as a whole: the section is larger than Parser::MAX_SECTION_SIZE or
+  //! a part of it is beyond the end of the file (these bytes are read as zeros by
+  //! Section::content). Callers must fall back on Section::content in these cases.
+  virtual span<const uint8_t> content_view() const override;
+
   //! @brief Set section content
   virtual void content(const std::vector<uint8_t>& data) override;
 
@@ -143,6 +151,9 @@ class LIEF_API Section : public LIEF::Section {
 
   LIEF_API friend std::ostream& operator<<(std::ostream& os, const Section& section);
 
+  protected:
+  virtual DigestCache::key_t digest_key() const override;
+
   private:
   // virtualAddress_, offset_ and size_ are inherited from LIEF::Section
   uint32_t              name_idx_;
@@ -22,6 +22,10 @@
 #include <memory>
 
 #include "LIEF/Object.hpp"
+#include "LIEF/hash.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/entropy.hpp"
+#include "LIEF/index_version.hpp"
 #include "LIEF/visibility.h"
 
 #include "LIEF/ELF/type_traits.hpp"
@@ -41,11 +45,12 @@ struct Elf64_Phdr;
 struct Elf32_Phdr;
 
 //! @brief Class which represent segments
-class LIEF_API Segment : public Object {
+class LIEF_API Segment : public Object, public Indexed {
 
   friend class Parser;
   friend class Section;
   friend class Binary;
+  friend class Builder;
 
   public:
   Segment();
@@ -69,6 +74,28 @@ class LIEF_API Segment : public Object {
   uint64_t alignment() const;
   std::vector<uint8_t> content() const;
 
+  //! Segment's content without copy.
+  //!
+  //! The view is empty, while Segment::content is not, if a part of the segment
+  //! is beyond the end of the file (these bytes are read as zeros by Segment::content).
+  //! Callers must fall back on Segment::content in this case.
+  span<const uint8_t> content_view() const;
+
+  //! Digest of the segment's content (see: Hash::hash)
+  //!
+  //! The digest is cached and it is computed again only when the content changes
+  size_t content_digest() const;
+
+  //! Entropy of the segment's content
+  double entropy() const;
+
+  //! Histogram of the segment's bytes (see: LIEF::histogram)
+  histogram_t histogram(size_t nb_threads = 1) const;
+
+  //! Entropy of the windows of ``block_size`` bytes of the segment,
+  //! every ``step`` bytes (see: LIEF::entropy_curve)
+  std::vector<double> entropy_curve(size_t block_size, size_t step = 0) const;
+
   bool has(ELF_SEGMENT_FLAGS flag) const;
   bool has(const Section& section) const;
   bool has(const std::string& section_name) const;
@@ -105,6 +132,13 @@ class LIEF_API Segment : public Object {
   LIEF_API friend std::ostream& operator<<(std::ostream& os, const Segment& segment);
 
   private:
+  //! Return a view on the content. If the content can't be borrowed,
+  //! it is copied in ``buffer``
+  span<const uint8_t> view_or_copy(std::vector<uint8_t>& buffer) const;
+
+  //! Key of the cached digest (see: Segment::content_digest)
+  DigestCache::key_t digest_key() const;
+
   SEGMENT_TYPES         type_;
   ELF_SEGMENT_FLAGS     flags_;
   uint64_t              file_offset_;
@@ -116,6 +150,8 @@ class LIEF_API Segment : public Object {
   sections_t            sections_;
   DataHandler::Handler* datahandler_{nullptr};
   std::vector<uint8_t>  content_c_;
+  uint64_t              content_version_ = 0;
+  DigestCache           digest_;
 };
 
 
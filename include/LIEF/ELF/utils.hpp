@@ -21,6 +21,7 @@
 
 #include "LIEF/types.hpp"
 #include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
 
 namespace LIEF {
 namespace ELF {
@@ -31,6 +32,9 @@ LIEF_API bool is_elf(const std::string& file);
 //! @brief check if the raw data is a ELF file
 LIEF_API bool is_elf(const std::vector<uint8_t>& raw);
 
+//! @brief check if the raw data is a ELF file
+LIEF_API bool is_elf(span<const uint8_t> raw);
+
 LIEF_API unsigned long hash32(const char* name);
 LIEF_API unsigned long hash64(const char* name);
 LIEF_API uint32_t dl_new_hash(const char* name);
@@ -28,6 +28,7 @@
 #include <LIEF/MachO.hpp>
 #include <LIEF/DWARF.hpp>
 #include <LIEF/logging.hpp>
+#include <LIEF/file_ostream.hpp>
 #include <LIEF/platforms.hpp>
 
 
@@ -26,6 +26,7 @@
 #include "LIEF/MachO/Builder.hpp"
 #include "LIEF/MachO/BuildVersion.hpp"
 #include "LIEF/MachO/CodeSignature.hpp"
+#include "LIEF/MachO/CodeDirectory.hpp"
 #include "LIEF/MachO/DataCodeEntry.hpp"
 #include "LIEF/MachO/DataInCode.hpp"
 #include "LIEF/MachO/DyldEnvironment.hpp"
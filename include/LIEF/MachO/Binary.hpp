@@ -21,6 +21,8 @@
 
 #include "LIEF/types.hpp"
 #include "LIEF/visibility.h"
+#include "LIEF/range_index.hpp"
+#include "LIEF/name_index.hpp"
 
 #include "LIEF/Abstract/Binary.hpp"
 
@@ -493,6 +495,7 @@ class LIEF_API Binary : public LIEF::Binary  {
   virtual LIEF::sections_t          get_abstract_sections() override;
   virtual LIEF::symbols_t           get_abstract_symbols() override;
   virtual LIEF::relocations_t       get_abstract_relocations() override;
+  virtual const LIEF::Symbol*       get_abstract_symbol(const std::string& name) const override;
   virtual LIEF::Binary::functions_t get_abstract_exported_functions() const override;
   virtual LIEF::Binary::functions_t get_abstract_imported_functions() const override;
   virtual std::vector<std::string>  get_abstract_imported_libraries() const override;
@@ -527,6 +530,10 @@ class LIEF_API Binary : public LIEF::Binary  {
   // offset_to_virtual_address
   std::map<uint64_t, SegmentCommand*> offset_seg_;
 
+  RangeIndex<SegmentCommand> segments_va_index_{layout_version_};
+  RangeIndex<Section>        sections_offset_index_{layout_version_};
+  NameIndex<Symbol>          symbols_index_{symbols_version_};
+
 
   protected:
   uint64_t fat_offset_ = 0;
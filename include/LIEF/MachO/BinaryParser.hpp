@@ -39,6 +39,7 @@ class Section;
 class Parser;
 struct ParserConfig;
 class DylibCommand;
+class FilesetCommand;
 
 //! @brief Class used to parse **single** binary (i.e. **not** FAT)
 //! @see MachO::Parser
@@ -127,6 +128,10 @@ class LIEF_API BinaryParser : public LIEF::Parser {
 
   void parse_export_trie(uint64_t start, uint64_t end, const std::string& prefix);
 
+  //! Parse the binaries of the fileset entries (e.g. in a kernel collection).
+  //! They are parsed concurrently and they share the input stream.
+  void parse_filesets(const std::vector<FilesetCommand*>& filesets);
+
   std::unique_ptr<BinaryStream>  stream_;
   Binary*                        binary_{nullptr};
   MACHO_TYPES                    type_;
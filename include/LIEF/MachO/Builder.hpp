@@ -30,6 +30,7 @@
 struct Profiler;
 
 namespace LIEF {
+class file_ostream;
 namespace MachO {
 class Binary;
 class FatBinary;
@@ -71,14 +72,13 @@ class LIEF_API Builder {
   void write(const std::string& filename) const;
 
   private:
+  //! Build the FAT binary in ``output``: the slices are built
+  //! and written one after the other
+  Builder(FatBinary* fat, file_ostream& output);
+
   template<typename T>
   void build();
 
-  template<typename T, typename HANDLER>
-  std::vector<std::string> optimize(const HANDLER& e,
-                                    std::function<std::string(const typename HANDLER::value_type)> getter,
-                                    std::unordered_map<std::string, size_t> *of_map_p=nullptr);
-
   void build_fat();
   void build_fat_header();
   void build_header();
@@ -144,6 +144,7 @@ class LIEF_API Builder {
   std::vector<Binary*> binaries_;
   Binary*              binary_{nullptr};
   mutable vector_iostream raw_;
+  file_ostream*        output_{nullptr};
 };
 
 } // namespace MachO
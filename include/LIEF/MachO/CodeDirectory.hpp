@@ -0,0 +1,118 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_MACHO_CODE_DIRECTORY_H_
+#define LIEF_MACHO_CODE_DIRECTORY_H_
+#include <vector>
+#include <string>
+#include <utility>
+#include <iostream>
+
+#include "LIEF/visibility.h"
+#include "LIEF/types.hpp"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+namespace MachO {
+
+class CodeSignature;
+
+//! Interface over a ``CodeDirectory`` blob of the code signature.
+//!
+//! It holds the hashes of the pages of the binary (*code slots*) and the hashes
+//! of the other blobs of the signature (*special slots*)
+class LIEF_API CodeDirectory {
+  friend class CodeSignature;
+  public:
+  static constexpr uint32_t MAGIC = 0xfade0c02;
+
+  //! Range ``[start, end)`` of file offsets
+  using range_t = std::pair<uint64_t, uint64_t>;
+
+  //! Hash algorithms used for the slots
+  enum class HASH_TYPES {
+    NONE             = 0,
+    SHA1             = 1,
+    SHA256           = 2,
+    SHA256_TRUNCATED = 3, ///< SHA-256 truncated to 20 bytes
+    SHA384           = 4,
+  };
+
+  CodeDirectory();
+  CodeDirectory& operator=(const CodeDirectory&);
+  CodeDirectory(const CodeDirectory&);
+  ~CodeDirectory();
+
+  //! Type of the slot in the SuperBlob (``0`` or ``0x1000+`` for the alternate directories)
+  uint32_t slot_type() const;
+
+  //! Offset of the blob in the raw signature
+  uint32_t offset() const;
+
+  uint32_t version() const;
+  uint32_t flags() const;
+
+  HASH_TYPES hash_type() const;
+
+  //! Size of the hashes in bytes
+  uint8_t hash_size() const;
+
+  //! Size of the hashed pages in bytes (``0`` if the code is hashed in one piece)
+  uint32_t page_size() const;
+
+  //! Number of bytes of the binary covered by the code slots
+  uint64_t code_limit() const;
+
+  //! Signing identifier (e.g. ``com.apple.ls``)
+  const std::string& identifier() const;
+
+  //! Team identifier (empty for the old versions of the directory)
+  const std::string& team_id() const;
+
+  uint32_t nb_code_slots() const;
+  uint32_t nb_special_slots() const;
+
+  //! Hash of the ``idx``-th page
+  span<const uint8_t> code_hash(size_t idx) const;
+
+  //! Hash of the special slot ``-slot`` (``slot`` in ``[1, nb_special_slots]``)
+  span<const uint8_t> special_hash(size_t slot) const;
+
+  //! Range of the binary hashed by the ``idx``-th code slot
+  range_t page_range(size_t idx) const;
+
+  LIEF_API friend std::ostream& operator<<(std::ostream& os, const CodeDirectory& cd);
+
+  private:
+  uint32_t    slot_type_        = 0;
+  uint32_t    offset_           = 0;
+  uint32_t    version_          = 0;
+  uint32_t    flags_            = 0;
+  HASH_TYPES  hash_type_        = HASH_TYPES::NONE;
+  uint8_t     hash_size_        = 0;
+  uint32_t    page_size_        = 0;
+  uint64_t    code_limit_       = 0;
+  uint32_t    nb_code_slots_    = 0;
+  uint32_t    nb_special_slots_ = 0;
+  std::string identifier_;
+  std::string team_id_;
+
+  // Special slots (from -nb_special_slots to -1) followed by the code slots
+  std::vector<uint8_t> hashes_;
+};
+
+}
+}
+#endif
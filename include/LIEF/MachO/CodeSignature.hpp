@@ -16,12 +16,17 @@
 #ifndef LIEF_MACHO_CODE_SIGNATURE_COMMAND_H_
 #define LIEF_MACHO_CODE_SIGNATURE_COMMAND_H_
 #include <vector>
+#include <string>
+#include <chrono>
 #include <iostream>
 
 #include "LIEF/visibility.h"
 #include "LIEF/types.hpp"
+#include "LIEF/iterators.hpp"
+#include "LIEF/span.hpp"
 
 #include "LIEF/MachO/LoadCommand.hpp"
+#include "LIEF/MachO/CodeDirectory.hpp"
 
 namespace LIEF {
 namespace MachO {
@@ -32,6 +37,41 @@ struct linkedit_data_command;
 class LIEF_API CodeSignature : public LoadCommand {
   friend class BinaryParser;
   public:
+  static constexpr uint32_t SUPERBLOB_MAGIC = 0xfade0cc0;
+
+  using code_directories_t        = std::vector<CodeDirectory>;
+  using it_const_code_directories = const_ref_iterator<const code_directories_t&>;
+
+  //! Outcome of the verification of a CodeDirectory
+  struct directory_verification_t {
+    //! Index of the directory in code_directories()
+    size_t index = 0;
+
+    //! Number of pages that have been hashed
+    uint32_t nb_pages = 0;
+
+    //! Indexes of the pages whose hash doesn't match the code slot
+    std::vector<uint32_t> mismatched_pages;
+
+    //! Special slots (``-slot``) whose blob doesn't match the hash
+    std::vector<uint32_t> mismatched_special_slots;
+
+    //! Special slots (``-slot``) which are set but whose blob is not in the signature
+    std::vector<uint32_t> missing_special_slots;
+
+    //! Size of the code (up to CodeDirectory::code_limit) which is not covered by the code slots
+    uint64_t uncovered_size = 0;
+
+    //! Wall-clock time spent on this directory
+    std::chrono::nanoseconds elapsed{0};
+
+    inline bool is_valid() const {
+      return this->mismatched_pages.empty() and this->mismatched_special_slots.empty() and
+             this->missing_special_slots.empty() and this->uncovered_size == 0;
+    }
+  };
+  using verification_t = std::vector<directory_verification_t>;
+
   CodeSignature();
   CodeSignature(const linkedit_data_command *cmd);
 
@@ -48,6 +88,25 @@ class LIEF_API CodeSignature : public LoadCommand {
   void data_offset(uint32_t offset);
   void data_size(uint32_t size);
 
+  //! Raw content of the signature (i.e. the SuperBlob)
+  const std::vector<uint8_t>& content() const;
+
+  //! CodeDirectory blobs found in the SuperBlob
+  it_const_code_directories code_directories() const;
+
+  //! Recompute the page hashes of the CodeDirectory blobs against ``raw``, the
+  //! content of the Mach-O file (the slice for a FAT binary) and check the special
+  //! slots against the blobs of the signature.
+  //!
+  //! The pages are hashed by ``nb_threads`` threads (0: number of hardware threads)
+  //! directly from ``raw`` which is not copied.
+  verification_t verify(span<const uint8_t> raw, size_t nb_threads = 0) const;
+
+  //! Memory-map ``filename`` and verify the signature against it.
+  //!
+  //! If ``filename`` is a FAT binary, the slice that embeds this signature is used.
+  verification_t verify(const std::string& filename, size_t nb_threads = 0) const;
+
   virtual ~CodeSignature();
 
   bool operator==(const CodeSignature& rhs) const;
@@ -58,9 +117,16 @@ class LIEF_API CodeSignature : public LoadCommand {
   virtual std::ostream& print(std::ostream& os) const override;
 
   private:
+  //! Decode the SuperBlob from raw_signature_
+  void parse_blobs();
+
   uint32_t              data_offset_;
   uint32_t              data_size_;
   std::vector<uint8_t>  raw_signature_;
+  code_directories_t    code_directories_;
+
+  // (type, offset) of the SuperBlob entries
+  std::vector<std::pair<uint32_t, uint32_t>> blobs_;
 
 };
 
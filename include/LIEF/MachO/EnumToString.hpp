@@ -20,6 +20,7 @@
 #include "LIEF/MachO/Structures.hpp"
 #include "LIEF/MachO/DataCodeEntry.hpp"
 #include "LIEF/MachO/BuildVersion.hpp"
+#include "LIEF/MachO/CodeDirectory.hpp"
 
 namespace LIEF {
 namespace MachO {
@@ -55,6 +56,7 @@ LIEF_API const char* to_string(EXPORT_SYMBOL_FLAGS e);
 LIEF_API const char* to_string(DataCodeEntry::TYPES e);
 LIEF_API const char* to_string(BuildVersion::PLATFORMS e);
 LIEF_API const char* to_string(BuildToolVersion::TOOLS e);
+LIEF_API const char* to_string(CodeDirectory::HASH_TYPES e);
 
 
 } // namespace MachO
@@ -21,6 +21,7 @@
 
 #include "LIEF/types.hpp"
 #include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
 
 #include "LIEF/Abstract/Parser.hpp"
 
@@ -46,9 +47,17 @@ class LIEF_API Parser : public LIEF::Parser {
   static std::unique_ptr<FatBinary> parse(const std::string& filename, const ParserConfig& conf = ParserConfig::deep());
   static std::unique_ptr<FatBinary> parse(const std::vector<uint8_t>& data, const std::string& name = "", const ParserConfig& conf = ParserConfig::deep());
 
+  //! Parse a Mach-O from a buffer owned by the caller, without copying it
+  static std::unique_ptr<FatBinary> parse(span<const uint8_t> data, const std::string& name = "", const ParserConfig& conf = ParserConfig::deep());
+
+  //! Parse a Mach-O from a stream that is already opened (e.g. by LIEF::Parser::parse)
+  static std::unique_ptr<FatBinary> parse(std::unique_ptr<BinaryStream> stream, const std::string& name = "", const ParserConfig& conf = ParserConfig::deep());
+
   private:
   Parser(const std::string& file, const ParserConfig& conf);
   Parser(const std::vector<uint8_t>& data, const std::string& name, const ParserConfig& conf);
+  Parser(span<const uint8_t> data, const std::string& name, const ParserConfig& conf);
+  Parser(std::unique_ptr<BinaryStream> stream, const std::string& name, const ParserConfig& conf);
   Parser();
 
   void build();
@@ -15,6 +15,8 @@
  */
 #ifndef LIEF_MACHO_PARSER_CONFIG_H_
 #define LIEF_MACHO_PARSER_CONFIG_H_
+#include <cstddef>
+
 #include "LIEF/visibility.h"
 
 namespace LIEF {
@@ -44,6 +46,11 @@ struct LIEF_API ParserConfig {
   bool parse_dyld_exports  = true;
   bool parse_dyld_bindings = true;
   bool parse_dyld_rebases  = true;
+
+  //! Number of threads used to parse the slices of a FAT binary and
+  //! the entries of a fileset (``LC_FILESET_ENTRY``). If it is 0, the
+  //! number of hardware threads is used.
+  size_t nb_threads = 0;
 };
 
 }
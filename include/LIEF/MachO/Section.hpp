@@ -68,6 +68,9 @@ class LIEF_API Section : public LIEF::Section {
   // ============================
   virtual content_t content() const override;
 
+  //! Section's content without copy
+  virtual span<const uint8_t> content_view() const override;
+
   //! @brief Set section content
   virtual void content(const content_t& data) override;
 
@@ -124,6 +127,9 @@ class LIEF_API Section : public LIEF::Section {
 
   LIEF_API friend std::ostream& operator<<(std::ostream& os, const Section& section);
 
+  protected:
+  virtual DigestCache::key_t digest_key() const override;
+
   private:
   std::string segment_name_;
   uint64_t original_size_{0};
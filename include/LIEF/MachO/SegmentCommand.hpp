@@ -22,6 +22,8 @@
 
 #include "LIEF/types.hpp"
 #include "LIEF/visibility.h"
+#include "LIEF/hash.hpp"
+#include "LIEF/index_version.hpp"
 
 #include "LIEF/MachO/type_traits.hpp"
 #include "LIEF/MachO/LoadCommand.hpp"
@@ -39,10 +41,11 @@ struct segment_command_64;
 
 //! @class SegmentCommand
 //! @brief Class which represent a MachO Segment
-class LIEF_API SegmentCommand : public LoadCommand {
+class LIEF_API SegmentCommand : public LoadCommand, public Indexed {
 
   friend class BinaryParser;
   friend class Binary;
+  friend class Section;
 
   public:
   using content_t = std::vector<uint8_t>;
@@ -81,6 +84,11 @@ class LIEF_API SegmentCommand : public LoadCommand {
 
   const content_t& content() const;
 
+  //! Digest of the segment's content (see: LIEF::Hash::hash)
+  //!
+  //! The digest is cached and it is computed again only when the content changes
+  size_t content_digest() const;
+
   inline int8_t index() const {
     return this->index_;
   }
@@ -128,6 +136,9 @@ class LIEF_API SegmentCommand : public LoadCommand {
   uint32_t flags_{0};
   int8_t  index_ = -1;
   content_t data_;
+  //! Number of modifications of data_: it is used as key of the cached digest
+  uint64_t content_version_ = 0;
+  DigestCache digest_;
   sections_t    sections_;
   relocations_t relocations_;
 
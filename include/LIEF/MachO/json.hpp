@@ -69,6 +69,10 @@ class LIEF_API JsonVisitor : public LIEF::JsonVisitor {
   public:
   using LIEF::JsonVisitor::JsonVisitor;
 
+  //! Members of the json representation of the binary, whose
+  //! large arrays are generated on demand (see: LIEF::to_json)
+  static JsonMembers members(const Binary& binary);
+
   public:
   virtual void visit(const Binary& binary)                        override;
   virtual void visit(const Header& header)                        override;
@@ -18,6 +18,7 @@
 
 #include "LIEF/types.hpp"
 #include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
 
 #include <string>
 #include <vector>
@@ -30,6 +31,8 @@ LIEF_API bool is_macho(const std::string& file);
 
 LIEF_API bool is_macho(const std::vector<uint8_t>& raw);
 
+LIEF_API bool is_macho(span<const uint8_t> raw);
+
 //! Check if the given Mach-O is fat
 LIEF_API bool is_fat(const std::string& file);
 
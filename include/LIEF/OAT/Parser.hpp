@@ -47,6 +47,9 @@ class LIEF_API Parser : public LIEF::Parser {
 
     static std::unique_ptr<Binary> parse(const std::vector<uint8_t>& data, const std::string& name = "");
 
+    //! Parse an OAT file from a stream that is already opened (e.g. by LIEF::Parser::parse)
+    static std::unique_ptr<Binary> parse(std::unique_ptr<BinaryStream> stream, const std::string& name = "");
+
     Parser& operator=(const Parser& copy) = delete;
     Parser(const Parser& copy)            = delete;
 
@@ -54,6 +57,7 @@ class LIEF_API Parser : public LIEF::Parser {
     Parser();
     Parser(const std::string& oat_file);
     Parser(const std::vector<uint8_t>& data, const std::string& name);
+    Parser(std::unique_ptr<BinaryStream> stream, const std::string& name);
     ~Parser();
 
     bool has_vdex() const;
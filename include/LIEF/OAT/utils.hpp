@@ -28,6 +28,7 @@
 #include "LIEF/platforms/android.hpp"
 
 namespace LIEF {
+class BinaryStream;
 namespace OAT {
 
 //! @brief Check if the given LIEF::ELF::Binary is an OAT one.
@@ -39,6 +40,12 @@ LIEF_API bool is_oat(const std::string& file);
 //! @brief Check if the given raw data is an OAT one.
 LIEF_API bool is_oat(const std::vector<uint8_t>& raw);
 
+//! @brief Check if the given stream is an OAT one.
+//!
+//! Only the ELF header, the section table and the ``.dynsym`` section are read:
+//! the ELF is not parsed.
+LIEF_API bool is_oat(BinaryStream& stream);
+
 //! @brief Return the OAT version of the given file
 LIEF_API oat_version_t version(const std::string& file);
 
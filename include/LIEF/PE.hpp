@@ -21,6 +21,7 @@
 #if defined(LIEF_PE_SUPPORT)
 
 #include "LIEF/PE/Parser.hpp"
+#include "LIEF/PE/ParserConfig.hpp"
 #include "LIEF/PE/Section.hpp"
 #include "LIEF/PE/TLS.hpp"
 #include "LIEF/PE/Export.hpp"
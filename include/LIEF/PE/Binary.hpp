@@ -28,15 +28,19 @@
 #include "LIEF/PE/Debug.hpp"
 #include "LIEF/PE/Symbol.hpp"
 #include "LIEF/PE/signature/Signature.hpp"
+#include "LIEF/PE/ParserConfig.hpp"
 
 #include "LIEF/Abstract/Binary.hpp"
 
+#include "LIEF/range_index.hpp"
+#include "LIEF/name_index.hpp"
 #include "LIEF/visibility.h"
 
 namespace LIEF {
 namespace PE {
 class Parser;
 class Builder;
+struct ResourcesCache;
 
 //! Class which represent a PE binary object
 class LIEF_API Binary : public LIEF::Binary {
@@ -128,6 +132,14 @@ class LIEF_API Binary : public LIEF::Binary {
   //! @see Export
   bool has_exports() const;
 
+  //! Structures which are present in the input but which have been skipped by the
+  //! parser (see: ParserConfig). For instance, ``skipped().signature`` is ``true``
+  //! if the input is signed but the signatures are not parsed.
+  //!
+  //! The Builder fails if the overlay has been skipped as it would be missing
+  //! from the output (see: Builder::build_overlay)
+  const SkippedStructures& skipped() const;
+
   //! Check if the current binary has resources
   bool has_resources() const;
 
@@ -159,9 +171,13 @@ class LIEF_API Binary : public LIEF::Binary {
   //!
   //! One can tweak the verification process with the Signature::VERIFICATION_CHECKS flags
   //!
+  //! The signatures are checked by ``nb_threads`` threads (0: number of hardware threads)
+  //! and the authentihash is computed once per digest algorithm.
+  //!
   //! @see LIEF::PE::Signature::check
   Signature::VERIFICATION_FLAGS verify_signature(
-      Signature::VERIFICATION_CHECKS checks = Signature::VERIFICATION_CHECKS::DEFAULT) const;
+      Signature::VERIFICATION_CHECKS checks = Signature::VERIFICATION_CHECKS::DEFAULT,
+      size_t nb_threads = 0) const;
 
   //! Verify the binary with the Signature object provided in the first parameter
   //! It can be used to verify a detached signature:
@@ -179,6 +195,15 @@ class LIEF_API Binary : public LIEF::Binary {
   //! parameter
   std::vector<uint8_t> authentihash(ALGORITHMS algo) const;
 
+  //! Compute the authentihashes for several algorithms with a single traversal of the binary
+  //!
+  //! The digests are cached until the binary is accessed through a non-const method
+  //! (e.g. Binary::sections, Binary::optional_header, Binary::patch_address, ...)
+  //! or until the layout or the content of a section is modified
+  //!
+  //! Unsupported algorithms are not present in the returned map
+  std::map<ALGORITHMS, std::vector<uint8_t>> authentihash(const std::vector<ALGORITHMS>& algos) const;
+
   //! Try to predict the RVA of the function `function` in the import library `library`
   //!
   //! @warning
@@ -286,6 +311,13 @@ class LIEF_API Binary : public LIEF::Binary {
   const std::vector<uint8_t>& overlay() const;
   std::vector<uint8_t>&       overlay();
 
+  //! Entropy of the overlay
+  double overlay_entropy() const;
+
+  //! Entropy of the windows of ``block_size`` bytes of the overlay,
+  //! every ``step`` bytes (see: LIEF::entropy_curve)
+  std::vector<double> overlay_entropy_curve(size_t block_size, size_t step = 0) const;
+
   // ========
   // DOS Stub
   // ========
@@ -429,9 +461,19 @@ class LIEF_API Binary : public LIEF::Binary {
   //! content of first section
   void make_space_for_new_section();
 
+  //! State of the sections on which the cached authentihashes depend
+  std::vector<uint64_t> authentihash_key() const;
+
+  //! Verify the signature against the given authentihash (computed with Signature::digest_algorithm)
+  Signature::VERIFICATION_FLAGS verify_signature(const Signature& sig, Signature::VERIFICATION_CHECKS checks,
+                                                 const std::vector<uint8_t>& authhash) const;
+
   //! Return binary's symbols as LIEF::Symbol
   virtual LIEF::symbols_t  get_abstract_symbols() override;
 
+  //! Lookup in the index of the symbols, the exports and the imports
+  virtual const LIEF::Symbol* get_abstract_symbol(const std::string& name) const override;
+
   virtual LIEF::Header     get_abstract_header() const override;
 
   //! Return binary's section as LIEF::Section
@@ -473,9 +515,14 @@ class LIEF_API Binary : public LIEF::Binary {
   strings_table_t      strings_table_;
   relocations_t        relocations_;
   ResourceNode*        resources_;
+  // Incremented when a node of resources_ is modified (see: ResourceNode::changed)
+  IndexVersion         resources_version_;
+  // Results memoized by the ResourcesManager
+  std::shared_ptr<ResourcesCache> resources_cache_;
   imports_t            imports_;
   Export               export_;
   debug_entries_t      debug_;
+  SkippedStructures skipped_;
   uint64_t overlay_offset_ = 0;
   std::vector<uint8_t> overlay_;
   std::vector<uint8_t> dos_stub_;
@@ -483,7 +530,19 @@ class LIEF_API Binary : public LIEF::Binary {
 
   LoadConfiguration*   load_configuration_{nullptr};
 
+  // Lazy indexes used by rva_to_offset, section_from_rva, ...
+  RangeIndex<Section>  sections_rva_index_{layout_version_};
+  RangeIndex<Section>  sections_mapped_rva_index_{layout_version_};
+  RangeIndex<Section>  sections_offset_index_{layout_version_};
+
+  NameIndex<LIEF::Symbol> symbols_index_{symbols_version_};
+
   std::map<std::string, std::map<std::string, uint64_t>> hooks_;
+
+  // Cache of the authentihashes, cleared by the non-const accessors
+  // or when authentihash_key() changes
+  mutable std::map<ALGORITHMS, std::vector<uint8_t>> authentihash_cache_;
+  mutable std::vector<uint64_t> authentihash_key_;
 };
 
 }
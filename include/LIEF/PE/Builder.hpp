@@ -29,12 +29,14 @@
 #include "LIEF/visibility.h"
 #include "LIEF/utils.hpp"
 #include "LIEF/iostream.hpp"
+#include "LIEF/span.hpp"
 
 #include "LIEF/PE/Binary.hpp"
 
 struct Profiler;
 
 namespace LIEF {
+class file_ostream;
 namespace PE {
 
 //! @brief Class which reconstruct a PE binary from a PE::Binary object
@@ -49,6 +51,10 @@ class LIEF_API Builder {
     //! @brief Perform the build process
     void build();
 
+    //! Perform the build process and write the result in ``output``
+    //! instead of assembling the binary in memory
+    void build(file_ostream& output);
+
     //! @brief Construct a ``jmp [address] @ from``.
     //!
     //! It is used when patching import table
@@ -81,6 +87,9 @@ class LIEF_API Builder {
     Builder& build_resources(bool flag);
 
     //! @brief Rebuild the binary's overlay
+    //!
+    //! The build fails if the overlay of the input has not been parsed (see: Binary::skipped)
+    //! unless this option is disabled
     Builder& build_overlay(bool flag);
 
     //! @brief Rebuild the DOS stub content
@@ -136,7 +145,14 @@ class LIEF_API Builder {
         uint32_t depth);
 
 
+    //! Cursor and writes on the output (file or memory)
+    uint64_t tellp();
+    void seekp(uint64_t offset);
+    void write_raw(const uint8_t* data, size_t size);
+    void write_raw(span<const uint8_t> data);
+
     mutable vector_iostream ios_;
+    file_ostream           *output_{nullptr};
     Binary                 *binary_;
 
     bool build_imports_;
@@ -22,9 +22,11 @@
 
 #include "LIEF/visibility.h"
 #include "LIEF/utils.hpp"
+#include "LIEF/span.hpp"
 
 #include "LIEF/Abstract/Parser.hpp"
 #include "LIEF/PE/enums.hpp"
+#include "LIEF/PE/ParserConfig.hpp"
 
 struct Profiler;
 
@@ -33,9 +35,7 @@ class BinaryStream;
 
 namespace PE {
 class Debug;
-class ResourceNode;
 class Binary;
-struct pe_resource_directory_table;
 
 class LIEF_API Parser : public LIEF::Parser {
   public:
@@ -54,15 +54,32 @@ class LIEF_API Parser : public LIEF::Parser {
   static bool is_valid_dll_name(const std::string& name);
 
   public:
-  static std::unique_ptr<Binary> parse(const std::string& filename);
-  static std::unique_ptr<Binary> parse(const std::vector<uint8_t>& data, const std::string& name = "");
+  //! Parse a PE binary from the given filename
+  //!
+  //! One can configure the parsing (e.g. to skip the resources or the signatures)
+  //! with the ``conf`` parameter. See LIEF::PE::ParserConfig
+  static std::unique_ptr<Binary> parse(const std::string& filename, const ParserConfig& conf = ParserConfig::deep());
+
+  //! Parse a PE binary from the given raw data
+  static std::unique_ptr<Binary> parse(const std::vector<uint8_t>& data, const std::string& name = "",
+                                       const ParserConfig& conf = ParserConfig::deep());
+
+  //! Parse a PE binary from a buffer owned by the caller, without copying it
+  static std::unique_ptr<Binary> parse(span<const uint8_t> data, const std::string& name = "",
+                                       const ParserConfig& conf = ParserConfig::deep());
+
+  //! Parse a PE binary from a stream that is already opened (e.g. by LIEF::Parser::parse)
+  static std::unique_ptr<Binary> parse(std::unique_ptr<BinaryStream> stream, const std::string& name = "",
+                                       const ParserConfig& conf = ParserConfig::deep());
 
   Parser& operator=(const Parser& copy) = delete;
   Parser(const Parser& copy)            = delete;
 
   private:
-  Parser(const std::string& file);
-  Parser(const std::vector<uint8_t>& data, const std::string& name);
+  Parser(const std::string& file, const ParserConfig& conf);
+  Parser(const std::vector<uint8_t>& data, const std::string& name, const ParserConfig& conf);
+  Parser(span<const uint8_t> data, const std::string& name, const ParserConfig& conf);
+  Parser(std::unique_ptr<BinaryStream> stream, const std::string& name, const ParserConfig& conf);
 
   ~Parser();
   Parser();
@@ -106,15 +123,14 @@ class LIEF_API Parser : public LIEF::Parser {
   void parse_dos_stub();
   void parse_rich_header();
 
-  ResourceNode* parse_resource_node(
-      const pe_resource_directory_table *directory_table,
-      uint32_t base_offset, uint32_t current_offset, uint32_t depth = 0);
-
+  //! ``true`` if the given structure, present in the input, must be parsed according
+  //! to the ParserConfig. Otherwise, it is recorded as ``skipped`` (see: Binary::skipped)
+  bool must_parse(bool ParserConfig::* structure, bool SkippedStructures::* skipped, bool present);
 
-  std::unique_ptr<BinaryStream> stream_;
+  std::shared_ptr<BinaryStream> stream_;
   Binary*                       binary_{nullptr};
   PE_TYPE                       type_;
-  std::set<uint32_t>            resource_visited_;
+  ParserConfig                  config_;
 };
 
 
@@ -0,0 +1,121 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_PE_PARSER_CONFIG_H_
+#define LIEF_PE_PARSER_CONFIG_H_
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+namespace PE {
+
+//! Configuration of the PE parser
+//!
+//! The headers, the sections and the data directories are always parsed.
+//! The other structures can be skipped to speed up the parsing.
+struct LIEF_API ParserConfig {
+  //! Return a configuration so that all the objects supported by
+  //! LIEF are parsed
+  //!
+  //! With this configuration all the ``parse_*`` attributes are set to ``true``
+  static ParserConfig deep();
+
+  //! Return a configuration so that the parsing is quick
+  //!
+  //! With this configuration only the imports and the exports are parsed
+  //! (in addition to the headers, the sections and the data directories)
+  static ParserConfig quick();
+
+  //! Return a configuration so that only the headers, the sections and
+  //! the data directories are parsed
+  //!
+  //! With this configuration all the ``parse_*`` attributes are set to ``false``
+  static ParserConfig none();
+
+  //! Rich header (from the DOS stub)
+  bool parse_rich_header = true;
+
+  //! Import table
+  bool parse_imports     = true;
+
+  //! Export table
+  bool parse_exports     = true;
+
+  //! Base relocations
+  bool parse_relocations = true;
+
+  //! Resource tree
+  bool parse_resources   = true;
+
+  //! Debug directory (CodeView, POGO, ...)
+  bool parse_debug       = true;
+
+  //! TLS directory
+  bool parse_tls         = true;
+
+  //! Load configuration
+  bool parse_load_config = true;
+
+  //! Authenticode signatures (PKCS #7)
+  //!
+  //! @warning Parsing the signatures can slow down the parsing
+  bool parse_signature   = true;
+
+  //! COFF symbols and string table
+  bool parse_symbols     = true;
+
+  //! Overlay data
+  bool parse_overlay     = true;
+};
+
+//! Structures which are present in the input but which have not been
+//! parsed because of the ParserConfig (see: Binary::skipped)
+struct LIEF_API SkippedStructures {
+  //! Rich header (from the DOS stub)
+  bool rich_header = false;
+
+  //! Import table
+  bool imports     = false;
+
+  //! Export table
+  bool exports     = false;
+
+  //! Base relocations
+  bool relocations = false;
+
+  //! Resource tree
+  bool resources   = false;
+
+  //! Debug directory (CodeView, POGO, ...)
+  bool debug       = false;
+
+  //! TLS directory
+  bool tls         = false;
+
+  //! Load configuration
+  bool load_config = false;
+
+  //! Authenticode signatures (PKCS #7)
+  bool signature   = false;
+
+  //! COFF symbols and string table
+  bool symbols     = false;
+
+  //! Overlay data
+  bool overlay     = false;
+};
+
+}
+}
+#endif
@@ -26,11 +26,13 @@ namespace PE {
 
 class Parser;
 class Builder;
+class ResourcesParser;
 
 class LIEF_API ResourceData : public ResourceNode {
 
   friend class Parser;
   friend class Builder;
+  friend class ResourcesParser;
 
   public:
   ResourceData();
@@ -50,6 +52,9 @@ class LIEF_API ResourceData : public ResourceNode {
   uint32_t code_page() const;
 
   //! @brief Resource content
+  //!
+  //! For a parsed binary, the content is read from the input the first time
+  //! it is accessed
   const std::vector<uint8_t>& content() const;
 
   //! @brief Reserved value. Should be ``0``
@@ -73,11 +78,16 @@ class LIEF_API ResourceData : public ResourceNode {
   LIEF_API friend std::ostream& operator<<(std::ostream& os, const ResourceData& data);
 
   private:
-  std::vector<uint8_t> content_;
+  mutable std::vector<uint8_t> content_;
   uint32_t             code_page_;
   uint32_t             reserved_;
   uint32_t             offset_;
 
+  // Set while the content (offset_, size_) is not read from the input.
+  // It is only accessed with std::atomic_load / std::atomic_store by the const functions
+  mutable std::shared_ptr<ResourcesParser> parser_;
+  uint32_t             size_{0};
+
 };
 
 } // namespace PE
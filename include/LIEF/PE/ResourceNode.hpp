@@ -17,9 +17,11 @@
 #define LIEF_PE_RESOURCE_NODE_H_
 #include <string>
 #include <vector>
+#include <memory>
 
 #include "LIEF/Object.hpp"
 #include "LIEF/visibility.h"
+#include "LIEF/index_version.hpp"
 
 #include "LIEF/PE/type_traits.hpp"
 #include "LIEF/PE/enums.hpp"
@@ -32,11 +34,27 @@ class ResourceData;
 
 class Parser;
 class Builder;
-
-class LIEF_API ResourceNode : public Object {
+class Binary;
+class ResourcesParser;
+class ResourcesManager;
+
+//! Node of the resource tree.
+//!
+//! The tree is decoded on demand: the entries of a ResourceDirectory are decoded
+//! the first time they are accessed and the content of a ResourceData is read from
+//! the input the first time it is accessed. The decoding is serialized by the
+//! parser shared by the nodes of the tree so that the const accessors can be
+//! called concurrently.
+//!
+//! The nodes of the tree of a PE::Binary are attached to its modification counter
+//! which invalidates the results memoized by its ResourcesManager.
+class LIEF_API ResourceNode : public Object, public Indexed {
 
   friend class Parser;
   friend class Builder;
+  friend class Binary;
+  friend class ResourcesParser;
+  friend class ResourcesManager;
 
   public:
   ResourceNode(const ResourceNode& other);
@@ -100,10 +118,31 @@ class LIEF_API ResourceNode : public Object {
   protected:
   ResourceNode();
 
+  //! Must be called by the functions that modify a node
+  inline void changed() const {
+    this->index_changed();
+  }
+
+  //! Attach the node and its decoded childs to the counter of a binary
+  void attach(const IndexVersion& version) const;
+
+  //! Decode the childs of the node if they are not decoded yet
+  inline void load() const {
+    if (std::atomic_load(&this->childs_parser_) != nullptr) {
+      this->load_childs();
+    }
+  }
+  void load_childs() const;
+
   uint32_t       id_;
   std::u16string name_;
   childs_t       childs_;
   uint32_t       depth_;
+
+  // Set while the entries of the directory located at childs_offset_ are not decoded.
+  // It is only accessed with std::atomic_load / std::atomic_store
+  mutable std::shared_ptr<ResourcesParser> childs_parser_;
+  uint32_t       childs_offset_{0};
 };
 }
 }
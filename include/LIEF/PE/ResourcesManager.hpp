@@ -19,6 +19,7 @@
 #include <iostream>
 #include <sstream>
 #include <set>
+#include <memory>
 
 #include "LIEF/visibility.h"
 #include "LIEF/Object.hpp"
@@ -35,10 +36,18 @@ namespace LIEF {
 class VectorStream;
 
 namespace PE {
+class Binary;
+struct ResourcesCache;
 
 //! @brief The Resource Manager provides an enhanced API to
 //! manipulate the resource tree.
+//!
+//! The results of the typed queries (icons(), version(), ...) are memoized until
+//! the resource tree is modified. The managers returned by Binary::resources_manager
+//! share the same results.
 class LIEF_API ResourcesManager : public Object {
+  friend class Binary;
+
   public:
   static RESOURCE_SUBLANGS sub_lang(RESOURCE_LANGS lang, size_t index);
 
@@ -160,6 +169,21 @@ class LIEF_API ResourcesManager : public Object {
   LIEF_API friend std::ostream& operator<<(std::ostream& os, const ResourcesManager& m);
 
   private:
+  ResourcesManager(ResourceNode *rsrc, ResourcesCache* cache);
+  static std::shared_ptr<ResourcesCache> make_cache();
+
+  //! @brief Return the memoized results, reset if the tree has been modified.
+  //! ResourcesCache::mutex must be held by the caller
+  ResourcesCache& cache() const;
+
+  std::string                      parse_manifest() const;
+  ResourceVersion                  parse_version() const;
+  std::vector<ResourceIcon>        parse_icons() const;
+  std::vector<ResourceDialog>      parse_dialogs() const;
+  std::vector<ResourceStringTable> parse_string_table() const;
+  std::vector<std::string>         parse_html() const;
+  std::vector<ResourceAccelerator> parse_accelerator() const;
+
   void print_tree(
       const ResourceNode& node,
       std::ostringstream& stream,
@@ -174,6 +198,10 @@ class LIEF_API ResourcesManager : public Object {
 
 
   ResourceNode *resources_{nullptr};
+  ResourcesCache* cache_{nullptr};
+
+  // Owner of cache_ when the manager is not created by a Binary
+  std::shared_ptr<ResourcesCache> own_cache_;
 };
 
 } // namespace PE
@@ -59,6 +59,9 @@ class LIEF_API Section : public LIEF::Section {
   // ============================
   virtual std::vector<uint8_t> content() const override;
 
+  //! Section's content without copy
+  virtual span<const uint8_t> content_view() const override;
+
   //! Content of the section's padding
   inline const std::vector<uint8_t>& padding() const {
     return this->padding_;
@@ -107,6 +110,8 @@ class LIEF_API Section : public LIEF::Section {
   LIEF_API friend std::ostream& operator<<(std::ostream& os, const Section& section);
 
   private:
+  //! The caller must call Section::content_changed once the content is modified
+  //! (the digest computed in the meantime would be cached for the old version)
   std::vector<uint8_t>& content_ref();
 
   std::vector<uint8_t> content_;
@@ -117,6 +117,14 @@ class LIEF_API x509 : public Object {
     DECIPHER_ONLY,         /**< In **association with** KEY_AGREEMENT (otherwise the meaning is undefined), the key is only used for deciphering data while performing key agreement */
   };
 
+  //! Statistics of the cache used by x509::verify and x509::is_trusted_by
+  struct cache_stats_t {
+    size_t hits        = 0; ///< Verifications whose result comes from the cache
+    size_t misses      = 0; ///< Verifications done by mbedtls
+    size_t nb_ca_lists = 0; ///< CA lists (see: is_trusted_by) in the cache
+    size_t nb_results  = 0; ///< Verification results in the cache
+  };
+
   x509(mbedtls_x509_crt* ca);
   x509(const x509& other);
   x509& operator=(x509 other);
@@ -158,11 +166,26 @@ class LIEF_API x509 : public Object {
   std::unique_ptr<RsaInfo> rsa_info() const;
 
   //! Verify that this certificate has been used **to trust** the given certificate
+  //!
+  //! The result is cached (process-wide) for the pair of certificates (see clear_cache) unless
+  //! it depends on the current time (e.g. VERIFICATION_FLAGS::BADCERT_EXPIRED). A cached result
+  //! is not used once one of the certificates has expired.
   VERIFICATION_FLAGS verify(const x509& child) const;
 
   //! Verify that this certificate **is trusted** by the given CA list
+  //!
+  //! The CA list is parsed once and kept in a process-wide cache keyed by the DER hashes of
+  //! its certificates, along with the results of the certificates verified against it
+  //! (with the same restrictions as verify).
   VERIFICATION_FLAGS is_trusted_by(const std::vector<x509>& ca) const;
 
+  //! Clear the cache of the CA lists and of the verification results used by verify
+  //! and is_trusted_by
+  static void clear_cache();
+
+  //! Statistics of the cache used by verify and is_trusted_by since the last clear_cache
+  static cache_stats_t cache_stats();
+
   //! Policy information terms as OID (see RFC #5280)
   std::vector<oid_t> certificate_policies() const;
 
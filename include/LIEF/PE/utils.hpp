@@ -21,6 +21,7 @@
 #include "LIEF/PE/enums.hpp"
 #include "LIEF/visibility.h"
 #include "LIEF/errors.hpp"
+#include "LIEF/span.hpp"
 
 
 namespace LIEF {
@@ -44,6 +45,9 @@ LIEF_API bool is_pe(const std::string& file);
 //! check if the raw data is a PE file
 LIEF_API bool is_pe(const std::vector<uint8_t>& raw);
 
+//! check if the raw data is a PE file
+LIEF_API bool is_pe(span<const uint8_t> raw);
+
 //! if the input `file` is a PE one, return `PE32` or `PE32+`
 LIEF_API result<PE_TYPE> get_type(const std::string& file);
 
@@ -24,6 +24,7 @@
 #include "LIEF/platforms/android.hpp"
 
 #include "LIEF/types.hpp"
+#include "LIEF/span.hpp"
 #include "LIEF/visibility.h"
 
 namespace LIEF {
@@ -35,6 +36,9 @@ LIEF_API bool is_vdex(const std::string& file);
 //! @brief Check if the given raw data is an VDEX one.
 LIEF_API bool is_vdex(const std::vector<uint8_t>& raw);
 
+//! @brief Check if the given buffer is an VDEX one.
+LIEF_API bool is_vdex(span<const uint8_t> raw);
+
 //! @brief Return the VDEX version of the given file
 LIEF_API vdex_version_t version(const std::string& file);
 
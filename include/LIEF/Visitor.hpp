@@ -211,6 +211,18 @@ LIEF_ART_FORWARD(Header)
 
 class LIEF_API Visitor {
   public:
+  //! Format of the objects that can be visited
+  enum class FORMAT {
+    ABSTRACT = 0,
+    PE,
+    ELF,
+    MACHO,
+    OAT,
+    DEX,
+    VDEX,
+    ART,
+  };
+
   Visitor();
   virtual ~Visitor();
 
@@ -221,6 +233,11 @@ class LIEF_API Visitor {
 
   virtual void visit(const Object&);
 
+  //! Format of the given object (e.g. FORMAT::ELF for a LIEF::ELF::Section)
+  //!
+  //! Only the object itself is visited, not its children
+  static FORMAT format_of(const Object& obj);
+
   // Abstract Part
   // =============
 
@@ -625,6 +642,11 @@ class LIEF_API Visitor {
   template<class T>
   void dispatch(const T& obj);
 
+  protected:
+  //! Called by the default ``visit`` methods, that is to say when the
+  //! visitor doesn't handle the visited object. ``format`` is the format
+  //! of this object.
+  virtual void unhandled(FORMAT format);
 
   private:
   std::set<size_t> visited_;
@@ -0,0 +1,51 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_ENTROPY_H_
+#define LIEF_ENTROPY_H_
+#include <array>
+#include <vector>
+
+#include "LIEF/types.hpp"
+#include "LIEF/span.hpp"
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+
+//! Number of occurrences of each byte value
+using histogram_t = std::array<uint64_t, 256>;
+
+//! Compute the histogram of the bytes of ``data``.
+//!
+//! If ``nb_threads`` is not 1 (0 for the number of cores), large buffers
+//! are split in chunks that are processed in parallel.
+LIEF_API histogram_t histogram(span<const uint8_t> data, size_t nb_threads = 1);
+
+//! Shannon entropy (in bits per byte) of the given histogram
+LIEF_API double entropy(const histogram_t& histogram);
+
+//! Shannon entropy (in bits per byte) of ``data``
+LIEF_API double entropy(span<const uint8_t> data, size_t nb_threads = 1);
+
+//! Entropy of the windows of ``block_size`` bytes of ``data``, every ``step`` bytes
+//! (``step = 0`` means ``step = block_size``, i.e. consecutive blocks).
+//!
+//! The i-th value is the entropy of ``data[i * step, i * step + block_size)``.
+//! If ``data`` is smaller than ``block_size``, the curve contains the entropy of the whole buffer.
+LIEF_API std::vector<double> entropy_curve(span<const uint8_t> data, size_t block_size, size_t step = 0);
+
+}
+
+#endif
@@ -0,0 +1,132 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_FILE_OSTREAM_H_
+#define LIEF_FILE_OSTREAM_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
+#include "LIEF/BinaryStream/Convert.hpp"
+
+namespace LIEF {
+
+//! Positioned writer over a file.
+//!
+//! The builders use this stream to write their output directly in the file
+//! instead of assembling the whole image in memory. Small contiguous writes
+//! are buffered while the unchanged regions of the input file can be copied
+//! from file to file (see: file_ostream::copy_from).
+//!
+//! The bytes which are not written are read as 0 (holes), including the ones
+//! between the last write and a further seekp().
+//!
+//! When the stream is created from a filename, the output is written in a temporary
+//! file of the same directory which replaces ``filename`` (``rename()``, ``MoveFileEx()``)
+//! in file_ostream::commit. Hence the file being written can be the input of the builder:
+//! a binary which still maps its input file keeps reading the original content.
+//! The new file gets the permissions and, if allowed, the owner of the replaced file
+//! but it is a new inode: the other hard links to ``filename`` keep the original content.
+class LIEF_API file_ostream {
+  public:
+  //! Size of the buffer used to merge small contiguous writes
+  static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+  //! Create a stream whose output replaces ``filename`` when it is committed
+  //! (see: file_ostream::commit).
+  //! It throws a LIEF::bad_file if the file can't be created
+  file_ostream(const std::string& filename, bool endian_swap = false);
+
+  //! Write in the file descriptor ``fd``. The offsets are
+  //! relative to the beginning of the file and ``fd`` is not closed
+  //! by the stream.
+  file_ostream(int fd, bool endian_swap = false);
+
+  ~file_ostream();
+
+  file_ostream& operator=(const file_ostream&) = delete;
+  file_ostream(const file_ostream&) = delete;
+
+  uint64_t tellp() const;
+  file_ostream& seekp(uint64_t offset);
+
+  file_ostream& write(const uint8_t* data, size_t size);
+  file_ostream& write(span<const uint8_t> data);
+  file_ostream& write(const std::vector<uint8_t>& data);
+  file_ostream& write(size_t count, uint8_t value);
+
+  template<typename T>
+  file_ostream& write_conv(const T& t);
+
+  //! Copy ``size`` bytes located at ``offset`` in the file descriptor
+  //! ``fd`` to the current position.
+  //!
+  //! The copy is done by the kernel (``copy_file_range``, ``sendfile``)
+  //! when the platform supports it.
+  file_ostream& copy_from(int fd, uint64_t offset, uint64_t size);
+
+  //! Size of the file (i.e. end of the furthest write or seekp)
+  uint64_t size() const;
+
+  //! Write the pending buffer in the file and extend it to file_ostream::size
+  file_ostream& flush();
+
+  //! Flush the stream and move the output to the filename given to the constructor.
+  //!
+  //! If the stream is destroyed without being committed (e.g. the builder
+  //! failed), the output is discarded and the original file is left untouched.
+  //! It throws a LIEF::bad_file if the output can't be moved.
+  void commit();
+
+  void set_endian_swap(bool swap);
+
+  private:
+  void write_at(uint64_t offset, const uint8_t* data, size_t size);
+  void flush_buffer();
+  uint64_t copy_range(int fd, uint64_t offset, uint64_t size);
+
+  void close();
+
+  int      fd_       = -1;
+  bool     owned_    = false;
+
+  // Final path of the output and the temporary file in which
+  // it is written (empty if the stream writes in the final file)
+  std::string path_;
+  std::string tmp_path_;
+  uint64_t pos_      = 0;
+  uint64_t size_     = 0;
+
+  // Pending bytes which start at buffer_offset_
+  std::vector<uint8_t> buffer_;
+  uint64_t             buffer_offset_ = 0;
+  bool                 endian_swap_{false};
+};
+
+
+template<typename T>
+file_ostream& file_ostream::write_conv(const T& t) {
+  if (not this->endian_swap_) {
+    return this->write(reinterpret_cast<const uint8_t*>(&t), sizeof(T));
+  }
+  T tmp = t;
+  LIEF::Convert::swap_endian<T>(&tmp);
+  return this->write(reinterpret_cast<const uint8_t*>(&tmp), sizeof(T));
+}
+
+}
+#endif
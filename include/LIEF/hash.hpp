@@ -19,6 +19,7 @@
 #include <iostream>
 
 #include "LIEF/visibility.h"
+#include "LIEF/span.hpp"
 #include "LIEF/Object.hpp"
 #include "LIEF/Visitor.hpp"
 
@@ -35,6 +36,7 @@ class LIEF_API Hash : public Visitor {
 
   static size_t hash(const std::vector<uint8_t>& raw);
   static size_t hash(const void* raw, size_t size);
+  static size_t hash(span<const uint8_t> raw);
 
   // combine two elements to produce a size_t.
   template<typename U = size_t>
@@ -51,6 +53,10 @@ class LIEF_API Hash : public Visitor {
   virtual Hash& process(const std::u16string& str);
   virtual Hash& process(const std::vector<uint8_t>& raw);
 
+  //! Process a digest already computed with Hash::hash. It gives the same
+  //! value as processing the original data.
+  Hash& process_digest(size_t digest);
+
   template<class T, typename = typename std::enable_if<std::is_enum<T>::value>::type>
   Hash& process(T v) {
     return this->process(static_cast<size_t>(v));
@@ -103,6 +109,58 @@ class LIEF_API Hash : public Visitor {
 
 };
 
+//! Cache of a digest computed with Hash::hash.
+//!
+//! The digest is associated with a key_t that must change when the
+//! hashed content changes:
+//!   - ``source`` identifies the owner of the data (e.g. the ELF data handler)
+//!   - ``version`` is incremented each time the source is modified
+//!   - ``offset`` and ``size`` locate the content in the source
+//!
+//! A copy of a DigestCache is empty so that copied objects don't rely on the
+//! digest of the original object.
+//!
+//! @warning The cache is not thread-safe
+class LIEF_API DigestCache {
+  public:
+  struct key_t {
+    const void* source = nullptr;
+    uint64_t version   = 0;
+    uint64_t offset    = 0;
+    uint64_t size      = 0;
+
+    bool operator==(const key_t& rhs) const {
+      return source  == rhs.source  and
+             version == rhs.version and
+             offset  == rhs.offset  and
+             size    == rhs.size;
+    }
+  };
+
+  DigestCache();
+  DigestCache(const DigestCache&);
+  DigestCache& operator=(const DigestCache&);
+
+  //! Return the digest cached for ``key`` or compute it with ``digest()``
+  template<class F>
+  size_t get(const key_t& key, F&& digest) const {
+    if (not this->cached_ or not (this->key_ == key)) {
+      this->value_  = digest();
+      this->key_    = key;
+      this->cached_ = true;
+    }
+    return this->value_;
+  }
+
+  //! Drop the cached digest
+  void clear();
+
+  private:
+  mutable key_t  key_;
+  mutable size_t value_  = 0;
+  mutable bool   cached_ = false;
+};
+
 template<typename U>
 size_t Hash::combine(size_t lhs, U rhs) {
   return (lhs ^ rhs) + 0x9e3779b9 + (lhs << 6) + (rhs >> 2);
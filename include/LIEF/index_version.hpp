@@ -0,0 +1,95 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_INDEX_VERSION_H_
+#define LIEF_INDEX_VERSION_H_
+#include <atomic>
+#include <cstdint>
+
+namespace LIEF {
+
+//! Modification counter of the elements of a binary (sections, segments,
+//! symbols, ...) that are indexed by a RangeIndex or a NameIndex.
+//!
+//! Each binary owns its counters: modifying an element of a binary only
+//! invalidates the indexes of this binary.
+class IndexVersion {
+  public:
+  IndexVersion() = default;
+
+  //! A copy has its own history
+  IndexVersion(const IndexVersion&) {}
+  IndexVersion& operator=(const IndexVersion&) {
+    this->changed();
+    return *this;
+  }
+
+  //! Current value of the counter
+  uint64_t value() const {
+    return this->value_.load(std::memory_order_acquire);
+  }
+
+  //! Must be called when an indexed element is modified, added or removed
+  void changed() const {
+    this->value_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  private:
+  mutable std::atomic<uint64_t> value_{0};
+};
+
+
+//! Base class of the elements which can be indexed by a RangeIndex or a NameIndex.
+//!
+//! When an element is indexed, it is attached to the IndexVersion of its
+//! binary, which is incremented by Indexed::index_changed. A copy of the
+//! element is not attached while an element which is assigned (or swapped)
+//! keeps its attachment and notifies its binary.
+class Indexed {
+  public:
+  Indexed() = default;
+  Indexed(const Indexed&) {}
+  Indexed& operator=(const Indexed&) {
+    this->index_changed();
+    return *this;
+  }
+
+  //! Attach the element to the counter of the binary that indexes it
+  void index_attach(const IndexVersion& version) const {
+    this->version_.store(&version, std::memory_order_release);
+  }
+
+  protected:
+  //! Must be called when an indexed attribute of the element
+  //! (address, size, name, ...) is modified
+  void index_changed() const {
+    const IndexVersion* version = this->version_.load(std::memory_order_acquire);
+    if (version != nullptr) {
+      version->changed();
+    }
+  }
+
+  //! Counter to which the element is attached (if any)
+  const IndexVersion* index_version() const {
+    return this->version_.load(std::memory_order_acquire);
+  }
+
+  private:
+  mutable std::atomic<const IndexVersion*> version_{nullptr};
+};
+
+}
+
+#endif
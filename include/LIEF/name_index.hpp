@@ -0,0 +1,151 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_NAME_INDEX_H_
+#define LIEF_NAME_INDEX_H_
+#include <string>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <limits>
+#include <type_traits>
+
+#include "LIEF/types.hpp"
+#include "LIEF/visibility.h"
+#include "LIEF/index_version.hpp"
+
+namespace LIEF {
+
+//! Hash index used to find an element (symbol, ...) from its name.
+//!
+//! A name is associated with the **first** element (in the order of the container)
+//! that has this name. Hence, the result is the same as a ``std::find_if`` on the container.
+//!
+//! The index is built lazily and it is rebuilt when the size of the
+//! container changes, when the IndexVersion of its binary has changed
+//! (e.g. a symbol has been renamed) or when NameIndex::invalidate has been
+//! called (e.g. when the container is reordered). As for the RangeIndex,
+//! the (re)build is done under a lock.
+template<class T>
+class NameIndex {
+  public:
+  //! Index over elements whose name can't change
+  NameIndex() = default;
+
+  //! Index over elements which increment ``version`` when they are renamed
+  NameIndex(const IndexVersion& version) :
+    version_{&version}
+  {}
+
+  NameIndex(const NameIndex&) = delete;
+  NameIndex& operator=(const NameIndex&) = delete;
+
+  //! Return the first element of ``items`` named ``name`` or a nullptr
+  template<class C>
+  T* find(const C& items, const std::string& name) const {
+    if (not this->is_valid(items.size())) {
+      std::lock_guard<std::mutex> lock{this->mutex_};
+      if (not this->is_valid(items.size())) {
+        this->build(items);
+      }
+    }
+    return this->get(name);
+  }
+
+  //! Whether the index is up-to-date for a container of ``count`` elements
+  bool is_valid(size_t count) const {
+    return this->built_version_.load(std::memory_order_acquire) == this->version() and
+           this->count_.load(std::memory_order_relaxed) == count;
+  }
+
+  //! Return the element associated with ``name`` without checking
+  //! that the index is up-to-date
+  T* get(const std::string& name) const {
+    auto it = this->index_.find(name);
+    return it == std::end(this->index_) ? nullptr : it->second;
+  }
+
+  //! Register an element that has been appended to the container
+  void push_back(T* item) {
+    if (this->built_version_.load(std::memory_order_acquire) == NOT_BUILT) {
+      return;
+    }
+    this->attach(*item);
+    this->index_.emplace(name_of(*item), item);
+    this->count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  //! Force the index to be rebuilt on the next lookup
+  void invalidate() {
+    this->built_version_.store(NOT_BUILT, std::memory_order_release);
+  }
+
+  private:
+  static constexpr uint64_t NOT_BUILT = std::numeric_limits<uint64_t>::max();
+
+  // (Re)build the index from the given elements (called with mutex_ held)
+  template<class C>
+  void build(const C& items) const {
+    const uint64_t version = this->version();
+    this->index_.clear();
+    this->index_.reserve(items.size());
+    for (T* item : items) {
+      if (item != nullptr) {
+        this->attach(*item);
+        this->index_.emplace(name_of(*item), item);
+      }
+    }
+    this->count_.store(items.size(), std::memory_order_relaxed);
+    this->built_version_.store(version, std::memory_order_release);
+  }
+
+  //! Name read through the const accessor: the non-const Symbol::name()
+  //! notifies the binary as the caller may rename the symbol
+  static const std::string& name_of(const T& item) {
+    return item.name();
+  }
+
+  uint64_t version() const {
+    return this->version_ == nullptr ? 0 : this->version_->value();
+  }
+
+  void attach(const T& item) const {
+    if (this->version_ != nullptr) {
+      // The element must notify this binary when it is renamed
+      attach(item, *this->version_, std::is_base_of<Indexed, T>{});
+    }
+  }
+
+  static void attach(const T& item, const IndexVersion& version, std::true_type) {
+    item.index_attach(version);
+  }
+
+  static void attach(const T&, const IndexVersion&, std::false_type) {}
+
+  const IndexVersion* version_ = nullptr;
+
+  mutable std::unordered_map<std::string, T*> index_;
+  mutable std::atomic<size_t>   count_{0};
+  // Value of version() when the index has been built
+  mutable std::atomic<uint64_t> built_version_{NOT_BUILT};
+  mutable std::mutex            mutex_;
+};
+
+template<class T>
+constexpr uint64_t NameIndex<T>::NOT_BUILT;
+
+}
+
+#endif
@@ -0,0 +1,187 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_RANGE_INDEX_H_
+#define LIEF_RANGE_INDEX_H_
+#include <vector>
+#include <set>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+#include "LIEF/types.hpp"
+#include "LIEF/visibility.h"
+#include "LIEF/index_version.hpp"
+
+namespace LIEF {
+
+//! Index used to find the element (section, segment, ...) whose range
+//! ``[start, start + size)`` contains a given value, in ``O(log n)``.
+//!
+//! The ranges are split into disjoint intervals which are associated with
+//! the **first** element (in the order of the container) that covers them.
+//! Hence, the result is the same as a ``std::find_if`` on the container.
+//!
+//! The index is built lazily and it is rebuilt when the size of the
+//! container changes or when the IndexVersion of its binary has changed
+//! (e.g. the address of a section has been modified). The (re)build is done
+//! under a lock so that concurrent lookups are safe as long as the binary
+//! is not modified at the same time.
+//!
+//! @warning A given RangeIndex must always be used with the same ``range``
+//! functor (see: RangeIndex::find)
+template<class T>
+class RangeIndex {
+  public:
+  //! Index over elements whose range can't change (e.g. a snapshot)
+  RangeIndex() = default;
+
+  //! Index over elements which increment ``version`` when their range changes
+  RangeIndex(const IndexVersion& version) :
+    version_{&version}
+  {}
+
+  RangeIndex(const RangeIndex&) = delete;
+  RangeIndex& operator=(const RangeIndex&) = delete;
+
+  //! Return the first element of ``items`` whose range contains ``value``
+  //! or a nullptr.
+  //!
+  //! ``range`` is a functor that returns the ``(start, size)`` pair of an element.
+  //! Elements with an empty range are ignored.
+  template<class F>
+  T* find(const std::vector<T*>& items, uint64_t value, F&& range) const {
+    if (not this->is_valid(items.size())) {
+      std::lock_guard<std::mutex> lock{this->mutex_};
+      if (not this->is_valid(items.size())) {
+        this->build(items, range);
+      }
+    }
+
+    auto it = std::upper_bound(std::begin(this->entries_), std::end(this->entries_), value,
+        [] (uint64_t value, const entry_t& entry) {
+          return value < entry.first;
+        });
+
+    if (it == std::begin(this->entries_)) {
+      return nullptr;
+    }
+    --it;
+    return it->second;
+  }
+
+  //! Force the index to be rebuilt on the next lookup
+  void invalidate() {
+    this->built_version_.store(NOT_BUILT, std::memory_order_release);
+  }
+
+  private:
+  using entry_t = std::pair<uint64_t, T*>; // start of the interval, element
+  static constexpr uint64_t NOT_BUILT = std::numeric_limits<uint64_t>::max();
+
+  uint64_t version() const {
+    return this->version_ == nullptr ? 0 : this->version_->value();
+  }
+
+  bool is_valid(size_t count) const {
+    return this->built_version_.load(std::memory_order_acquire) == this->version() and
+           this->count_.load(std::memory_order_relaxed) == count;
+  }
+
+  static void attach(const T& item, const IndexVersion& version, std::true_type) {
+    item.index_attach(version);
+  }
+
+  static void attach(const T&, const IndexVersion&, std::false_type) {}
+
+  template<class F>
+  void build(const std::vector<T*>& items, F&& range) const {
+    const uint64_t version = this->version();
+
+    // (bound, index in the container)
+    std::vector<std::pair<uint64_t, size_t>> starts;
+    std::vector<std::pair<uint64_t, size_t>> ends;
+    starts.reserve(items.size());
+    ends.reserve(items.size());
+
+    for (size_t i = 0; i < items.size(); ++i) {
+      if (items[i] == nullptr) {
+        continue;
+      }
+      if (this->version_ != nullptr) {
+        // The element must notify this binary when its range changes
+        attach(*items[i], *this->version_, std::is_base_of<Indexed, T>{});
+      }
+      const std::pair<uint64_t, uint64_t> r = range(*items[i]);
+      if (r.second == 0) {
+        continue;
+      }
+      const uint64_t max_size = std::numeric_limits<uint64_t>::max() - r.first;
+      starts.emplace_back(r.first, i);
+      ends.emplace_back(r.first + std::min(r.second, max_size), i);
+    }
+    std::sort(std::begin(starts), std::end(starts));
+    std::sort(std::begin(ends), std::end(ends));
+
+    this->entries_.clear();
+    std::set<size_t> active;
+    auto it_start = std::begin(starts);
+    auto it_end   = std::begin(ends);
+
+    while (it_start != std::end(starts) or it_end != std::end(ends)) {
+      uint64_t bound = std::numeric_limits<uint64_t>::max();
+      if (it_start != std::end(starts)) {
+        bound = it_start->first;
+      }
+      if (it_end != std::end(ends)) {
+        bound = std::min(bound, it_end->first);
+      }
+
+      for (; it_end != std::end(ends) and it_end->first == bound; ++it_end) {
+        active.erase(it_end->second);
+      }
+
+      for (; it_start != std::end(starts) and it_start->first == bound; ++it_start) {
+        active.insert(it_start->second);
+      }
+
+      T* item = active.empty() ? nullptr : items[*std::begin(active)];
+      if (this->entries_.empty() or this->entries_.back().second != item) {
+        this->entries_.emplace_back(bound, item);
+      }
+    }
+
+    this->count_.store(items.size(), std::memory_order_relaxed);
+    this->built_version_.store(version, std::memory_order_release);
+  }
+
+  const IndexVersion* version_ = nullptr;
+
+  mutable std::vector<entry_t> entries_;
+  mutable std::atomic<size_t>   count_{0};
+  // Value of version() when the index has been built
+  mutable std::atomic<uint64_t> built_version_{NOT_BUILT};
+  mutable std::mutex            mutex_;
+};
+
+template<class T>
+constexpr uint64_t RangeIndex<T>::NOT_BUILT;
+
+}
+
+#endif
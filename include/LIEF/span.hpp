@@ -0,0 +1,107 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_SPAN_H_
+#define LIEF_SPAN_H_
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+namespace LIEF {
+
+//! Non-owning view over a contiguous sequence of objects (similar to C++20 ``std::span``)
+//!
+//! @warning The view is invalidated when the underlying buffer is modified or released
+template<class T>
+class span {
+  public:
+  using element_type = T;
+  using value_type   = typename std::remove_cv<T>::type;
+  using pointer      = T*;
+  using reference    = T&;
+  using iterator     = T*;
+
+  span() = default;
+
+  span(T* data, size_t size) :
+    data_{data},
+    size_{size}
+  {}
+
+  template<class U, class A>
+  span(const std::vector<U, A>& vector) :
+    data_{vector.data()},
+    size_{vector.size()}
+  {}
+
+  template<class U, class A>
+  span(std::vector<U, A>& vector) :
+    data_{vector.data()},
+    size_{vector.size()}
+  {}
+
+  template<class U>
+  span(const span<U>& other) :
+    data_{other.data()},
+    size_{other.size()}
+  {}
+
+  inline T* data() const {
+    return this->data_;
+  }
+
+  inline size_t size() const {
+    return this->size_;
+  }
+
+  inline bool empty() const {
+    return this->size_ == 0;
+  }
+
+  inline T* begin() const {
+    return this->data_;
+  }
+
+  inline T* end() const {
+    return this->data_ + this->size_;
+  }
+
+  inline T& operator[](size_t idx) const {
+    return this->data_[idx];
+  }
+
+  //! View on ``count`` elements starting at ``offset``. The view is
+  //! truncated if it exceeds the current view.
+  inline span subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const {
+    if (offset >= this->size_) {
+      return {};
+    }
+    const size_t available = this->size_ - offset;
+    return {this->data_ + offset, count < available ? count : available};
+  }
+
+  //! Copy the content of the view in a std::vector
+  inline std::vector<value_type> to_vector() const {
+    return {this->begin(), this->end()};
+  }
+
+  private:
+  T*     data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_STRING_TABLE_H_
+#define LIEF_STRING_TABLE_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LIEF/visibility.h"
+
+namespace LIEF {
+class vector_iostream;
+
+//! Builder of string tables (e.g. ELF ``.dynstr``, ``.strtab``, ``.shstrtab``
+//! or the Mach-O ``LC_SYMTAB`` strings) which merges the strings that are
+//! suffixes of another one: ``"foo"`` is stored within ``"barfoo"``.
+//!
+//! The strings are copied in an arena and sorted with a multikey quicksort on
+//! their reversed characters, such as a suffix directly follows the strings
+//! that contain it. The merge is then done in a single pass and the offsets
+//! are indexed with a hash table over the arena (the keys are not copied).
+//!
+//! @code{.cpp}
+//! StringTable table;
+//! table.add("barfoo");
+//! table.add("foo");
+//! table.finalize(1);      // The table starts with a null byte
+//! table.offset("foo");    // 4
+//! @endcode
+class LIEF_API StringTable {
+  public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  StringTable();
+  ~StringTable();
+
+  //! Reserve the memory for ``nb_strings`` strings of ``nb_bytes`` bytes (total)
+  void reserve(size_t nb_strings, size_t nb_bytes = 0);
+
+  //! Add a string to the table. Duplicated strings are stored once.
+  void add(const std::string& str);
+  void add(const char* str, size_t size);
+
+  //! Merge the strings and compute their offsets. The first string
+  //! is located at ``base``.
+  //!
+  //! This function must be called again if strings are added afterwards.
+  void finalize(size_t base = 0);
+
+  //! Size of the merged strings, null terminators included
+  //! (i.e. the size written by StringTable::write)
+  size_t size() const;
+
+  //! Number of distinct strings
+  size_t nb_strings() const;
+
+  //! Offset of the given string or StringTable::npos if it is not in the table.
+  //!
+  //! The empty string is located at the offset 0 as the string tables start with a null byte.
+  size_t offset(const std::string& str) const;
+  size_t offset(const char* str, size_t size) const;
+
+  //! Write the merged strings (null terminated)
+  void write(vector_iostream& os) const;
+
+  private:
+  struct entry_t {
+    uint64_t start;  // Offset in the arena
+    uint32_t size;
+    bool     merged; // Suffix of the previous emitted string
+    size_t   offset; // Offset in the table
+  };
+
+  int char_at(const entry_t& entry, size_t pos) const;
+  bool is_suffix(const entry_t& suffix, const entry_t& str) const;
+  void sort();
+  void build_index();
+
+  std::vector<char>    arena_;
+  std::vector<entry_t> entries_;
+  std::vector<uint32_t> index_; // Open addressing: entry index + 1 (0 is empty)
+  size_t               size_ = 0;
+  size_t               nb_strings_ = 0;
+  bool                 finalized_ = false;
+};
+
+}
+#endif
@@ -26,7 +26,7 @@
     }
 
   #define LIEF_PE_VISITABLE(OBJ) \
-    virtual void visit(const PE::OBJ&) {}
+    virtual void visit(const PE::OBJ&) { this->unhandled(FORMAT::PE); }
 #else
   #define LIEF_PE_VISITABLE(OBJ)
   #define LIEF_PE_FORWARD(OBJ)
@@ -41,7 +41,7 @@
     class OBJ;                 \
     }
   #define LIEF_ELF_VISITABLE(OBJ)         \
-    virtual void visit(const ELF::OBJ&) {}
+    virtual void visit(const ELF::OBJ&) { this->unhandled(FORMAT::ELF); }
 #else
   #define LIEF_ELF_FORWARD(OBJ)
   #define LIEF_ELF_VISITABLE(OBJ)
@@ -55,7 +55,7 @@
     class OBJ;                 \
     }
   #define LIEF_MACHO_VISITABLE(OBJ) \
-    virtual void visit(const MachO::OBJ&) {}
+    virtual void visit(const MachO::OBJ&) { this->unhandled(FORMAT::MACHO); }
 #else
   #define LIEF_MACHO_FORWARD(OBJ)
   #define LIEF_MACHO_VISITABLE(OBJ)
@@ -70,7 +70,7 @@
     class OBJ;                 \
     }
   #define LIEF_OAT_VISITABLE(OBJ) \
-    virtual void visit(const OAT::OBJ&) {}
+    virtual void visit(const OAT::OBJ&) { this->unhandled(FORMAT::OAT); }
 #else
   #define LIEF_OAT_FORWARD(OBJ)
   #define LIEF_OAT_VISITABLE(OBJ)
@@ -85,7 +85,7 @@
     class OBJ;                 \
     }
   #define LIEF_DEX_VISITABLE(OBJ) \
-    virtual void visit(const DEX::OBJ&) {}
+    virtual void visit(const DEX::OBJ&) { this->unhandled(FORMAT::DEX); }
 #else
   #define LIEF_DEX_FORWARD(OBJ)
   #define LIEF_DEX_VISITABLE(OBJ)
@@ -100,7 +100,7 @@
     class OBJ;                 \
     }
   #define LIEF_VDEX_VISITABLE(OBJ) \
-    virtual void visit(const VDEX::OBJ&) {}
+    virtual void visit(const VDEX::OBJ&) { this->unhandled(FORMAT::VDEX); }
 #else
   #define LIEF_VDEX_FORWARD(OBJ)
   #define LIEF_VDEX_VISITABLE(OBJ)
@@ -115,7 +115,7 @@
     class OBJ;                 \
     }
   #define LIEF_ART_VISITABLE(OBJ) \
-    virtual void visit(const ART::OBJ&) {}
+    virtual void visit(const ART::OBJ&) { this->unhandled(FORMAT::ART); }
 #else
   #define LIEF_ART_FORWARD(OBJ)
   #define LIEF_ART_VISITABLE(OBJ)
@@ -127,7 +127,7 @@
   class OBJ;
 
 #define LIEF_ABSTRACT_VISITABLE(OBJ) \
-  virtual void visit(const OBJ&) {}
+  virtual void visit(const OBJ&) { this->unhandled(FORMAT::ABSTRACT); }
 
 
 #endif
@@ -20,15 +20,123 @@
 
 #ifdef LIEF_JSON_SUPPORT
 
+#include <functional>
+#include <map>
+#include <ostream>
+
 #include "LIEF/visibility.h"
 #include "LIEF/Visitor.hpp"
 #include "LIEF/json.hpp"
 
 namespace LIEF {
 
+//! Write JSON values in a stream as they come, without building
+//! the whole document in memory.
+class LIEF_API JsonStream {
+  public:
+  enum class FORMAT {
+    JSON = 0, ///< Same output as ``json::dump()``
+    NDJSON,   ///< One line per member of the top-level object. An array is written as a
+              ///< ``{"key": []}`` line followed by one line per element
+    CBOR,     ///< CBOR with indefinite-length maps and arrays
+  };
+
+  JsonStream(std::ostream& os, FORMAT format = FORMAT::JSON);
+
+  FORMAT format() const;
+
+  JsonStream& begin_object();
+  JsonStream& end_object();
+
+  JsonStream& begin_array();
+  JsonStream& end_array();
+
+  //! Key of the next value of the current object
+  JsonStream& key(const std::string& key);
+
+  //! Write a complete value
+  JsonStream& value(const json& node);
+
+  private:
+  //! Write the separator that precedes a new element (JSON only)
+  void separator();
+  void write(const json& node);
+
+  std::ostream& os_;
+  FORMAT format_;
+  std::vector<bool> first_; // One entry per opened object/array
+  bool after_key_ = false;
+  std::string ndjson_key_;
+};
+
+//! Members of a JSON object whose large arrays are produced element by element.
+//!
+//! It is used for the objects with a lot of children (e.g. a binary) such as they
+//! can either be converted into a json node or written in a JsonStream with a
+//! bounded amount of memory. The members are sorted by key as in a json node
+//! so that both outputs are the same.
+//!
+//! @warning The arrays refer to the object: it must outlive the JsonMembers
+class LIEF_API JsonMembers {
+  public:
+  using sink_t  = std::function<void(const json&)>;
+  using array_t = std::function<void(const sink_t&)>;
+
+  JsonMembers& set(const std::string& key, json value);
+
+  //! Member whose value is the array of the elements given to the
+  //! ``sink`` by ``array``
+  JsonMembers& set_array(const std::string& key, array_t array);
+
+  //! Member whose value is the array of the json representation of
+  //! the elements of ``range`` given by the visitor ``V``
+  template<class V, class R>
+  JsonMembers& set_array(const std::string& key, R range) {
+    return this->set_array(key, [range] (const sink_t& sink) {
+      for (auto&& element : range) {
+        V visitor;
+        visitor(element);
+        sink(visitor.get());
+      }
+    });
+  }
+
+  template<class V, class T>
+  JsonMembers& set_array(const std::string& key, const std::vector<T>& container) {
+    const std::vector<T>* elements = &container;
+    return this->set_array(key, [elements] (const sink_t& sink) {
+      for (const T& element : *elements) {
+        V visitor;
+        visitor(element);
+        sink(visitor.get());
+      }
+    });
+  }
+
+  //! Set the members in ``node``
+  void update(json& node) const;
+
+  //! Write the object in the given stream
+  void write(JsonStream& stream) const;
+
+  private:
+  struct member_t {
+    json    value;
+    array_t array;
+  };
+  std::map<std::string, member_t> members_;
+};
+
 LIEF_API json to_json(const Object& v);
 LIEF_API std::string to_json_str(const Object& v);
 
+//! Write the json representation of the given object in ``os``
+//!
+//! The binaries (ELF, PE, Mach-O) are written incrementally: the nodes of their
+//! sections, symbols, relocations, ... are created and written one at a time.
+LIEF_API void to_json(const Object& v, std::ostream& os,
+                      JsonStream::FORMAT format = JsonStream::FORMAT::JSON);
+
 class LIEF_API JsonVisitor : public Visitor {
 
   public:
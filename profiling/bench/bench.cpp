@@ -0,0 +1,528 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32)
+  #include <windows.h>
+  #include <psapi.h>
+  #include <process.h>
+#else
+  #include <sys/resource.h>
+  #include <unistd.h>
+#endif
+
+#include <LIEF/logging.hpp>
+#include <LIEF/version.h>
+
+#include "bench.hpp"
+
+// usage: lief_bench [--filter=<regex>] [--min-time=<seconds>] [--repetitions=<n>]
+//                   [--format=console|json|csv] [--out=<file>] [--list] [--verbose]
+//
+// The JSON output can be compared between two commits with compare.py
+
+namespace lief_bench {
+
+namespace {
+
+struct benchmark_t {
+  std::string name;
+  function_t  func;
+  int64_t     arg;
+};
+
+std::vector<benchmark_t>& registry() {
+  static std::vector<benchmark_t> benchmarks;
+  return benchmarks;
+}
+
+struct result_t {
+  std::string name;
+  std::string run_name;               // name of the benchmark without the aggregate suffix
+  std::string run_type = "iteration"; // or "aggregate"
+  std::string aggregate;
+  uint64_t    iterations = 0;
+  double      real_time  = 0;         // ns per iteration
+  double      cpu_time   = 0;         // ns per iteration
+  double      bytes_per_second = 0;
+  double      items_per_second = 0;
+  uint64_t    peak_rss   = 0;         // bytes
+  std::string error;
+};
+
+struct options_t {
+  std::string filter      = ".*";
+  double      min_time    = 0.5;
+  size_t      repetitions = 1;
+  std::string format      = "console";
+  std::string out;
+  bool        list        = false;
+  bool        verbose     = false; // Keep LIEF's logging enabled
+};
+
+
+// Peak RSS
+// ========
+// On Linux, the high water mark is reset before each benchmark so that
+// the value reported is the peak of this benchmark (not of the process).
+void reset_peak_rss() {
+#if defined(__linux__)
+  std::ofstream clear_refs{"/proc/self/clear_refs"};
+  if (clear_refs) {
+    clear_refs << "5";
+  }
+#endif
+}
+
+uint64_t peak_rss() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize;
+  }
+  return 0;
+#else
+  #if defined(__linux__)
+  std::ifstream status{"/proc/self/status"};
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+    }
+  }
+  #endif
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  #if defined(__APPLE__)
+  return usage.ru_maxrss;        // bytes
+  #else
+  return usage.ru_maxrss * 1024; // kilobytes
+  #endif
+#endif
+}
+
+std::string json_escape(const std::string& str) {
+  std::string out;
+  out.reserve(str.size());
+  for (char c : str) {
+    switch (c) {
+      case '"':  out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n";  break;
+      case '\t': out += "\\t";  break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          out += buffer;
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out;
+}
+
+std::string human_size(double value, const char* unit) {
+  static const char* const PREFIXES[] = {"", "k", "M", "G", "T"};
+  size_t idx = 0;
+  while (value >= 1024 and idx < 4) {
+    value /= 1024;
+    ++idx;
+  }
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.2f %s%s", value, PREFIXES[idx], unit);
+  return buffer;
+}
+
+}
+
+// State
+// =====
+State::State(uint64_t max_iterations, int64_t arg) :
+  max_iterations_{max_iterations},
+  arg_{arg}
+{}
+
+State::iterator State::begin() {
+  this->start();
+  return iterator{this};
+}
+
+State::iterator State::end() {
+  return iterator{};
+}
+
+void State::start() {
+  this->running_    = true;
+  this->real_start_ = clock_t::now();
+  this->cpu_start_  = std::clock();
+}
+
+void State::finish() {
+  if (this->running_) {
+    this->pause_timing();
+  }
+}
+
+void State::pause_timing() {
+  if (not this->running_) {
+    return;
+  }
+  this->real_time_ += std::chrono::duration<double>(clock_t::now() - this->real_start_).count();
+  this->cpu_time_  += static_cast<double>(std::clock() - this->cpu_start_) / CLOCKS_PER_SEC;
+  this->running_ = false;
+}
+
+void State::resume_timing() {
+  this->start();
+}
+
+void State::skip_with_error(const std::string& msg) {
+  this->error_     = true;
+  this->error_msg_ = msg;
+}
+
+void register_benchmark(const std::string& name, function_t func, std::vector<int64_t> args) {
+  if (args.empty()) {
+    registry().push_back({name, func, 0});
+    return;
+  }
+  for (int64_t arg : args) {
+    registry().push_back({name + "/" + std::to_string(arg), func, arg});
+  }
+}
+
+std::string tmp_file(const std::string& suffix) {
+#if defined(_WIN32)
+  const char* tmp = std::getenv("TEMP");
+  const int pid = _getpid();
+#else
+  const char* tmp = std::getenv("TMPDIR");
+  const int pid = getpid();
+#endif
+  std::string dir = tmp != nullptr ? tmp : "/tmp";
+  return dir + "/lief_bench." + std::to_string(pid) + suffix;
+}
+
+
+// Runner
+// ======
+class Runner {
+  public:
+  Runner(const options_t& opt) :
+    opt_(opt)
+  {}
+
+  result_t run_once(const benchmark_t& bench, uint64_t iterations) const {
+    State state{iterations, bench.arg};
+    result_t result;
+    result.name     = bench.name;
+    result.run_name = bench.name;
+    try {
+      bench.func(state);
+    } catch (const std::exception& e) {
+      state.skip_with_error(e.what());
+    }
+    state.finish();
+    if (state.error_) {
+      result.error = state.error_msg_;
+      return result;
+    }
+    result.iterations = iterations;
+    result.real_time  = state.real_time_ * 1e9 / iterations;
+    result.cpu_time   = state.cpu_time_  * 1e9 / iterations;
+    if (state.real_time_ > 0) {
+      result.bytes_per_second = state.bytes_processed_ / state.real_time_;
+      result.items_per_second = state.items_processed_ / state.real_time_;
+    }
+    return result;
+  }
+
+  //! Increase the number of iterations until the benchmark runs for at least ``min_time``
+  result_t run(const benchmark_t& bench) const {
+    static constexpr uint64_t MAX_ITERATIONS = 1000000000;
+    uint64_t iterations = 1;
+    while (true) {
+      result_t result = this->run_once(bench, iterations);
+      const double elapsed = result.real_time * iterations / 1e9;
+      if (not result.error.empty() or elapsed >= this->opt_.min_time or iterations >= MAX_ITERATIONS) {
+        return result;
+      }
+      double multiplier = elapsed > 0 ? this->opt_.min_time * 1.4 / elapsed : 10.0;
+      multiplier = std::min(std::max(multiplier, 2.0), 10.0);
+      iterations = std::min<uint64_t>(iterations * multiplier, MAX_ITERATIONS);
+    }
+  }
+
+  std::vector<result_t> run_all() const {
+    std::vector<result_t> results;
+    const std::regex filter{this->opt_.filter};
+    for (const benchmark_t& bench : registry()) {
+      if (not std::regex_search(bench.name, filter)) {
+        continue;
+      }
+      std::vector<result_t> runs;
+      for (size_t i = 0; i < this->opt_.repetitions; ++i) {
+        reset_peak_rss();
+        result_t result = this->run(bench);
+        result.peak_rss = peak_rss();
+        if (this->opt_.format != "console") {
+          std::fprintf(stderr, "%s: %s\n", bench.name.c_str(), result.error.empty() ? "done" : result.error.c_str());
+        } else {
+          print_console(result);
+        }
+        runs.push_back(std::move(result));
+      }
+      results.insert(std::end(results), std::begin(runs), std::end(runs));
+      if (runs.size() > 1 and runs.front().error.empty()) {
+        for (result_t& aggregate : aggregates(runs)) {
+          if (this->opt_.format == "console") {
+            print_console(aggregate);
+          }
+          results.push_back(std::move(aggregate));
+        }
+      }
+    }
+    return results;
+  }
+
+  static std::vector<result_t> aggregates(const std::vector<result_t>& runs) {
+    auto&& make = [&runs] (const char* name, std::function<double(std::vector<double>)> func) {
+      result_t result = runs.front();
+      result.name       += std::string{"_"} + name;
+      result.run_type   = "aggregate";
+      result.aggregate  = name;
+      auto&& apply = [&] (double result_t::* field) {
+        std::vector<double> values;
+        for (const result_t& r : runs) {
+          values.push_back(r.*field);
+        }
+        return func(std::move(values));
+      };
+      result.real_time        = apply(&result_t::real_time);
+      result.cpu_time         = apply(&result_t::cpu_time);
+      result.bytes_per_second = apply(&result_t::bytes_per_second);
+      result.items_per_second = apply(&result_t::items_per_second);
+      for (const result_t& r : runs) {
+        result.peak_rss = std::max(result.peak_rss, r.peak_rss);
+      }
+      return result;
+    };
+
+    auto&& mean = [] (std::vector<double> values) {
+      double sum = 0;
+      for (double v : values) {
+        sum += v;
+      }
+      return sum / values.size();
+    };
+
+    auto&& median = [] (std::vector<double> values) {
+      std::sort(std::begin(values), std::end(values));
+      const size_t mid = values.size() / 2;
+      return values.size() % 2 == 0 ? (values[mid - 1] + values[mid]) / 2 : values[mid];
+    };
+
+    auto&& stddev = [mean] (std::vector<double> values) {
+      const double m = mean(values);
+      double sum = 0;
+      for (double v : values) {
+        sum += (v - m) * (v - m);
+      }
+      return std::sqrt(sum / (values.size() - 1));
+    };
+
+    return {make("mean", mean), make("median", median), make("stddev", stddev)};
+  }
+
+  static void print_header() {
+    std::printf("%-40s %14s %14s %12s %14s %14s %12s\n",
+                "Benchmark", "Time", "CPU", "Iterations", "Bytes/s", "Items/s", "Peak RSS");
+    std::printf("%s\n", std::string(126, '-').c_str());
+  }
+
+  static void print_console(const result_t& r) {
+    if (not r.error.empty()) {
+      std::printf("%-40s ERROR: %s\n", r.name.c_str(), r.error.c_str());
+      return;
+    }
+    std::printf("%-40s %11.0f ns %11.0f ns %12llu %14s %14s %12s\n",
+                r.name.c_str(), r.real_time, r.cpu_time,
+                static_cast<unsigned long long>(r.iterations),
+                r.bytes_per_second > 0 ? human_size(r.bytes_per_second, "B/s").c_str() : "",
+                r.items_per_second > 0 ? human_size(r.items_per_second, "/s").c_str() : "",
+                human_size(r.peak_rss, "B").c_str());
+    std::fflush(stdout);
+  }
+
+  static void write_json(std::ostream& os, const std::vector<result_t>& results) {
+    char date[64] = {0};
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"date\": \"" << date << "\",\n";
+    os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    os << "    \"library_version\": \"" << json_escape(LIEF_VERSION) << "\",\n";
+    os << "    \"library_commit\": \"" << json_escape(LIEF_COMMIT) << "\",\n";
+#if defined(NDEBUG)
+    os << "    \"library_build_type\": \"release\"\n";
+#else
+    os << "    \"library_build_type\": \"debug\"\n";
+#endif
+    os << "  },\n";
+    os << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+      const result_t& r = results[i];
+      os << (i == 0 ? "\n" : ",\n");
+      os << "    {\n";
+      os << "      \"name\": \""      << json_escape(r.name) << "\",\n";
+      os << "      \"run_name\": \""  << json_escape(r.run_name) << "\",\n";
+      os << "      \"run_type\": \""  << r.run_type << "\",\n";
+      if (not r.aggregate.empty()) {
+        os << "      \"aggregate_name\": \"" << r.aggregate << "\",\n";
+      }
+      if (not r.error.empty()) {
+        os << "      \"error_occurred\": true,\n";
+        os << "      \"error_message\": \"" << json_escape(r.error) << "\"\n";
+        os << "    }";
+        continue;
+      }
+      os << "      \"iterations\": "       << r.iterations       << ",\n";
+      os << "      \"real_time\": "        << r.real_time        << ",\n";
+      os << "      \"cpu_time\": "         << r.cpu_time         << ",\n";
+      os << "      \"time_unit\": \"ns\",\n";
+      os << "      \"bytes_per_second\": " << r.bytes_per_second << ",\n";
+      os << "      \"items_per_second\": " << r.items_per_second << ",\n";
+      os << "      \"peak_rss\": "         << r.peak_rss         << "\n";
+      os << "    }";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  static void write_csv(std::ostream& os, const std::vector<result_t>& results) {
+    os << "name,iterations,real_time,cpu_time,time_unit,bytes_per_second,items_per_second,peak_rss,error_message\n";
+    for (const result_t& r : results) {
+      os << '"' << r.name << "\"," << r.iterations << ',' << r.real_time << ',' << r.cpu_time << ",ns,"
+         << r.bytes_per_second << ',' << r.items_per_second << ',' << r.peak_rss << ",\"" << r.error << "\"\n";
+    }
+  }
+
+  private:
+  const options_t& opt_;
+};
+
+}
+
+
+static bool parse_option(const char* arg, const char* name, std::string& value) {
+  const size_t len = std::strlen(name);
+  if (std::strncmp(arg, name, len) != 0 or arg[len] != '=') {
+    return false;
+  }
+  value = arg + len + 1;
+  return true;
+}
+
+int main(int argc, char** argv) {
+  using namespace lief_bench;
+  options_t opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string value;
+    if (parse_option(argv[i], "--filter", value)) {
+      opt.filter = value;
+    } else if (parse_option(argv[i], "--min-time", value)) {
+      opt.min_time = std::strtod(value.c_str(), nullptr);
+    } else if (parse_option(argv[i], "--repetitions", value)) {
+      opt.repetitions = std::max<size_t>(std::strtoull(value.c_str(), nullptr, 0), 1);
+    } else if (parse_option(argv[i], "--format", value)) {
+      opt.format = value;
+    } else if (parse_option(argv[i], "--out", value)) {
+      opt.out = value;
+    } else if (std::strcmp(argv[i], "--list") == 0) {
+      opt.list = true;
+    } else if (std::strcmp(argv[i], "--verbose") == 0) {
+      opt.verbose = true;
+    } else {
+      std::fprintf(stderr, "Usage: %s [--filter=<regex>] [--min-time=<seconds>] [--repetitions=<n>] "
+                           "[--format=console|json|csv] [--out=<file>] [--list] [--verbose]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (opt.format != "console" and opt.format != "json" and opt.format != "csv") {
+    std::fprintf(stderr, "Unknown format: %s\n", opt.format.c_str());
+    return EXIT_FAILURE;
+  }
+
+  if (opt.list) {
+    const std::regex filter{opt.filter};
+    for (const auto& bench : registry()) {
+      if (std::regex_search(bench.name, filter)) {
+        std::printf("%s\n", bench.name.c_str());
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // The messages of the parsers and the builders would be timed with them
+  if (not opt.verbose) {
+    LIEF::logging::disable();
+  }
+
+  // The console output is printed as the benchmarks run. The other formats
+  // are written at the end (in --out or on stdout).
+  if (opt.format == "console") {
+    std::printf("LIEF %s\n", LIEF_VERSION);
+    Runner::print_header();
+  }
+
+  Runner runner{opt};
+  const std::vector<result_t> results = runner.run_all();
+
+  if (opt.format == "console" and opt.out.empty()) {
+    return EXIT_SUCCESS;
+  }
+
+  std::ofstream file;
+  if (not opt.out.empty()) {
+    file.open(opt.out);
+    if (not file) {
+      std::fprintf(stderr, "Can't open %s\n", opt.out.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream& os = opt.out.empty() ? std::cout : file;
+  if (opt.format == "csv") {
+    Runner::write_csv(os, results);
+  } else {
+    Runner::write_json(os, results);
+  }
+  return EXIT_SUCCESS;
+}
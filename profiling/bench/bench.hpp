@@ -0,0 +1,200 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_BENCH_H_
+#define LIEF_BENCH_H_
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness modeled on Google Benchmark:
+//
+//   static void elf_parse(lief_bench::State& state) {
+//     const std::vector<uint8_t>& raw = ...;
+//     for (auto _ : state) {
+//       lief_bench::do_not_optimize(LIEF::ELF::Parser::parse(raw));
+//     }
+//     state.set_bytes_processed(state.iterations() * raw.size());
+//   }
+//   LIEF_BENCHMARK("ELF/parse", elf_parse, {1 << 10, 1 << 14});
+//
+// The harness doesn't depend on a third-party library so that it can be
+// built everywhere LIEF is built and its JSON output follows the schema of
+// Google Benchmark (tools like compare.py can consume it).
+
+namespace lief_bench {
+
+class State {
+  public:
+  //! Value of ``for (auto _ : state)``. The user-provided destructor keeps
+  //! the compiler from warning about the unused loop variable.
+  struct Value {
+    ~Value() {}
+  };
+
+  class iterator {
+    public:
+    iterator() = default;
+    explicit iterator(State* state) :
+      state_{state},
+      remaining_{state->max_iterations_}
+    {}
+
+    inline Value operator*() const {
+      return {};
+    }
+
+    inline iterator& operator++() {
+      --this->remaining_;
+      return *this;
+    }
+
+    inline bool operator!=(const iterator&) const {
+      if (this->remaining_ > 0 and not this->state_->error_) {
+        return true;
+      }
+      this->state_->finish();
+      return false;
+    }
+
+    private:
+    State*   state_     = nullptr;
+    uint64_t remaining_ = 0;
+  };
+
+  State(uint64_t max_iterations, int64_t arg);
+
+  //! Argument of the benchmark (e.g. number of symbols)
+  inline int64_t range() const {
+    return this->arg_;
+  }
+
+  inline uint64_t iterations() const {
+    return this->max_iterations_;
+  }
+
+  iterator begin();
+  iterator end();
+
+  //! Stop the timers (e.g. to re-create the input of the next iteration)
+  void pause_timing();
+  void resume_timing();
+
+  inline void set_bytes_processed(uint64_t bytes) {
+    this->bytes_processed_ = bytes;
+  }
+
+  inline void set_items_processed(uint64_t items) {
+    this->items_processed_ = items;
+  }
+
+  //! Abort the benchmark: the loop ends and ``msg`` is reported
+  void skip_with_error(const std::string& msg);
+
+  inline bool error_occurred() const {
+    return this->error_;
+  }
+
+  private:
+  friend class Runner;
+  void start();
+  void finish();
+
+  using clock_t = std::chrono::steady_clock;
+
+  uint64_t    max_iterations_  = 0;
+  int64_t     arg_             = 0;
+  bool        running_         = false;
+  bool        error_           = false;
+  std::string error_msg_;
+
+  uint64_t    bytes_processed_ = 0;
+  uint64_t    items_processed_ = 0;
+
+  clock_t::time_point   real_start_;
+  double                real_time_ = 0; // seconds
+  std::clock_t          cpu_start_ = 0;
+  double                cpu_time_  = 0; // seconds
+};
+
+using function_t = std::function<void(State&)>;
+
+//! Register ``func`` as ``name/<arg>`` for each argument of ``args``
+void register_benchmark(const std::string& name, function_t func, std::vector<int64_t> args);
+
+struct registrar {
+  registrar(const std::string& name, function_t func, std::vector<int64_t> args) {
+    register_benchmark(name, std::move(func), std::move(args));
+  }
+};
+
+//! Prevent the compiler from optimizing out the computation of ``value``
+template<class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+//! Output stream that discards (and counts) the bytes written
+class null_ostream : public std::ostream {
+  public:
+  null_ostream() :
+    std::ostream{&buffer_}
+  {}
+
+  inline uint64_t count() const {
+    return this->buffer_.count;
+  }
+
+  private:
+  struct buffer_t : public std::streambuf {
+    uint64_t count = 0;
+
+    int_type overflow(int_type c) override {
+      ++this->count;
+      return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+      this->count += n;
+      return n;
+    }
+  };
+  buffer_t buffer_;
+};
+
+//! Path of a scratch file in the temporary directory
+std::string tmp_file(const std::string& suffix);
+
+}
+
+#define LIEF_BENCH_CONCAT_(A, B) A##B
+#define LIEF_BENCH_CONCAT(A, B)  LIEF_BENCH_CONCAT_(A, B)
+
+#define LIEF_BENCHMARK(NAME, FUNC, ...)                                  \
+  static ::lief_bench::registrar LIEF_BENCH_CONCAT(bench_, __LINE__) {  \
+    NAME, FUNC, __VA_ARGS__                                              \
+  }
+
+#endif
@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Description
+# -----------
+# Compare two results of lief_bench --format=json (e.g. before/after a commit)
+# and exit with a non-zero status if a benchmark is slower than the threshold
+#
+# usage: compare.py baseline.json contender.json [--threshold 5] [--metric real_time]
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, "r") as f:
+        data = json.load(f)
+
+    results = {}
+    for bench in data["benchmarks"]:
+        if bench.get("error_occurred", False):
+            continue
+        # Compare the median of the repetitions when there are some
+        run_type = bench.get("run_type", "iteration")
+        if run_type == "aggregate" and bench.get("aggregate_name") != "median":
+            continue
+        name = bench.get("run_name", bench["name"])
+        if run_type == "iteration" and name in results:
+            continue
+        results[name] = bench
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="Regression threshold in percent (default: %(default)s)")
+    parser.add_argument("--metric", default="real_time",
+                        choices=["real_time", "cpu_time", "peak_rss"])
+    args = parser.parse_args()
+
+    baseline  = load(args.baseline)
+    contender = load(args.contender)
+
+    regressions = []
+    print("{:<32} {:>16} {:>16} {:>9}".format("Benchmark", "Baseline", "Contender", "Delta"))
+    for name in sorted(baseline.keys()):
+        if name not in contender:
+            continue
+        old = baseline[name].get(args.metric, 0)
+        new = contender[name].get(args.metric, 0)
+        if old == 0:
+            continue
+        delta = 100.0 * (new - old) / old
+        flag = ""
+        if delta > args.threshold:
+            flag = " <--"
+            regressions.append(name)
+        print("{:<32} {:>16.0f} {:>16.0f} {:>+8.1f}%{}".format(name, old, new, delta, flag))
+
+    missing = sorted(set(baseline.keys()) - set(contender.keys()))
+    for name in missing:
+        print("{:<32} missing in {}".format(name, args.contender))
+
+    if len(regressions) > 0:
+        print("\n{:d} regression(s) above {:.1f}%".format(len(regressions), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
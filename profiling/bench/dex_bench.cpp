@@ -0,0 +1,88 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+
+#include <LIEF/DEX.hpp>
+#include <LIEF/hash.hpp>
+#include <LIEF/to_json.hpp>
+
+#include "bench.hpp"
+#include "generators.hpp"
+
+using namespace lief_bench;
+
+// The argument is the number of classes defined in the file
+static const std::vector<uint8_t>& input(int64_t n) {
+  static std::map<int64_t, std::vector<uint8_t>> cache;
+  auto it = cache.find(n);
+  if (it == std::end(cache)) {
+    dex_config_t config;
+    config.nb_classes = n;
+    it = cache.emplace(n, generate_dex(config)).first;
+  }
+  return it->second;
+}
+
+static void dex_parse(State& state) {
+  const std::vector<uint8_t>& raw = input(state.range());
+  for (auto _ : state) {
+    std::unique_ptr<LIEF::DEX::File> file = LIEF::DEX::Parser::parse(raw);
+    do_not_optimize(file);
+  }
+  state.set_bytes_processed(state.iterations() * raw.size());
+}
+
+static void dex_hash(State& state) {
+  std::unique_ptr<LIEF::DEX::File> file = LIEF::DEX::Parser::parse(input(state.range()));
+  for (auto _ : state) {
+    do_not_optimize(LIEF::hash(*file));
+  }
+  state.set_items_processed(state.iterations());
+}
+
+#if defined(LIEF_JSON_SUPPORT)
+static void dex_json(State& state) {
+  std::unique_ptr<LIEF::DEX::File> file = LIEF::DEX::Parser::parse(input(state.range()));
+  null_ostream os;
+  for (auto _ : state) {
+    LIEF::to_json(*file, os);
+  }
+  state.set_bytes_processed(os.count());
+}
+#endif
+
+static void dex_search(State& state) {
+  const size_t nb_classes = state.range();
+  std::unique_ptr<LIEF::DEX::File> file = LIEF::DEX::Parser::parse(input(nb_classes));
+  std::vector<std::string> names;
+  names.reserve(nb_classes);
+  for (size_t i = 0; i < nb_classes; ++i) {
+    names.push_back(class_name((i * 7919) % nb_classes));
+  }
+  for (auto _ : state) {
+    for (const std::string& name : names) {
+      do_not_optimize(file->has_class(name));
+    }
+  }
+  state.set_items_processed(state.iterations() * names.size());
+}
+
+LIEF_BENCHMARK("DEX/parse",  dex_parse,  {1 << 10, 1 << 14});
+LIEF_BENCHMARK("DEX/hash",   dex_hash,   {1 << 10, 1 << 14});
+#if defined(LIEF_JSON_SUPPORT)
+LIEF_BENCHMARK("DEX/json",   dex_json,   {1 << 10, 1 << 14});
+#endif
+LIEF_BENCHMARK("DEX/search", dex_search, {1 << 10, 1 << 14});
@@ -0,0 +1,121 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <map>
+
+#include <LIEF/ELF.hpp>
+#include <LIEF/hash.hpp>
+#include <LIEF/to_json.hpp>
+
+#include "bench.hpp"
+#include "generators.hpp"
+
+using namespace lief_bench;
+
+// The argument is the number of symbols and relocations
+static const std::vector<uint8_t>& input(int64_t n) {
+  static std::map<int64_t, std::vector<uint8_t>> cache;
+  auto it = cache.find(n);
+  if (it == std::end(cache)) {
+    elf_config_t config;
+    config.nb_symbols     = n;
+    config.nb_relocations = n;
+    config.nb_sections    = n / 100;
+    it = cache.emplace(n, generate_elf(config)).first;
+  }
+  return it->second;
+}
+
+static void elf_parse(State& state) {
+  const std::vector<uint8_t>& raw = input(state.range());
+  for (auto _ : state) {
+    std::unique_ptr<LIEF::ELF::Binary> binary = LIEF::ELF::Parser::parse(raw);
+    do_not_optimize(binary);
+  }
+  state.set_bytes_processed(state.iterations() * raw.size());
+}
+
+static void elf_build(State& state) {
+  const std::vector<uint8_t>& raw = input(state.range());
+  for (auto _ : state) {
+    state.pause_timing();
+    std::unique_ptr<LIEF::ELF::Binary> binary = LIEF::ELF::Parser::parse(raw);
+    state.resume_timing();
+
+    LIEF::ELF::Builder builder{*binary};
+    builder.build();
+    do_not_optimize(builder.get_build());
+  }
+  state.set_bytes_processed(state.iterations() * raw.size());
+}
+
+static void elf_write(State& state) {
+  const std::vector<uint8_t>& raw = input(state.range());
+  const std::string output = tmp_file(".so");
+  for (auto _ : state) {
+    state.pause_timing();
+    std::unique_ptr<LIEF::ELF::Binary> binary = LIEF::ELF::Parser::parse(raw);
+    state.resume_timing();
+
+    binary->write(output);
+  }
+  std::remove(output.c_str());
+  state.set_bytes_processed(state.iterations() * raw.size());
+}
+
+static void elf_hash(State& state) {
+  std::unique_ptr<LIEF::ELF::Binary> binary = LIEF::ELF::Parser::parse(input(state.range()));
+  for (auto _ : state) {
+    do_not_optimize(LIEF::hash(*binary));
+  }
+  state.set_items_processed(state.iterations());
+}
+
+#if defined(LIEF_JSON_SUPPORT)
+static void elf_json(State& state) {
+  std::unique_ptr<LIEF::ELF::Binary> binary = LIEF::ELF::Parser::parse(input(state.range()));
+  null_ostream os;
+  for (auto _ : state) {
+    LIEF::to_json(*binary, os);
+  }
+  state.set_bytes_processed(os.count());
+}
+#endif
+
+static void elf_search(State& state) {
+  const size_t nb_symbols = state.range();
+  std::unique_ptr<LIEF::ELF::Binary> binary = LIEF::ELF::Parser::parse(input(nb_symbols));
+  std::vector<std::string> names;
+  names.reserve(nb_symbols);
+  for (size_t i = 0; i < nb_symbols; ++i) {
+    names.push_back(symbol_name((i * 7919) % nb_symbols));
+  }
+  for (auto _ : state) {
+    for (const std::string& name : names) {
+      do_not_optimize(binary->get_dynamic_symbol(name));
+    }
+  }
+  state.set_items_processed(state.iterations() * names.size());
+}
+
+LIEF_BENCHMARK("ELF/parse",  elf_parse,  {1 << 10, 1 << 14, 1 << 17});
+LIEF_BENCHMARK("ELF/build",  elf_build,  {1 << 10, 1 << 14});
+LIEF_BENCHMARK("ELF/write",  elf_write,  {1 << 10, 1 << 14});
+LIEF_BENCHMARK("ELF/hash",   elf_hash,   {1 << 10, 1 << 14});
+#if defined(LIEF_JSON_SUPPORT)
+LIEF_BENCHMARK("ELF/json",   elf_json,   {1 << 10, 1 << 14});
+#endif
+LIEF_BENCHMARK("ELF/search", elf_search, {1 << 10, 1 << 14});
@@ -0,0 +1,111 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <cmath>
+#include <map>
+#include <random>
+
+#include <LIEF/entropy.hpp>
+
+#include "bench.hpp"
+
+using namespace lief_bench;
+
+// Compare LIEF::entropy with the previous implementation of Section::entropy()
+// (single histogram table) on random, low-entropy and zero-filled buffers.
+// The argument is the size of the buffer.
+
+enum class content_t {
+  RANDOM, TEXT, ZEROS,
+};
+
+static const std::vector<uint8_t>& input(content_t content, int64_t size) {
+  static std::map<std::pair<content_t, int64_t>, std::vector<uint8_t>> cache;
+  auto it = cache.find({content, size});
+  if (it == std::end(cache)) {
+    std::mt19937 rng{0};
+    std::vector<uint8_t> data(size, 0);
+    for (uint8_t& x : data) {
+      if (content == content_t::RANDOM) {
+        x = static_cast<uint8_t>(rng());
+      } else if (content == content_t::TEXT) {
+        x = static_cast<uint8_t>('a' + rng() % 26);
+      }
+    }
+    it = cache.emplace(std::make_pair(content, size), std::move(data)).first;
+  }
+  return it->second;
+}
+
+static double reference_entropy(const std::vector<uint8_t>& content) {
+  std::array<uint64_t, 256> frequencies = { {0} };
+  for (uint8_t x : content) {
+    frequencies[x]++;
+  }
+
+  double entropy = 0.0;
+  for (uint64_t p : frequencies) {
+    if (p > 0) {
+      double freq = static_cast<double>(p) / static_cast<double>(content.size());
+      entropy += freq * std::log2l(freq);
+    }
+  }
+  return (-entropy);
+}
+
+template<content_t C>
+static void entropy_reference(State& state) {
+  const std::vector<uint8_t>& data = input(C, state.range());
+  for (auto _ : state) {
+    do_not_optimize(reference_entropy(data));
+  }
+  state.set_bytes_processed(state.iterations() * data.size());
+}
+
+template<content_t C, size_t NB_THREADS>
+static void entropy(State& state) {
+  const std::vector<uint8_t>& data = input(C, state.range());
+  if (std::fabs(LIEF::entropy(data, NB_THREADS) - reference_entropy(data)) > 1e-6) {
+    state.skip_with_error("The entropy doesn't match the reference");
+  }
+  for (auto _ : state) {
+    do_not_optimize(LIEF::entropy(data, NB_THREADS));
+  }
+  state.set_bytes_processed(state.iterations() * data.size());
+}
+
+template<content_t C>
+static void entropy_curve(State& state) {
+  const std::vector<uint8_t>& data = input(C, state.range());
+  for (auto _ : state) {
+    do_not_optimize(LIEF::entropy_curve(data, 4096, 512).back());
+  }
+  state.set_bytes_processed(state.iterations() * data.size());
+}
+
+// 0 threads: as many threads as the hardware supports
+LIEF_BENCHMARK("entropy/reference/random", entropy_reference<content_t::RANDOM>, {1 << 20, 1 << 26});
+LIEF_BENCHMARK("entropy/single/random",    (entropy<content_t::RANDOM, 1>),     {1 << 20, 1 << 26});
+LIEF_BENCHMARK("entropy/parallel/random",  (entropy<content_t::RANDOM, 0>),     {1 << 20, 1 << 26});
+LIEF_BENCHMARK("entropy/curve/random",     entropy_curve<content_t::RANDOM>,     {1 << 20, 1 << 26});
+
+LIEF_BENCHMARK("entropy/reference/text",   entropy_reference<content_t::TEXT>,   {1 << 20, 1 << 26});
+LIEF_BENCHMARK("entropy/single/text",      (entropy<content_t::TEXT, 1>),       {1 << 20, 1 << 26});
+LIEF_BENCHMARK("entropy/parallel/text",    (entropy<content_t::TEXT, 0>),       {1 << 20, 1 << 26});
+
+LIEF_BENCHMARK("entropy/reference/zeros",  entropy_reference<content_t::ZEROS>,  {1 << 20, 1 << 26});
+LIEF_BENCHMARK("entropy/single/zeros",     (entropy<content_t::ZEROS, 1>),      {1 << 20, 1 << 26});
+LIEF_BENCHMARK("entropy/parallel/zeros",   (entropy<content_t::ZEROS, 0>),      {1 << 20, 1 << 26});
@@ -0,0 +1,920 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <numeric>
+
+#include "generators.hpp"
+
+// The structures are written field by field in little-endian (i.e. the generators
+// assume a little-endian host as LIEF does)
+
+namespace lief_bench {
+
+namespace {
+
+class writer_t {
+  public:
+  template<class T>
+  void write(size_t offset, T value) {
+    this->reserve(offset + sizeof(T));
+    std::memcpy(this->data_.data() + offset, &value, sizeof(T));
+  }
+
+  void write(size_t offset, const void* data, size_t size) {
+    this->reserve(offset + size);
+    std::memcpy(this->data_.data() + offset, data, size);
+  }
+
+  void write(size_t offset, const std::string& str) {
+    this->write(offset, str.c_str(), str.size() + 1);
+  }
+
+  void fill(size_t offset, size_t size, uint8_t value) {
+    this->reserve(offset + size);
+    std::fill_n(this->data_.begin() + offset, size, value);
+  }
+
+  void reserve(size_t size) {
+    if (this->data_.size() < size) {
+      this->data_.resize(size, 0);
+    }
+  }
+
+  size_t size() const {
+    return this->data_.size();
+  }
+
+  std::vector<uint8_t> release() {
+    return std::move(this->data_);
+  }
+
+  private:
+  std::vector<uint8_t> data_;
+};
+
+size_t align(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t uleb128_size(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+void write_uleb128(std::vector<uint8_t>& out, uint64_t value) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) {
+      byte |= 0x80;
+    }
+    out.push_back(byte);
+  } while (value != 0);
+}
+
+//! Table of NUL-terminated strings (the first string is the empty string)
+class string_table_t {
+  public:
+  string_table_t() :
+    raw_(1, 0)
+  {}
+
+  uint32_t add(const std::string& str) {
+    const uint32_t offset = this->raw_.size();
+    this->raw_.insert(std::end(this->raw_), std::begin(str), std::end(str));
+    this->raw_.push_back(0);
+    return offset;
+  }
+
+  const std::vector<uint8_t>& raw() const {
+    return this->raw_;
+  }
+
+  private:
+  std::vector<uint8_t> raw_;
+};
+
+}
+
+std::string symbol_name(size_t idx) {
+  const std::string ns = "ns"       + std::to_string(idx % 16);
+  const std::string fn = "function" + std::to_string(idx);
+  return "_ZN4lief5bench" + std::to_string(ns.size()) + ns + std::to_string(fn.size()) + fn + "Ev";
+}
+
+std::string class_name(size_t idx) {
+  return "Lcom/lief/bench/p" + std::to_string(idx % 32) + "/Class" + std::to_string(idx) + ";";
+}
+
+
+// ELF
+// ===
+std::vector<uint8_t> generate_elf(const elf_config_t& config) {
+  static constexpr size_t EHDR_SIZE = 64;
+  static constexpr size_t PHDR_SIZE = 56;
+  static constexpr size_t SHDR_SIZE = 64;
+  static constexpr size_t SYM_SIZE  = 24;
+  static constexpr size_t RELA_SIZE = 24;
+  static constexpr size_t DYN_SIZE  = 16;
+  static constexpr size_t NB_PHDRS  = 3;
+  static constexpr size_t FUNC_SIZE = 16;
+  static constexpr size_t PAGE_SIZE = 0x1000;
+
+  const size_t nb_symbols = config.nb_symbols;
+  const size_t nb_dynsym  = nb_symbols + 1;
+
+  string_table_t dynstr;
+  const uint32_t soname = dynstr.add("libbench.so");
+  std::vector<uint32_t> names;
+  names.reserve(nb_symbols);
+  for (size_t i = 0; i < nb_symbols; ++i) {
+    names.push_back(dynstr.add(symbol_name(i)));
+  }
+
+  // SYSV hash table
+  auto&& elf_hash = [] (const std::string& name) {
+    uint32_t h = 0;
+    for (unsigned char c : name) {
+      h = (h << 4) + c;
+      const uint32_t g = h & 0xf0000000;
+      if (g != 0) {
+        h ^= g >> 24;
+      }
+      h &= ~g;
+    }
+    return h;
+  };
+  const uint32_t nbucket = nb_symbols / 4 + 1;
+  std::vector<uint32_t> buckets(nbucket, 0);
+  std::vector<uint32_t> chains(nb_dynsym, 0);
+  for (size_t i = 1; i < nb_dynsym; ++i) {
+    const uint32_t h = elf_hash(symbol_name(i - 1)) % nbucket;
+    chains[i]  = buckets[h];
+    buckets[h] = i;
+  }
+
+  // Layout
+  const size_t hash_off    = align(EHDR_SIZE + NB_PHDRS * PHDR_SIZE, 8);
+  const size_t hash_size   = (2 + nbucket + nb_dynsym) * sizeof(uint32_t);
+  const size_t dynsym_off  = align(hash_off + hash_size, 8);
+  const size_t dynsym_size = nb_dynsym * SYM_SIZE;
+  const size_t dynstr_off  = dynsym_off + dynsym_size;
+  const size_t dynstr_size = dynstr.raw().size();
+  const size_t rela_off    = align(dynstr_off + dynstr_size, 8);
+  const size_t rela_size   = config.nb_relocations * RELA_SIZE;
+  const size_t text_off    = align(rela_off + rela_size, 16);
+  const size_t text_size   = std::max<size_t>(nb_symbols, 1) * FUNC_SIZE;
+  const size_t extra_off   = text_off + text_size;
+  const size_t rx_end      = extra_off + config.nb_sections * FUNC_SIZE;
+
+  const size_t dynamic_off  = align(rx_end, PAGE_SIZE);
+  const size_t nb_dynamic   = 10;
+  const size_t dynamic_size = nb_dynamic * DYN_SIZE;
+  const size_t data_off     = dynamic_off + dynamic_size;
+  const size_t data_size    = std::max<size_t>(config.nb_relocations, 1) * sizeof(uint64_t);
+  const size_t rw_end       = data_off + data_size;
+
+  // Sections: null, .hash, .dynsym, .dynstr, .rela.dyn, .text, .text.<i>, .dynamic, .data, .shstrtab
+  string_table_t shstrtab;
+  struct section_t {
+    uint32_t name;
+    uint32_t type;
+    uint64_t flags;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t link;
+    uint32_t info;
+    uint64_t align;
+    uint64_t entsize;
+  };
+  enum : uint32_t {SHT_PROGBITS = 1, SHT_STRTAB = 3, SHT_RELA = 4, SHT_HASH = 5, SHT_DYNAMIC = 6, SHT_DYNSYM = 11};
+  enum : uint64_t {SHF_WRITE = 1, SHF_ALLOC = 2, SHF_EXECINSTR = 4};
+  const uint32_t DYNSYM_IDX = 2;
+  const uint32_t DYNSTR_IDX = 3;
+  const uint32_t TEXT_IDX   = 5;
+
+  std::vector<section_t> sections;
+  sections.push_back({0, 0, 0, 0, 0, 0, 0, 0, 0});
+  sections.push_back({shstrtab.add(".hash"),     SHT_HASH,   SHF_ALLOC, hash_off,   hash_size,   DYNSYM_IDX, 0, 8, 4});
+  sections.push_back({shstrtab.add(".dynsym"),   SHT_DYNSYM, SHF_ALLOC, dynsym_off, dynsym_size, DYNSTR_IDX, 1, 8, SYM_SIZE});
+  sections.push_back({shstrtab.add(".dynstr"),   SHT_STRTAB, SHF_ALLOC, dynstr_off, dynstr_size, 0,          0, 1, 0});
+  sections.push_back({shstrtab.add(".rela.dyn"), SHT_RELA,   SHF_ALLOC, rela_off,   rela_size,   DYNSYM_IDX, 0, 8, RELA_SIZE});
+  sections.push_back({shstrtab.add(".text"),     SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, text_off, text_size, 0, 0, 16, 0});
+  for (size_t i = 0; i < config.nb_sections; ++i) {
+    sections.push_back({shstrtab.add(".text." + std::to_string(i)), SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR,
+                        extra_off + i * FUNC_SIZE, FUNC_SIZE, 0, 0, 16, 0});
+  }
+  sections.push_back({shstrtab.add(".dynamic"),  SHT_DYNAMIC,  SHF_ALLOC | SHF_WRITE, dynamic_off, dynamic_size, DYNSTR_IDX, 0, 8, DYN_SIZE});
+  sections.push_back({shstrtab.add(".data"),     SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, data_off,    data_size,    0,          0, 8, 0});
+  const uint32_t shstrtab_name = shstrtab.add(".shstrtab");
+  const size_t shstrtab_off = rw_end;
+  sections.push_back({shstrtab_name, SHT_STRTAB, 0, shstrtab_off, shstrtab.raw().size(), 0, 0, 1, 0});
+  const size_t shdr_off = align(shstrtab_off + shstrtab.raw().size(), 8);
+
+  writer_t w;
+  w.reserve(shdr_off + sections.size() * SHDR_SIZE);
+
+  // Header
+  static const uint8_t IDENT[] = {0x7f, 'E', 'L', 'F', /* ELFCLASS64 */ 2, /* ELFDATA2LSB */ 1, /* EV_CURRENT */ 1};
+  w.write(0, IDENT, sizeof(IDENT));
+  w.write<uint16_t>(16, /* ET_DYN */ 3);
+  w.write<uint16_t>(18, /* EM_X86_64 */ 62);
+  w.write<uint32_t>(20, 1);
+  w.write<uint64_t>(24, text_off);
+  w.write<uint64_t>(32, EHDR_SIZE);
+  w.write<uint64_t>(40, shdr_off);
+  w.write<uint32_t>(48, 0);
+  w.write<uint16_t>(52, EHDR_SIZE);
+  w.write<uint16_t>(54, PHDR_SIZE);
+  w.write<uint16_t>(56, NB_PHDRS);
+  w.write<uint16_t>(58, SHDR_SIZE);
+  w.write<uint16_t>(60, sections.size());
+  w.write<uint16_t>(62, sections.size() - 1);
+
+  // Segments (the virtual addresses match the offsets)
+  auto&& write_phdr = [&w] (size_t idx, uint32_t type, uint32_t flags, uint64_t offset, uint64_t size, uint64_t alignment) {
+    const size_t off = EHDR_SIZE + idx * PHDR_SIZE;
+    w.write<uint32_t>(off +  0, type);
+    w.write<uint32_t>(off +  4, flags);
+    w.write<uint64_t>(off +  8, offset);
+    w.write<uint64_t>(off + 16, offset);
+    w.write<uint64_t>(off + 24, offset);
+    w.write<uint64_t>(off + 32, size);
+    w.write<uint64_t>(off + 40, size);
+    w.write<uint64_t>(off + 48, alignment);
+  };
+  write_phdr(0, /* PT_LOAD */ 1,    /* R+X */ 5, 0,           rx_end,                 PAGE_SIZE);
+  write_phdr(1, /* PT_LOAD */ 1,    /* R+W */ 6, dynamic_off, rw_end - dynamic_off,   PAGE_SIZE);
+  write_phdr(2, /* PT_DYNAMIC */ 2, /* R+W */ 6, dynamic_off, dynamic_size,           8);
+
+  // .hash
+  w.write<uint32_t>(hash_off,     nbucket);
+  w.write<uint32_t>(hash_off + 4, nb_dynsym);
+  w.write(hash_off + 8, buckets.data(), buckets.size() * sizeof(uint32_t));
+  w.write(hash_off + 8 + buckets.size() * sizeof(uint32_t), chains.data(), chains.size() * sizeof(uint32_t));
+
+  // .dynsym
+  for (size_t i = 0; i < nb_symbols; ++i) {
+    const size_t off = dynsym_off + (i + 1) * SYM_SIZE;
+    w.write<uint32_t>(off +  0, names[i]);
+    w.write<uint8_t> (off +  4, /* STB_GLOBAL | STT_FUNC */ 0x12);
+    w.write<uint8_t> (off +  5, 0);
+    w.write<uint16_t>(off +  6, TEXT_IDX);
+    w.write<uint64_t>(off +  8, text_off + i * FUNC_SIZE);
+    w.write<uint64_t>(off + 16, FUNC_SIZE);
+  }
+
+  // .dynstr
+  w.write(dynstr_off, dynstr.raw().data(), dynstr_size);
+
+  // .rela.dyn
+  for (size_t i = 0; i < config.nb_relocations; ++i) {
+    const size_t off = rela_off + i * RELA_SIZE;
+    const uint64_t info = nb_symbols > 0 ?
+                          ((i % nb_symbols + 1) << 32) | /* R_X86_64_64 */ 1 :
+                          /* R_X86_64_RELATIVE */ 8;
+    w.write<uint64_t>(off +  0, data_off + i * sizeof(uint64_t));
+    w.write<uint64_t>(off +  8, info);
+    w.write<int64_t> (off + 16, 0);
+  }
+
+  // .text: ret
+  w.fill(text_off, rx_end - text_off, 0xc3);
+
+  // .dynamic
+  const std::pair<int64_t, uint64_t> dynamic[nb_dynamic] = {
+    {/* DT_SONAME   */ 14, soname},
+    {/* DT_HASH     */ 4,  hash_off},
+    {/* DT_STRTAB   */ 5,  dynstr_off},
+    {/* DT_SYMTAB   */ 6,  dynsym_off},
+    {/* DT_STRSZ    */ 10, dynstr_size},
+    {/* DT_SYMENT   */ 11, SYM_SIZE},
+    {/* DT_RELA     */ 7,  rela_off},
+    {/* DT_RELASZ   */ 8,  rela_size},
+    {/* DT_RELAENT  */ 9,  RELA_SIZE},
+    {/* DT_NULL     */ 0,  0},
+  };
+  for (size_t i = 0; i < nb_dynamic; ++i) {
+    w.write<int64_t> (dynamic_off + i * DYN_SIZE,     dynamic[i].first);
+    w.write<uint64_t>(dynamic_off + i * DYN_SIZE + 8, dynamic[i].second);
+  }
+
+  // .shstrtab and section headers
+  w.write(shstrtab_off, shstrtab.raw().data(), shstrtab.raw().size());
+  for (size_t i = 0; i < sections.size(); ++i) {
+    const section_t& s = sections[i];
+    const size_t off = shdr_off + i * SHDR_SIZE;
+    const bool alloc = (s.flags & SHF_ALLOC) != 0;
+    w.write<uint32_t>(off +  0, s.name);
+    w.write<uint32_t>(off +  4, s.type);
+    w.write<uint64_t>(off +  8, s.flags);
+    w.write<uint64_t>(off + 16, alloc ? s.offset : 0);
+    w.write<uint64_t>(off + 24, s.offset);
+    w.write<uint64_t>(off + 32, s.size);
+    w.write<uint32_t>(off + 40, s.link);
+    w.write<uint32_t>(off + 44, s.info);
+    w.write<uint64_t>(off + 48, s.align);
+    w.write<uint64_t>(off + 56, s.entsize);
+  }
+  return w.release();
+}
+
+
+// PE
+// ==
+std::vector<uint8_t> generate_pe(const pe_config_t& config) {
+  static constexpr size_t   FILE_ALIGN      = 0x200;
+  static constexpr size_t   SECTION_ALIGN   = 0x1000;
+  static constexpr size_t   PE_OFF          = 0x40;
+  static constexpr size_t   OPT_HDR_OFF     = PE_OFF + 4 + 20;
+  static constexpr size_t   OPT_HDR_SIZE    = 240;
+  static constexpr size_t   SECTIONS_OFF    = OPT_HDR_OFF + OPT_HDR_SIZE;
+  static constexpr size_t   NB_SECTIONS     = 3;
+  static constexpr size_t   FUNCS_PER_DLL   = 64;
+  static constexpr uint64_t IMAGE_BASE      = 0x180000000;
+  static constexpr uint32_t RT_RCDATA       = 10;
+
+  const size_t nb_imports   = config.nb_imports;
+  const size_t nb_dlls      = (nb_imports + FUNCS_PER_DLL - 1) / FUNCS_PER_DLL;
+  const size_t nb_resources = std::min<size_t>(config.nb_resources, 0xffff);
+
+  // .idata: descriptors, ILTs, IATs, hint/name entries and DLL names
+  std::vector<uint8_t> idata;
+  const uint32_t idata_rva = 2 * SECTION_ALIGN;
+  const size_t descriptors_size = (nb_dlls + 1) * 20;
+  const size_t thunks_size      = (nb_imports + nb_dlls) * sizeof(uint64_t);
+  const size_t ilt_off  = descriptors_size;
+  const size_t iat_off  = ilt_off + thunks_size;
+  size_t       data_off = iat_off + thunks_size;
+  writer_t iw;
+  for (size_t dll = 0, func = 0, thunk = 0; dll < nb_dlls; ++dll, ++thunk) {
+    const size_t first_thunk = thunk;
+    for (size_t i = 0; i < FUNCS_PER_DLL and func < nb_imports; ++i, ++func, ++thunk) {
+      // Hint/Name entry
+      const std::string name = "Function" + std::to_string(func);
+      iw.write<uint16_t>(data_off, i);
+      iw.write(data_off + 2, name);
+      iw.write<uint64_t>(ilt_off + thunk * sizeof(uint64_t), idata_rva + data_off);
+      iw.write<uint64_t>(iat_off + thunk * sizeof(uint64_t), idata_rva + data_off);
+      data_off = align(data_off + 2 + name.size() + 1, 2);
+    }
+    const std::string dll_name = "library" + std::to_string(dll) + ".dll";
+    iw.write(data_off, dll_name);
+
+    const size_t desc = dll * 20;
+    iw.write<uint32_t>(desc +  0, idata_rva + ilt_off + first_thunk * sizeof(uint64_t));
+    iw.write<uint32_t>(desc + 12, idata_rva + data_off);
+    iw.write<uint32_t>(desc + 16, idata_rva + iat_off + first_thunk * sizeof(uint64_t));
+    data_off = align(data_off + dll_name.size() + 1, 2);
+  }
+  iw.reserve(std::max<size_t>(data_off, descriptors_size));
+  idata = iw.release();
+
+  // .rsrc: RT_RCDATA -> <id> -> 0x409 -> data
+  static constexpr size_t DIR_SIZE   = 16;
+  static constexpr size_t ENTRY_SIZE = 8;
+  static constexpr size_t DATA_SIZE  = 16;
+  static constexpr uint32_t SUBDIR   = 0x80000000;
+  const uint32_t rsrc_rva = align(idata_rva + idata.size(), SECTION_ALIGN);
+  const size_t type_dir_off  = DIR_SIZE + ENTRY_SIZE;
+  const size_t lang_dirs_off = type_dir_off + DIR_SIZE + nb_resources * ENTRY_SIZE;
+  const size_t entries_off   = lang_dirs_off + nb_resources * (DIR_SIZE + ENTRY_SIZE);
+  const size_t blobs_off     = entries_off + nb_resources * DATA_SIZE;
+  writer_t rw;
+  auto&& write_dir = [&rw] (size_t offset, uint16_t nb_ids) {
+    rw.write<uint16_t>(offset + 14, nb_ids);
+  };
+  write_dir(0, 1);
+  rw.write<uint32_t>(DIR_SIZE,     RT_RCDATA);
+  rw.write<uint32_t>(DIR_SIZE + 4, SUBDIR | type_dir_off);
+  write_dir(type_dir_off, nb_resources);
+  for (size_t i = 0; i < nb_resources; ++i) {
+    const size_t lang_dir = lang_dirs_off + i * (DIR_SIZE + ENTRY_SIZE);
+    const size_t entry    = entries_off   + i * DATA_SIZE;
+    const size_t blob     = blobs_off     + i * DATA_SIZE;
+    rw.write<uint32_t>(type_dir_off + DIR_SIZE + i * ENTRY_SIZE,     i + 1);
+    rw.write<uint32_t>(type_dir_off + DIR_SIZE + i * ENTRY_SIZE + 4, SUBDIR | lang_dir);
+
+    write_dir(lang_dir, 1);
+    rw.write<uint32_t>(lang_dir + DIR_SIZE,     /* en-US */ 0x409);
+    rw.write<uint32_t>(lang_dir + DIR_SIZE + 4, entry);
+
+    rw.write<uint32_t>(entry,     rsrc_rva + blob);
+    rw.write<uint32_t>(entry + 4, DATA_SIZE);
+    rw.fill(blob, DATA_SIZE, static_cast<uint8_t>(i));
+  }
+  rw.reserve(blobs_off + nb_resources * DATA_SIZE);
+  const std::vector<uint8_t> rsrc = rw.release();
+
+  struct section_t {
+    const char* name;
+    uint32_t    rva;
+    uint32_t    vsize;
+    uint32_t    offset;
+    uint32_t    size;
+    uint32_t    characteristics;
+  };
+  const uint32_t headers_size = align(SECTIONS_OFF + NB_SECTIONS * 40, FILE_ALIGN);
+  const uint32_t idata_off    = headers_size + FILE_ALIGN;
+  const uint32_t rsrc_off     = idata_off + align(idata.size(), FILE_ALIGN);
+  const section_t sections[NB_SECTIONS] = {
+    {".text",  SECTION_ALIGN, 0x10,                      headers_size, FILE_ALIGN,                       0x60000020},
+    {".idata", idata_rva,     static_cast<uint32_t>(idata.size()), idata_off, static_cast<uint32_t>(align(idata.size(), FILE_ALIGN)), 0xc0000040},
+    {".rsrc",  rsrc_rva,      static_cast<uint32_t>(rsrc.size()),  rsrc_off,  static_cast<uint32_t>(align(rsrc.size(), FILE_ALIGN)),  0x40000040},
+  };
+  const uint32_t image_size = align(rsrc_rva + rsrc.size(), SECTION_ALIGN);
+
+  writer_t w;
+  w.reserve(rsrc_off + sections[2].size);
+
+  // DOS header
+  w.write<uint16_t>(0, 0x5a4d);
+  w.write<uint32_t>(0x3c, PE_OFF);
+
+  // PE header
+  w.write<uint32_t>(PE_OFF, 0x00004550);
+  w.write<uint16_t>(PE_OFF +  4, /* AMD64 */ 0x8664);
+  w.write<uint16_t>(PE_OFF +  6, NB_SECTIONS);
+  w.write<uint16_t>(PE_OFF + 20, OPT_HDR_SIZE);
+  w.write<uint16_t>(PE_OFF + 22, /* EXECUTABLE_IMAGE | LARGE_ADDRESS_AWARE | DLL */ 0x2022);
+
+  // Optional header (PE32+)
+  const size_t o = OPT_HDR_OFF;
+  w.write<uint16_t>(o +   0, 0x20b);
+  w.write<uint32_t>(o +   4, FILE_ALIGN);
+  w.write<uint32_t>(o +   8, sections[1].size + sections[2].size);
+  w.write<uint32_t>(o +  16, SECTION_ALIGN);
+  w.write<uint32_t>(o +  20, SECTION_ALIGN);
+  w.write<uint64_t>(o +  24, IMAGE_BASE);
+  w.write<uint32_t>(o +  32, SECTION_ALIGN);
+  w.write<uint32_t>(o +  36, FILE_ALIGN);
+  w.write<uint16_t>(o +  40, 6);
+  w.write<uint16_t>(o +  48, 6);
+  w.write<uint32_t>(o +  56, image_size);
+  w.write<uint32_t>(o +  60, headers_size);
+  w.write<uint16_t>(o +  68, /* WINDOWS_GUI */ 2);
+  w.write<uint16_t>(o +  70, /* DYNAMIC_BASE | NX_COMPAT */ 0x0140);
+  w.write<uint64_t>(o +  72, 0x100000);
+  w.write<uint64_t>(o +  80, 0x1000);
+  w.write<uint64_t>(o +  88, 0x100000);
+  w.write<uint64_t>(o +  96, 0x1000);
+  w.write<uint32_t>(o + 108, 16);
+
+  // Data directories
+  const size_t dirs = o + 112;
+  w.write<uint32_t>(dirs + 1 * 8,      idata_rva);
+  w.write<uint32_t>(dirs + 1 * 8 + 4,  descriptors_size);
+  w.write<uint32_t>(dirs + 2 * 8,      rsrc_rva);
+  w.write<uint32_t>(dirs + 2 * 8 + 4,  rsrc.size());
+  w.write<uint32_t>(dirs + 12 * 8,     idata_rva + iat_off);
+  w.write<uint32_t>(dirs + 12 * 8 + 4, thunks_size);
+
+  for (size_t i = 0; i < NB_SECTIONS; ++i) {
+    const section_t& s = sections[i];
+    const size_t off = SECTIONS_OFF + i * 40;
+    w.write(off, s.name, std::strlen(s.name));
+    w.write<uint32_t>(off +  8, s.vsize);
+    w.write<uint32_t>(off + 12, s.rva);
+    w.write<uint32_t>(off + 16, s.size);
+    w.write<uint32_t>(off + 20, s.offset);
+    w.write<uint32_t>(off + 36, s.characteristics);
+  }
+
+  w.fill(headers_size, 0x10, 0xc3);
+  w.write(idata_off, idata.data(), idata.size());
+  w.write(rsrc_off,  rsrc.data(),  rsrc.size());
+  return w.release();
+}
+
+
+// Mach-O
+// ======
+namespace {
+
+//! Node of the export trie (radix tree)
+struct trie_node_t {
+  std::vector<std::pair<std::string, std::unique_ptr<trie_node_t>>> children;
+  bool     terminal = false;
+  uint64_t address  = 0;
+  uint32_t offset   = 0;
+
+  void insert(const std::string& name, size_t pos, uint64_t addr) {
+    if (pos == name.size()) {
+      this->terminal = true;
+      this->address  = addr;
+      return;
+    }
+    for (auto& child : this->children) {
+      std::string& edge = child.first;
+      size_t common = 0;
+      while (common < edge.size() and pos + common < name.size() and edge[common] == name[pos + common]) {
+        ++common;
+      }
+      if (common == 0) {
+        continue;
+      }
+      if (common < edge.size()) {
+        // Split the edge
+        std::unique_ptr<trie_node_t> middle{new trie_node_t{}};
+        middle->children.emplace_back(edge.substr(common), std::move(child.second));
+        edge.resize(common);
+        child.second = std::move(middle);
+      }
+      child.second->insert(name, pos + common, addr);
+      return;
+    }
+    std::unique_ptr<trie_node_t> leaf{new trie_node_t{}};
+    leaf->terminal = true;
+    leaf->address  = addr;
+    this->children.emplace_back(name.substr(pos), std::move(leaf));
+  }
+
+  size_t info_size() const {
+    // flags (0) + address
+    return this->terminal ? 1 + uleb128_size(this->address) : 0;
+  }
+
+  size_t size() const {
+    const size_t info = this->info_size();
+    size_t size = uleb128_size(info) + info + 1;
+    for (const auto& child : this->children) {
+      size += child.first.size() + 1 + uleb128_size(child.second->offset);
+    }
+    return size;
+  }
+
+  void nodes(std::vector<trie_node_t*>& out) {
+    out.push_back(this);
+    for (auto& child : this->children) {
+      child.second->nodes(out);
+    }
+  }
+};
+
+std::vector<uint8_t> export_trie(const std::vector<std::pair<std::string, uint64_t>>& exports) {
+  trie_node_t root;
+  for (const auto& exp : exports) {
+    root.insert(exp.first, 0, exp.second);
+  }
+
+  std::vector<trie_node_t*> nodes;
+  root.nodes(nodes);
+
+  // The size of a node depends on the (ULEB128) offsets of its children:
+  // iterate until the offsets are stable (as ld64 does)
+  bool changed = true;
+  size_t trie_size = 0;
+  while (changed) {
+    changed = false;
+    size_t offset = 0;
+    for (trie_node_t* node : nodes) {
+      if (node->offset != offset) {
+        node->offset = offset;
+        changed = true;
+      }
+      offset += node->size();
+    }
+    trie_size = offset;
+  }
+
+  std::vector<uint8_t> out;
+  out.reserve(trie_size);
+  for (trie_node_t* node : nodes) {
+    write_uleb128(out, node->info_size());
+    if (node->terminal) {
+      write_uleb128(out, 0);
+      write_uleb128(out, node->address);
+    }
+    out.push_back(node->children.size());
+    for (const auto& child : node->children) {
+      out.insert(std::end(out), std::begin(child.first), std::end(child.first));
+      out.push_back(0);
+      write_uleb128(out, child.second->offset);
+    }
+  }
+  return out;
+}
+
+}
+
+std::vector<uint8_t> generate_macho(const macho_config_t& config) {
+  static constexpr size_t   HEADER_SIZE   = 32;
+  static constexpr size_t   SEGMENT_SIZE  = 72;
+  static constexpr size_t   SECTION_SIZE  = 80;
+  static constexpr size_t   NLIST_SIZE    = 16;
+  static constexpr size_t   PAGE_SIZE     = 0x1000;
+  static constexpr size_t   FUNC_SIZE     = 4;
+  static constexpr uint64_t TEXT_VMADDR   = 0;
+
+  const size_t nb_exports = config.nb_exports;
+  const std::string install_name = "@rpath/libbench.dylib";
+
+  const size_t id_dylib_size = align(24 + install_name.size() + 1, 8);
+  const size_t cmds_size = (SEGMENT_SIZE + SECTION_SIZE) + SEGMENT_SIZE + id_dylib_size +
+                           /* LC_DYLD_INFO_ONLY */ 48 + /* LC_SYMTAB */ 24 + /* LC_DYSYMTAB */ 80;
+  const size_t nb_cmds = 6;
+
+  const size_t text_off  = align(HEADER_SIZE + cmds_size, 16);
+  const size_t text_size = std::max<size_t>(nb_exports, 1) * FUNC_SIZE;
+  const size_t text_seg_size = align(text_off + text_size, PAGE_SIZE);
+
+  std::vector<std::pair<std::string, uint64_t>> exports;
+  exports.reserve(nb_exports);
+  string_table_t strtab;
+  std::vector<uint32_t> names;
+  names.reserve(nb_exports);
+  for (size_t i = 0; i < nb_exports; ++i) {
+    const std::string name = "_" + symbol_name(i);
+    exports.emplace_back(name, text_off + i * FUNC_SIZE);
+    names.push_back(strtab.add(name));
+  }
+  const std::vector<uint8_t> trie = export_trie(exports);
+
+  // __LINKEDIT: export trie, symbol table, string table
+  const size_t trie_off     = text_seg_size;
+  const size_t symtab_off   = align(trie_off + trie.size(), 8);
+  const size_t strtab_off   = symtab_off + nb_exports * NLIST_SIZE;
+  const size_t strtab_size  = align(strtab.raw().size(), 8);
+  const size_t linkedit_size = strtab_off + strtab_size - trie_off;
+
+  writer_t w;
+  w.reserve(strtab_off + strtab_size);
+
+  w.write<uint32_t>(0,  /* MH_MAGIC_64 */ 0xfeedfacf);
+  w.write<uint32_t>(4,  /* CPU_TYPE_X86_64 */ 0x01000007);
+  w.write<uint32_t>(8,  /* CPU_SUBTYPE_X86_64_ALL */ 3);
+  w.write<uint32_t>(12, /* MH_DYLIB */ 6);
+  w.write<uint32_t>(16, nb_cmds);
+  w.write<uint32_t>(20, cmds_size);
+  w.write<uint32_t>(24, /* MH_NOUNDEFS | MH_DYLDLINK | MH_TWOLEVEL */ 0x85);
+
+  size_t off = HEADER_SIZE;
+  auto&& write_segment = [&w] (size_t off, const char* name, uint64_t vmaddr, uint64_t vmsize,
+                               uint64_t fileoff, uint64_t filesize, uint32_t prot, uint32_t nsects) {
+    w.write<uint32_t>(off, /* LC_SEGMENT_64 */ 0x19);
+    w.write<uint32_t>(off +  4, SEGMENT_SIZE + nsects * SECTION_SIZE);
+    w.write(off + 8, name, std::strlen(name));
+    w.write<uint64_t>(off + 24, vmaddr);
+    w.write<uint64_t>(off + 32, vmsize);
+    w.write<uint64_t>(off + 40, fileoff);
+    w.write<uint64_t>(off + 48, filesize);
+    w.write<uint32_t>(off + 56, prot);
+    w.write<uint32_t>(off + 60, prot);
+    w.write<uint32_t>(off + 64, nsects);
+  };
+
+  // __TEXT,__text
+  write_segment(off, "__TEXT", TEXT_VMADDR, text_seg_size, 0, text_seg_size, /* R+X */ 5, 1);
+  const size_t sect = off + SEGMENT_SIZE;
+  w.write(sect,      "__text", 6);
+  w.write(sect + 16, "__TEXT", 6);
+  w.write<uint64_t>(sect + 32, TEXT_VMADDR + text_off);
+  w.write<uint64_t>(sect + 40, text_size);
+  w.write<uint32_t>(sect + 48, text_off);
+  w.write<uint32_t>(sect + 52, 4);
+  w.write<uint32_t>(sect + 64, /* S_ATTR_PURE_INSTRUCTIONS | S_ATTR_SOME_INSTRUCTIONS */ 0x80000400);
+  off += SEGMENT_SIZE + SECTION_SIZE;
+
+  // __LINKEDIT
+  write_segment(off, "__LINKEDIT", TEXT_VMADDR + text_seg_size, align(linkedit_size, PAGE_SIZE),
+                trie_off, linkedit_size, /* R */ 1, 0);
+  off += SEGMENT_SIZE;
+
+  // LC_ID_DYLIB
+  w.write<uint32_t>(off,      0xd);
+  w.write<uint32_t>(off +  4, id_dylib_size);
+  w.write<uint32_t>(off +  8, 24);
+  w.write<uint32_t>(off + 12, 2);
+  w.write<uint32_t>(off + 16, 0x10000);
+  w.write<uint32_t>(off + 20, 0x10000);
+  w.write(off + 24, install_name);
+  off += id_dylib_size;
+
+  // LC_DYLD_INFO_ONLY
+  w.write<uint32_t>(off,      0x80000022);
+  w.write<uint32_t>(off +  4, 48);
+  w.write<uint32_t>(off + 40, trie_off);
+  w.write<uint32_t>(off + 44, trie.size());
+  off += 48;
+
+  // LC_SYMTAB
+  w.write<uint32_t>(off,      0x2);
+  w.write<uint32_t>(off +  4, 24);
+  w.write<uint32_t>(off +  8, symtab_off);
+  w.write<uint32_t>(off + 12, nb_exports);
+  w.write<uint32_t>(off + 16, strtab_off);
+  w.write<uint32_t>(off + 20, strtab_size);
+  off += 24;
+
+  // LC_DYSYMTAB (all the symbols are external definitions)
+  w.write<uint32_t>(off,      0xb);
+  w.write<uint32_t>(off +  4, 80);
+  w.write<uint32_t>(off + 16, 0);
+  w.write<uint32_t>(off + 20, nb_exports);
+  w.write<uint32_t>(off + 24, nb_exports);
+  off += 80;
+
+  w.fill(text_off, text_size, 0xc3);
+  w.write(trie_off, trie.data(), trie.size());
+  for (size_t i = 0; i < nb_exports; ++i) {
+    const size_t sym = symtab_off + i * NLIST_SIZE;
+    w.write<uint32_t>(sym,     names[i]);
+    w.write<uint8_t> (sym + 4, /* N_SECT | N_EXT */ 0x0f);
+    w.write<uint8_t> (sym + 5, 1);
+    w.write<uint64_t>(sym + 8, TEXT_VMADDR + text_off + i * FUNC_SIZE);
+  }
+  w.write(strtab_off, strtab.raw().data(), strtab.raw().size());
+  return w.release();
+}
+
+
+// DEX
+// ===
+std::vector<uint8_t> generate_dex(const dex_config_t& config) {
+  static constexpr size_t   HEADER_SIZE  = 0x70;
+  static constexpr uint32_t NO_INDEX     = 0xffffffff;
+  static constexpr uint32_t ACC_PUBLIC   = 0x1;
+  static constexpr uint32_t ACC_ABSTRACT = 0x400;
+
+  // Type indexes are 16 bits in the method ids
+  const size_t nb_classes = std::min<size_t>(config.nb_classes, 0xff00);
+
+  // Strings must be sorted: class descriptors, "Ljava/lang/Object;", "V" and "run"
+  std::vector<std::string> strings;
+  strings.reserve(nb_classes + 3);
+  for (size_t i = 0; i < nb_classes; ++i) {
+    strings.push_back(class_name(i));
+  }
+  strings.emplace_back("Ljava/lang/Object;");
+  strings.emplace_back("V");
+  strings.emplace_back("run");
+  std::vector<uint32_t> order(strings.size());
+  std::iota(std::begin(order), std::end(order), 0);
+  std::sort(std::begin(order), std::end(order),
+            [&strings] (uint32_t lhs, uint32_t rhs) { return strings[lhs] < strings[rhs]; });
+  std::vector<uint32_t> string_idx(strings.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    string_idx[order[i]] = i;
+  }
+  const uint32_t object_str = string_idx[nb_classes];
+  const uint32_t void_str   = string_idx[nb_classes + 1];
+  const uint32_t run_str    = string_idx[nb_classes + 2];
+
+  // Types (sorted by string index): the classes, Object and V
+  std::vector<uint32_t> type_strings;
+  for (size_t i = 0; i < nb_classes + 2; ++i) {
+    type_strings.push_back(string_idx[i]);
+  }
+  std::sort(std::begin(type_strings), std::end(type_strings));
+  auto&& type_idx = [&type_strings] (uint32_t str) {
+    return static_cast<uint32_t>(std::lower_bound(std::begin(type_strings), std::end(type_strings), str) -
+                                 std::begin(type_strings));
+  };
+
+  // One method "run()V" per class. The method ids are sorted by class type
+  std::vector<uint32_t> method_classes;
+  for (size_t i = 0; i < nb_classes; ++i) {
+    method_classes.push_back(type_idx(string_idx[i]));
+  }
+  std::sort(std::begin(method_classes), std::end(method_classes));
+  auto&& method_idx = [&method_classes] (uint32_t type) {
+    return static_cast<uint32_t>(std::lower_bound(std::begin(method_classes), std::end(method_classes), type) -
+                                 std::begin(method_classes));
+  };
+
+  const size_t string_ids_off = HEADER_SIZE;
+  const size_t type_ids_off   = string_ids_off + strings.size() * 4;
+  const size_t proto_ids_off  = type_ids_off + type_strings.size() * 4;
+  const size_t method_ids_off = proto_ids_off + 12;
+  const size_t class_defs_off = method_ids_off + nb_classes * 8;
+  const size_t data_off       = class_defs_off + nb_classes * 32;
+
+  writer_t w;
+  size_t off = data_off;
+
+  // string_data_item (the strings are ASCII: MUTF-8 == ASCII)
+  const size_t string_data_off = off;
+  for (size_t i = 0; i < order.size(); ++i) {
+    const std::string& str = strings[order[i]];
+    std::vector<uint8_t> size;
+    write_uleb128(size, str.size());
+    w.write<uint32_t>(string_ids_off + i * 4, off);
+    w.write(off, size.data(), size.size());
+    w.write(off + size.size(), str);
+    off += size.size() + str.size() + 1;
+  }
+
+  for (size_t i = 0; i < type_strings.size(); ++i) {
+    w.write<uint32_t>(type_ids_off + i * 4, type_strings[i]);
+  }
+
+  w.write<uint32_t>(proto_ids_off,     void_str);
+  w.write<uint32_t>(proto_ids_off + 4, type_idx(void_str));
+  w.write<uint32_t>(proto_ids_off + 8, 0);
+
+  for (size_t i = 0; i < method_classes.size(); ++i) {
+    w.write<uint16_t>(method_ids_off + i * 8,     method_classes[i]);
+    w.write<uint16_t>(method_ids_off + i * 8 + 2, 0);
+    w.write<uint32_t>(method_ids_off + i * 8 + 4, run_str);
+  }
+
+  // class_data_item: one abstract virtual method
+  const size_t class_data_off = off;
+  std::vector<uint32_t> class_data(nb_classes);
+  for (size_t i = 0; i < nb_classes; ++i) {
+    std::vector<uint8_t> data = {0, 0, 0, 1};
+    write_uleb128(data, method_idx(type_idx(string_idx[i])));
+    write_uleb128(data, ACC_PUBLIC | ACC_ABSTRACT);
+    write_uleb128(data, 0);
+    class_data[i] = off;
+    w.write(off, data.data(), data.size());
+    off += data.size();
+  }
+
+  // class_def_item: every fourth class extends Object, the others extend the previous class
+  for (size_t i = 0; i < nb_classes; ++i) {
+    const size_t def = class_defs_off + i * 32;
+    const uint32_t super = i % 4 == 0 ? object_str : string_idx[i - 1];
+    w.write<uint32_t>(def,      type_idx(string_idx[i]));
+    w.write<uint32_t>(def +  4, ACC_PUBLIC | ACC_ABSTRACT);
+    w.write<uint32_t>(def +  8, type_idx(super));
+    w.write<uint32_t>(def + 16, NO_INDEX);
+    w.write<uint32_t>(def + 24, class_data[i]);
+  }
+
+  // map_list
+  const size_t map_off = align(off, 4);
+  const std::pair<uint16_t, std::pair<size_t, size_t>> items[] = {
+    {/* HEADER      */ 0x0000, {1,                   0}},
+    {/* STRING_ID   */ 0x0001, {strings.size(),      string_ids_off}},
+    {/* TYPE_ID     */ 0x0002, {type_strings.size(), type_ids_off}},
+    {/* PROTO_ID    */ 0x0003, {1,                   proto_ids_off}},
+    {/* METHOD_ID   */ 0x0005, {nb_classes,          method_ids_off}},
+    {/* CLASS_DEF   */ 0x0006, {nb_classes,          class_defs_off}},
+    {/* STRING_DATA */ 0x2002, {strings.size(),      string_data_off}},
+    {/* CLASS_DATA  */ 0x2000, {nb_classes,          class_data_off}},
+    {/* MAP_LIST    */ 0x1000, {1,                   map_off}},
+  };
+  const size_t nb_items = sizeof(items) / sizeof(items[0]);
+  w.write<uint32_t>(map_off, nb_items);
+  for (size_t i = 0; i < nb_items; ++i) {
+    const size_t item = map_off + 4 + i * 12;
+    w.write<uint16_t>(item,     items[i].first);
+    w.write<uint32_t>(item + 4, items[i].second.first);
+    w.write<uint32_t>(item + 8, items[i].second.second);
+  }
+  const size_t file_size = map_off + 4 + nb_items * 12;
+  w.reserve(file_size);
+
+  static const uint8_t MAGIC[] = {'d', 'e', 'x', '\n', '0', '3', '5', 0};
+  w.write(0, MAGIC, sizeof(MAGIC));
+  w.write<uint32_t>(32,  file_size);
+  w.write<uint32_t>(36,  HEADER_SIZE);
+  w.write<uint32_t>(40,  0x12345678);
+  w.write<uint32_t>(52,  map_off);
+  w.write<uint32_t>(56,  strings.size());
+  w.write<uint32_t>(60,  string_ids_off);
+  w.write<uint32_t>(64,  type_strings.size());
+  w.write<uint32_t>(68,  type_ids_off);
+  w.write<uint32_t>(72,  1);
+  w.write<uint32_t>(76,  proto_ids_off);
+  w.write<uint32_t>(88,  nb_classes);
+  w.write<uint32_t>(92,  method_ids_off);
+  w.write<uint32_t>(96,  nb_classes);
+  w.write<uint32_t>(100, class_defs_off);
+  w.write<uint32_t>(104, file_size - data_off);
+  w.write<uint32_t>(108, data_off);
+
+  // Adler-32 of the file after the checksum (the SHA-1 signature is left empty)
+  std::vector<uint8_t> raw = w.release();
+  uint32_t a = 1, b = 0;
+  for (size_t i = 12; i < raw.size(); ++i) {
+    a = (a + raw[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+  const uint32_t checksum = (b << 16) | a;
+  std::memcpy(raw.data() + 8, &checksum, sizeof(checksum));
+  return raw;
+}
+
+}
@@ -0,0 +1,67 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_BENCH_GENERATORS_H_
+#define LIEF_BENCH_GENERATORS_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Generators of synthetic binaries.
+//
+// The binaries are written from scratch (not with the LIEF builders) so that
+// the inputs don't change when the code under benchmark changes. For a given
+// configuration, the output is deterministic.
+
+namespace lief_bench {
+
+//! x86-64 shared library with a SYSV hash table
+struct elf_config_t {
+  size_t nb_symbols     = 1000; //!< Exported functions (.dynsym)
+  size_t nb_relocations = 1000; //!< R_X86_64_64 relocations (.rela.dyn)
+  size_t nb_sections    = 10;   //!< Additional .text.<i> sections
+};
+
+//! PE32+ DLL
+struct pe_config_t {
+  size_t nb_imports   = 1000; //!< Imported functions (64 per DLL)
+  size_t nb_resources = 100;  //!< RT_RCDATA entries
+};
+
+//! x86-64 Mach-O dylib
+struct macho_config_t {
+  size_t nb_exports = 1000; //!< Entries of the export trie (and of the symbol table)
+};
+
+//! DEX 035 file
+struct dex_config_t {
+  size_t nb_classes = 1000; //!< Classes with one method each
+};
+
+std::vector<uint8_t> generate_elf(const elf_config_t& config);
+std::vector<uint8_t> generate_pe(const pe_config_t& config);
+std::vector<uint8_t> generate_macho(const macho_config_t& config);
+std::vector<uint8_t> generate_dex(const dex_config_t& config);
+
+//! Name of the ``idx``-th generated symbol. The names share prefixes
+//! like the mangled names of a C++ library.
+std::string symbol_name(size_t idx);
+
+//! Name of the ``idx``-th generated DEX class (e.g. ``Lcom/lief/bench/p3/Class42;``)
+std::string class_name(size_t idx);
+
+}
+
+#endif
@@ -0,0 +1,135 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <map>
+
+#include <LIEF/PE.hpp>
+#include <LIEF/hash.hpp>
+#include <LIEF/to_json.hpp>
+
+#include "bench.hpp"
+#include "generators.hpp"
+
+using namespace lief_bench;
+
+// The argument is the number of imported functions (64 per DLL).
+// There is one resource every 10 imports.
+static const std::vector<uint8_t>& input(int64_t n) {
+  static std::map<int64_t, std::vector<uint8_t>> cache;
+  auto it = cache.find(n);
+  if (it == std::end(cache)) {
+    pe_config_t config;
+    config.nb_imports   = n;
+    config.nb_resources = n / 10;
+    it = cache.emplace(n, generate_pe(config)).first;
+  }
+  return it->second;
+}
+
+static void pe_parse(State& state) {
+  const std::vector<uint8_t>& raw = input(state.range());
+  for (auto _ : state) {
+    std::unique_ptr<LIEF::PE::Binary> binary = LIEF::PE::Parser::parse(raw);
+    do_not_optimize(binary);
+  }
+  state.set_bytes_processed(state.iterations() * raw.size());
+}
+
+static void pe_build(State& state) {
+  const std::vector<uint8_t>& raw = input(state.range());
+  for (auto _ : state) {
+    state.pause_timing();
+    std::unique_ptr<LIEF::PE::Binary> binary = LIEF::PE::Parser::parse(raw);
+    state.resume_timing();
+
+    LIEF::PE::Builder builder{binary.get()};
+    builder.build_imports(true).build_resources(true);
+    builder.build();
+    do_not_optimize(builder.get_build());
+  }
+  state.set_bytes_processed(state.iterations() * raw.size());
+}
+
+static void pe_write(State& state) {
+  const std::vector<uint8_t>& raw = input(state.range());
+  const std::string output = tmp_file(".dll");
+  for (auto _ : state) {
+    state.pause_timing();
+    std::unique_ptr<LIEF::PE::Binary> binary = LIEF::PE::Parser::parse(raw);
+    state.resume_timing();
+
+    binary->write(output);
+  }
+  std::remove(output.c_str());
+  state.set_bytes_processed(state.iterations() * raw.size());
+}
+
+static void pe_hash(State& state) {
+  std::unique_ptr<LIEF::PE::Binary> binary = LIEF::PE::Parser::parse(input(state.range()));
+  for (auto _ : state) {
+    do_not_optimize(LIEF::hash(*binary));
+  }
+  state.set_items_processed(state.iterations());
+}
+
+#if defined(LIEF_JSON_SUPPORT)
+static void pe_json(State& state) {
+  std::unique_ptr<LIEF::PE::Binary> binary = LIEF::PE::Parser::parse(input(state.range()));
+  null_ostream os;
+  for (auto _ : state) {
+    LIEF::to_json(*binary, os);
+  }
+  state.set_bytes_processed(os.count());
+}
+#endif
+
+static void pe_search(State& state) {
+  static constexpr size_t FUNCS_PER_DLL = 64;
+  const size_t nb_imports = state.range();
+  std::unique_ptr<LIEF::PE::Binary> binary = LIEF::PE::Parser::parse(input(nb_imports));
+  std::vector<std::pair<std::string, std::string>> names;
+  names.reserve(nb_imports);
+  for (size_t i = 0; i < nb_imports; ++i) {
+    const size_t func = (i * 7919) % nb_imports;
+    names.emplace_back("library" + std::to_string(func / FUNCS_PER_DLL) + ".dll", "Function" + std::to_string(func));
+  }
+  for (auto _ : state) {
+    for (const auto& name : names) {
+      do_not_optimize(binary->get_import(name.first).get_entry(name.second));
+    }
+  }
+  state.set_items_processed(state.iterations() * names.size());
+}
+
+static void pe_resources(State& state) {
+  std::unique_ptr<LIEF::PE::Binary> binary = LIEF::PE::Parser::parse(input(state.range()));
+  for (auto _ : state) {
+    const LIEF::PE::ResourcesManager manager = binary->resources_manager();
+    do_not_optimize(manager.has_type(LIEF::PE::RESOURCE_TYPES::RCDATA));
+    do_not_optimize(manager.get_node_type(LIEF::PE::RESOURCE_TYPES::RCDATA));
+  }
+  state.set_items_processed(state.iterations());
+}
+
+LIEF_BENCHMARK("PE/parse",     pe_parse,     {1 << 10, 1 << 14});
+LIEF_BENCHMARK("PE/build",     pe_build,     {1 << 10, 1 << 14});
+LIEF_BENCHMARK("PE/write",     pe_write,     {1 << 10, 1 << 14});
+LIEF_BENCHMARK("PE/hash",      pe_hash,      {1 << 10, 1 << 14});
+#if defined(LIEF_JSON_SUPPORT)
+LIEF_BENCHMARK("PE/json",      pe_json,      {1 << 10, 1 << 14});
+#endif
+LIEF_BENCHMARK("PE/search",    pe_search,    {1 << 10, 1 << 14});
+LIEF_BENCHMARK("PE/resources", pe_resources, {1 << 10, 1 << 14});
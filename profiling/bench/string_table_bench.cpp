@@ -0,0 +1,204 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <LIEF/iostream.hpp>
+#include <LIEF/string_table.hpp>
+
+#include "bench.hpp"
+
+using namespace lief_bench;
+
+// Compare LIEF::StringTable with the previous implementation of the string
+// table optimization (ELF::Builder::optimize) on C++-like mangled names.
+// The argument is the number of strings.
+
+static std::vector<std::string> reference_optimize(const std::vector<std::string>& names,
+                                                   size_t& offset_counter,
+                                                   std::unordered_map<std::string, size_t>& offset_map) {
+  std::set<std::string> string_table{std::begin(names), std::end(names)};
+  std::vector<std::string> string_table_optimized;
+  string_table_optimized.reserve(names.size());
+
+  for (auto &val: string_table) {
+    string_table_optimized.emplace_back(std::move(val));
+    std::reverse(std::begin(string_table_optimized.back()), std::end(string_table_optimized.back()));
+  }
+
+  std::sort(std::begin(string_table_optimized), std::end(string_table_optimized),
+      [] (const std::string& lhs, const std::string& rhs) {
+        if (lhs.size() > rhs.size()) {
+          return lhs.compare(0, rhs.size(), rhs) <= 0;
+        }
+        return rhs.compare(0, lhs.size(), lhs) > 0;
+      });
+
+  std::unordered_map<std::string, std::string> merged_map;
+  size_t to_set_idx = 0, cur_elm_idx = 1;
+  for (; cur_elm_idx < string_table_optimized.size(); ++cur_elm_idx) {
+    auto &cur_elm = string_table_optimized[cur_elm_idx];
+    auto &to_set_elm = string_table_optimized[to_set_idx];
+    if (to_set_elm.size() >= cur_elm.size() and to_set_elm.compare(0, cur_elm.size(), cur_elm) == 0) {
+      std::string rev_cur_elm = cur_elm;
+      std::string rev_to_set_elm = to_set_elm;
+      std::reverse(std::begin(rev_cur_elm), std::end(rev_cur_elm));
+      std::reverse(std::begin(rev_to_set_elm), std::end(rev_to_set_elm));
+      merged_map[rev_cur_elm] = rev_to_set_elm;
+      continue;
+    }
+    ++to_set_idx;
+    std::swap(string_table_optimized[to_set_idx], cur_elm);
+  }
+  if (string_table_optimized[0].size() == 0) {
+    std::swap(string_table_optimized[0], string_table_optimized[to_set_idx]);
+    --to_set_idx;
+  }
+  string_table_optimized.resize(to_set_idx + 1);
+
+  for (auto &val: string_table_optimized) {
+    std::reverse(std::begin(val), std::end(val));
+  }
+  std::sort(std::begin(string_table_optimized), std::end(string_table_optimized));
+
+  offset_map[""] = 0;
+  for (const auto &v : string_table_optimized) {
+    offset_map[v] = offset_counter;
+    offset_counter += v.size() + 1;
+  }
+  for (const auto &kv : merged_map) {
+    offset_map[kv.first] = offset_map[kv.second] + (kv.second.size() - kv.first.size());
+  }
+  return string_table_optimized;
+}
+
+// Some symbols are suffixes of others (e.g. @plt, version aliases)
+static const std::vector<std::string>& input(int64_t nb_strings) {
+  static std::map<int64_t, std::vector<std::string>> cache;
+  auto it = cache.find(nb_strings);
+  if (it != std::end(cache)) {
+    return it->second;
+  }
+
+  static const char* const NAMESPACES[] = {"std", "llvm", "boost", "LIEF", "detail", "impl", "v1"};
+  static const char* const SUFFIXES[]   = {"Ev", "EPKc", "ERKS_", "EmRKS0_", "Ei", "ED2Ev", "EC1Ev"};
+  std::mt19937 rng{0};
+  std::vector<std::string> names;
+  names.reserve(nb_strings);
+  for (int64_t i = 0; i < nb_strings; ++i) {
+    std::string name = "_ZN";
+    const size_t depth = 1 + rng() % 4;
+    for (size_t d = 0; d < depth; ++d) {
+      const std::string ns = NAMESPACES[rng() % 7];
+      name += std::to_string(ns.size()) + ns;
+    }
+    const std::string fname = "func" + std::to_string(rng() % (nb_strings / 4 + 1));
+    name += std::to_string(fname.size()) + fname + SUFFIXES[rng() % 7];
+    names.push_back(std::move(name));
+    if (rng() % 8 == 0) {
+      names.push_back(names.back().substr(names.back().size() / 2));
+    }
+  }
+  return cache.emplace(nb_strings, std::move(names)).first->second;
+}
+
+//! Check that every string of ``names`` is found at its offset in ``table``
+static bool check(const std::vector<uint8_t>& table, const std::vector<std::string>& names,
+                  const std::function<size_t(const std::string&)>& offset) {
+  for (const std::string& name : names) {
+    const size_t off = offset(name);
+    if (off + name.size() >= table.size() or
+        std::memcmp(table.data() + off, name.data(), name.size()) != 0 or
+        table[off + name.size()] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void string_table_reference(State& state) {
+  const std::vector<std::string>& names = input(state.range());
+  uint64_t size = 0;
+  bool checked  = false;
+  for (auto _ : state) {
+    std::unordered_map<std::string, size_t> offset_map;
+    size_t offset_counter = 1;
+    LIEF::vector_iostream raw;
+    raw.write<uint8_t>(0);
+    for (const std::string& name : reference_optimize(names, offset_counter, offset_map)) {
+      raw.write(name);
+    }
+    size = raw.size();
+    do_not_optimize(size);
+
+    // The table is checked once (outside of the timers)
+    if (not checked) {
+      state.pause_timing();
+      if (not check(raw.raw(), names, [&] (const std::string& s) { return offset_map[s]; })) {
+        state.skip_with_error("Wrong offsets");
+      }
+      checked = true;
+      state.resume_timing();
+    }
+  }
+  state.set_items_processed(state.iterations() * names.size());
+  state.set_bytes_processed(state.iterations() * size);
+}
+
+static void string_table_build(State& state) {
+  const std::vector<std::string>& names = input(state.range());
+  uint64_t size = 0;
+  bool checked  = false;
+  for (auto _ : state) {
+    LIEF::StringTable table;
+    table.reserve(names.size());
+    for (const std::string& name : names) {
+      table.add(name);
+    }
+    table.finalize(1);
+    LIEF::vector_iostream raw;
+    raw.write<uint8_t>(0);
+    table.write(raw);
+    size_t checksum = 0;
+    for (const std::string& name : names) {
+      checksum += table.offset(name);
+    }
+    do_not_optimize(checksum);
+    size = raw.size();
+
+    // The table is checked once (outside of the timers)
+    if (not checked) {
+      state.pause_timing();
+      if (not check(raw.raw(), names, [&] (const std::string& s) { return table.offset(s); })) {
+        state.skip_with_error("Wrong offsets");
+      }
+      checked = true;
+      state.resume_timing();
+    }
+  }
+  state.set_items_processed(state.iterations() * names.size());
+  state.set_bytes_processed(state.iterations() * size);
+}
+
+LIEF_BENCHMARK("StringTable/reference", string_table_reference, {1 << 14, 1 << 17, 500000});
+LIEF_BENCHMARK("StringTable/build",     string_table_build,     {1 << 14, 1 << 17, 500000});
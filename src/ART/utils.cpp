@@ -40,6 +40,10 @@ bool is_art(const std::string& file) {
 }
 
 bool is_art(const std::vector<uint8_t>& raw) {
+  return is_art(span<const uint8_t>{raw});
+}
+
+bool is_art(span<const uint8_t> raw) {
   if (raw.size() < sizeof(ART::art_magic)) {
     return false;
   }
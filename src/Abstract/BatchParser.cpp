@@ -0,0 +1,57 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "logging.hpp"
+#include "parallel.hpp"
+
+#include "LIEF/Abstract/BatchParser.hpp"
+#include "LIEF/Abstract/Binary.hpp"
+#include "LIEF/Abstract/Parser.hpp"
+
+namespace LIEF {
+
+void parse_many(const std::vector<std::string>& paths, const batch_callback_t& callback,
+                const BatchConfig& config, size_t nb_threads) {
+  // The exceptions raised by the parsers are reported for their file while
+  // parallel_for() stops the batch on the first exception raised by ``callback``
+  parallel_for(paths.size(), nb_threads,
+      [&paths, &callback, &config] (size_t idx) {
+        const std::string& path = paths[idx];
+        std::unique_ptr<Binary> binary;
+        try {
+          binary = Parser::parse(path, config);
+        } catch (const std::exception& e) {
+          LIEF_ERR("{}: {}", path, e.what());
+        } catch (...) {
+          LIEF_ERR("{}: unknown error", path);
+        }
+        callback(idx, std::move(binary));
+      });
+}
+
+
+std::vector<std::unique_ptr<Binary>> parse_many(const std::vector<std::string>& paths,
+                                                const BatchConfig& config, size_t nb_threads) {
+  std::vector<std::unique_ptr<Binary>> binaries(paths.size());
+  // Each index is written by a single worker
+  parse_many(paths,
+      [&binaries] (size_t idx, std::unique_ptr<Binary> binary) {
+        binaries[idx] = std::move(binary);
+      },
+      config, nb_threads);
+  return binaries;
+}
+
+}
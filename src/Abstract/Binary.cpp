@@ -13,10 +13,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
 #include "LIEF/Abstract/Binary.hpp"
 #include "LIEF/exception.hpp"
 #include "LIEF/config.h"
 
+#include "multi_search.hpp"
+
 #if defined(LIEF_ELF_SUPPORT)
 #include "LIEF/ELF/Binary.hpp"
 #endif
@@ -76,7 +83,7 @@ it_const_symbols Binary::symbols() const {
 }
 
 
-bool Binary::has_symbol(const std::string& name) const {
+const Symbol* Binary::get_abstract_symbol(const std::string& name) const {
   symbols_t symbols = const_cast<Binary*>(this)->get_abstract_symbols();
   auto&& it_symbol = std::find_if(
       std::begin(symbols),
@@ -85,24 +92,22 @@ bool Binary::has_symbol(const std::string& name) const {
         return s->name() == name;
       });
 
-  return it_symbol != std::end(symbols);
+  if (it_symbol == std::end(symbols)) {
+    return nullptr;
+  }
+  return *it_symbol;
+}
+
+bool Binary::has_symbol(const std::string& name) const {
+  return this->get_abstract_symbol(name) != nullptr;
 }
 
 const Symbol& Binary::get_symbol(const std::string& name) const {
-  if (not this->has_symbol(name)) {
+  const Symbol* symbol = this->get_abstract_symbol(name);
+  if (symbol == nullptr) {
     throw not_found("Symbol '" + name + "' not found!");
   }
-
-  symbols_t symbols = const_cast<Binary*>(this)->get_abstract_symbols();
-
-  auto&& it_symbol = std::find_if(
-      std::begin(symbols),
-      std::end(symbols),
-      [&name] (const Symbol* s) {
-        return s->name() == name;
-      });
-
-  return **it_symbol;
+  return *symbol;
 }
 
 Symbol& Binary::get_symbol(const std::string& name) {
@@ -158,6 +163,109 @@ std::vector<uint64_t> Binary::xref(uint64_t address) const {
   return result;
 }
 
+//! Scan the content of ``sections`` with ``searcher`` and return the virtual addresses
+//! of the matches of each needle (sorted by section, then by offset)
+static std::vector<std::vector<uint64_t>> search_sections(const std::vector<Section*>& sections,
+                                                          const multisearch& searcher, size_t nb_threads) {
+  std::vector<multisearch::matches_t> sections_matches(sections.size());
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::atomic<bool> failed{false};
+
+  auto&& worker = [&] () {
+    for (size_t idx = next++; idx < sections.size() and not failed; idx = next++) {
+      try {
+        const Section& section = *sections[idx];
+        span<const uint8_t> content = section.content_view();
+        std::vector<uint8_t> buffer;
+        if (content.empty()) {
+          buffer  = section.content();
+          content = buffer;
+        }
+        sections_matches[idx] = searcher.search_all(content);
+      } catch (...) {
+        // Only the first thread that fails records its exception
+        if (not failed.exchange(true)) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  if (nb_threads == 0) {
+    nb_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  nb_threads = std::min(nb_threads, sections.size());
+
+  if (nb_threads <= 1) {
+    worker();
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(nb_threads);
+    for (size_t i = 0; i < nb_threads; ++i) {
+      threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  std::vector<std::vector<uint64_t>> result(searcher.size());
+  for (size_t idx = 0; idx < sections.size(); ++idx) {
+    const uint64_t va = sections[idx]->virtual_address();
+    const multisearch::matches_t& matches = sections_matches[idx];
+    for (size_t id = 0; id < matches.size(); ++id) {
+      for (size_t offset : matches[id]) {
+        result[id].push_back(va + offset);
+      }
+    }
+  }
+  return result;
+}
+
+
+std::map<uint64_t, std::vector<uint64_t>> Binary::xref(const std::vector<uint64_t>& addresses, size_t nb_threads) const {
+  std::vector<std::vector<uint8_t>> patterns;
+  patterns.reserve(addresses.size());
+  for (uint64_t address : addresses) {
+    patterns.push_back(Section::integer_pattern(address, 0));
+  }
+
+  const multisearch searcher{std::move(patterns)};
+  std::vector<std::vector<uint64_t>> founds =
+    search_sections(const_cast<Binary*>(this)->get_abstract_sections(), searcher, nb_threads);
+
+  std::map<uint64_t, std::vector<uint64_t>> result;
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    std::vector<uint64_t>& xrefs = result[addresses[i]];
+    if (xrefs.empty()) {
+      xrefs = std::move(founds[i]);
+    }
+  }
+  return result;
+}
+
+
+std::map<std::vector<uint8_t>, std::vector<uint64_t>>
+Binary::search_all(const std::vector<std::vector<uint8_t>>& patterns, size_t nb_threads) const {
+  const multisearch searcher{patterns};
+  std::vector<std::vector<uint64_t>> founds =
+    search_sections(const_cast<Binary*>(this)->get_abstract_sections(), searcher, nb_threads);
+
+  std::map<std::vector<uint8_t>, std::vector<uint64_t>> result;
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    std::vector<uint64_t>& addresses = result[patterns[i]];
+    if (addresses.empty()) {
+      addresses = std::move(founds[i]);
+    }
+  }
+  return result;
+}
+
 void Binary::accept(Visitor& visitor) const {
   visitor.visit(*this);
 }
@@ -91,6 +91,22 @@ const char* to_string(ENDIANNESS e) {
   return it == enumStrings.end() ? "UNDEFINED" : it->second;
 }
 
+const char* to_string(FILE_FORMATS e) {
+  CONST_MAP(FILE_FORMATS, const char*, 9) enumStrings {
+    { FILE_FORMATS::UNKNOWN,   "UNKNOWN"   },
+    { FILE_FORMATS::ELF,       "ELF"       },
+    { FILE_FORMATS::OAT,       "OAT"       },
+    { FILE_FORMATS::PE,        "PE"        },
+    { FILE_FORMATS::MACHO,     "MACHO"     },
+    { FILE_FORMATS::MACHO_FAT, "MACHO_FAT" },
+    { FILE_FORMATS::DEX,       "DEX"       },
+    { FILE_FORMATS::VDEX,      "VDEX"      },
+    { FILE_FORMATS::ART,       "ART"       },
+  };
+  auto   it  = enumStrings.find(e);
+  return it == enumStrings.end() ? "UNDEFINED" : it->second;
+}
+
 const char* to_string(Binary::VA_TYPES e) {
   CONST_MAP(Binary::VA_TYPES, const char*, 3) enumStrings {
     { LIEF::Binary::VA_TYPES::AUTO, "AUTO" },
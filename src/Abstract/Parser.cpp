@@ -17,24 +17,29 @@
 #include <fstream>
 
 #include "logging.hpp"
+#include "filesystem/filesystem.h"
+
 #include "LIEF/Abstract/Parser.hpp"
+#include "LIEF/Abstract/BatchParser.hpp"
+#include "LIEF/Abstract/identify.hpp"
+#include "LIEF/Abstract/EnumToString.hpp"
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/BinaryStream/VectorStream.hpp"
 
 #include "LIEF/OAT.hpp"
 
 #if defined(LIEF_ELF_SUPPORT)
-#include "LIEF/ELF/utils.hpp"
 #include "LIEF/ELF/Parser.hpp"
 #include "LIEF/ELF/Binary.hpp"
 #endif
 
 #if defined(LIEF_PE_SUPPORT)
-#include "LIEF/PE/utils.hpp"
 #include "LIEF/PE/Parser.hpp"
 #include "LIEF/PE/Binary.hpp"
 #endif
 
 #if defined(LIEF_MACHO_SUPPORT)
-#include "LIEF/MachO/utils.hpp"
 #include "LIEF/MachO/Parser.hpp"
 #include "LIEF/MachO/FatBinary.hpp"
 #include "LIEF/MachO/Binary.hpp"
@@ -49,83 +54,85 @@ Parser::Parser() :
   binary_name_{""}
 {}
 
-std::unique_ptr<Binary> Parser::parse(const std::string& filename) {
+//! Give ``stream`` to the parser of its format, identified once
+static std::unique_ptr<Binary> parse_stream(std::unique_ptr<BinaryStream> stream, const std::string& name,
+                                            const BatchConfig& config) {
+  const FILE_FORMATS format = identify(*stream);
 
+  switch (format) {
 #if defined(LIEF_OAT_SUPPORT)
-  if (OAT::is_oat(filename)) {
-    return OAT::Parser::parse(filename);
-  }
+    case FILE_FORMATS::OAT:
+      {
+        return OAT::Parser::parse(std::move(stream), name);
+      }
 #endif
 
 #if defined(LIEF_ELF_SUPPORT)
-  if (ELF::is_elf(filename)) {
-    return ELF::Parser::parse(filename);
-  }
+    case FILE_FORMATS::ELF:
+      {
+        return ELF::Parser::parse(std::move(stream), name, config.elf);
+      }
 #endif
 
-
 #if defined(LIEF_PE_SUPPORT)
-  if (PE::is_pe(filename)) {
-     return PE::Parser::parse(filename);
-  }
+    case FILE_FORMATS::PE:
+      {
+        return PE::Parser::parse(std::move(stream), name, config.pe);
+      }
 #endif
 
 #if defined(LIEF_MACHO_SUPPORT)
-  if (MachO::is_macho(filename)) {
-    // For fat binary we take the last one...
-    MachO::FatBinary* fat = MachO::Parser::parse(filename).release();
-    MachO::Binary* binary_return = nullptr;
-    if (fat) {
-      binary_return = fat->pop_back();
-      delete fat;
-    }
-    return std::unique_ptr<Binary>{binary_return};
-  }
-#endif
-
-  LIEF_ERR("Unknown format");
-  return nullptr;
-
-}
-
-std::unique_ptr<Binary> Parser::parse(const std::vector<uint8_t>& raw, const std::string& name) {
-
-#if defined(LIEF_OAT_SUPPORT)
-  if (OAT::is_oat(raw)) {
-    return OAT::Parser::parse(raw, name);
-  }
+    case FILE_FORMATS::MACHO:
+    case FILE_FORMATS::MACHO_FAT:
+      {
+        // For fat binary we take the last one...
+        std::unique_ptr<MachO::FatBinary> fat = MachO::Parser::parse(std::move(stream), name, config.macho);
+        if (fat == nullptr) {
+          return nullptr;
+        }
+        return std::unique_ptr<Binary>{fat->pop_back()};
+      }
 #endif
 
-#if defined(LIEF_ELF_SUPPORT)
-  if (ELF::is_elf(raw)) {
-    return ELF::Parser::parse(raw, name);
+    case FILE_FORMATS::DEX:
+    case FILE_FORMATS::VDEX:
+    case FILE_FORMATS::ART:
+      {
+        LIEF_ERR("{}: {} files are not LIEF::Binary (see LIEF::{}::Parser::parse)", name, to_string(format), to_string(format));
+        return nullptr;
+      }
+
+    default:
+      {
+        LIEF_ERR("Unknown format");
+        return nullptr;
+      }
   }
-#endif
-
+}
 
-#if defined(LIEF_PE_SUPPORT)
-  if (PE::is_pe(raw)) {
-     return PE::Parser::parse(raw, name);
-  }
-#endif
+std::unique_ptr<Binary> Parser::parse(const std::string& filename) {
+  return Parser::parse(filename, BatchConfig{});
+}
 
-#if defined(LIEF_MACHO_SUPPORT)
-  if (MachO::is_macho(raw)) {
-    // For fat binary we take the last one...
-    MachO::FatBinary* fat = MachO::Parser::parse(raw, name).release();
-    MachO::Binary* binary_return = nullptr;
-
-    if (fat) {
-      binary_return = fat->pop_back();
-      delete fat;
-    }
-    return std::unique_ptr<Binary>{binary_return};
+std::unique_ptr<Binary> Parser::parse(const std::string& filename, const BatchConfig& config) {
+  // The file is opened once: the stream used to identify the
+  // format is then given to the parser of this format
+  std::unique_ptr<BinaryStream> stream;
+  try {
+    stream = BinaryStream::from_file(filename);
+  } catch (const LIEF::exception& e) {
+    LIEF_ERR("{}", e.what());
+    return nullptr;
   }
-#endif
+  return parse_stream(std::move(stream), filesystem::path(filename).filename(), config);
+}
 
-  LIEF_ERR("Unknown format");
-  return nullptr;
+std::unique_ptr<Binary> Parser::parse(const std::vector<uint8_t>& raw, const std::string& name) {
+  return parse_stream(std::unique_ptr<BinaryStream>{new VectorStream{raw}}, name, BatchConfig{});
+}
 
+std::unique_ptr<Binary> Parser::parse(span<const uint8_t> raw, const std::string& name) {
+  return parse_stream(std::unique_ptr<BinaryStream>{new SpanStream{raw}}, name, BatchConfig{});
 }
 
 Parser::Parser(const std::string& filename) :
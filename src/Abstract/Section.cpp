@@ -24,6 +24,8 @@
 
 #include "LIEF/Abstract/Section.hpp"
 
+#include "multi_search.hpp"
+
 #include "Section.tcc"
 
 namespace LIEF {
@@ -68,6 +70,7 @@ uint64_t Section::size() const {
 
 
 void Section::size(uint64_t size) {
+  this->index_changed();
   this->size_ = size;
 }
 
@@ -81,17 +84,53 @@ uint64_t Section::virtual_address() const {
 }
 
 void Section::virtual_address(uint64_t virtual_address) {
+  this->index_changed();
   this->virtual_address_ = virtual_address;;
 }
 
 void Section::offset(uint64_t offset) {
+  this->index_changed();
   this->offset_ = offset;
 }
 
 
-// Search functions
-// ================
-size_t Section::search(uint64_t integer, size_t pos, size_t size) const {
+span<const uint8_t> Section::content_view() const {
+  return {};
+}
+
+
+size_t Section::content_digest() const {
+  return this->digest_.get(this->digest_key(), [this] {
+    std::vector<uint8_t> buffer;
+    return Hash::hash(this->view_or_copy(buffer));
+  });
+}
+
+
+DigestCache::key_t Section::digest_key() const {
+  DigestCache::key_t key;
+  key.version = this->content_version_;
+  key.size    = this->size();
+  return key;
+}
+
+
+void Section::content_changed() {
+  ++this->content_version_;
+}
+
+
+span<const uint8_t> Section::view_or_copy(std::vector<uint8_t>& buffer) const {
+  span<const uint8_t> view = this->content_view();
+  if (not view.empty()) {
+    return view;
+  }
+  buffer = this->content();
+  return buffer;
+}
+
+
+std::vector<uint8_t> Section::integer_pattern(uint64_t integer, size_t size) {
   if (size > sizeof(integer)) {
     throw std::runtime_error("Invalid size (" + std::to_string(size) + ")");
   }
@@ -120,12 +159,14 @@ size_t Section::search(uint64_t integer, size_t pos, size_t size) const {
       reinterpret_cast<const uint8_t*>(&integer),
       reinterpret_cast<const uint8_t*>(&integer) + minimal_size,
       pattern.data());
-
-  return this->search(pattern, pos);
+  return pattern;
 }
 
-size_t Section::search(const std::vector<uint8_t>& pattern, size_t pos) const {
-  std::vector<uint8_t> content = this->content();
+
+size_t Section::find(span<const uint8_t> content, const std::vector<uint8_t>& pattern, size_t pos) {
+  if (pos > content.size()) {
+    return Section::npos;
+  }
 
   auto&& it_found = std::search(
       std::begin(content) + pos, std::end(content),
@@ -139,6 +180,31 @@ size_t Section::search(const std::vector<uint8_t>& pattern, size_t pos) const {
   return std::distance(std::begin(content), it_found);
 }
 
+
+std::vector<size_t> Section::find_all(span<const uint8_t> content, const std::vector<uint8_t>& pattern) {
+  std::vector<size_t> result;
+  size_t pos = Section::find(content, pattern, 0);
+
+  while (pos != Section::npos) {
+    result.push_back(pos);
+    pos = Section::find(content, pattern, pos + 1);
+  }
+
+  return result;
+}
+
+
+// Search functions
+// ================
+size_t Section::search(uint64_t integer, size_t pos, size_t size) const {
+  return this->search(Section::integer_pattern(integer, size), pos);
+}
+
+size_t Section::search(const std::vector<uint8_t>& pattern, size_t pos) const {
+  std::vector<uint8_t> buffer;
+  return Section::find(this->view_or_copy(buffer), pattern, pos);
+}
+
 size_t Section::search(const std::string& pattern, size_t pos) const {
   std::vector<uint8_t> pattern_formated = {std::begin(pattern), std::end(pattern)};
   return this->search(pattern_formated, pos);
@@ -151,19 +217,8 @@ size_t Section::search(uint64_t integer, size_t pos) const {
 // Search all functions
 // ====================
 std::vector<size_t> Section::search_all(uint64_t v, size_t size) const {
-  std::vector<size_t> result;
-  size_t pos = this->search(v, 0, size);
-
-  if (pos == Section::npos) {
-    return result;
-  }
-
-  do {
-    result.push_back(pos);
-    pos = this->search(v, pos + 1, size);
-  } while(pos != Section::npos);
-
-  return result;
+  std::vector<uint8_t> buffer;
+  return Section::find_all(this->view_or_copy(buffer), Section::integer_pattern(v, size));
 }
 
 std::vector<size_t> Section::search_all(uint64_t v) const {
@@ -174,22 +229,27 @@ std::vector<size_t> Section::search_all(const std::string& v) const {
   return this->search_all_<std::string>(v);
 }
 
+std::vector<std::vector<size_t>> Section::search_all(const std::vector<std::vector<uint8_t>>& patterns) const {
+  std::vector<uint8_t> buffer;
+  return multisearch{patterns}.search_all(this->view_or_copy(buffer));
+}
+
 
 double Section::entropy() const {
-  std::array<uint64_t, 256> frequencies = { {0} };
-  const std::vector<uint8_t>& content = this->content();
-  for (uint8_t x : content) {
-    frequencies[x]++;
-  }
+  std::vector<uint8_t> buffer;
+  return LIEF::entropy(this->view_or_copy(buffer));
+}
 
-  double entropy = 0.0;
-  for (uint64_t p : frequencies) {
-    if (p > 0) {
-      double freq = static_cast<double>(p) / static_cast<double>(content.size());
-      entropy += freq * std::log2l(freq) ;
-    }
-  }
-  return (-entropy);
+
+histogram_t Section::histogram(size_t nb_threads) const {
+  std::vector<uint8_t> buffer;
+  return LIEF::histogram(this->view_or_copy(buffer), nb_threads);
+}
+
+
+std::vector<double> Section::entropy_curve(size_t block_size, size_t step) const {
+  std::vector<uint8_t> buffer;
+  return LIEF::entropy_curve(this->view_or_copy(buffer), block_size, step);
 }
 
 
@@ -19,19 +19,9 @@ namespace LIEF {
 
 template<typename T>
 std::vector<size_t> Section::search_all_(const T& v) const {
-  std::vector<size_t> result;
-  size_t pos = this->search(v, 0);
-
-  if (pos == Section::npos) {
-    return result;
-  }
-
-  do {
-    result.push_back(pos);
-    pos = this->search(v, pos + 1);
-  } while(pos != Section::npos);
-
-  return result;
+  const std::vector<uint8_t> pattern = {std::begin(v), std::end(v)};
+  std::vector<uint8_t> buffer;
+  return Section::find_all(this->view_or_copy(buffer), pattern);
 }
 
 }
@@ -43,6 +43,8 @@ Symbol::Symbol(const std::string& name, uint64_t value, uint64_t size) :
 {}
 
 void Symbol::swap(Symbol& other) {
+  this->index_changed();
+  other.index_changed();
   std::swap(this->name_,   other.name_);
   std::swap(this->value_,  other.value_);
   std::swap(this->size_,   other.size_);
@@ -53,10 +55,13 @@ const std::string& Symbol::name() const {
 }
 
 std::string& Symbol::name() {
+  // The caller may rename the symbol through the reference
+  this->index_changed();
   return this->name_;
 }
 
 void Symbol::name(const std::string& name) {
+  this->index_changed();
   this->name_ = name;
 }
 
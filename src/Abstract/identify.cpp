@@ -0,0 +1,139 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+
+#include "logging.hpp"
+
+#include "LIEF/Abstract/identify.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/exception.hpp"
+
+#if defined(LIEF_ELF_SUPPORT)
+#include "LIEF/ELF/utils.hpp"
+#endif
+
+#if defined(LIEF_OAT_SUPPORT)
+#include "LIEF/OAT/utils.hpp"
+#endif
+
+#if defined(LIEF_PE_SUPPORT)
+#include "LIEF/PE/Structures.hpp"
+#endif
+
+#if defined(LIEF_MACHO_SUPPORT)
+#include "LIEF/MachO/utils.hpp"
+#include "LIEF/MachO/enums.hpp"
+#endif
+
+#if defined(LIEF_DEX_SUPPORT)
+#include "LIEF/DEX/utils.hpp"
+#endif
+
+#if defined(LIEF_VDEX_SUPPORT)
+#include "LIEF/VDEX/utils.hpp"
+#endif
+
+#if defined(LIEF_ART_SUPPORT)
+#include "LIEF/ART/utils.hpp"
+#endif
+
+namespace LIEF {
+
+//! Number of bytes read to identify the format. It covers the magic
+//! numbers and the DOS header of the PE files.
+static constexpr size_t HEADER_WINDOW = 0x40;
+
+FILE_FORMATS identify(BinaryStream& stream) {
+  const size_t size = std::min<uint64_t>(stream.size(), HEADER_WINDOW);
+  const uint8_t* header = stream.peek_array<uint8_t>(0, size, /* check */ false);
+  if (header == nullptr) {
+    return FILE_FORMATS::UNKNOWN;
+  }
+  const span<const uint8_t> window{header, size};
+
+#if defined(LIEF_ELF_SUPPORT)
+  if (ELF::is_elf(window)) {
+#if defined(LIEF_OAT_SUPPORT)
+    if (OAT::is_oat(stream)) {
+      return FILE_FORMATS::OAT;
+    }
+#endif
+    return FILE_FORMATS::ELF;
+  }
+#endif
+
+#if defined(LIEF_PE_SUPPORT)
+  if (size >= sizeof(PE::pe_dos_header) and window[0] == 'M' and window[1] == 'Z') {
+    PE::pe_dos_header dos_header;
+    std::memcpy(&dos_header, header, sizeof(dos_header));
+    const char* signature = stream.peek_array<char>(dos_header.AddressOfNewExeHeader, sizeof(PE::PE_Magic), /* check */ false);
+    if (signature != nullptr and std::equal(signature, signature + sizeof(PE::PE_Magic), std::begin(PE::PE_Magic))) {
+      return FILE_FORMATS::PE;
+    }
+  }
+#endif
+
+#if defined(LIEF_MACHO_SUPPORT)
+  if (MachO::is_macho(window)) {
+    uint32_t magic = 0;
+    std::memcpy(&magic, header, sizeof(magic));
+    const auto type = static_cast<MachO::MACHO_TYPES>(magic);
+    if (type == MachO::MACHO_TYPES::FAT_MAGIC or type == MachO::MACHO_TYPES::FAT_CIGAM) {
+      return FILE_FORMATS::MACHO_FAT;
+    }
+    return FILE_FORMATS::MACHO;
+  }
+#endif
+
+#if defined(LIEF_DEX_SUPPORT)
+  if (DEX::is_dex(window)) {
+    return FILE_FORMATS::DEX;
+  }
+#endif
+
+#if defined(LIEF_VDEX_SUPPORT)
+  if (VDEX::is_vdex(window)) {
+    return FILE_FORMATS::VDEX;
+  }
+#endif
+
+#if defined(LIEF_ART_SUPPORT)
+  if (ART::is_art(window)) {
+    return FILE_FORMATS::ART;
+  }
+#endif
+
+  return FILE_FORMATS::UNKNOWN;
+}
+
+FILE_FORMATS identify(span<const uint8_t> raw) {
+  SpanStream stream{raw};
+  return identify(stream);
+}
+
+FILE_FORMATS identify(const std::string& filename) {
+  std::unique_ptr<BinaryStream> stream;
+  try {
+    stream = BinaryStream::from_file(filename);
+  } catch (const LIEF::exception& e) {
+    LIEF_ERR("{}", e.what());
+    return FILE_FORMATS::UNKNOWN;
+  }
+  return identify(*stream);
+}
+
+}
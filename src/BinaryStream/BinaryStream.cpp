@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include "LIEF/BinaryStream/BinaryStream.hpp"
+#include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/MmapStream.hpp"
 #include "LIEF/DWARF/enums.hpp"
 #include "LIEF/utils.hpp"
+#include "LIEF/exception.hpp"
 #include "LIEF/third-party/utfcpp/utf8/checked.h"
 #include <mbedtls/platform.h>
 #include <mbedtls/asn1.h>
@@ -23,6 +26,7 @@
 #include <mbedtls/oid.h>
 #include <mbedtls/x509_crt.h>
 
+#include "logging.hpp"
 #include "intmem.h"
 
 #include <iomanip>
@@ -36,6 +40,18 @@ namespace LIEF {
 BinaryStream::~BinaryStream() = default;
 BinaryStream::BinaryStream() = default;
 
+std::unique_ptr<BinaryStream> BinaryStream::from_file(const std::string& filename) {
+  if (MmapStream::is_supported()) {
+    try {
+      return std::unique_ptr<MmapStream>{new MmapStream{filename}};
+    } catch (const LIEF::exception& e) {
+      // e.g. special files that can't be mapped: fallback on a regular read
+      LIEF_DEBUG("{}", e.what());
+    }
+  }
+  return std::unique_ptr<VectorStream>{new VectorStream{filename}};
+}
+
 
 template<typename T>
 T BinaryStream::swap_endian(T u) {
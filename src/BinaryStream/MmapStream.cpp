@@ -0,0 +1,217 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(_WIN32)
+  #include <windows.h>
+#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+  #define LIEF_MMAP_POSIX
+#endif
+
+#include <algorithm>
+
+#include "logging.hpp"
+
+#include "LIEF/BinaryStream/MmapStream.hpp"
+#include "LIEF/exception.hpp"
+
+namespace LIEF {
+
+#if defined(LIEF_MMAP_POSIX)
+inline int to_madvise(MmapStream::ADVICE advice) {
+  switch (advice) {
+    case MmapStream::ADVICE::SEQUENTIAL: return MADV_SEQUENTIAL;
+    case MmapStream::ADVICE::RANDOM:     return MADV_RANDOM;
+    case MmapStream::ADVICE::WILLNEED:   return MADV_WILLNEED;
+    case MmapStream::ADVICE::NORMAL:
+    default:                             return MADV_NORMAL;
+  }
+}
+#endif
+
+bool MmapStream::is_supported() {
+#if defined(LIEF_MMAP_POSIX) || defined(_WIN32)
+  return true;
+#else
+  return false;
+#endif
+}
+
+MmapStream::MmapStream(const std::string& filename) {
+#if defined(LIEF_MMAP_POSIX)
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw LIEF::bad_file("Unable to open " + filename);
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 or st.st_size <= 0) {
+    ::close(fd);
+    throw LIEF::bad_file("Unable to get the size of " + filename);
+  }
+  const uint64_t size = static_cast<uint64_t>(st.st_size);
+
+  void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (addr == MAP_FAILED) {
+    ::close(fd);
+    throw LIEF::bad_file("Unable to map " + filename);
+  }
+  // The descriptor is kept open for the file-to-file copies of the builders
+  this->fd_   = fd;
+  this->data_ = reinterpret_cast<const uint8_t*>(addr);
+  this->size_ = size;
+
+  // Headers are read first, then the parsers jump
+  // to the tables referenced by the headers
+  this->advise(ADVICE::RANDOM);
+#elif defined(_WIN32)
+  HANDLE file = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw LIEF::bad_file("Unable to open " + filename);
+  }
+
+  LARGE_INTEGER size;
+  if (not ::GetFileSizeEx(file, &size) or size.QuadPart <= 0) {
+    ::CloseHandle(file);
+    throw LIEF::bad_file("Unable to get the size of " + filename);
+  }
+
+  HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  ::CloseHandle(file);
+  if (mapping == nullptr) {
+    throw LIEF::bad_file("Unable to map " + filename);
+  }
+
+  void* addr = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (addr == nullptr) {
+    ::CloseHandle(mapping);
+    throw LIEF::bad_file("Unable to map " + filename);
+  }
+  this->mapping_ = mapping;
+  this->data_    = reinterpret_cast<const uint8_t*>(addr);
+  this->size_    = static_cast<uint64_t>(size.QuadPart);
+#else
+  throw LIEF::not_supported("Memory-mapped files are not supported on this platform");
+#endif
+}
+
+
+MmapStream::~MmapStream() {
+  if (this->data_ == nullptr) {
+    return;
+  }
+#if defined(LIEF_MMAP_POSIX)
+  ::munmap(const_cast<uint8_t*>(this->data_), this->size_);
+  if (this->fd_ >= 0) {
+    ::close(this->fd_);
+  }
+#elif defined(_WIN32)
+  ::UnmapViewOfFile(this->data_);
+  if (this->mapping_ != nullptr) {
+    ::CloseHandle(this->mapping_);
+  }
+#endif
+}
+
+
+uint64_t MmapStream::size() const {
+  return this->size_;
+}
+
+
+void MmapStream::advise(ADVICE advice, uint64_t offset, uint64_t size) const {
+#if defined(LIEF_MMAP_POSIX)
+  if (offset >= this->size_) {
+    return;
+  }
+  size = std::min<uint64_t>(size, this->size_ - offset);
+
+  // madvise() requires a page-aligned address
+  static const uint64_t page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+  const uint64_t aligned = offset & ~(page_size - 1);
+  uint8_t* addr = const_cast<uint8_t*>(this->data_) + aligned;
+
+  if (::madvise(addr, size + (offset - aligned), to_madvise(advice)) != 0) {
+    LIEF_DEBUG("madvise(0x{:x}, 0x{:x}) failed", offset, size);
+  }
+#else
+  (void)advice;
+  (void)offset;
+  (void)size;
+#endif
+}
+
+
+std::vector<uint8_t> MmapStream::content() const {
+  return {this->start(), this->end()};
+}
+
+
+std::unique_ptr<MmapStream> MmapStream::private_copy() const {
+  if (this->data_ == nullptr) {
+    return nullptr;
+  }
+  void* addr = nullptr;
+#if defined(LIEF_MMAP_POSIX)
+  struct stat st;
+  // Don't map a file that has been truncated since it has been parsed
+  if (this->fd_ < 0 or ::fstat(this->fd_, &st) != 0 or static_cast<uint64_t>(st.st_size) != this->size_) {
+    return nullptr;
+  }
+  // MAP_PRIVATE: the modifications are not propagated to the file
+  addr = ::mmap(nullptr, this->size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, this->fd_, 0);
+  if (addr == MAP_FAILED) {
+    LIEF_DEBUG("Can't map the file again");
+    return nullptr;
+  }
+#elif defined(_WIN32)
+  // FILE_MAP_COPY: the modifications are private to the process.
+  // The view keeps a reference on the mapping object.
+  addr = ::MapViewOfFile(this->mapping_, FILE_MAP_COPY, 0, 0, 0);
+  if (addr == nullptr) {
+    LIEF_DEBUG("Can't map the file again");
+    return nullptr;
+  }
+#endif
+  std::unique_ptr<MmapStream> copy{new MmapStream{}};
+  copy->data_     = reinterpret_cast<const uint8_t*>(addr);
+  copy->size_     = this->size_;
+  copy->writable_ = true;
+  return copy;
+}
+
+
+uint8_t* MmapStream::cow_start() {
+  return this->writable_ ? const_cast<uint8_t*>(this->data_) : nullptr;
+}
+
+
+const void* MmapStream::read_at(uint64_t offset, uint64_t size, bool throw_error) const {
+  if (offset > this->size() or (offset + size) > this->size()) {
+    LIEF_DEBUG("Can't read #{:d} bytes at 0x{:04x}", size, offset);
+    if (throw_error) {
+      throw LIEF::read_out_of_bound(offset, size);
+    }
+    return nullptr;
+  }
+  return this->data_ + offset;
+}
+
+}
+
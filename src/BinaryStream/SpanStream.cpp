@@ -0,0 +1,49 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "logging.hpp"
+
+#include "LIEF/BinaryStream/SpanStream.hpp"
+#include "LIEF/exception.hpp"
+
+namespace LIEF {
+
+SpanStream::SpanStream(span<const uint8_t> data) :
+  data_{data}
+{}
+
+
+uint64_t SpanStream::size() const {
+  return this->data_.size();
+}
+
+
+std::vector<uint8_t> SpanStream::content() const {
+  return this->data_.to_vector();
+}
+
+
+const void* SpanStream::read_at(uint64_t offset, uint64_t size, bool throw_error) const {
+  if (offset > this->size() or size > (this->size() - offset)) {
+    LIEF_DEBUG("Can't read #{:d} bytes at 0x{:04x}", size, offset);
+    if (throw_error) {
+      throw LIEF::read_out_of_bound(offset, size);
+    }
+    return nullptr;
+  }
+  return this->start() + offset;
+}
+
+}
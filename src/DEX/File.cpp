@@ -20,6 +20,7 @@
 #include "LIEF/DEX/hash.hpp"
 
 #include "LIEF/json.hpp"
+#include "LIEF/BinaryStream/BinaryStream.hpp"
 
 namespace LIEF {
 namespace DEX {
@@ -30,10 +31,21 @@ File::File() :
   header_{},
   classes_{},
   methods_{},
-  strings_{},
-  original_data_{}
+  strings_{}
 {}
 
+span<const uint8_t> File::original_data() const {
+  if (this->stream_ == nullptr or this->stream_->size() == 0) {
+    return {};
+  }
+  const uint64_t size = this->stream_->size();
+  const uint8_t* data = this->stream_->peek_array<uint8_t>(0, size, /* check */false);
+  if (data == nullptr) {
+    return {};
+  }
+  return {data, static_cast<size_t>(size)};
+}
+
 
 dex_version_t File::version() const {
   magic_t m = this->header().magic();
@@ -55,7 +67,8 @@ std::string File::save(const std::string path, bool deoptimize) const {
       const std::vector<uint8_t> raw = this->raw(deoptimize);
       ifs.write(reinterpret_cast<const char*>(raw.data()), raw.size());
     } else {
-      ifs.write(reinterpret_cast<const char*>(this->original_data_.data()), this->original_data_.size());
+      const span<const uint8_t> raw = this->original_data();
+      ifs.write(reinterpret_cast<const char*>(raw.data()), raw.size());
     }
     return path;
   }
@@ -65,16 +78,17 @@ std::string File::save(const std::string path, bool deoptimize) const {
 
 
 std::vector<uint8_t> File::raw(bool deoptimize) const {
+  const span<const uint8_t> original = this->original_data();
   if (not deoptimize) {
-    return this->original_data_;
+    return {std::begin(original), std::end(original)};
   }
   dex2dex_info_t dex2dex_info = this->dex2dex_info();
 
   if (dex2dex_info.size() == 0) {
-    return this->original_data_;
+    return {std::begin(original), std::end(original)};
   }
 
-  std::vector<uint8_t> raw = this->original_data_;
+  std::vector<uint8_t> raw = {std::begin(original), std::end(original)};
 
   for (Method* method : this->methods_) {
     if (method->bytecode().size() == 0) {
@@ -58,7 +58,7 @@ Parser::Parser(const std::vector<uint8_t>& data, const std::string& name) :
 
 Parser::Parser(const std::string& file) :
   file_{new File{}},
-  stream_{std::unique_ptr<VectorStream>(new VectorStream{file})}
+  stream_{BinaryStream::from_file(file)}
 {
   if (not is_dex(file)) {
     LIEF_ERR("'{}' is not a DEX File", file);
@@ -26,8 +26,6 @@ namespace DEX {
 
 template<typename DEX_T>
 void Parser::parse_file() {
-  this->file_->original_data_ = this->stream_->content();
-
   this->parse_header<DEX_T>();
   this->parse_map<DEX_T>();
   this->parse_strings<DEX_T>();
@@ -43,6 +41,8 @@ void Parser::parse_file() {
   this->resolve_external_methods();
   this->resolve_external_fields();
 
+  // The file reads its original content through the parser's stream
+  this->file_->stream_ = std::move(this->stream_);
 }
 
 
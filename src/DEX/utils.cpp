@@ -39,6 +39,10 @@ bool is_dex(const std::string& file) {
 }
 
 bool is_dex(const std::vector<uint8_t>& raw) {
+  return is_dex(span<const uint8_t>{raw});
+}
+
+bool is_dex(span<const uint8_t> raw) {
 
   if (raw.size() < sizeof(DEX::magic)) {
     return false;
@@ -34,8 +34,10 @@
 
 #include "LIEF/exception.hpp"
 #include "LIEF/utils.hpp"
+#include "LIEF/entropy.hpp"
 
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/file_ostream.hpp"
 
 #include "LIEF/ELF/utils.hpp"
 #include "LIEF/ELF/EnumToString.hpp"
@@ -50,10 +52,12 @@
 #include "LIEF/ELF/DynamicSharedObject.hpp"
 #include "LIEF/ELF/Note.hpp"
 #include "LIEF/ELF/Builder.hpp"
+#include "LIEF/ELF/Parser.hpp"
 #include "LIEF/ELF/Section.hpp"
 #include "LIEF/ELF/Segment.hpp"
 #include "LIEF/ELF/Relocation.hpp"
 #include "LIEF/ELF/Symbol.hpp"
+#include "LIEF/ELF/SymbolVersionAux.hpp"
 #include "LIEF/ELF/SymbolVersion.hpp"
 #include "LIEF/ELF/SymbolVersionDefinition.hpp"
 #include "LIEF/ELF/SymbolVersionRequirement.hpp"
@@ -240,6 +244,7 @@ DynamicEntry& Binary::add(const DynamicEntry& entry) {
 
 
 Note& Binary::add(const Note& note) {
+  this->load(LAZY_TABLES::NOTES);
   this->notes_.emplace_back(new Note{note});
   return *this->notes_.back();
 }
@@ -277,6 +282,7 @@ void Binary::remove(DYNAMIC_TAGS tag) {
 }
 
 void Binary::remove(const Section& section, bool clear) {
+  this->load_all();
   auto&& it_section = std::find_if(
       std::begin(this->sections_),
       std::end(this->sections_),
@@ -331,9 +337,11 @@ void Binary::remove(const Section& section, bool clear) {
 
   delete s;
   this->sections_.erase(it_section);
+  this->layout_version_.changed();
 }
 
 void Binary::remove(const Note& note) {
+  this->load(LAZY_TABLES::NOTES);
 
   auto&& it_note = std::find_if(
       std::begin(this->notes_), std::end(this->notes_),
@@ -350,6 +358,7 @@ void Binary::remove(const Note& note) {
 }
 
 void Binary::remove(NOTE_TYPES type) {
+  this->load(LAZY_TABLES::NOTES);
   for (auto&& it = std::begin(this->notes_);
               it != std::end(this->notes_);) {
     Note* n = *it;
@@ -371,10 +380,12 @@ void Binary::remove(NOTE_TYPES type) {
 // -------
 
 it_symbols Binary::static_symbols() {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
   return this->static_symbols_;
 }
 
 it_const_symbols Binary::static_symbols() const {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
   return this->static_symbols_;
 }
 
@@ -382,10 +393,12 @@ it_const_symbols Binary::static_symbols() const {
 // --------
 
 it_symbols Binary::dynamic_symbols() {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   return this->dynamic_symbols_;
 }
 
 it_const_symbols Binary::dynamic_symbols() const {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   return this->dynamic_symbols_;
 }
 
@@ -438,6 +451,7 @@ Symbol& Binary::export_symbol(const Symbol& symbol) {
   }
 
   s.visibility(ELF_SYMBOL_VISIBILITY::STV_DEFAULT);
+  this->hash_tables_sync(false);
   return s;
 }
 
@@ -513,56 +527,228 @@ Symbol& Binary::add_exported_function(uint64_t address, const std::string& name)
 
 
 bool Binary::has_dynamic_symbol(const std::string& name) const {
-  auto&& it_symbol = std::find_if(
-      std::begin(this->dynamic_symbols_),
-      std::end(this->dynamic_symbols_),
-      [&name] (const Symbol* s) {
-        return s->name() == name;
-      });
-  return it_symbol != std::end(this->dynamic_symbols_);
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
+  return this->dynamic_symbols_index_.find(this->dynamic_symbols_, name) != nullptr;
 }
 
 const Symbol& Binary::get_dynamic_symbol(const std::string& name) const {
-  if (not this->has_dynamic_symbol(name)) {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
+  const Symbol* symbol = this->dynamic_symbols_index_.find(this->dynamic_symbols_, name);
+  if (symbol == nullptr) {
     throw not_found("Symbol '" + name + "' not found!");
   }
-
-  auto&& it_symbol = std::find_if(
-      std::begin(this->dynamic_symbols_),
-      std::end(this->dynamic_symbols_),
-      [&name] (const Symbol* s) {
-        return s->name() == name;
-      });
-  return **it_symbol;
+  return *symbol;
 }
 
 Symbol& Binary::get_dynamic_symbol(const std::string& name) {
   return const_cast<Symbol&>(static_cast<const Binary*>(this)->get_dynamic_symbol(name));
 }
 
+namespace {
+// State of a lookup among the symbols that share the hash of the name.
+// It mirrors check_match() from the glibc's dl-lookup.c: for a reference without version
+// it follows the DL_LOOKUP_RETURN_NEWEST mode used by dlsym()
+struct lookup_state_t {
+  const Symbol* versioned_symbol = nullptr;
+  size_t        nb_versions      = 0;
+};
+
+const Symbol* check_match(const Symbol& symbol, const std::string& name,
+                          const std::string& version, lookup_state_t& state) {
+  const ELF_SYMBOL_TYPES type = symbol.type();
+  if (symbol.value() == 0 and type != ELF_SYMBOL_TYPES::STT_TLS) {
+    return nullptr;
+  }
+
+  if (symbol.shndx() == static_cast<uint16_t>(SYMBOL_SECTION_INDEX::SHN_UNDEF)) {
+    return nullptr;
+  }
+
+  if (type != ELF_SYMBOL_TYPES::STT_NOTYPE and type != ELF_SYMBOL_TYPES::STT_OBJECT and
+      type != ELF_SYMBOL_TYPES::STT_FUNC   and type != ELF_SYMBOL_TYPES::STT_COMMON and
+      type != ELF_SYMBOL_TYPES::STT_TLS    and type != ELF_SYMBOL_TYPES::STT_GNU_IFUNC) {
+    return nullptr;
+  }
+
+  const SYMBOL_BINDINGS binding = symbol.binding();
+  if (binding != SYMBOL_BINDINGS::STB_GLOBAL and binding != SYMBOL_BINDINGS::STB_WEAK and
+      binding != SYMBOL_BINDINGS::STB_GNU_UNIQUE) {
+    return nullptr;
+  }
+
+  if (symbol.name() != name) {
+    return nullptr;
+  }
+
+  if (not version.empty()) {
+    if (not symbol.has_version()) {
+      // The binary is not versioned: any definition matches
+      return &symbol;
+    }
+    const SymbolVersion& symbol_version = symbol.symbol_version();
+    const uint16_t value = symbol_version.value();
+    const bool versioned = (value & 0x7fff) >= 2;
+    if (versioned and symbol_version.has_auxiliary_version() and
+        symbol_version.symbol_version_auxiliary().name() == version) {
+      return &symbol;
+    }
+    // An unversioned definition (local or global index) matches
+    // unless it is hidden
+    return versioned or (value & 0x8000) != 0 ? nullptr : &symbol;
+  }
+
+  if (symbol.has_version()) {
+    const uint16_t value = symbol.symbol_version().value();
+    if ((value & 0x7fff) >= 2) {
+      // Hidden versions are never selected and a default version is only
+      // selected if it is the only one
+      if ((value & 0x8000) == 0 and state.nb_versions++ == 0) {
+        state.versioned_symbol = &symbol;
+      }
+      return nullptr;
+    }
+  }
+  return &symbol;
+}
+
+const Symbol* versioned_match(const lookup_state_t& state) {
+  return state.nb_versions == 1 ? state.versioned_symbol : nullptr;
+}
+}
+
+
+const Symbol* Binary::lookup_dynamic_symbol(const std::string& name) const {
+  return this->lookup_dynamic_symbol(name, "");
+}
+
+
+const Symbol* Binary::lookup_dynamic_symbol(const std::string& name, const std::string& version) const {
+  return this->lookup_dynamic_symbol(name,
+      dl_new_hash(name.c_str()), static_cast<uint32_t>(hash32(name.c_str())), version);
+}
+
+
+const Symbol* Binary::lookup_dynamic_symbol(const std::string& name, uint32_t gnu_hash, uint32_t sysv_hash,
+                                            const std::string& version) const {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
+  this->load(LAZY_TABLES::HASH_TABLES);
+
+  const size_t nb_symbols = this->dynamic_symbols_.size();
+  lookup_state_t state;
+
+  const bool sync = this->hash_tables_sync();
+
+  const GnuHash& gnu = this->gnu_hash_;
+  if (sync and this->is_gnu_hash_usable()) {
+    const uint32_t C    = gnu.c_;
+    const uint64_t word = gnu.bloom_filters_[(gnu_hash / C) % gnu.bloom_filters_.size()];
+    if ((((word >> (gnu_hash % C)) & (word >> ((gnu_hash >> gnu.shift2_) % C))) & 1) == 0) {
+      return nullptr;
+    }
+
+    uint32_t idx = gnu.buckets_[gnu_hash % gnu.buckets_.size()];
+    if (idx < gnu.symbol_index_) {
+      return nullptr;
+    }
+
+    for (; idx < nb_symbols; ++idx) {
+      const uint32_t value = gnu.hash_values_[idx - gnu.symbol_index_];
+      if (((value ^ gnu_hash) >> 1) == 0) {
+        if (const Symbol* symbol = check_match(*this->dynamic_symbols_[idx], name, version, state)) {
+          return symbol;
+        }
+      }
+
+      // The last entry of a chain has its lowest bit set
+      if (value & 1) {
+        break;
+      }
+    }
+    return versioned_match(state);
+  }
+
+  const SysvHash& sysv = this->sysv_hash_;
+  if (sync and this->is_sysv_hash_usable()) {
+    // A chain can't be longer than the number of symbols (prevent loops in corrupted tables)
+    size_t nb_steps = 0;
+    for (uint32_t idx = sysv.buckets_[sysv_hash % sysv.buckets_.size()];
+         idx != 0 and idx < nb_symbols and nb_steps < nb_symbols;
+         idx = sysv.chains_[idx], ++nb_steps)
+    {
+      if (const Symbol* symbol = check_match(*this->dynamic_symbols_[idx], name, version, state)) {
+        return symbol;
+      }
+    }
+    return versioned_match(state);
+  }
+
+  // No (usable) hash table: the name index gives the first symbol with this name
+  // which is the right one unless several symbols share the name (e.g. versions)
+  const Symbol* first = this->dynamic_symbols_index_.find(this->dynamic_symbols_, name);
+  if (first == nullptr) {
+    return nullptr;
+  }
+
+  if (const Symbol* symbol = check_match(*first, name, version, state)) {
+    return symbol;
+  }
+
+  state = lookup_state_t{};
+  for (const Symbol* candidate : this->dynamic_symbols_) {
+    if (const Symbol* symbol = check_match(*candidate, name, version, state)) {
+      return symbol;
+    }
+  }
+  return versioned_match(state);
+}
+
+
+std::vector<std::pair<const Binary*, const Symbol*>>
+Binary::lookup_dynamic_symbols(const std::vector<const Binary*>& scope, const std::vector<std::string>& names) {
+  return lookup_dynamic_symbols(scope, names, {});
+}
+
+
+std::vector<std::pair<const Binary*, const Symbol*>>
+Binary::lookup_dynamic_symbols(const std::vector<const Binary*>& scope, const std::vector<std::string>& names,
+                               const std::vector<std::string>& versions) {
+  static const std::string NO_VERSION;
+  std::vector<std::pair<const Binary*, const Symbol*>> result;
+  result.reserve(names.size());
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    const std::string& name    = names[i];
+    const std::string& version = i < versions.size() ? versions[i] : NO_VERSION;
+    const uint32_t gnu_hash  = dl_new_hash(name.c_str());
+    const uint32_t sysv_hash = static_cast<uint32_t>(hash32(name.c_str()));
+
+    std::pair<const Binary*, const Symbol*> resolved{nullptr, nullptr};
+    for (const Binary* binary : scope) {
+      if (binary == nullptr) {
+        continue;
+      }
+      if (const Symbol* symbol = binary->lookup_dynamic_symbol(name, gnu_hash, sysv_hash, version)) {
+        resolved = {binary, symbol};
+        break;
+      }
+    }
+    result.push_back(resolved);
+  }
+  return result;
+}
+
 bool Binary::has_static_symbol(const std::string& name) const {
-  auto&& it_symbol = std::find_if(
-      std::begin(this->static_symbols_),
-      std::end(this->static_symbols_),
-      [&name] (const Symbol* s) {
-        return s->name() == name;
-      });
-  return it_symbol != std::end(this->static_symbols_);
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
+  return this->static_symbols_index_.find(this->static_symbols_, name) != nullptr;
 }
 
 const Symbol& Binary::get_static_symbol(const std::string& name) const {
-  if (not this->has_static_symbol(name)) {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
+  const Symbol* symbol = this->static_symbols_index_.find(this->static_symbols_, name);
+  if (symbol == nullptr) {
     throw not_found("Symbol '" + name + "' not found!");
   }
-
-  auto&& it_symbol = std::find_if(
-      std::begin(this->static_symbols_),
-      std::end(this->static_symbols_),
-      [&name] (const Symbol* s) {
-        return s->name() == name;
-      });
-  return **it_symbol;
-
+  return *symbol;
 }
 
 
@@ -659,10 +845,12 @@ it_const_imported_symbols Binary::imported_symbols() const {
 // --------------
 
 it_symbols_version Binary::symbols_version() {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   return this->symbol_version_table_;
 }
 
 it_const_symbols_version Binary::symbols_version() const {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   return this->symbol_version_table_;
 }
 
@@ -670,10 +858,12 @@ it_const_symbols_version Binary::symbols_version() const {
 // -------------------------
 
 it_symbols_version_definition Binary::symbols_version_definition() {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   return this->symbol_version_definition_;
 }
 
 it_const_symbols_version_definition Binary::symbols_version_definition() const {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   return this->symbol_version_definition_;
 }
 
@@ -681,10 +871,12 @@ it_const_symbols_version_definition Binary::symbols_version_definition() const {
 // --------------------------
 
 it_symbols_version_requirement Binary::symbols_version_requirement() {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   return this->symbol_version_requirements_;
 }
 
 it_const_symbols_version_requirement Binary::symbols_version_requirement() const {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   return this->symbol_version_requirements_;
 }
 
@@ -695,22 +887,21 @@ void Binary::remove_symbol(const std::string& name) {
 
 
 void Binary::remove_static_symbol(const std::string& name) {
-  auto&& it_symbol = std::find_if(
-      std::begin(this->static_symbols_),
-      std::end(this->static_symbols_),
-      [&name] (const Symbol* symbol) {
-        return symbol != nullptr and symbol->name() == name;
-      });
-
-  if (it_symbol == std::end(this->static_symbols_)) {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
+  Symbol* symbol = this->static_symbols_index_.find(this->static_symbols_, name);
+  if (symbol == nullptr) {
     throw not_found("Can't find '" + name + "'");
   }
 
-  this->remove_static_symbol(*it_symbol);
+  this->remove_static_symbol(symbol);
 
 }
 
 void Binary::remove_static_symbol(Symbol* symbol) {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
+  // The relocations reference the static symbols by index: they
+  // must be resolved before the table is modified
+  this->load(LAZY_TABLES::RELOCATIONS);
   auto&& it_symbol = std::find_if(
       std::begin(this->static_symbols_),
       std::end(this->static_symbols_),
@@ -724,6 +915,7 @@ void Binary::remove_static_symbol(Symbol* symbol) {
 
   delete *it_symbol;
   this->static_symbols_.erase(it_symbol);
+  this->static_symbols_index_.invalidate();
 
   symbol = nullptr;
 }
@@ -731,22 +923,19 @@ void Binary::remove_static_symbol(Symbol* symbol) {
 
 
 void Binary::remove_dynamic_symbol(const std::string& name) {
-  auto&& it_symbol = std::find_if(
-      std::begin(this->dynamic_symbols_),
-      std::end(this->dynamic_symbols_),
-      [&name] (const Symbol* symbol) {
-        return symbol != nullptr and symbol->name() == name;
-      });
-
-  if (it_symbol == std::end(this->dynamic_symbols_)) {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
+  Symbol* symbol = this->dynamic_symbols_index_.find(this->dynamic_symbols_, name);
+  if (symbol == nullptr) {
     throw not_found("Can't find '" + name + "'");
   }
 
-  this->remove_dynamic_symbol(*it_symbol);
+  this->remove_dynamic_symbol(symbol);
 
 }
 
 void Binary::remove_dynamic_symbol(Symbol* symbol) {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
+  this->load(LAZY_TABLES::RELOCATIONS);
   auto&& it_symbol = std::find_if(
       std::begin(this->dynamic_symbols_),
       std::end(this->dynamic_symbols_),
@@ -804,6 +993,8 @@ void Binary::remove_dynamic_symbol(Symbol* symbol) {
 
   delete *it_symbol;
   this->dynamic_symbols_.erase(it_symbol);
+  this->dynamic_symbols_index_.invalidate();
+  this->hash_tables_sync(false);
 
   symbol = nullptr;
 
@@ -817,6 +1008,7 @@ void Binary::remove_dynamic_symbol(Symbol* symbol) {
 // --------
 
 it_dynamic_relocations Binary::dynamic_relocations() {
+  this->load(LAZY_TABLES::RELOCATIONS);
   return filter_iterator<relocations_t>{std::ref(this->relocations_),
     [] (const Relocation* reloc) {
       return reloc->purpose() == RELOCATION_PURPOSES::RELOC_PURPOSE_DYNAMIC;
@@ -825,6 +1017,7 @@ it_dynamic_relocations Binary::dynamic_relocations() {
 }
 
 it_const_dynamic_relocations Binary::dynamic_relocations() const {
+  this->load(LAZY_TABLES::RELOCATIONS);
   return const_filter_iterator<const relocations_t>{std::cref(this->relocations_),
     [] (const Relocation* reloc) {
       return reloc->purpose() == RELOCATION_PURPOSES::RELOC_PURPOSE_DYNAMIC;
@@ -833,6 +1026,7 @@ it_const_dynamic_relocations Binary::dynamic_relocations() const {
 }
 
 Relocation& Binary::add_dynamic_relocation(const Relocation& relocation) {
+  this->load(LAZY_TABLES::RELOCATIONS);
   Relocation* relocation_ptr = new Relocation{relocation};
   relocation_ptr->purpose(RELOCATION_PURPOSES::RELOC_PURPOSE_DYNAMIC);
   relocation_ptr->architecture_ = this->header().machine_type();
@@ -851,8 +1045,8 @@ Relocation& Binary::add_dynamic_relocation(const Relocation& relocation) {
     auto&& it_sym = std::find_if(
         std::begin(this->dynamic_symbols_),
         std::end(this->dynamic_symbols_),
-        [&inner_sym] (const Symbol* s) {
-          return s->name() == inner_sym->name();
+        [&associated_sym] (const Symbol* s) {
+          return s->name() == associated_sym.name();
         });
     const size_t idx = std::distance(std::begin(this->dynamic_symbols_), it_sym);
     relocation_ptr->info(idx);
@@ -875,6 +1069,7 @@ Relocation& Binary::add_dynamic_relocation(const Relocation& relocation) {
 
 
 Relocation& Binary::add_pltgot_relocation(const Relocation& relocation) {
+  this->load(LAZY_TABLES::RELOCATIONS);
   Relocation* relocation_ptr = new Relocation{relocation};
   relocation_ptr->purpose(RELOCATION_PURPOSES::RELOC_PURPOSE_PLTGOT);
   relocation_ptr->architecture_ = this->header().machine_type();
@@ -892,8 +1087,8 @@ Relocation& Binary::add_pltgot_relocation(const Relocation& relocation) {
     auto&& it_sym = std::find_if(
         std::begin(this->dynamic_symbols_),
         std::end(this->dynamic_symbols_),
-        [&inner_sym] (const Symbol* s) {
-          return s->name() == inner_sym->name();
+        [&associated_sym] (const Symbol* s) {
+          return s->name() == associated_sym.name();
         });
     const size_t idx = std::distance(std::begin(this->dynamic_symbols_), it_sym);
     relocation_ptr->info(idx);
@@ -949,6 +1144,7 @@ Relocation* Binary::add_object_relocation(const Relocation& relocation, const Se
 // plt/got
 // -------
 it_pltgot_relocations Binary::pltgot_relocations() {
+  this->load(LAZY_TABLES::RELOCATIONS);
   return filter_iterator<relocations_t>{std::ref(this->relocations_),
     [] (const Relocation* reloc) {
       return reloc->purpose() == RELOCATION_PURPOSES::RELOC_PURPOSE_PLTGOT;
@@ -957,6 +1153,7 @@ it_pltgot_relocations Binary::pltgot_relocations() {
 }
 
 it_const_pltgot_relocations Binary::pltgot_relocations() const {
+  this->load(LAZY_TABLES::RELOCATIONS);
   return const_filter_iterator<const relocations_t>{std::cref(this->relocations_),
     [] (const Relocation* reloc) {
       return reloc->purpose() == RELOCATION_PURPOSES::RELOC_PURPOSE_PLTGOT;
@@ -968,6 +1165,7 @@ it_const_pltgot_relocations Binary::pltgot_relocations() const {
 // objects
 // -------
 it_object_relocations Binary::object_relocations() {
+  this->load(LAZY_TABLES::RELOCATIONS);
   return filter_iterator<relocations_t>{std::ref(this->relocations_),
     [] (const Relocation* reloc) {
       return reloc->purpose() == RELOCATION_PURPOSES::RELOC_PURPOSE_OBJECT;
@@ -976,6 +1174,7 @@ it_object_relocations Binary::object_relocations() {
 }
 
 it_const_object_relocations Binary::object_relocations() const {
+  this->load(LAZY_TABLES::RELOCATIONS);
   return const_filter_iterator<const relocations_t>{std::cref(this->relocations_),
     [] (const Relocation* reloc) {
       return reloc->purpose() == RELOCATION_PURPOSES::RELOC_PURPOSE_OBJECT;
@@ -986,14 +1185,17 @@ it_const_object_relocations Binary::object_relocations() const {
 // All relocations
 // ---------------
 it_relocations Binary::relocations() {
+  this->load(LAZY_TABLES::RELOCATIONS);
   return this->relocations_;
 }
 
 it_const_relocations Binary::relocations() const {
+  this->load(LAZY_TABLES::RELOCATIONS);
   return this->relocations_;
 }
 
 LIEF::relocations_t Binary::get_abstract_relocations() {
+  this->load(LAZY_TABLES::RELOCATIONS);
   LIEF::relocations_t relocations;
   relocations.reserve(this->relocations_.size());
   std::copy(
@@ -1005,7 +1207,20 @@ LIEF::relocations_t Binary::get_abstract_relocations() {
 }
 
 
+const LIEF::Symbol* Binary::get_abstract_symbol(const std::string& name) const {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
+  // Same order as get_abstract_symbols()
+  const Symbol* symbol = this->dynamic_symbols_index_.find(this->dynamic_symbols_, name);
+  if (symbol != nullptr) {
+    return symbol;
+  }
+  return this->static_symbols_index_.find(this->static_symbols_, name);
+}
+
 LIEF::symbols_t Binary::get_abstract_symbols() {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
   LIEF::symbols_t symbols;
   symbols.reserve(this->dynamic_symbols_.size() + this->static_symbols_.size());
   std::copy(
@@ -1139,6 +1354,7 @@ uint64_t Binary::get_function_address(const std::string& func_name) const {
 }
 
 uint64_t Binary::get_function_address(const std::string& func_name, bool demangled) const {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
   auto&& it_symbol = std::find_if(
       std::begin(this->static_symbols_),
       std::end(this->static_symbols_),
@@ -1164,6 +1380,7 @@ uint64_t Binary::get_function_address(const std::string& func_name, bool demangl
 }
 
 Section& Binary::add(const Section& section, bool loaded) {
+  this->load_all();
   if (loaded) {
     return this->add_section<true>(section);
   } else {
@@ -1206,6 +1423,7 @@ bool Binary::has_nx() const {
 }
 
 Segment& Binary::add(const Segment& segment, uint64_t base) {
+  this->load_all();
   uint64_t new_base = base;
 
   if (new_base == 0) {
@@ -1234,6 +1452,7 @@ Segment& Binary::add(const Segment& segment, uint64_t base) {
 
 
 Segment& Binary::replace(const Segment& new_segment, const Segment& original_segment, uint64_t base) {
+  this->load_all();
 
   auto&& it_original_segment = std::find_if(
       std::begin(this->segments_),
@@ -1311,6 +1530,7 @@ Segment& Binary::replace(const Segment& new_segment, const Segment& original_seg
 
   delete local_original_segment;
   this->segments_.erase(it_original_segment);
+  this->layout_version_.changed();
 
   // Patch shdr
   Header& header = this->header();
@@ -1323,6 +1543,7 @@ Segment& Binary::replace(const Segment& new_segment, const Segment& original_seg
 
 
 void Binary::remove(const Segment& segment) {
+  this->load_all();
   const auto& it_segment = std::find_if(std::begin(this->segments_), std::end(this->segments_),
       [&segment] (const Segment* s) {
         return *s == segment;
@@ -1342,10 +1563,12 @@ void Binary::remove(const Segment& segment) {
 
   delete local_segment;
   this->segments_.erase(it_segment);
+  this->layout_version_.changed();
 }
 
 
 Segment& Binary::extend(const Segment& segment, uint64_t size) {
+  this->load_all();
   const SEGMENT_TYPES type = segment.type();
   switch (type) {
     case SEGMENT_TYPES::PT_PHDR:
@@ -1364,6 +1587,7 @@ Segment& Binary::extend(const Segment& segment, uint64_t size) {
 
 
 Section& Binary::extend(const Section& section, uint64_t size) {
+  this->load_all();
   auto&& it_section = std::find_if(
       std::begin(this->sections_),
       std::end(this->sections_),
@@ -1458,6 +1682,17 @@ void Binary::patch_address(uint64_t address, const std::vector<uint8_t>& patch_v
   // Find the segment associated with the virtual address
   Segment& segment_topatch = this->segment_from_virtual_address(address);
   const uint64_t offset = address - segment_topatch.virtual_address();
+
+  // Only write the patched bytes so that the (copy-on-write) data
+  // handler does not duplicate the whole segment
+  if (segment_topatch.datahandler_ != nullptr and
+      (offset + patch_value.size()) <= segment_topatch.physical_size())
+  {
+    uint8_t* dst = this->datahandler_->writable(segment_topatch.file_offset() + offset, patch_value.size());
+    std::copy(std::begin(patch_value), std::end(patch_value), dst);
+    return;
+  }
+
   std::vector<uint8_t> content = segment_topatch.content();
   if ((offset + patch_value.size()) > content.size()) {
     content.resize(offset + patch_value.size());
@@ -1470,37 +1705,19 @@ void Binary::patch_address(uint64_t address, const std::vector<uint8_t>& patch_v
 }
 
 
-void Binary::patch_address(uint64_t address, uint64_t patch_value, size_t size, LIEF::Binary::VA_TYPES) {
+void Binary::patch_address(uint64_t address, uint64_t patch_value, size_t size, LIEF::Binary::VA_TYPES addr_type) {
   if (size > sizeof(patch_value)) {
     throw std::runtime_error("Invalid size (" + std::to_string(size) + ")");
   }
 
-  // Object file does not have segments
-  if (this->header().file_type() == E_TYPE::ET_REL) {
-    Section& section = this->section_from_offset(address);
-    std::vector<uint8_t> content = section.content();
-    const uint64_t offset = address - section.file_offset();
-
-    // TODO: Handle Endiness
-    std::copy(
-        reinterpret_cast<uint8_t*>(&patch_value),
-        reinterpret_cast<uint8_t*>(&patch_value) + size,
-        content.data() + offset);
-    section.content(content);
-    return;
+  // Encode the value with the endianness of the binary
+  const bool is_big = this->header().abstract_endianness() == ENDIANNESS::ENDIAN_BIG;
+  std::vector<uint8_t> raw(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    const size_t shift = 8 * (is_big ? (size - 1 - i) : i);
+    raw[i] = static_cast<uint8_t>(patch_value >> shift);
   }
-
-
-  Segment& segment_topatch = this->segment_from_virtual_address(address);
-  const uint64_t offset = address - segment_topatch.virtual_address();
-  std::vector<uint8_t> content = segment_topatch.content();
-
-  // TODO: Handle Endiness
-  std::copy(
-      reinterpret_cast<uint8_t*>(&patch_value),
-      reinterpret_cast<uint8_t*>(&patch_value) + size,
-      content.data() + offset);
-  segment_topatch.content(content);
+  this->patch_address(address, raw, addr_type);
 }
 
 
@@ -1535,24 +1752,18 @@ void Binary::patch_pltgot(const std::string& symbol_name, uint64_t address) {
 
 
 const Segment& Binary::segment_from_virtual_address(uint64_t address) const {
-  auto&& it_segment = std::find_if(
-      this->segments_.cbegin(),
-      this->segments_.cend(),
-      [&address] (const Segment* segment) {
-        if (segment == nullptr) {
-          return false;
-        }
-        return ((segment->virtual_address() <= address) and
-            (segment->virtual_address() + segment->virtual_size()) > address);
+  const Segment* segment = this->segments_va_index_.find(this->segments_, address,
+      [] (const Segment& segment) {
+        return std::make_pair(segment.virtual_address(), segment.virtual_size());
       });
 
-  if (it_segment == this->segments_.cend()) {
+  if (segment == nullptr) {
     std::stringstream adr_str;
     adr_str << "0x" << std::hex << address;
     throw not_found("Unable to find the segment associated with the address: " + adr_str.str());
   }
 
-  return **it_segment;
+  return *segment;
 
 }
 
@@ -1628,7 +1839,10 @@ bool Binary::has_section_with_va(uint64_t va) const {
 }
 
 void Binary::strip() {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
+  this->load(LAZY_TABLES::RELOCATIONS);
   this->static_symbols_ = {};
+  this->static_symbols_index_.invalidate();
 
   if (this->has(ELF_SECTION_TYPES::SHT_SYMTAB)) {
     Section& symtab = this->get(ELF_SECTION_TYPES::SHT_SYMTAB);
@@ -1638,12 +1852,17 @@ void Binary::strip() {
 
 
 Symbol& Binary::add_static_symbol(const Symbol& symbol) {
+  this->load(LAZY_TABLES::STATIC_SYMBOLS);
+  this->load(LAZY_TABLES::RELOCATIONS);
   this->static_symbols_.push_back(new Symbol{symbol});
+  this->static_symbols_index_.push_back(this->static_symbols_.back());
   return *(this->static_symbols_.back());
 }
 
 
 Symbol& Binary::add_dynamic_symbol(const Symbol& symbol, const SymbolVersion* version) {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
+  this->load(LAZY_TABLES::RELOCATIONS);
   Symbol* sym = new Symbol{symbol};
   SymbolVersion* symver = nullptr;
   if (version == nullptr) {
@@ -1655,30 +1874,26 @@ Symbol& Binary::add_dynamic_symbol(const Symbol& symbol, const SymbolVersion* ve
   sym->symbol_version_ = symver;
 
   this->dynamic_symbols_.push_back(sym);
+  this->dynamic_symbols_index_.push_back(sym);
+  this->hash_tables_sync(false);
   this->symbol_version_table_.push_back(symver);
   return *(this->dynamic_symbols_.back());
 }
 
 uint64_t Binary::virtual_address_to_offset(uint64_t virtual_address) const {
-  const auto it_segment = std::find_if(
-      std::begin(this->segments_), std::end(this->segments_),
-      [virtual_address] (const Segment* segment)
-      {
-        if (segment == nullptr) {
-          return false;
+  const Segment* segment = this->load_segments_va_index_.find(this->segments_, virtual_address,
+      [] (const Segment& segment) {
+        if (segment.type() != SEGMENT_TYPES::PT_LOAD) {
+          return std::make_pair<uint64_t, uint64_t>(0, 0);
         }
-        return (
-          segment->type() == SEGMENT_TYPES::PT_LOAD and
-          segment->virtual_address() <= virtual_address and
-          segment->virtual_address() + segment->virtual_size() > virtual_address
-          );
+        return std::make_pair(segment.virtual_address(), segment.virtual_size());
       });
 
-  if (it_segment == std::end(this->segments_)) {
+  if (segment == nullptr) {
     LIEF_DEBUG("Address: 0x{:x}", virtual_address);
     throw conversion_error("Invalid virtual address");
   }
-  uint64_t baseAddress = (*it_segment)->virtual_address() - (*it_segment)->file_offset();
+  uint64_t baseAddress = segment->virtual_address() - segment->file_offset();
   uint64_t offset      = virtual_address - baseAddress;
 
   return offset;
@@ -1742,8 +1957,16 @@ void Binary::interpreter(const std::string& interpreter) {
 
 void Binary::write(const std::string& filename) {
   Builder builder{*this};
-  builder.build();
-  builder.write(filename);
+
+  // The output replaces filename once it is complete (see: file_ostream::commit) such as
+  // the input file, still read through its mapping, can be written in place
+  try {
+    file_ostream output{filename};
+    builder.build(output);
+    output.commit();
+  } catch (const bad_file& e) {
+    LIEF_ERR("{}", e.what());
+  }
 }
 
 
@@ -1753,21 +1976,21 @@ uint64_t Binary::entrypoint() const {
 
 
 const Section& Binary::section_from_offset(uint64_t offset, bool skip_nobits) const {
-  auto&& it_section = std::find_if(
-      this->sections_.cbegin(), this->sections_.cend(),
-      [offset, skip_nobits] (const Section* section) {
-        if (skip_nobits and section->type() == ELF_SECTION_TYPES::SHT_NOBITS) {
-          return false;
+  const RangeIndex<Section>& index = skip_nobits ? this->sections_offset_index_ :
+                                                   this->all_sections_offset_index_;
+  const Section* section = index.find(this->sections_, offset,
+      [skip_nobits] (const Section& section) {
+        if (skip_nobits and section.type() == ELF_SECTION_TYPES::SHT_NOBITS) {
+          return std::make_pair<uint64_t, uint64_t>(0, 0);
         }
-        return ((section->offset() <= offset) and
-            (section->offset() + section->size()) > offset);
+        return std::make_pair(section.offset(), section.size());
       });
 
-  if (it_section == this->sections_.cend()) {
+  if (section == nullptr) {
     throw not_found("Unable to find the section");
   }
 
-  return **it_section;
+  return *section;
 }
 
 Section& Binary::section_from_offset(uint64_t offset, bool skip_nobits) {
@@ -1869,6 +2092,7 @@ Segment& Binary::get(SEGMENT_TYPES type) {
 }
 
 const Note& Binary::get(NOTE_TYPES type) const {
+  this->load(LAZY_TABLES::NOTES);
 
   if (not this->has(type)) {
     throw not_found("Unable to find a note of type '" + std::string(to_string(type)) + "'.");
@@ -1928,6 +2152,7 @@ bool Binary::has(SEGMENT_TYPES type) const {
 
 
 bool Binary::has(NOTE_TYPES type) const {
+  this->load(LAZY_TABLES::NOTES);
   auto&& it_note = std::find_if(
       std::begin(this->notes_),
       std::end(this->notes_),
@@ -1954,6 +2179,8 @@ bool Binary::has(ELF_SECTION_TYPES type) const {
 
 
 void Binary::permute_dynamic_symbols(const std::vector<size_t>& permutation) {
+  this->load(LAZY_TABLES::SYMBOL_VERSIONS);
+  this->load(LAZY_TABLES::RELOCATIONS);
   std::set<size_t> done;
   for (size_t i = 0; i < permutation.size(); ++i) {
     if (permutation[i] == i or done.count(permutation[i]) > 0 or done.count(permutation[i]) > 0) {
@@ -1974,6 +2201,8 @@ void Binary::permute_dynamic_symbols(const std::vector<size_t>& permutation) {
     }
 
   }
+  this->dynamic_symbols_index_.invalidate();
+  this->hash_tables_sync(false);
 }
 
 LIEF::Header Binary::get_abstract_header() const {
@@ -2007,15 +2236,18 @@ bool Binary::has_notes() const {
 }
 
 it_const_notes Binary::notes() const {
+  this->load(LAZY_TABLES::NOTES);
   return this->notes_;
 }
 
 it_notes Binary::notes() {
+  this->load(LAZY_TABLES::NOTES);
   return this->notes_;
 }
 
 
 void Binary::accept(LIEF::Visitor& visitor) const {
+  this->load_all();
   visitor.visit(*this);
 }
 
@@ -2033,6 +2265,7 @@ bool Binary::use_gnu_hash() const {
 
 
 const GnuHash& Binary::gnu_hash() const {
+  this->load(LAZY_TABLES::HASH_TABLES);
   if (this->use_gnu_hash()) {
     return this->gnu_hash_;
   } else {
@@ -2053,6 +2286,7 @@ bool Binary::use_sysv_hash() const {
 }
 
 const SysvHash& Binary::sysv_hash() const {
+  this->load(LAZY_TABLES::HASH_TABLES);
   if (this->use_sysv_hash()) {
     return this->sysv_hash_;
   } else {
@@ -2063,10 +2297,13 @@ const SysvHash& Binary::sysv_hash() const {
 
 void Binary::shift_sections(uint64_t from, uint64_t shift) {
   LIEF_DEBUG("[+] Shift Sections");
+  // Shift all the nodes at once instead of re-indexing them one by one
+  this->datahandler_->shift(from, shift, DataHandler::Node::SECTION);
+  this->layout_version_.changed();
   for (Section* section : this->sections_) {
     if (section->file_offset() >= from) {
       LIEF_DEBUG("[BEFORE] {}", *section);
-      section->file_offset(section->file_offset() + shift);
+      section->offset_ += shift;
       if (section->virtual_address() > 0) {
         section->virtual_address(section->virtual_address() + shift);
       }
@@ -2079,10 +2316,12 @@ void Binary::shift_segments(uint64_t from, uint64_t shift) {
 
   LIEF_DEBUG("Shift segments by 0x{:x} from 0x{:x}", shift, from);
 
+  this->datahandler_->shift(from, shift, DataHandler::Node::SEGMENT);
+  this->layout_version_.changed();
   for (Segment* segment : this->segments_) {
     if (segment->file_offset() >= from) {
       LIEF_DEBUG("[BEFORE] {}", *segment);
-      segment->file_offset(segment->file_offset() + shift);
+      segment->file_offset_ += shift;
       segment->virtual_address(segment->virtual_address() + shift);
       segment->physical_address(segment->physical_address() + shift);
       LIEF_DEBUG("[AFTER ] {}", *segment);
@@ -2381,6 +2620,7 @@ LIEF::Binary::functions_t Binary::dtor_functions() const {
 
 
 const Relocation* Binary::get_relocation(uint64_t address) const {
+  this->load(LAZY_TABLES::RELOCATIONS);
   auto&& it = std::find_if(
       std::begin(this->relocations_),
       std::end(this->relocations_),
@@ -2401,6 +2641,7 @@ Relocation* Binary::get_relocation(uint64_t address) {
 }
 
 const Relocation* Binary::get_relocation(const Symbol& symbol) const {
+  this->load(LAZY_TABLES::RELOCATIONS);
   auto&& it = std::find_if(
       std::begin(this->relocations_),
       std::end(this->relocations_),
@@ -2751,17 +2992,30 @@ uint64_t Binary::eof_offset() const {
 
 
 bool Binary::has_overlay() const {
+  this->load(LAZY_TABLES::OVERLAY);
   return this->overlay_.size() > 0;
 }
 
 const Binary::overlay_t& Binary::overlay() const {
+  this->load(LAZY_TABLES::OVERLAY);
   return this->overlay_;
 }
 
 void Binary::overlay(Binary::overlay_t overlay) {
+  this->load(LAZY_TABLES::OVERLAY);
   this->overlay_ = std::move(overlay);
 }
 
+double Binary::overlay_entropy() const {
+  this->load(LAZY_TABLES::OVERLAY);
+  return LIEF::entropy(this->overlay_);
+}
+
+std::vector<double> Binary::overlay_entropy_curve(size_t block_size, size_t step) const {
+  this->load(LAZY_TABLES::OVERLAY);
+  return LIEF::entropy_curve(this->overlay_, block_size, step);
+}
+
 
 std::string Binary::shstrtab_name() const {
   const Header& hdr = this->header();
@@ -3199,6 +3453,7 @@ bool Binary::operator!=(const Binary& rhs) const {
 
 
 std::ostream& Binary::print(std::ostream& os) const {
+  this->load_all();
 
   os << "Header" << std::endl;
   os << "======" << std::endl;
@@ -3344,6 +3599,124 @@ std::ostream& Binary::print(std::ostream& os) const {
 
 
 
+void Binary::parse_table(LAZY_TABLES table, bool lazy, lazy_steps_t steps) {
+  this->lazy_tables_[static_cast<size_t>(table)] = std::move(steps);
+  if (not lazy) {
+    this->load(table);
+  }
+}
+
+
+void Binary::load(LAZY_TABLES table) const {
+  lazy_steps_t& pending = this->lazy_tables_[static_cast<size_t>(table)];
+  if (pending.empty()) {
+    return;
+  }
+  // The steps can load other tables (e.g. the relocations reference
+  // the static symbols): mark this one as loaded before running them
+  lazy_steps_t steps = std::move(pending);
+  pending.clear();
+  for (const std::function<void()>& step : steps) {
+    step();
+  }
+}
+
+
+void Binary::load_all() const {
+  for (size_t i = 0; i < this->lazy_tables_.size(); ++i) {
+    this->load(static_cast<LAZY_TABLES>(i));
+  }
+}
+
+
+bool Binary::has_deferred_tables() const {
+  return std::any_of(
+      std::begin(this->lazy_tables_),
+      std::end(this->lazy_tables_),
+      [] (const lazy_steps_t& steps) {
+        return not steps.empty();
+      });
+}
+
+
+void Binary::hash_tables_sync(bool sync) {
+  if (sync) {
+    // The dynamic symbols must notify this binary when they are renamed
+    for (const Symbol* symbol : this->dynamic_symbols_) {
+      symbol->index_attach(this->symbols_version_);
+    }
+  }
+  this->hash_tables_version_.store(this->symbols_version_.value(), std::memory_order_relaxed);
+  this->hash_tables_sync_.store(sync, std::memory_order_release);
+}
+
+
+bool Binary::hash_tables_sync() const {
+  if (not this->hash_tables_sync_.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  if (this->hash_tables_version_.load(std::memory_order_acquire) == this->symbols_version_.value()) {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock{this->hash_tables_mutex_};
+  const uint64_t version = this->symbols_version_.value();
+  if (not this->hash_tables_sync_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  if (this->hash_tables_version_.load(std::memory_order_relaxed) == version) {
+    return true;
+  }
+
+  // Some symbols of this binary have been renamed since the last check:
+  // make sure that the hash tables still match the names of the dynamic symbols
+  const size_t nb_symbols = this->dynamic_symbols_.size();
+  bool sync = true;
+
+  if (this->is_gnu_hash_usable()) {
+    const GnuHash& gnu = this->gnu_hash_;
+    for (size_t idx = gnu.symbol_index_; idx < nb_symbols and sync; ++idx) {
+      const Symbol& symbol = *this->dynamic_symbols_[idx];
+      const uint32_t hash = dl_new_hash(symbol.name().c_str());
+      sync = ((gnu.hash_values_[idx - gnu.symbol_index_] ^ hash) >> 1) == 0;
+    }
+  }
+  else if (this->is_sysv_hash_usable()) {
+    const SysvHash& sysv = this->sysv_hash_;
+    const size_t nbuckets = sysv.buckets_.size();
+    for (size_t bucket = 0; bucket < nbuckets and sync; ++bucket) {
+      size_t nb_steps = 0;
+      for (uint32_t idx = sysv.buckets_[bucket];
+           idx != 0 and idx < nb_symbols and nb_steps < nb_symbols and sync;
+           idx = sysv.chains_[idx], ++nb_steps)
+      {
+        const Symbol& symbol = *this->dynamic_symbols_[idx];
+        sync = hash32(symbol.name().c_str()) % nbuckets == bucket;
+      }
+    }
+  }
+
+  this->hash_tables_sync_.store(sync, std::memory_order_relaxed);
+  this->hash_tables_version_.store(version, std::memory_order_release);
+  return sync;
+}
+
+
+bool Binary::is_gnu_hash_usable() const {
+  const GnuHash& gnu = this->gnu_hash_;
+  return gnu.c_ > 0 and gnu.shift2_ < 32 and
+         not gnu.bloom_filters_.empty() and not gnu.buckets_.empty() and
+         gnu.symbol_index_ + gnu.hash_values_.size() == this->dynamic_symbols_.size();
+}
+
+
+bool Binary::is_sysv_hash_usable() const {
+  const SysvHash& sysv = this->sysv_hash_;
+  return not sysv.buckets_.empty() and sysv.chains_.size() == this->dynamic_symbols_.size();
+}
+
+
 Binary::~Binary() {
   for (Relocation* relocation : this->relocations_) {
     delete relocation;
@@ -3386,6 +3759,7 @@ Binary::~Binary() {
   }
 
   delete datahandler_;
+  delete parser_;
 }
 
 
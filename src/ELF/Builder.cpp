@@ -24,6 +24,7 @@
 #include "LIEF/exception.hpp"
 #include "LIEF/utils.hpp"
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/file_ostream.hpp"
 #include "LIEF/ELF/Builder.hpp"
 
 #include "LIEF/ELF/Binary.hpp"
@@ -59,6 +60,8 @@ Builder::Builder(Binary& binary) :
   binary_{&binary},
   layout_{nullptr}
 {
+  // The layout needs all the tables (see: ParserConfig)
+  binary.load_all();
   const E_TYPE type = binary.header().file_type();
   switch (type) {
     case E_TYPE::ET_CORE:
@@ -111,6 +114,34 @@ void Builder::build() {
   }
 }
 
+void Builder::build(file_ostream& output) {
+  output.set_endian_swap(this->should_swap());
+  this->output_ = &output;
+  try {
+    this->build();
+  } catch (...) {
+    this->output_ = nullptr;
+    throw;
+  }
+  this->output_ = nullptr;
+  output.flush();
+}
+
+
+void Builder::write_at(uint64_t offset, const uint8_t* data, size_t size) {
+  if (this->output_ != nullptr) {
+    this->output_->seekp(offset).write(data, size);
+    return;
+  }
+  this->ios_.seekp(offset);
+  this->ios_.write(data, size);
+}
+
+
+void Builder::write_at(uint64_t offset, const std::vector<uint8_t>& data) {
+  this->write_at(offset, data.data(), data.size());
+}
+
 const std::vector<uint8_t>& Builder::get_build() {
   return this->ios_.raw();
 }
@@ -123,14 +154,15 @@ Builder& Builder::force_relocations(bool flag) {
 
 
 void Builder::write(const std::string& filename) const {
-  std::ofstream output_file{filename, std::ios::out | std::ios::binary | std::ios::trunc};
-  if (not output_file) {
-    LIEF_ERR("Can't open {}!", filename);
-    return;
-  }
   std::vector<uint8_t> content;
   this->ios_.move(content);
-  output_file.write(reinterpret_cast<const char*>(content.data()), content.size());
+  try {
+    file_ostream output{filename};
+    output.write(content);
+    output.commit();
+  } catch (const bad_file& e) {
+    LIEF_ERR("Can't write {}: {}", filename, e.what());
+  }
 }
 
 
@@ -169,6 +201,8 @@ uint32_t Builder::sort_dynamic_symbols() {
 
   const uint32_t first_exported_symbol_index =
       std::distance(it_begin, it_first_exported_symbol);
+  this->binary_->dynamic_symbols_index_.invalidate();
+  this->binary_->hash_tables_sync(false);
   return first_exported_symbol_index;
 }
 
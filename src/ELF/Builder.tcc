@@ -21,6 +21,8 @@
 #include "logging.hpp"
 
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/file_ostream.hpp"
+#include "LIEF/string_table.hpp"
 
 #include "LIEF/ELF/utils.hpp"
 #include "LIEF/ELF/EnumToString.hpp"
@@ -640,93 +642,6 @@ void Builder::build_relocatable() {
   build_overlay<ELF_T>();
 }
 
-template<typename T, typename HANDLER>
-std::vector<std::string> Builder::optimize(const HANDLER& container,
-                                           std::function<std::string(const typename HANDLER::value_type)> getter,
-                                           size_t& offset_counter,
-                                           std::unordered_map<std::string, size_t> *of_map_p) {
-
-  std::set<std::string> string_table;
-  std::vector<std::string> string_table_optimized;
-  string_table_optimized.reserve(container.size());
-
-  // reverse all symbol names and sort them so we can merge then in the linear time:
-  // aaa, aadd, aaaa, cca, ca -> aaaa, aaa, acc, ac ddaa
-  std::transform(
-    std::begin(container), std::end(container),
-    std::inserter(string_table, std::end(string_table)),
-    getter);
-
-  for (auto &val: string_table) {
-    string_table_optimized.emplace_back(std::move(val));
-    std::reverse(std::begin(string_table_optimized.back()), std::end(string_table_optimized.back()));
-  }
-
-  std::sort(std::begin(string_table_optimized), std::end(string_table_optimized),
-      [] (const std::string& lhs, const std::string& rhs) {
-          bool ret = false;
-          if (lhs.size() > rhs.size()) {
-            auto res = lhs.compare(0, rhs.size(), rhs);
-            ret = (res <= 0);
-          } else {
-            auto res = rhs.compare(0, lhs.size(), lhs);
-            ret = (res > 0);
-          }
-          return ret;
-      }
-  );
-
-  // as all elements that can be merged are adjacent we can just go through the list once
-  // and memorize one we merged to calculate the offsets later
-  std::unordered_map<std::string, std::string> merged_map;
-  size_t to_set_idx = 0, cur_elm_idx = 1;
-  for (; cur_elm_idx < string_table_optimized.size(); ++cur_elm_idx) {
-      auto &cur_elm = string_table_optimized[cur_elm_idx];
-      auto &to_set_elm = string_table_optimized[to_set_idx];
-      if (to_set_elm.size() >= cur_elm.size()) {
-          auto ret = to_set_elm.compare(0, cur_elm.size(), cur_elm);
-          if (ret == 0) {
-            // when memorizing reverse back symbol names
-            std::string rev_cur_elm = cur_elm;
-            std::string rev_to_set_elm = to_set_elm;
-            std::reverse(std::begin(rev_cur_elm), std::end(rev_cur_elm));
-            std::reverse(std::begin(rev_to_set_elm), std::end(rev_to_set_elm));
-            merged_map[rev_cur_elm] = rev_to_set_elm;
-            continue;
-          }
-      }
-      ++to_set_idx;
-      std::swap(string_table_optimized[to_set_idx], cur_elm);
-  }
-  // if the first one is empty
-  if (string_table_optimized[0].size() == 0) {
-    std::swap(string_table_optimized[0], string_table_optimized[to_set_idx]);
-    --to_set_idx;
-  }
-  string_table_optimized.resize(to_set_idx + 1);
-
-  //reverse symbols back and sort them again
-  for (auto &val: string_table_optimized) {
-    std::reverse(std::begin(val), std::end(val));
-  }
-  std::sort(std::begin(string_table_optimized), std::end(string_table_optimized));
-
-  if (of_map_p != nullptr) {
-    std::unordered_map<std::string, size_t>& offset_map = *of_map_p;
-    offset_map[""] = 0;
-    for (const auto &v : string_table_optimized) {
-      offset_map[v] = offset_counter;
-      offset_counter += v.size() + 1;
-    }
-    for (const auto &kv : merged_map) {
-      offset_map[kv.first] = offset_map[kv.second] + (kv.second.size() - kv.first.size());
-    }
-  }
-
-  return string_table_optimized;
-}
-
-
 template<typename ELF_T>
 void Builder::build(const Header& header) {;
   using Elf_Half = typename ELF_T::Elf_Half;
@@ -756,8 +671,7 @@ void Builder::build(const Header& header) {;
   std::copy(std::begin(header.identity()), std::end(header.identity()),
     std::begin(ehdr.e_ident));
 
-  ios_.seekp(0);
-  ios_.write_conv<Elf_Ehdr>(ehdr);
+  this->write_conv_at<Elf_Ehdr>(0, ehdr);
 }
 
 
@@ -777,7 +691,7 @@ void Builder::build_sections() {
   Section* string_names_section = binary_->sections_[header.section_name_table_idx()];
   string_names_section->content(layout_->raw_shstr());
 
-  const std::unordered_map<std::string, size_t>& shstr_map = layout_->shstr_map();
+  const StringTable& shstr_map = layout_->shstr_map();
   for (size_t i = 0; i < binary_->sections_.size(); i++) {
     const Section* section = binary_->sections_[i];
 
@@ -790,16 +704,15 @@ void Builder::build_sections() {
 
       LIEF_DEBUG("Section content: {}@0x{:x}:0x{:x}",
                  section->name(), section->file_offset(), section->size());
-      ios_.seekp(section->file_offset());
-      ios_.write(section->content());
+      this->write_content(*section, section->file_offset(), section->size());
     }
 
     Elf_Off offset_name = 0;
-    const auto& it = shstr_map.find(section->name());
-    if (it == std::end(shstr_map)) {
+    const size_t name_offset = shstr_map.offset(section->name());
+    if (name_offset == StringTable::npos) {
       LIEF_ERR("Can't find string offset for section name '{}'", section->name());
     } else {
-      offset_name = it->second;
+      offset_name = name_offset;
     }
 
     Elf_Shdr shdr;
@@ -819,8 +732,7 @@ void Builder::build_sections() {
       LIEF_DEBUG("Section header:  {}@0x{:x}:0x{:x}",
                  section->name(),
                  section_headers_offset + i * sizeof(Elf_Shdr), sizeof(Elf_Shdr));
-      ios_.seekp(section_headers_offset + i * sizeof(Elf_Shdr));
-      ios_.write_conv<Elf_Shdr>(shdr);
+      this->write_conv_at<Elf_Shdr>(section_headers_offset + i * sizeof(Elf_Shdr), shdr);
     }
   }
 }
@@ -868,12 +780,11 @@ void Builder::build_segments() {
   // Write segment content
   for (const Segment* segment : binary_->segments_) {
     if (segment->physical_size() > 0) {
-      const std::vector<uint8_t>& content = segment->content();
       LIEF_DEBUG("Write content of segment {}@0{:x} (off: 0x{:x}:0{:x})",
-                to_string(segment->type()), segment->virtual_address(), segment->file_offset(), content.size());
+                to_string(segment->type()), segment->virtual_address(),
+                segment->file_offset(), segment->physical_size());
 
-      ios_.seekp(segment->file_offset());
-      ios_.write(std::move(content));
+      this->write_content(*segment, segment->file_offset(), segment->physical_size());
     }
   }
 
@@ -881,8 +792,7 @@ void Builder::build_segments() {
 
   LIEF_DEBUG("Write segments header 0x{} -> 0x{}",
     segment_header_offset, segment_header_offset + pheaders.size());
-  ios_.seekp(segment_header_offset);
-  ios_.write(std::move(pheaders.raw()));
+  this->write_at(segment_header_offset, pheaders.raw());
 }
 
 template<typename ELF_T>
@@ -905,6 +815,7 @@ void Builder::build_static_symbols() {
         return lhs->binding() == SYMBOL_BINDINGS::STB_LOCAL and
                (rhs->binding() == SYMBOL_BINDINGS::STB_GLOBAL or rhs->binding() == SYMBOL_BINDINGS::STB_WEAK);
   });
+  binary_->static_symbols_index_.invalidate();
 
   const auto it_first_exported_symbol =
       std::find_if(std::begin(binary_->static_symbols_), std::end(binary_->static_symbols_),
@@ -928,7 +839,7 @@ void Builder::build_static_symbols() {
   content.reserve(layout->static_sym_size<ELF_T>());
 
   // On recent compilers, the symtab string table is merged with the section name table
-  const std::unordered_map<std::string, size_t>* str_map = nullptr;
+  const StringTable* str_map = nullptr;
   if (layout->is_strtab_shared_shstrtab()) {
     str_map = &layout->shstr_map();
   } else {
@@ -939,11 +850,11 @@ void Builder::build_static_symbols() {
     const std::string& name = symbol->name();
 
     Elf_Off offset_name = 0;
-    const auto& it = str_map->find(name);
-    if (it == std::end(*str_map)) {
+    const size_t name_offset = str_map->offset(name);
+    if (name_offset == StringTable::npos) {
       LIEF_ERR("Can't find string offset for static symbol name '{}'", name);
     } else {
-      offset_name = it->second;
+      offset_name = name_offset;
     }
 
     Elf_Sym sym_hdr;
@@ -977,48 +888,48 @@ void Builder::build_dynamic_section() {
       case DYNAMIC_TAGS::DT_NEEDED:
         {
           const std::string& name = entry->as<DynamicEntryLibrary>()->name();
-          const auto& it = dynstr_map.find(name);
-          if (it == std::end(dynstr_map)) {
+          const size_t offset = dynstr_map.offset(name);
+          if (offset == StringTable::npos) {
             LIEF_ERR("Can't find string offset in .dynstr for {}", name);
             break;
           }
-          entry->value(it->second);
+          entry->value(offset);
           break;
         }
 
       case DYNAMIC_TAGS::DT_SONAME:
         {
           const std::string& name = entry->as<DynamicSharedObject>()->name();
-          const auto& it = dynstr_map.find(name);
-          if (it == std::end(dynstr_map)) {
+          const size_t offset = dynstr_map.offset(name);
+          if (offset == StringTable::npos) {
             LIEF_ERR("Can't find string offset in .dynstr for {}", name);
             break;
           }
-          entry->value(it->second);
+          entry->value(offset);
           break;
         }
 
       case DYNAMIC_TAGS::DT_RPATH:
         {
           const std::string& name = entry->as<DynamicEntryRpath>()->name();
-          const auto& it = dynstr_map.find(name);
-          if (it == std::end(dynstr_map)) {
+          const size_t offset = dynstr_map.offset(name);
+          if (offset == StringTable::npos) {
             LIEF_ERR("Can't find string offset in .dynstr for {}", name);
             break;
           }
-          entry->value(it->second);
+          entry->value(offset);
           break;
         }
 
       case DYNAMIC_TAGS::DT_RUNPATH:
         {
           const std::string& name = entry->as<DynamicEntryRunPath>()->name();
-          const auto& it = dynstr_map.find(name);
-          if (it == std::end(dynstr_map)) {
+          const size_t offset = dynstr_map.offset(name);
+          if (offset == StringTable::npos) {
             LIEF_ERR("Can't find string offset in .dynstr for {}", name);
             break;
           }
-          entry->value(it->second);
+          entry->value(offset);
           break;
         }
 
@@ -1221,7 +1132,7 @@ void Builder::build_obj_symbols() {
 
   using Elf_Sym  = typename ELF_T::Elf_Sym;
   const auto* layout = reinterpret_cast<const ObjectFileLayout*>(layout_.get());
-  const std::unordered_map<std::string, size_t>* str_map = nullptr;
+  const StringTable* str_map = nullptr;
 
   if (layout->is_strtab_shared_shstrtab()) {
     str_map = &layout->shstr_map();
@@ -1236,13 +1147,13 @@ void Builder::build_obj_symbols() {
   vector_iostream symbol_table_raw(should_swap());
   for (const Symbol* symbol : binary_->static_symbols_) {
     const std::string& name = symbol->name();
-    const auto& offset_it = str_map->find(name);
-    if (offset_it == std::end(*str_map)) {
+    const size_t offset = str_map->offset(name);
+    if (offset == StringTable::npos) {
       LIEF_ERR("Unable to find the symbol offset for '{}' in the string table", name);
       continue;
     }
 
-    const Elf_Off name_offset = static_cast<Elf_Off>(offset_it->second);
+    const Elf_Off name_offset = static_cast<Elf_Off>(offset);
 
     Elf_Sym sym_header;
     memset(&sym_header, 0, sizeof(Elf_Sym));
@@ -1283,13 +1194,13 @@ void Builder::build_dynamic_symbols() {
   vector_iostream symbol_table_raw(should_swap());
   for (const Symbol* symbol : binary_->dynamic_symbols_) {
     const std::string& name = symbol->name();
-    const auto& offset_it = dynstr_map.find(name);
-    if (offset_it == std::end(dynstr_map)) {
+    const size_t offset = dynstr_map.offset(name);
+    if (offset == StringTable::npos) {
       LIEF_ERR("Unable to find the symbol offset for '{}' in the string table", name);
       continue;
     }
 
-    const Elf_Off name_offset = static_cast<Elf_Off>(offset_it->second);
+    const Elf_Off name_offset = static_cast<Elf_Off>(offset);
 
     Elf_Sym sym_header;
 
@@ -1616,9 +1527,9 @@ void Builder::build_symbol_requirement() {
     const std::string& name = svr.name();
 
     Elf_Off name_offset = 0;
-    const auto& it_name_offset = sym_name_offset.find(name);
-    if (it_name_offset != std::end(sym_name_offset)) {
-      name_offset = it_name_offset->second;
+    const size_t dynstr_offset = sym_name_offset.offset(name);
+    if (dynstr_offset != StringTable::npos) {
+      name_offset = dynstr_offset;
     } else {
       LIEF_ERR("Can't find dynstr offset for '{}'", name);
       continue;
@@ -1647,9 +1558,9 @@ void Builder::build_symbol_requirement() {
 
       Elf_Off svar_name_offset = 0;
 
-      const auto& it_name_offset = sym_name_offset.find(svar_name);
-      if (it_name_offset != std::end(sym_name_offset)) {
-        svar_name_offset = it_name_offset->second;
+      const size_t dynstr_offset = sym_name_offset.offset(svar_name);
+      if (dynstr_offset != StringTable::npos) {
+        svar_name_offset = dynstr_offset;
       } else {
         LIEF_ERR("Can't find dynstr offset for '{}'", name);
         continue;
@@ -1735,9 +1646,9 @@ void Builder::build_symbol_definition() {
       const std::string& sva_name = sva.name();
 
       Elf_Off sva_name_offset = 0;
-      const auto& it_name_offset = sym_name_offset.find(sva_name);
-      if (it_name_offset != std::end(sym_name_offset)) {
-        sva_name_offset = it_name_offset->second;
+      const size_t dynstr_offset = sym_name_offset.offset(sva_name);
+      if (dynstr_offset != StringTable::npos) {
+        sva_name_offset = dynstr_offset;
       } else {
         LIEF_ERR("Can't find dynstr offset for '{}'", sva_name);
         continue;
@@ -1838,9 +1749,40 @@ void Builder::build_overlay() {
   const uint64_t last_offset = binary_->eof_offset();
 
   if (last_offset > 0) {
-    ios_.seekp(last_offset);
-    ios_.write(overlay);
+    this->write_at(last_offset, overlay);
+  }
+}
+
+
+template<typename T>
+void Builder::write_conv_at(uint64_t offset, const T& t) {
+  if (this->output_ != nullptr) {
+    this->output_->seekp(offset).write_conv<T>(t);
+    return;
+  }
+  this->ios_.seekp(offset);
+  this->ios_.write_conv<T>(t);
+}
+
+
+template<class T>
+void Builder::write_content(const T& object, uint64_t offset, uint64_t size) {
+  const DataHandler::Handler* handler = object.datahandler_;
+  if (handler != nullptr) {
+    const int fd = this->output_ != nullptr ? handler->source_fd(offset, size) : -1;
+    if (fd >= 0) {
+      // Unchanged region of the input file
+      this->output_->seekp(offset).copy_from(fd, offset, size);
+      return;
+    }
+
+    const uint8_t* data = handler->view(offset, size);
+    if (data != nullptr) {
+      this->write_at(offset, data, size);
+      return;
+    }
   }
+  this->write_at(offset, object.content());
 }
 
 } // namespace ELF
@@ -16,11 +16,14 @@
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
+#include <utility>
 
 #include "logging.hpp"
 
 #include "LIEF/BinaryStream/MemoryStream.hpp"
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/MmapStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
 
 #include "LIEF/ELF/DataHandler/Handler.hpp"
 #include "LIEF/exception.hpp"
@@ -30,8 +33,42 @@ namespace ELF {
 namespace DataHandler {
 
 Handler::Handler() = default;
-Handler& Handler::operator=(const Handler&) = default;
-Handler::Handler(const Handler&) = default;
+
+Handler& Handler::operator=(const Handler& other) {
+  if (&other == this) {
+    return *this;
+  }
+  Handler copy{other};
+  std::swap(this->data_,       copy.data_);
+  std::swap(this->arena_,      copy.arena_);
+  std::swap(this->free_nodes_, copy.free_nodes_);
+  std::swap(this->indexes_,    copy.indexes_);
+  std::swap(this->stream_,   copy.stream_);
+  std::swap(this->cow_stream_, copy.cow_stream_);
+  std::swap(this->raw_,      copy.raw_);
+  std::swap(this->cow_,      copy.cow_);
+  std::swap(this->raw_size_, copy.raw_size_);
+  std::swap(this->size_,     copy.size_);
+  std::swap(this->dirty_,    copy.dirty_);
+  ++this->version_;
+  return *this;
+}
+
+Handler::Handler(const Handler& other) :
+  data_{other.read(0, other.size())}
+{
+  // The copy must not share the copy-on-write pages of the original
+  for (size_t i = 0; i < other.indexes_.size(); ++i) {
+    const Index& from = other.indexes_[i];
+    Index& to = this->indexes_[i];
+    to.max_size = from.max_size;
+    to.nodes.reserve(from.nodes.size());
+    for (const Node* n : from.nodes) {
+      this->arena_.push_back(*n);
+      to.nodes.push_back(&this->arena_.back());
+    }
+  }
+}
 
 Handler::Handler(const std::vector<uint8_t>& content) :
   data_{content}
@@ -52,6 +89,20 @@ Handler::Handler(BinaryStream& stream) {
         break;
       }
 
+    case BinaryStream::STREAM_TYPE::MMAP:
+      {
+        auto& ms = static_cast<MmapStream&>(stream);
+        data_ = {ms.start(), ms.end()};
+        break;
+      }
+
+    case BinaryStream::STREAM_TYPE::SPAN:
+      {
+        auto& ss = static_cast<SpanStream&>(stream);
+        data_ = ss.content();
+        break;
+      }
+
     case BinaryStream::STREAM_TYPE::MEMORY:
       {
         throw std::runtime_error("Not impletemented yet");
@@ -66,38 +117,225 @@ Handler::Handler(BinaryStream& stream) {
   }
 }
 
-const std::vector<uint8_t>& Handler::content() const {
-  return this->data_;
+Handler::Handler(std::shared_ptr<BinaryStream> stream) {
+  switch (stream->type()) {
+    case BinaryStream::STREAM_TYPE::FILE:
+      {
+        auto& vs = static_cast<VectorStream&>(*stream);
+        this->raw_      = vs.start();
+        this->raw_size_ = vs.size();
+        break;
+      }
+
+    case BinaryStream::STREAM_TYPE::MMAP:
+      {
+        auto& ms = static_cast<MmapStream&>(*stream);
+        this->raw_      = ms.start();
+        this->raw_size_ = ms.size();
+        break;
+      }
+
+    case BinaryStream::STREAM_TYPE::SPAN:
+      {
+        // The buffer is read-only: it is copied on the first write (see writable())
+        auto& ss = static_cast<SpanStream&>(*stream);
+        this->raw_      = ss.start();
+        this->raw_size_ = ss.size();
+        break;
+      }
+
+    case BinaryStream::STREAM_TYPE::MEMORY:
+      {
+        throw std::runtime_error("Not impletemented yet");
+        break;
+      }
+
+    case BinaryStream::STREAM_TYPE::UNKNOWN:
+    default:
+      {
+        LIEF_ERR("Unknown stream type!");
+        return;
+      }
+  }
+  this->size_   = this->raw_size_;
+  this->stream_ = std::move(stream);
+}
+
+uint64_t Handler::size() const {
+  return this->is_borrowed() ? this->size_ : this->data_.size();
+}
+
+bool Handler::is_borrowed() const {
+  return this->stream_ != nullptr;
+}
+
+const uint8_t* Handler::view(uint64_t offset, uint64_t size) const {
+  if (not this->is_borrowed()) {
+    if (offset > this->data_.size() or size > (this->data_.size() - offset)) {
+      return nullptr;
+    }
+    return this->data_.data() + offset;
+  }
+
+  if (offset > this->raw_size_ or size > (this->raw_size_ - offset)) {
+    return nullptr;
+  }
+  return this->raw_ + offset;
+}
+
+std::vector<uint8_t> Handler::read(uint64_t offset, uint64_t size) const {
+  if (offset > this->size() or size > (this->size() - offset)) {
+    return {};
+  }
+
+  const uint8_t* data = this->view(offset, size);
+  if (data != nullptr) {
+    return {data, data + size};
+  }
+
+  // Range partially backed by the stream: the reserved bytes are zeros
+  std::vector<uint8_t> result(size, 0);
+  if (offset < this->raw_size_) {
+    std::copy(this->raw_ + offset, this->raw_ + this->raw_size_, result.data());
+  }
+  return result;
+}
+
+int Handler::source_fd(uint64_t offset, uint64_t size) const {
+  if (not this->is_borrowed() or this->stream_->type() != BinaryStream::STREAM_TYPE::MMAP) {
+    return -1;
+  }
+
+  if (offset > this->raw_size_ or size > (this->raw_size_ - offset)) {
+    return -1;
+  }
+
+  const uint64_t end = offset + size;
+  for (const std::pair<uint64_t, uint64_t>& range : this->dirty_) {
+    if (offset < range.second and range.first < end) {
+      return -1;
+    }
+  }
+  return static_cast<const MmapStream&>(*this->stream_).fd();
+}
+
+uint64_t Handler::version() const {
+  return this->version_;
+}
+
+uint8_t* Handler::writable(uint64_t offset, uint64_t size) {
+  this->reserve(offset, size);
+  ++this->version_;
+
+  if (this->is_borrowed()) {
+    if ((offset + size) <= this->raw_size_ and this->cow_ == nullptr and
+        this->stream_->type() == BinaryStream::STREAM_TYPE::MMAP)
+    {
+      // The input stream can still be read after the modifications (e.g. by the
+      // lazy tables): the writes go in a private mapping of the file
+      this->cow_stream_ = static_cast<const MmapStream&>(*this->stream_).private_copy();
+      if (this->cow_stream_ != nullptr) {
+        this->cow_ = this->cow_stream_->cow_start();
+        this->raw_ = this->cow_;
+      }
+    }
+
+    if ((offset + size) <= this->raw_size_ and this->cow_ != nullptr) {
+      const uint64_t end = offset + size;
+      // Consecutive writes usually target the same area
+      if (not this->dirty_.empty() and offset <= this->dirty_.back().second and
+          end >= this->dirty_.back().first) {
+        auto& last = this->dirty_.back();
+        last = {std::min(last.first, offset), std::max(last.second, end)};
+      } else {
+        this->dirty_.emplace_back(offset, end);
+      }
+      return this->cow_ + offset;
+    }
+    this->materialize();
+  }
+  return this->data_.data() + offset;
+}
+
+void Handler::materialize() {
+  if (not this->is_borrowed()) {
+    return;
+  }
+  LIEF_DEBUG("Copy 0x{:x} bytes from the input stream", this->raw_size_);
+  this->data_.reserve(this->size_);
+  this->data_.assign(this->raw_, this->raw_ + this->raw_size_);
+  this->data_.resize(this->size_, 0);
+
+  this->stream_   = nullptr;
+  this->cow_stream_ = nullptr;
+  this->raw_      = nullptr;
+  this->cow_      = nullptr;
+  this->raw_size_ = 0;
+  this->size_     = 0;
+  this->dirty_.clear();
 }
 
 std::vector<uint8_t>& Handler::content() {
-  return const_cast<std::vector<uint8_t>&>(static_cast<const Handler*>(this)->content());
+  this->materialize();
+  ++this->version_;
+  return this->data_;
 }
 
-bool Handler::has(uint64_t offset, uint64_t size, Node::Type type) {
-  Node tmp{offset, size, type};
-  auto&& it_node = std::find_if(
-      std::begin(this->nodes_),
-      std::end(this->nodes_),
-      [&tmp] (const Node* node)
-      {
-        return tmp == *node;
+namespace {
+inline bool key_lt(const Node* lhs, const Node* rhs) {
+  return std::make_pair(lhs->offset(), lhs->size()) < std::make_pair(rhs->offset(), rhs->size());
+}
+}
+
+Handler::Index& Handler::index(Node::Type type) {
+  const size_t idx = std::min<size_t>(type, Node::UNKNOWN);
+  return this->indexes_[idx];
+}
+
+Handler::it_index_t Handler::lookup(Index& idx, uint64_t offset, uint64_t size) {
+  auto&& it_node = std::lower_bound(
+      std::begin(idx.nodes),
+      std::end(idx.nodes),
+      std::make_pair(offset, size),
+      [] (const Node* node, const std::pair<uint64_t, uint64_t>& key) {
+        return std::make_pair(node->offset(), node->size()) < key;
       });
-  return it_node != std::end(this->nodes_);
+
+  if (it_node != std::end(idx.nodes) and
+      (*it_node)->offset() == offset and (*it_node)->size() == size) {
+    return it_node;
+  }
+  return std::end(idx.nodes);
 }
 
-Node& Handler::get(uint64_t offset, uint64_t size, Node::Type type) {
-  Node tmp{offset, size, type};
+Node& Handler::insert(const Node& node) {
+  Node* new_node = nullptr;
+  if (not this->free_nodes_.empty()) {
+    new_node = this->free_nodes_.back();
+    this->free_nodes_.pop_back();
+    *new_node = node;
+  } else {
+    this->arena_.push_back(node);
+    new_node = &this->arena_.back();
+  }
+
+  Index& idx = this->index(new_node->type());
+  auto&& it_pos = std::upper_bound(std::begin(idx.nodes), std::end(idx.nodes), new_node, key_lt);
+  idx.nodes.insert(it_pos, new_node);
+  idx.max_size = std::max(idx.max_size, new_node->size());
+  return *new_node;
+}
+
+bool Handler::has(uint64_t offset, uint64_t size, Node::Type type) {
+  Index& idx = this->index(type);
+  return this->lookup(idx, offset, size) != std::end(idx.nodes);
+}
 
-  auto&& it_node = std::find_if(
-        std::begin(this->nodes_),
-        std::end(this->nodes_),
-        [&tmp] (const Node* node)
-        {
-          return tmp == *node;
-        });
+Node& Handler::get(uint64_t offset, uint64_t size, Node::Type type) {
+  Index& idx = this->index(type);
+  auto&& it_node = this->lookup(idx, offset, size);
 
-  if (it_node != std::end(this->nodes_)) {
+  if (it_node != std::end(idx.nodes)) {
     return **it_node;
   } else {
     throw not_found("Unable to find node");
@@ -106,20 +344,12 @@ Node& Handler::get(uint64_t offset, uint64_t size, Node::Type type) {
 
 
 void Handler::remove(uint64_t offset, uint64_t size, Node::Type type) {
+  Index& idx = this->index(type);
+  auto&& it_node = this->lookup(idx, offset, size);
 
-  Node tmp{offset, size, type};
-
-  auto&& it_node = std::find_if(
-        std::begin(this->nodes_),
-        std::end(this->nodes_),
-        [&tmp] (const Node* node)
-        {
-          return tmp == *node;
-        });
-
-  if (it_node != std::end(this->nodes_)) {
-    delete *it_node;
-    this->nodes_.erase(it_node);
+  if (it_node != std::end(idx.nodes)) {
+    this->free_nodes_.push_back(*it_node);
+    idx.nodes.erase(it_node);
   } else {
     throw not_found("Unable to find node");
   }
@@ -127,19 +357,83 @@ void Handler::remove(uint64_t offset, uint64_t size, Node::Type type) {
 
 
 Node& Handler::create(uint64_t offset, uint64_t size, Node::Type type) {
-  this->nodes_.emplace_back(new Node{offset, size, type});
-  return *this->nodes_.back();
+  return this->insert({offset, size, type});
 }
 
 
 Node& Handler::add(const Node& node) {
-  this->nodes_.push_back(new Node{node});
-  return *this->nodes_.back();
+  return this->insert(node);
+}
+
+
+void Handler::move(Node& node, uint64_t offset, uint64_t size) {
+  Index& idx = this->index(node.type());
+  auto&& range = std::equal_range(std::begin(idx.nodes), std::end(idx.nodes), &node, key_lt);
+  auto&& it_node = std::find(range.first, range.second, &node);
+  if (it_node == range.second) {
+    throw not_found("Unable to find node");
+  }
+  idx.nodes.erase(it_node);
+
+  node.offset(offset);
+  node.size(size);
+
+  auto&& it_pos = std::upper_bound(std::begin(idx.nodes), std::end(idx.nodes), &node, key_lt);
+  idx.nodes.insert(it_pos, &node);
+  idx.max_size = std::max(idx.max_size, size);
+}
+
+
+void Handler::shift(uint64_t from, uint64_t shift, Node::Type type) {
+  Index& idx = this->index(type);
+  auto&& it_node = std::lower_bound(
+      std::begin(idx.nodes),
+      std::end(idx.nodes),
+      from,
+      [] (const Node* node, uint64_t offset) {
+        return node->offset() < offset;
+      });
+
+  // The shifted nodes keep the same relative order and remain after the
+  // nodes located before ``from``: the index doesn't need to be sorted again
+  for (; it_node != std::end(idx.nodes); ++it_node) {
+    (*it_node)->offset((*it_node)->offset() + shift);
+  }
+}
+
+
+std::vector<Node*> Handler::overlapping(uint64_t offset, uint64_t size, Node::Type type) {
+  std::vector<Node*> result;
+  if (size == 0) {
+    return result;
+  }
+
+  Index& idx = this->index(type);
+  const uint64_t end = offset + size;
+  // A node that starts before ``offset - max_size`` can't reach ``offset``
+  const uint64_t lower = offset > idx.max_size ? offset - idx.max_size : 0;
+
+  auto&& it_node = std::lower_bound(
+      std::begin(idx.nodes),
+      std::end(idx.nodes),
+      lower,
+      [] (const Node* node, uint64_t offset) {
+        return node->offset() < offset;
+      });
+
+  for (; it_node != std::end(idx.nodes) and (*it_node)->offset() < end; ++it_node) {
+    if (((*it_node)->offset() + (*it_node)->size()) > offset) {
+      result.push_back(*it_node);
+    }
+  }
+  return result;
 }
 
 void Handler::make_hole(uint64_t offset, uint64_t size) {
   this->reserve(offset, size);
+  this->materialize();
   this->data_.insert(std::begin(this->data_) + offset, size, 0);
+  ++this->version_;
 }
 
 
@@ -147,16 +441,19 @@ void Handler::reserve(uint64_t offset, uint64_t size) {
   if ((offset + size) > Handler::MAX_SIZE) {
     throw std::bad_alloc();
   }
+
+  if (this->is_borrowed()) {
+    // Reserved bytes are virtually zero-filled until they are written
+    this->size_ = std::max<uint64_t>(this->size_, offset + size);
+    return;
+  }
+
   if (this->data_.size() < (offset + size)) {
     this->data_.resize((offset + size), 0);
   }
 }
 
-Handler::~Handler() {
-  for (Node* n : this->nodes_) {
-    delete n;
-  }
-}
+Handler::~Handler() = default;
 
 } // namespace DataHandler
 } // namespace ELF
@@ -0,0 +1,522 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+  #include <glob.h>
+  #define LIEF_HAS_GLOB
+#endif
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "logging.hpp"
+
+#include "LIEF/exception.hpp"
+
+#include "LIEF/ELF/DependencyResolver.hpp"
+#include "LIEF/ELF/Binary.hpp"
+#include "LIEF/ELF/DynamicEntryLibrary.hpp"
+#include "LIEF/ELF/DynamicEntryRpath.hpp"
+#include "LIEF/ELF/DynamicEntryRunPath.hpp"
+#include "LIEF/ELF/DynamicSharedObject.hpp"
+#include "LIEF/ELF/Parser.hpp"
+#include "LIEF/ELF/Symbol.hpp"
+#include "LIEF/ELF/SymbolVersion.hpp"
+#include "LIEF/ELF/SymbolVersionAux.hpp"
+#include "LIEF/ELF/utils.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+namespace {
+static constexpr size_t NO_PARENT       = static_cast<size_t>(-1);
+static constexpr size_t MAX_CONF_DEPTH  = 8;
+
+// Identity of a file: a library replaced on the disk gets a new entry in the cache
+struct file_id_t {
+  uint64_t dev   = 0;
+  uint64_t ino   = 0;
+  int64_t  mtime = 0;
+  int64_t  mtime_nsec = 0;
+
+  bool operator==(const file_id_t& rhs) const {
+    return this->dev == rhs.dev and this->ino == rhs.ino and
+           this->mtime == rhs.mtime and this->mtime_nsec == rhs.mtime_nsec;
+  }
+};
+
+struct file_id_hash_t {
+  size_t operator()(const file_id_t& id) const {
+    size_t h = std::hash<uint64_t>{}(id.ino);
+    h ^= std::hash<uint64_t>{}(id.dev)   + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int64_t>{}(id.mtime)  + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+  }
+};
+
+//! Return false if ``path`` is not a regular file
+bool get_file_id(const std::string& path, file_id_t& id) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0 or (st.st_mode & S_IFMT) != S_IFREG) {
+    return false;
+  }
+  id.dev   = static_cast<uint64_t>(st.st_dev);
+  id.ino   = static_cast<uint64_t>(st.st_ino);
+  id.mtime = static_cast<int64_t>(st.st_mtime);
+#if defined(__linux__)
+  id.mtime_nsec = static_cast<int64_t>(st.st_mtim.tv_nsec);
+#endif
+  return true;
+}
+
+//! Process-wide LRU cache of the parsed libraries
+class LibraryCache {
+  public:
+  static LibraryCache& instance() {
+    static LibraryCache cache;
+    return cache;
+  }
+
+  //! Return the binary located at ``path`` (parsed if it is not in the cache)
+  //! or a nullptr if it is not an ELF binary. ``id`` is set to the identity of the file
+  std::shared_ptr<const Binary> get(const std::string& path, file_id_t& id) {
+    if (not get_file_id(path, id)) {
+      return nullptr;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      auto it = this->index_.find(id);
+      if (it != std::end(this->index_)) {
+        this->lru_.splice(std::begin(this->lru_), this->lru_, it->second);
+        return it->second->second;
+      }
+    }
+
+    // Parse outside of the lock: two threads may parse the same library
+    // but the first one that is inserted is kept
+    std::shared_ptr<const Binary> binary = parse(path);
+    if (binary == nullptr) {
+      return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    auto it = this->index_.find(id);
+    if (it != std::end(this->index_)) {
+      this->lru_.splice(std::begin(this->lru_), this->lru_, it->second);
+      return it->second->second;
+    }
+
+    if (this->capacity_ == 0) {
+      return binary;
+    }
+
+    this->lru_.emplace_front(id, binary);
+    this->index_.emplace(id, std::begin(this->lru_));
+    this->shrink();
+    return binary;
+  }
+
+  void capacity(size_t size) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->capacity_ = size;
+    this->shrink();
+  }
+
+  size_t capacity() {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->capacity_;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->index_.clear();
+    this->lru_.clear();
+  }
+
+  private:
+  using entry_t = std::pair<file_id_t, std::shared_ptr<const Binary>>;
+
+  static std::shared_ptr<const Binary> parse(const std::string& path) {
+    if (not is_elf(path)) {
+      return nullptr;
+    }
+
+    // The cached binaries are shared by several threads: all the tables are loaded
+    // (Binary::load is not synchronized) and the lookup state is initialized here
+    try {
+      std::shared_ptr<Binary> binary = Parser::parse(path, ParserConfig::quick());
+      if (binary != nullptr) {
+        binary->load_all();
+        binary->lookup_dynamic_symbol("");
+      }
+      return binary;
+    } catch (const exception& e) {
+      LIEF_WARN("Can't parse '{}': {}", path, e.what());
+    }
+    return nullptr;
+  }
+
+  // Remove the least recently used binaries (they remain alive as long as a closure uses them)
+  void shrink() {
+    while (this->lru_.size() > this->capacity_) {
+      this->index_.erase(this->lru_.back().first);
+      this->lru_.pop_back();
+    }
+  }
+
+  std::list<entry_t> lru_;
+  std::unordered_map<file_id_t, std::list<entry_t>::iterator, file_id_hash_t> index_;
+  size_t     capacity_ = 256;
+  std::mutex mutex_;
+};
+
+std::string dirname(const std::string& path) {
+  const size_t pos = path.rfind('/');
+  if (pos == std::string::npos) {
+    return ".";
+  }
+  return pos == 0 ? "/" : path.substr(0, pos);
+}
+
+std::string join(const std::string& dir, const std::string& name) {
+  if (dir.empty()) {
+    return name;
+  }
+  return dir.back() == '/' ? dir + name : dir + "/" + name;
+}
+
+void replace_all(std::string& str, const std::string& token, const std::string& value) {
+  size_t pos = 0;
+  while ((pos = str.find(token, pos)) != std::string::npos) {
+    str.replace(pos, token.size(), value);
+    pos += value.size();
+  }
+}
+
+//! Expand the *Dynamic String Tokens* supported by the resolver
+std::string expand(std::string path, const std::string& origin, ELF_CLASS cls) {
+  const std::string lib = cls == ELF_CLASS::ELFCLASS64 ? "lib64" : "lib";
+  replace_all(path, "${ORIGIN}", origin);
+  replace_all(path, "$ORIGIN",   origin);
+  replace_all(path, "${LIB}",    lib);
+  replace_all(path, "$LIB",      lib);
+  return path;
+}
+
+std::vector<std::string> paths_of(const Binary& binary, DYNAMIC_TAGS tag) {
+  if (not binary.has(tag)) {
+    return {};
+  }
+  const DynamicEntry& entry = binary.get(tag);
+  if (const auto* rpath = dynamic_cast<const DynamicEntryRpath*>(&entry)) {
+    return rpath->paths();
+  }
+  if (const auto* runpath = dynamic_cast<const DynamicEntryRunPath*>(&entry)) {
+    return runpath->paths();
+  }
+  return {};
+}
+}
+
+
+DependencyResolver::DependencyResolver() :
+  sysroot_{"/"},
+  default_paths_{"/lib64", "/usr/lib64", "/lib", "/usr/lib"}
+{}
+
+DependencyResolver::~DependencyResolver() = default;
+
+
+DependencyResolver& DependencyResolver::sysroot(const std::string& root) {
+  this->sysroot_ = root;
+  this->ld_so_conf_read_ = false;
+  this->ld_so_conf_paths_.clear();
+  return *this;
+}
+
+const std::string& DependencyResolver::sysroot() const {
+  return this->sysroot_;
+}
+
+DependencyResolver& DependencyResolver::library_paths(const std::vector<std::string>& paths) {
+  this->library_paths_ = paths;
+  return *this;
+}
+
+const std::vector<std::string>& DependencyResolver::library_paths() const {
+  return this->library_paths_;
+}
+
+DependencyResolver& DependencyResolver::default_paths(const std::vector<std::string>& paths) {
+  this->default_paths_ = paths;
+  return *this;
+}
+
+const std::vector<std::string>& DependencyResolver::default_paths() const {
+  return this->default_paths_;
+}
+
+DependencyResolver& DependencyResolver::bind_symbols(bool flag) {
+  this->bind_symbols_ = flag;
+  return *this;
+}
+
+bool DependencyResolver::bind_symbols() const {
+  return this->bind_symbols_;
+}
+
+
+void DependencyResolver::cache_size(size_t size) {
+  LibraryCache::instance().capacity(size);
+}
+
+size_t DependencyResolver::cache_size() {
+  return LibraryCache::instance().capacity();
+}
+
+void DependencyResolver::clear_cache() {
+  LibraryCache::instance().clear();
+}
+
+
+std::string DependencyResolver::host_path(const std::string& path) const {
+  if (this->sysroot_.empty() or this->sysroot_ == "/") {
+    return path;
+  }
+  std::string root = this->sysroot_;
+  if (root.back() == '/') {
+    root.pop_back();
+  }
+  return path.empty() or path.front() != '/' ? root + "/" + path : root + path;
+}
+
+
+const std::vector<std::string>& DependencyResolver::ld_so_conf_paths() const {
+  if (this->ld_so_conf_read_) {
+    return this->ld_so_conf_paths_;
+  }
+  this->ld_so_conf_read_ = true;
+
+  // Files to process with their include depth
+  std::vector<std::pair<std::string, size_t>> files = {{"/etc/ld.so.conf", 0}};
+  while (not files.empty()) {
+    const std::string file  = files.back().first;
+    const size_t      depth = files.back().second;
+    files.pop_back();
+
+    std::ifstream ifs(this->host_path(file));
+    std::string line;
+    while (std::getline(ifs, line)) {
+      line = line.substr(0, line.find('#'));
+      const size_t start = line.find_first_not_of(" \t\r");
+      if (start == std::string::npos) {
+        continue;
+      }
+      line = line.substr(start, line.find_last_not_of(" \t\r") - start + 1);
+
+      if (line.compare(0, 8, "include ") == 0 or line.compare(0, 8, "include\t") == 0) {
+        if (depth >= MAX_CONF_DEPTH) {
+          continue;
+        }
+        std::string pattern = line.substr(line.find_first_not_of(" \t", 8));
+        if (pattern.front() != '/') {
+          pattern = join(dirname(file), pattern);
+        }
+#if defined(LIEF_HAS_GLOB)
+        glob_t result;
+        const std::string host_pattern = this->host_path(pattern);
+        if (glob(host_pattern.c_str(), 0, nullptr, &result) == 0) {
+          // Processed in the order of the glob (sorted) as files is a stack
+          const size_t prefix = host_pattern.size() - pattern.size();
+          for (size_t i = result.gl_pathc; i > 0; --i) {
+            files.emplace_back(std::string{result.gl_pathv[i - 1]}.substr(prefix), depth + 1);
+          }
+        }
+        globfree(&result);
+#endif
+        continue;
+      }
+
+      if (line.compare(0, 6, "hwcap ") == 0) {
+        continue;
+      }
+      this->ld_so_conf_paths_.push_back(line);
+    }
+  }
+  return this->ld_so_conf_paths_;
+}
+
+
+DependencyResolver::closure_t DependencyResolver::resolve(const std::string& path) const {
+  closure_t closure;
+  LibraryCache& cache = LibraryCache::instance();
+
+  file_id_t id;
+  std::shared_ptr<const Binary> main = cache.get(this->host_path(path), id);
+  if (main == nullptr) {
+    throw bad_file("'" + path + "' is not an ELF binary");
+  }
+
+  const ELF_CLASS cls  = main->header().identity_class();
+  const ARCH      arch = main->header().machine_type();
+
+  std::vector<library_t>& libraries = closure.libraries;
+  std::vector<size_t> loaders; // Index of the library that loads the i-th library
+
+  // DT_NEEDED names, SONAMEs and files already processed
+  std::unordered_map<std::string, size_t> names;
+  std::unordered_map<file_id_t, size_t, file_id_hash_t> files;
+
+  auto&& add_library = [&] (const std::string& name, const std::string& lib_path,
+                            std::shared_ptr<const Binary> binary, const file_id_t& id, size_t loader) {
+    const size_t idx = libraries.size();
+    files.emplace(id, idx);
+    names.emplace(name, idx);
+    if (binary->has(DYNAMIC_TAGS::DT_SONAME)) {
+      const auto& soname = dynamic_cast<const DynamicSharedObject&>(binary->get(DYNAMIC_TAGS::DT_SONAME));
+      names.emplace(soname.name(), idx);
+    }
+    libraries.push_back({name, lib_path, std::move(binary)});
+    loaders.push_back(loader);
+  };
+
+  add_library(path, path, main, id, NO_PARENT);
+
+  for (size_t i = 0; i < libraries.size(); ++i) {
+    std::shared_ptr<const Binary> requester = libraries[i].binary;
+    const bool has_runpath = requester->has(DYNAMIC_TAGS::DT_RUNPATH);
+
+    for (const DynamicEntry& entry : requester->dynamic_entries()) {
+      if (entry.tag() != DYNAMIC_TAGS::DT_NEEDED) {
+        continue;
+      }
+      const std::string& name = dynamic_cast<const DynamicEntryLibrary&>(entry).name();
+      if (names.count(name) > 0) {
+        continue;
+      }
+
+      // Directories to search (with the $ORIGIN to use) in the order of ld.so
+      std::vector<std::pair<std::string, std::string>> candidates;
+      if (name.find('/') != std::string::npos) {
+        candidates.emplace_back(expand(name, dirname(libraries[i].path), cls), "path");
+      } else {
+        if (not has_runpath) {
+          for (size_t j = i; j != NO_PARENT; j = loaders[j]) {
+            const std::string origin = dirname(libraries[j].path);
+            for (const std::string& dir : paths_of(*libraries[j].binary, DYNAMIC_TAGS::DT_RPATH)) {
+              candidates.emplace_back(join(expand(dir, origin, cls), name), "DT_RPATH");
+            }
+          }
+        }
+        for (const std::string& dir : this->library_paths_) {
+          candidates.emplace_back(join(dir, name), "library path");
+        }
+        for (const std::string& dir : paths_of(*requester, DYNAMIC_TAGS::DT_RUNPATH)) {
+          candidates.emplace_back(join(expand(dir, dirname(libraries[i].path), cls), name), "DT_RUNPATH");
+        }
+        for (const std::string& dir : this->ld_so_conf_paths()) {
+          candidates.emplace_back(join(dir, name), "ld.so.conf");
+        }
+        for (const std::string& dir : this->default_paths_) {
+          candidates.emplace_back(join(dir, name), "default path");
+        }
+      }
+
+      bool found = false;
+      for (const std::pair<std::string, std::string>& candidate : candidates) {
+        std::shared_ptr<const Binary> binary = cache.get(this->host_path(candidate.first), id);
+        if (binary == nullptr) {
+          continue;
+        }
+        if (binary->header().identity_class() != cls or binary->header().machine_type() != arch) {
+          LIEF_DEBUG("Skip {}: wrong class or architecture", candidate.first);
+          continue;
+        }
+        LIEF_DEBUG("{} -> {} ({})", name, candidate.first, candidate.second);
+
+        // Same file as an already loaded library (e.g. through a symlink)
+        auto it = files.find(id);
+        if (it != std::end(files)) {
+          names.emplace(name, it->second);
+        } else {
+          add_library(name, candidate.first, std::move(binary), id, i);
+        }
+        found = true;
+        break;
+      }
+
+      if (not found) {
+        LIEF_DEBUG("Can't find {} (needed by {})", name, libraries[i].path);
+        closure.missing.push_back(name);
+        names.emplace(name, NO_PARENT);
+      }
+    }
+  }
+
+  if (not this->bind_symbols_) {
+    return closure;
+  }
+
+  std::vector<const Binary*> scope;
+  scope.reserve(libraries.size());
+  for (const library_t& library : libraries) {
+    scope.push_back(library.binary.get());
+  }
+
+  for (const Binary* binary : scope) {
+    std::vector<const Symbol*> imports;
+    std::vector<std::string>   imports_names;
+    std::vector<std::string>   imports_versions;
+    for (const Symbol& symbol : binary->dynamic_symbols()) {
+      if (symbol.shndx() != static_cast<uint16_t>(SYMBOL_SECTION_INDEX::SHN_UNDEF) or symbol.name().empty() or
+          (symbol.binding() != SYMBOL_BINDINGS::STB_GLOBAL and symbol.binding() != SYMBOL_BINDINGS::STB_WEAK)) {
+        continue;
+      }
+      imports.push_back(&symbol);
+      imports_names.push_back(symbol.name());
+
+      // Version required by the DT_VERNEED entry of the import (if any)
+      std::string version;
+      if (symbol.has_version()) {
+        const SymbolVersion& symbol_version = symbol.symbol_version();
+        if ((symbol_version.value() & 0x7fff) >= 2 and symbol_version.has_auxiliary_version()) {
+          version = symbol_version.symbol_version_auxiliary().name();
+        }
+      }
+      imports_versions.push_back(std::move(version));
+    }
+
+    const std::vector<std::pair<const Binary*, const Symbol*>> resolved =
+      Binary::lookup_dynamic_symbols(scope, imports_names, imports_versions);
+
+    for (size_t i = 0; i < imports.size(); ++i) {
+      binding_t binding;
+      binding.binary     = binary;
+      binding.symbol     = imports[i];
+      binding.provider   = resolved[i].first;
+      binding.definition = resolved[i].second;
+      closure.bindings.push_back(binding);
+    }
+  }
+  return closure;
+}
+
+}
+}
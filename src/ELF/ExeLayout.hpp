@@ -40,40 +40,34 @@ class LIEF_LOCAL ExeLayout : public Layout {
       return raw_dynstr_.size();
     }
     LIEF_SW_START(sw);
+    // All the strings are merged in a single table such as a
+    // string can share the bytes of another one (suffix)
+    offset_name_map_.reserve(binary_->dynamic_symbols_.size());
+
     // Start with dynamic entries: NEEDED / SONAME etc
-    vector_iostream raw_dynstr;
-    raw_dynstr.write<uint8_t>(0);
     for (DynamicEntry* entry : binary_->dynamic_entries_) {
       switch (entry->tag()) {
       case DYNAMIC_TAGS::DT_NEEDED:
         {
-          const std::string& name = entry->as<DynamicEntryLibrary>()->name();
-          offset_name_map_[name] = raw_dynstr.tellp();
-          raw_dynstr.write(name);
+          offset_name_map_.add(entry->as<DynamicEntryLibrary>()->name());
           break;
         }
 
       case DYNAMIC_TAGS::DT_SONAME:
         {
-          const std::string& name = entry->as<DynamicSharedObject>()->name();
-          offset_name_map_[name] = raw_dynstr.tellp();
-          raw_dynstr.write(name);
+          offset_name_map_.add(entry->as<DynamicSharedObject>()->name());
           break;
         }
 
       case DYNAMIC_TAGS::DT_RPATH:
         {
-          const std::string& name = entry->as<DynamicEntryRpath>()->name();
-          offset_name_map_[name] = raw_dynstr.tellp();
-          raw_dynstr.write(name);
+          offset_name_map_.add(entry->as<DynamicEntryRpath>()->name());
           break;
         }
 
       case DYNAMIC_TAGS::DT_RUNPATH:
         {
-          const std::string& name = entry->as<DynamicEntryRunPath>()->name();
-          offset_name_map_[name] = raw_dynstr.tellp();
-          raw_dynstr.write(name);
+          offset_name_map_.add(entry->as<DynamicEntryRunPath>()->name());
           break;
         }
 
@@ -82,58 +76,29 @@ class LIEF_LOCAL ExeLayout : public Layout {
     }
 
     // Dynamic symbols names
-    size_t offset_counter = raw_dynstr.tellp();
-    std::vector<std::string> string_table_optimized =
-      Builder::optimize<Symbol, decltype(binary_->dynamic_symbols_)>(binary_->dynamic_symbols_,
-                                    [] (const Symbol* sym) { return sym->name(); },
-                                    offset_counter,
-                                    &offset_name_map_);
-    for (const std::string& name : string_table_optimized) {
-      raw_dynstr.write(name);
+    for (const Symbol* symbol : binary_->dynamic_symbols_) {
+      offset_name_map_.add(symbol->name());
     }
 
     // Symbol definition
     for (const SymbolVersionDefinition& svd: binary_->symbols_version_definition()) {
       for (const SymbolVersionAux& sva : svd.symbols_aux()) {
-        const std::string& sva_name = sva.name();
-        auto it = offset_name_map_.find(sva_name);
-        if (it != std::end(offset_name_map_)) {
-          continue;
-        }
-        offset_name_map_[sva_name] = raw_dynstr.tellp();
-        raw_dynstr.write(sva_name);
+        offset_name_map_.add(sva.name());
       }
     }
+
     // Symbol version requirement
     for (const SymbolVersionRequirement& svr: binary_->symbols_version_requirement()) {
-      const std::string& libname = svr.name();
-      auto it = offset_name_map_.find(libname);
-      if (it == std::end(offset_name_map_)) {
-        offset_name_map_[libname] = raw_dynstr.tellp();
-        raw_dynstr.write(libname);
-      }
+      offset_name_map_.add(svr.name());
       for (const SymbolVersionAuxRequirement& svar : svr.auxiliary_symbols()) {
-        const std::string& name = svar.name();
-        auto it = offset_name_map_.find(name);
-        if (it != std::end(offset_name_map_)) {
-          continue;
-        }
-        offset_name_map_[name] = raw_dynstr.tellp();
-        raw_dynstr.write(name);
-      }
-    }
-    // Symbol version definition
-    for (const SymbolVersionDefinition& svd: binary_->symbols_version_definition()) {
-      for (const SymbolVersionAux& svar : svd.symbols_aux()) {
-        const std::string& name = svar.name();
-        auto it = offset_name_map_.find(name);
-        if (it != std::end(offset_name_map_)) {
-          continue;
-        }
-        offset_name_map_[name] = raw_dynstr.tellp();
-        raw_dynstr.write(name);
+        offset_name_map_.add(svar.name());
       }
     }
+
+    vector_iostream raw_dynstr;
+    raw_dynstr.write<uint8_t>(0);
+    offset_name_map_.finalize(raw_dynstr.tellp());
+    offset_name_map_.write(raw_dynstr);
     raw_dynstr.move(raw_dynstr_);
     LIEF_SW_END(".dynstr values computed in {}", duration_cast<std::chrono::milliseconds>(sw.elapsed()));
     return raw_dynstr_.size();
@@ -1038,7 +1003,7 @@ class LIEF_LOCAL ExeLayout : public Layout {
     }
   }
 
-  inline const std::unordered_map<std::string, size_t>& dynstr_map() const {
+  inline const StringTable& dynstr_map() const {
     return offset_name_map_;
   }
 
@@ -1055,7 +1020,7 @@ class LIEF_LOCAL ExeLayout : public Layout {
   private:
   ExeLayout() = delete;
 
-  std::unordered_map<std::string, size_t> offset_name_map_;
+  StringTable offset_name_map_;
   std::unordered_map<const Note*, size_t> notes_off_map_;
 
   std::vector<uint8_t> raw_notes_;
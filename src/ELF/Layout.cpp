@@ -46,24 +46,19 @@ size_t Layout::section_strtab_size() {
     return 0;
   }
 
-  vector_iostream raw_strtab;
-  raw_strtab.write<uint8_t>(0);
-
-  size_t offset_counter = raw_strtab.tellp();
-
   if (binary_->static_symbols_.size() == 0) {
     return 0;
   }
 
-  offset_counter = raw_strtab.tellp();
-  std::vector<std::string> symstr_opt =
-    Builder::optimize<Symbol, decltype(binary_->static_symbols_)>(binary_->static_symbols_,
-                     [] (const Symbol* sym) { return sym->name(); },
-                     offset_counter,
-                     &strtab_name_map_);
-  for (const std::string& name : symstr_opt) {
-    raw_strtab.write(name);
+  vector_iostream raw_strtab;
+  raw_strtab.write<uint8_t>(0);
+
+  strtab_name_map_.reserve(binary_->static_symbols_.size());
+  for (const Symbol* sym : binary_->static_symbols_) {
+    strtab_name_map_.add(sym->name());
   }
+  strtab_name_map_.finalize(raw_strtab.tellp());
+  strtab_name_map_.write(raw_strtab);
   raw_strtab.move(raw_strtab_);
   return raw_strtab_.size();
 }
@@ -80,32 +75,23 @@ size_t Layout::section_shstr_size() {
   // start with a null entry.
   raw_shstrtab.write<uint8_t>(0);
 
-  // First write section names
-  size_t offset_counter = raw_shstrtab.tellp();
-  std::vector<std::string> shstrtab_opt =
-    Builder::optimize<Section, decltype(binary_->sections_)>(binary_->sections_,
-                      [] (const Section* sec) { return sec->name(); },
-                      offset_counter,
-                      &shstr_name_map_);
-
-  for (const std::string& name : shstrtab_opt) {
-    raw_shstrtab.write(name);
+  // Section names
+  shstr_name_map_.reserve(binary_->sections_.size());
+  for (const Section* sec : binary_->sections_) {
+    shstr_name_map_.add(sec->name());
   }
 
   // Check if the .shstrtab and the .strtab are shared (optimization used by clang)
   // in this case, include the static symbol names
   if (binary_->static_symbols_.size() > 0 and is_strtab_shared_shstrtab()) {
-    offset_counter = raw_shstrtab.tellp();
-    std::vector<std::string> symstr_opt =
-      Builder::optimize<Symbol, decltype(binary_->static_symbols_)>(binary_->static_symbols_,
-                       [] (const Symbol* sym) { return sym->name(); },
-                       offset_counter,
-                       &shstr_name_map_);
-    for (const std::string& name : symstr_opt) {
-      raw_shstrtab.write(name);
+    for (const Symbol* sym : binary_->static_symbols_) {
+      shstr_name_map_.add(sym->name());
     }
   }
 
+  shstr_name_map_.finalize(raw_shstrtab.tellp());
+  shstr_name_map_.write(raw_shstrtab);
+
   raw_shstrtab.move(raw_shstrtab_);
   return raw_shstrtab_.size();
 }
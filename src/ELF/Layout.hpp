@@ -1,8 +1,9 @@
 #ifndef LIEF_ELF_LAYOUT_H_
 #define LIEF_ELF_LAYOUT_H_
-#include <unordered_map>
 #include <string>
 #include <vector>
+
+#include "LIEF/string_table.hpp"
 namespace LIEF {
 namespace ELF {
 class Section;
@@ -11,11 +12,11 @@ class Layout {
   public:
   Layout(Binary& bin);
 
-  inline virtual const std::unordered_map<std::string, size_t>& shstr_map() const {
+  inline virtual const StringTable& shstr_map() const {
     return shstr_name_map_;
   }
 
-  inline virtual const std::unordered_map<std::string, size_t>& strtab_map() const {
+  inline virtual const StringTable& strtab_map() const {
     return strtab_name_map_;
   }
 
@@ -45,8 +46,8 @@ class Layout {
   Layout() = delete;
   Binary* binary_ = nullptr;
 
-  std::unordered_map<std::string, size_t> shstr_name_map_;
-  std::unordered_map<std::string, size_t> strtab_name_map_;
+  StringTable shstr_name_map_;
+  StringTable strtab_name_map_;
 
   std::vector<uint8_t> raw_shstrtab_;
   std::vector<uint8_t> raw_strtab_;
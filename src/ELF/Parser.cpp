@@ -25,6 +25,7 @@
 
 #include "LIEF/exception.hpp"
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
 
 #include "LIEF/ELF/utils.hpp"
 #include "LIEF/ELF/Parser.hpp"
@@ -62,11 +63,26 @@ constexpr const char AndroidNote::NAME[];
 Parser::~Parser() = default;
 Parser::Parser()  = default;
 
+//! Default (eager) configuration with the given method to count the dynamic symbols
+static ParserConfig config_from(DYNSYM_COUNT_METHODS count_mtd) {
+  ParserConfig config;
+  config.count_mtd = count_mtd;
+  return config;
+}
+
 Parser::Parser(const std::vector<uint8_t>& data, const std::string& name, DYNSYM_COUNT_METHODS count_mtd, Binary* output) :
+  Parser{data, name, config_from(count_mtd), output}
+{}
+
+Parser::Parser(const std::string& file, DYNSYM_COUNT_METHODS count_mtd, Binary* output) :
+  Parser{file, config_from(count_mtd), output}
+{}
+
+Parser::Parser(const std::vector<uint8_t>& data, const std::string& name, const ParserConfig& config, Binary* output) :
   stream_{std::unique_ptr<VectorStream>(new VectorStream{data})},
   binary_{nullptr},
   type_{ELF_CLASS::ELFCLASSNONE},
-  count_mtd_{count_mtd}
+  config_{config}
 {
   if (output) {
     this->binary_ = output;
@@ -76,11 +92,41 @@ Parser::Parser(const std::vector<uint8_t>& data, const std::string& name, DYNSYM
   this->init(name);
 }
 
-Parser::Parser(const std::string& file, DYNSYM_COUNT_METHODS count_mtd, Binary* output) :
+Parser::Parser(span<const uint8_t> data, const std::string& name, const ParserConfig& config, Binary* output) :
+  stream_{std::unique_ptr<SpanStream>(new SpanStream{data})},
+  binary_{nullptr},
+  type_{ELF_CLASS::ELFCLASSNONE},
+  config_{config}
+{
+  if (output) {
+    this->binary_ = output;
+  } else {
+    this->binary_ = new Binary{};
+  }
+  this->init(name);
+}
+
+Parser::Parser(std::unique_ptr<BinaryStream> stream, const std::string& name, const ParserConfig& config, Binary* output) :
+  stream_{std::move(stream)},
+  binary_{nullptr},
+  type_{ELF_CLASS::ELFCLASSNONE},
+  config_{config}
+{
+  if (output) {
+    this->binary_ = output;
+  } else {
+    this->binary_ = new Binary{};
+  }
+  this->binary_size_ = this->stream_->size();
+  this->binary_name_ = name;
+  this->init(name);
+}
+
+Parser::Parser(const std::string& file, const ParserConfig& config, Binary* output) :
   LIEF::Parser{file},
   binary_{nullptr},
   type_{ELF_CLASS::ELFCLASSNONE},
-  count_mtd_{count_mtd}
+  config_{config}
 {
   if (output) {
     this->binary_ = output;
@@ -88,7 +134,7 @@ Parser::Parser(const std::string& file, DYNSYM_COUNT_METHODS count_mtd, Binary*
     this->binary_ = new Binary{};
   }
 
-  this->stream_ = std::unique_ptr<VectorStream>(new VectorStream{file});
+  this->stream_ = BinaryStream::from_file(file);
   this->init(filesystem::path(file).filename());
 }
 
@@ -121,7 +167,7 @@ void Parser::init(const std::string& name) {
   try {
     this->binary_->original_size_ = this->binary_size_;
     this->binary_->name(name);
-    this->binary_->datahandler_ = new DataHandler::Handler{*stream_};
+    this->binary_->datahandler_ = new DataHandler::Handler{stream_};
 
     const Elf32_Ehdr& elf_hdr = this->stream_->peek<Elf32_Ehdr>(0);
     this->stream_->set_endian_swap(this->should_swap());
@@ -154,27 +200,74 @@ void Parser::init(const std::string& name) {
 }
 
 std::unique_ptr<Binary> Parser::parse(const std::string& filename, DYNSYM_COUNT_METHODS count_mtd) {
+  return Parser::parse(filename, config_from(count_mtd));
+}
+
+std::unique_ptr<Binary> Parser::parse(
+    const std::vector<uint8_t>& data,
+    const std::string& name,
+    DYNSYM_COUNT_METHODS count_mtd) {
+  return Parser::parse(data, name, config_from(count_mtd));
+}
+
+std::unique_ptr<Binary> Parser::parse(const std::string& filename, const ParserConfig& config) {
   if (not is_elf(filename)) {
     LIEF_ERR("{} is not an ELF", filename);
     return nullptr;
   }
 
-  Parser parser{filename, count_mtd};
-  return std::unique_ptr<Binary>{parser.binary_};
+  return Parser::release(new Parser{filename, config});
 }
 
 std::unique_ptr<Binary> Parser::parse(
     const std::vector<uint8_t>& data,
     const std::string& name,
-    DYNSYM_COUNT_METHODS count_mtd) {
+    const ParserConfig& config) {
+
+  if (not is_elf(data)) {
+    LIEF_ERR("{} is not an ELF", name);
+    return nullptr;
+  }
+
+  return Parser::release(new Parser{data, name, config});
+}
+
+std::unique_ptr<Binary> Parser::parse(
+    span<const uint8_t> data,
+    const std::string& name,
+    const ParserConfig& config) {
 
   if (not is_elf(data)) {
     LIEF_ERR("{} is not an ELF", name);
     return nullptr;
   }
 
-  Parser parser{data, name, count_mtd};
-  return std::unique_ptr<Binary>{parser.binary_};
+  return Parser::release(new Parser{data, name, config});
+}
+
+std::unique_ptr<Binary> Parser::parse(
+    std::unique_ptr<BinaryStream> stream,
+    const std::string& name,
+    const ParserConfig& config) {
+
+  const uint8_t* magic = stream->peek_array<uint8_t>(0, sizeof(ElfMagic), /* check */ false);
+  if (magic == nullptr or not is_elf({magic, sizeof(ElfMagic)})) {
+    LIEF_ERR("{} is not an ELF", name);
+    return nullptr;
+  }
+
+  return Parser::release(new Parser{std::move(stream), name, config});
+}
+
+std::unique_ptr<Binary> Parser::release(Parser* parser) {
+  Binary* binary = parser->binary_;
+  if (binary->has_deferred_tables()) {
+    // The deferred steps run on this parser (and its stream)
+    binary->parser_ = parser;
+  } else {
+    delete parser;
+  }
+  return std::unique_ptr<Binary>{binary};
 }
 
 
@@ -321,6 +414,7 @@ void Parser::parse_symbol_sysv_hash(uint64_t offset) {
   sysvhash.chains_ = std::move(chains);
 
   this->binary_->sysv_hash_ = std::move(sysvhash);
+  this->binary_->hash_tables_sync(true);
 
 }
 
@@ -391,9 +485,7 @@ void Parser::parse_notes(uint64_t offset, uint64_t size) {
 }
 
 
-void Parser::parse_overlay() {
-  const uint64_t last_offset = this->binary_->eof_offset();
-
+void Parser::parse_overlay(uint64_t last_offset) {
   if (last_offset > this->stream_->size()) {
     return;
   }
@@ -140,123 +140,12 @@ void Parser::parse_binary() {
     }
   }
 
-  // Parse dynamic relocations
-  // =========================
-
-  // RELA
-  // ----
-  auto&& it_dynamic_relocations = std::find_if(
-      std::begin(this->binary_->dynamic_entries_),
-      std::end(this->binary_->dynamic_entries_),
-      [] (const DynamicEntry* entry) {
-        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_RELA;
-      });
-
-  auto&& it_dynamic_relocations_size = std::find_if(
-      std::begin(this->binary_->dynamic_entries_),
-      std::end(this->binary_->dynamic_entries_),
-      [] (const DynamicEntry* entry) {
-        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_RELASZ;
-      });
-
-  if (it_dynamic_relocations != std::end(this->binary_->dynamic_entries_) and
-      it_dynamic_relocations_size != std::end(this->binary_->dynamic_entries_)) {
-    const uint64_t virtual_address = (*it_dynamic_relocations)->value();
-    const uint64_t size            = (*it_dynamic_relocations_size)->value();
-    try {
-      uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
-      this->parse_dynamic_relocations<ELF_T, typename ELF_T::Elf_Rela>(offset, size);
-    } catch (const LIEF::exception& e) {
-      LIEF_WARN(e.what());
-    }
-  }
-
-
-  // REL
-  // ---
-  it_dynamic_relocations = std::find_if(
-      std::begin(this->binary_->dynamic_entries_),
-      std::end(this->binary_->dynamic_entries_),
-      [] (const DynamicEntry* entry) {
-        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_REL;
-      });
-
-  it_dynamic_relocations_size = std::find_if(
-      std::begin(this->binary_->dynamic_entries_),
-      std::end(this->binary_->dynamic_entries_),
-      [] (const DynamicEntry* entry) {
-        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_RELSZ;
-      });
-
-  if (it_dynamic_relocations != std::end(this->binary_->dynamic_entries_) and
-      it_dynamic_relocations_size != std::end(this->binary_->dynamic_entries_)) {
-    const uint64_t virtual_address = (*it_dynamic_relocations)->value();
-    const uint64_t size            = (*it_dynamic_relocations_size)->value();
-    try {
-      const uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
-      this->parse_dynamic_relocations<ELF_T, typename ELF_T::Elf_Rel>(offset, size);
-    } catch (const LIEF::exception& e) {
-      LIEF_WARN(e.what());
-    }
-
-  }
-
-  // Parse PLT/GOT Relocations
-  // ==========================
-  auto&& it_pltgot_relocations = std::find_if(
-      std::begin(this->binary_->dynamic_entries_),
-      std::end(this->binary_->dynamic_entries_),
-      [] (const DynamicEntry* entry) {
-        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_JMPREL;
-      });
-
-  auto&& it_pltgot_relocations_size = std::find_if(
-      std::begin(this->binary_->dynamic_entries_),
-      std::end(this->binary_->dynamic_entries_),
-      [] (const DynamicEntry* entry) {
-        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_PLTRELSZ;
-      });
-
-  auto&& it_pltgot_relocations_type = std::find_if(
-      std::begin(this->binary_->dynamic_entries_),
-      std::end(this->binary_->dynamic_entries_),
-      [] (const DynamicEntry* entry) {
-        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_PLTREL;
-      });
-
-  if (it_pltgot_relocations != std::end(this->binary_->dynamic_entries_) and
-      it_pltgot_relocations_size != std::end(this->binary_->dynamic_entries_)) {
-    const uint64_t virtual_address = (*it_pltgot_relocations)->value();
-    const uint64_t size            = (*it_pltgot_relocations_size)->value();
-    DYNAMIC_TAGS type;
-    if (it_pltgot_relocations_type != std::end(this->binary_->dynamic_entries_)) {
-      type = static_cast<DYNAMIC_TAGS>((*it_pltgot_relocations_type)->value());
-    } else {
-      // Try to guess: We assume that on ELF64 -> DT_RELA and on ELF32 -> DT_REL
-      if (std::is_same<ELF_T, ELF64>::value) {
-        type = DYNAMIC_TAGS::DT_RELA;
-      } else {
-        type = DYNAMIC_TAGS::DT_REL;
-      }
-    }
-
-    try {
-      const uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
-      if (type == DYNAMIC_TAGS::DT_RELA) {
-        this->parse_pltgot_relocations<ELF_T, typename ELF_T::Elf_Rela>(offset, size);
-      } else {
-        this->parse_pltgot_relocations<ELF_T, typename ELF_T::Elf_Rel>(offset, size);
-      }
-    } catch (const LIEF::exception& e) {
-      LIEF_WARN(e.what());
-
-    }
-
-
-  }
+  // The remaining tables can be parsed lazily (see: ParserConfig). Their location
+  // is resolved here and the parsing steps are run now or on the first access.
 
   // Parse Symbol Version
   // ====================
+  Binary::lazy_steps_t symbol_versions;
   auto&& it_symbol_versions = std::find_if(
       std::begin(this->binary_->dynamic_entries_),
       std::end(this->binary_->dynamic_entries_),
@@ -268,7 +157,12 @@ void Parser::parse_binary() {
     const uint64_t virtual_address = (*it_symbol_versions)->value();
     try {
       uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
-      this->parse_symbol_version(offset);
+      symbol_versions.emplace_back([this, offset] () {
+        try {
+          this->parse_symbol_version(offset);
+        } catch (const LIEF::exception&) {
+        }
+      });
     } catch (const LIEF::exception&) {
 
     }
@@ -301,7 +195,13 @@ void Parser::parse_binary() {
     const uint32_t nb_entries = std::min(Parser::NB_MAX_SYMBOLS, static_cast<uint32_t>(dt_verneed_num->value()));
     try {
       const uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
-      this->parse_symbol_version_requirement<ELF_T>(offset, nb_entries);
+      symbol_versions.emplace_back([this, offset, nb_entries] () {
+        try {
+          this->parse_symbol_version_requirement<ELF_T>(offset, nb_entries);
+        } catch (const LIEF::exception& e) {
+          LIEF_WARN("{}", e.what());
+        }
+      });
     } catch (const LIEF::exception& e) {
       LIEF_WARN("{}", e.what());
     }
@@ -330,16 +230,28 @@ void Parser::parse_binary() {
     const uint32_t size            = static_cast<uint32_t>((*it_symbol_version_definition_size)->value());
     try {
       const uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
-      this->parse_symbol_version_definition<ELF_T>(offset, size);
+      symbol_versions.emplace_back([this, offset, size] () {
+        try {
+          this->parse_symbol_version_definition<ELF_T>(offset, size);
+        } catch (const LIEF::exception&) {
+        }
+      });
     } catch (const LIEF::exception&) {
 
     }
 
   }
 
+  symbol_versions.emplace_back([this] () {
+    this->link_symbol_version();
+  });
+  this->binary_->parse_table(Binary::LAZY_TABLES::SYMBOL_VERSIONS,
+                             this->config_.lazy_symbol_versions, std::move(symbol_versions));
+
 
   // Parse static symbols
   // ====================
+  Binary::lazy_steps_t static_symbols;
   auto&& it_symtab_section = std::find_if(
       std::begin(this->binary_->sections_),
       std::end(this->binary_->sections_),
@@ -358,10 +270,11 @@ void Parser::parse_binary() {
       // We should have:
       // nb_entries == section->information())
       // but lots of compiler not respect this rule
-      this->parse_static_symbols<ELF_T>(
-          section->file_offset(),
-          nb_entries,
-          this->binary_->sections_[section->link()]);
+      const uint64_t offset         = section->file_offset();
+      const Section* string_section = this->binary_->sections_[section->link()];
+      static_symbols.emplace_back([this, offset, nb_entries, string_section] () {
+        this->parse_static_symbols<ELF_T>(offset, nb_entries, string_section);
+      });
     }
 
     it_symtab_section = std::find_if(
@@ -376,10 +289,177 @@ void Parser::parse_binary() {
       LIEF_WARN("Support for multiple SHT_SYMTAB section is not implemented");
     }
   }
+  this->binary_->parse_table(Binary::LAZY_TABLES::STATIC_SYMBOLS,
+                             this->config_.lazy_static_symbols, std::move(static_symbols));
+
+
+  // Parse dynamic relocations
+  // =========================
+  Binary::lazy_steps_t relocations;
+
+  // RELA
+  // ----
+  auto&& it_dynamic_relocations = std::find_if(
+      std::begin(this->binary_->dynamic_entries_),
+      std::end(this->binary_->dynamic_entries_),
+      [] (const DynamicEntry* entry) {
+        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_RELA;
+      });
+
+  auto&& it_dynamic_relocations_size = std::find_if(
+      std::begin(this->binary_->dynamic_entries_),
+      std::end(this->binary_->dynamic_entries_),
+      [] (const DynamicEntry* entry) {
+        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_RELASZ;
+      });
+
+  if (it_dynamic_relocations != std::end(this->binary_->dynamic_entries_) and
+      it_dynamic_relocations_size != std::end(this->binary_->dynamic_entries_)) {
+    const uint64_t virtual_address = (*it_dynamic_relocations)->value();
+    const uint64_t size            = (*it_dynamic_relocations_size)->value();
+    try {
+      uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
+      relocations.emplace_back([this, offset, size] () {
+        try {
+          this->parse_dynamic_relocations<ELF_T, typename ELF_T::Elf_Rela>(offset, size);
+        } catch (const LIEF::exception& e) {
+          LIEF_WARN(e.what());
+        }
+      });
+    } catch (const LIEF::exception& e) {
+      LIEF_WARN(e.what());
+    }
+  }
+
+
+  // REL
+  // ---
+  it_dynamic_relocations = std::find_if(
+      std::begin(this->binary_->dynamic_entries_),
+      std::end(this->binary_->dynamic_entries_),
+      [] (const DynamicEntry* entry) {
+        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_REL;
+      });
+
+  it_dynamic_relocations_size = std::find_if(
+      std::begin(this->binary_->dynamic_entries_),
+      std::end(this->binary_->dynamic_entries_),
+      [] (const DynamicEntry* entry) {
+        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_RELSZ;
+      });
+
+  if (it_dynamic_relocations != std::end(this->binary_->dynamic_entries_) and
+      it_dynamic_relocations_size != std::end(this->binary_->dynamic_entries_)) {
+    const uint64_t virtual_address = (*it_dynamic_relocations)->value();
+    const uint64_t size            = (*it_dynamic_relocations_size)->value();
+    try {
+      const uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
+      relocations.emplace_back([this, offset, size] () {
+        try {
+          this->parse_dynamic_relocations<ELF_T, typename ELF_T::Elf_Rel>(offset, size);
+        } catch (const LIEF::exception& e) {
+          LIEF_WARN(e.what());
+        }
+      });
+    } catch (const LIEF::exception& e) {
+      LIEF_WARN(e.what());
+    }
+
+  }
+
+  // Parse PLT/GOT Relocations
+  // ==========================
+  auto&& it_pltgot_relocations = std::find_if(
+      std::begin(this->binary_->dynamic_entries_),
+      std::end(this->binary_->dynamic_entries_),
+      [] (const DynamicEntry* entry) {
+        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_JMPREL;
+      });
+
+  auto&& it_pltgot_relocations_size = std::find_if(
+      std::begin(this->binary_->dynamic_entries_),
+      std::end(this->binary_->dynamic_entries_),
+      [] (const DynamicEntry* entry) {
+        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_PLTRELSZ;
+      });
+
+  auto&& it_pltgot_relocations_type = std::find_if(
+      std::begin(this->binary_->dynamic_entries_),
+      std::end(this->binary_->dynamic_entries_),
+      [] (const DynamicEntry* entry) {
+        return entry != nullptr and entry->tag() == DYNAMIC_TAGS::DT_PLTREL;
+      });
+
+  if (it_pltgot_relocations != std::end(this->binary_->dynamic_entries_) and
+      it_pltgot_relocations_size != std::end(this->binary_->dynamic_entries_)) {
+    const uint64_t virtual_address = (*it_pltgot_relocations)->value();
+    const uint64_t size            = (*it_pltgot_relocations_size)->value();
+    DYNAMIC_TAGS type;
+    if (it_pltgot_relocations_type != std::end(this->binary_->dynamic_entries_)) {
+      type = static_cast<DYNAMIC_TAGS>((*it_pltgot_relocations_type)->value());
+    } else {
+      // Try to guess: We assume that on ELF64 -> DT_RELA and on ELF32 -> DT_REL
+      if (std::is_same<ELF_T, ELF64>::value) {
+        type = DYNAMIC_TAGS::DT_RELA;
+      } else {
+        type = DYNAMIC_TAGS::DT_REL;
+      }
+    }
+
+    try {
+      const uint64_t offset = this->binary_->virtual_address_to_offset(virtual_address);
+      relocations.emplace_back([this, offset, size, type] () {
+        try {
+          if (type == DYNAMIC_TAGS::DT_RELA) {
+            this->parse_pltgot_relocations<ELF_T, typename ELF_T::Elf_Rela>(offset, size);
+          } else {
+            this->parse_pltgot_relocations<ELF_T, typename ELF_T::Elf_Rel>(offset, size);
+          }
+        } catch (const LIEF::exception& e) {
+          LIEF_WARN(e.what());
+        }
+      });
+    } catch (const LIEF::exception& e) {
+      LIEF_WARN(e.what());
+
+    }
+
+
+  }
+
+  // Try to parse using sections
+  // If we don't have any relocations, we parse all relocation sections
+  // otherwise, only the non-allocated sections to avoid parsing dynamic
+  // relocations (or plt relocations) twice.
+  relocations.emplace_back([this] () {
+    // Relocations from sections can reference static symbols
+    this->binary_->load(Binary::LAZY_TABLES::STATIC_SYMBOLS);
+
+    bool skip_allocated_sections = this->binary_->relocations_.size() > 0;
+    for (const Section* section : this->binary_->sections_) {
+      if(skip_allocated_sections && section->has(ELF_SECTION_FLAGS::SHF_ALLOC)){
+        continue;
+      }
+      try {
+        if (section->type() == ELF_SECTION_TYPES::SHT_REL) {
+          this->parse_section_relocations<ELF_T, typename ELF_T::Elf_Rel>(*section);
+        }
+        else if (section->type() == ELF_SECTION_TYPES::SHT_RELA) {
+          this->parse_section_relocations<ELF_T, typename ELF_T::Elf_Rela>(*section);
+        }
+
+      } catch (const exception& e) {
+        LIEF_WARN("Unable to parse relocations from section '{}' ({})", section->name(), e.what());
+      }
+    }
+  });
+  this->binary_->parse_table(Binary::LAZY_TABLES::RELOCATIONS,
+                             this->config_.lazy_relocations, std::move(relocations));
 
 
   // Parse Symbols's hash
   // ====================
+  Binary::lazy_steps_t hash_tables;
 
   auto&& it_symbol_hash = std::find_if(
       std::begin(this->binary_->dynamic_entries_),
@@ -398,7 +478,13 @@ void Parser::parse_binary() {
   if (it_symbol_hash != std::end(this->binary_->dynamic_entries_)) {
     try {
       const uint64_t symbol_sys_hash_offset = this->binary_->virtual_address_to_offset((*it_symbol_hash)->value());
-      this->parse_symbol_sysv_hash(symbol_sys_hash_offset);
+      hash_tables.emplace_back([this, symbol_sys_hash_offset] () {
+        try {
+          this->parse_symbol_sysv_hash(symbol_sys_hash_offset);
+        } catch (const exception& e) {
+          LIEF_WARN("{}", e.what());
+        }
+      });
     } catch (const conversion_error&) {
     } catch (const exception& e) {
       LIEF_WARN("{}", e.what());
@@ -409,22 +495,38 @@ void Parser::parse_binary() {
   if (it_symbol_gnu_hash != std::end(this->binary_->dynamic_entries_)) {
     try {
       const uint64_t symbol_gnu_hash_offset = this->binary_->virtual_address_to_offset((*it_symbol_gnu_hash)->value());
-      this->parse_symbol_gnu_hash<ELF_T>(symbol_gnu_hash_offset);
+      hash_tables.emplace_back([this, symbol_gnu_hash_offset] () {
+        try {
+          this->parse_symbol_gnu_hash<ELF_T>(symbol_gnu_hash_offset);
+        } catch (const exception& e) {
+          LIEF_WARN("{}", e.what());
+        }
+      });
     } catch (const conversion_error&) {
     } catch (const exception& e) {
       LIEF_WARN("{}", e.what());
     }
   }
+  this->binary_->parse_table(Binary::LAZY_TABLES::HASH_TABLES,
+                             this->config_.lazy_hash_tables, std::move(hash_tables));
 
   // Parse Note segment
   // ==================
+  Binary::lazy_steps_t notes;
   for (const Segment& segment : binary_->segments()) {
     if (segment.type() != SEGMENT_TYPES::PT_NOTE) {
       continue;
     }
     try {
       const uint64_t note_offset = this->binary_->virtual_address_to_offset(segment.virtual_address());
-      this->parse_notes(note_offset, segment.physical_size());
+      const uint64_t note_size   = segment.physical_size();
+      notes.emplace_back([this, note_offset, note_size] () {
+        try {
+          this->parse_notes(note_offset, note_size);
+        } catch (const exception& e) {
+          LIEF_WARN("{}", e.what());
+        }
+      });
     } catch (const conversion_error&) {
     } catch (const exception& e) {
       LIEF_WARN("{}", e.what());
@@ -439,40 +541,29 @@ void Parser::parse_binary() {
       continue;
     }
 
-    try {
-      this->parse_notes(section.offset(), section.size());
-    } catch (const conversion_error&) {
-    } catch (const exception& e) {
-      LIEF_WARN("{}", e.what());
-    }
-
-
-  }
-
-  // Try to parse using sections
-  // If we don't have any relocations, we parse all relocation sections
-  // otherwise, only the non-allocated sections to avoid parsing dynamic
-  // relocations (or plt relocations) twice.
-  bool skip_allocated_sections = this->binary_->relocations_.size() > 0;
-  for (const Section& section : this->binary_->sections()) {
-    if(skip_allocated_sections && section.has(ELF_SECTION_FLAGS::SHF_ALLOC)){
-      continue;
-    }
-    try {
-      if (section.type() == ELF_SECTION_TYPES::SHT_REL) {
-        this->parse_section_relocations<ELF_T, typename ELF_T::Elf_Rel>(section);
-      }
-      else if (section.type() == ELF_SECTION_TYPES::SHT_RELA) {
-        this->parse_section_relocations<ELF_T, typename ELF_T::Elf_Rela>(section);
+    const uint64_t note_offset = section.offset();
+    const uint64_t note_size   = section.size();
+    notes.emplace_back([this, note_offset, note_size] () {
+      try {
+        this->parse_notes(note_offset, note_size);
+      } catch (const conversion_error&) {
+      } catch (const exception& e) {
+        LIEF_WARN("{}", e.what());
       }
+    });
 
-    } catch (const exception& e) {
-      LIEF_WARN("Unable to parse relocations from section '{}' ({})", section.name(), e.what());
-    }
   }
+  this->binary_->parse_table(Binary::LAZY_TABLES::NOTES,
+                             this->config_.lazy_notes, std::move(notes));
 
-  this->link_symbol_version();
-  this->parse_overlay();
+  // Parse overlay
+  // =============
+  const uint64_t last_offset = this->binary_->eof_offset();
+  this->binary_->parse_table(Binary::LAZY_TABLES::OVERLAY, this->config_.lazy_overlay, {
+    [this, last_offset] () {
+      this->parse_overlay(last_offset);
+    }
+  });
 }
 
 
@@ -858,13 +949,13 @@ void Parser::parse_sections() {
       const Elf_Off size                = section->size();
       this->binary_->datahandler_->reserve(section->file_offset(), section->size());
 
+      // The data handler shares the stream's buffer: the content
+      // is already there and we just check that it can be read
       const uint8_t* content = this->stream_->peek_array<uint8_t>(offset_to_content, size, /* check */false);
       if (content == nullptr) {
         if (section->type() != ELF_SECTION_TYPES::SHT_NOBITS) {
           LIEF_WARN("  Unable to get content of section #{:d}", i);
         }
-      } else {
-        section->content({content, content + size});
       }
     }
     this->binary_->sections_.push_back(section.release());
@@ -927,7 +1018,6 @@ void Parser::parse_segments() {
       this->binary_->datahandler_->reserve(segment->file_offset(), segment->physical_size());
       const uint8_t* content = this->stream_->peek_array<uint8_t>(offset_to_content, size, /* check */false);
       if (content != nullptr) {
-        segment->content({content, content + size});
         if (segment->type() == SEGMENT_TYPES::PT_INTERP) {
           this->binary_->interpreter_ = this->stream_->peek_string_at(offset_to_content, segment->physical_size());
         }
@@ -1004,8 +1094,8 @@ void Parser::parse_static_symbols(uint64_t offset, uint32_t nbSymbols, const Sec
     const Elf_Sym raw_sym = this->stream_->read_conv<Elf_Sym>();
 
     std::unique_ptr<Symbol> symbol{new Symbol{&raw_sym}};
-    std::string symbol_name = this->stream_->peek_string_at(string_section->file_offset() + raw_sym.st_name);
-    symbol->name(symbol_name);
+    // The symbol is not indexed yet: set its name without notifying the binary
+    symbol->name_ = this->stream_->peek_string_at(string_section->file_offset() + raw_sym.st_name);
     this->binary_->static_symbols_.push_back(symbol.release());
   }
 } // build_static_symbols
@@ -1018,7 +1108,7 @@ void Parser::parse_dynamic_symbols(uint64_t offset) {
 
   LIEF_DEBUG("== Parsing dynamics symbols ==");
 
-  uint32_t nb_symbols = this->get_numberof_dynamic_symbols<ELF_T>(this->count_mtd_);
+  uint32_t nb_symbols = this->get_numberof_dynamic_symbols<ELF_T>(this->config_.count_mtd);
 
   const Elf_Off dynamic_symbols_offset = offset;
   const Elf_Off string_offset          = this->get_dynamic_string_table();
@@ -1054,7 +1144,8 @@ void Parser::parse_dynamic_symbols(uint64_t offset) {
         LIEF_DEBUG("Symbol's name #{:d} is empty!", i);
       }
 
-      symbol->name(name);
+      // The symbol is not indexed yet: set its name without notifying the binary
+      symbol->name_ = std::move(name);
     }
     this->binary_->dynamic_symbols_.push_back(symbol.release());
   }
@@ -1670,6 +1761,7 @@ void Parser::parse_symbol_gnu_hash(uint64_t offset) {
     }
   }
   this->binary_->gnu_hash_ = std::move(gnuhash);
+  this->binary_->hash_tables_sync(true);
 
 }
 
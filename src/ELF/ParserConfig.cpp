@@ -0,0 +1,45 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LIEF/ELF/ParserConfig.hpp"
+
+namespace LIEF {
+namespace ELF {
+
+ParserConfig ParserConfig::deep() {
+  ParserConfig conf;
+  conf.lazy(false);
+  return conf;
+}
+
+ParserConfig ParserConfig::quick() {
+  ParserConfig conf;
+  conf.lazy(true);
+  return conf;
+}
+
+
+ParserConfig& ParserConfig::lazy(bool flag) {
+  this->lazy_static_symbols  = flag;
+  this->lazy_relocations     = flag;
+  this->lazy_symbol_versions = flag;
+  this->lazy_hash_tables     = flag;
+  this->lazy_notes           = flag;
+  this->lazy_overlay         = flag;
+  return *this;
+}
+
+} // namespace ELF
+} // namespace LIEF
@@ -149,6 +149,8 @@ Section::Section(const Section& other) :
 }
 
 void Section::swap(Section& other) {
+  this->index_changed();
+  other.index_changed();
 
   std::swap(this->name_,            other.name_);
   std::swap(this->virtual_address_, other.virtual_address_);
@@ -227,22 +229,24 @@ uint64_t Section::offset() const {
 
 
 void Section::size(uint64_t size) {
+  this->index_changed();
   if (this->datahandler_ != nullptr) {
     DataHandler::Node& node = this->datahandler_->get(
         this->file_offset(), this->size(),
         DataHandler::Node::SECTION);
-    node.size(size);
+    this->datahandler_->move(node, node.offset(), size);
   }
   this->size_ = size;
 }
 
 
 void Section::offset(uint64_t offset) {
+  this->index_changed();
   if (this->datahandler_ != nullptr) {
     DataHandler::Node& node = this->datahandler_->get(
         this->file_offset(), this->size(),
         DataHandler::Node::SECTION);
-    node.offset(offset);
+    this->datahandler_->move(node, offset, node.size());
   }
   this->offset_ = offset;
 }
@@ -261,8 +265,41 @@ std::vector<uint8_t> Section::content() const {
   }
 
   DataHandler::Node& node = this->datahandler_->get(this->offset(), this->size(), DataHandler::Node::SECTION);
-  const std::vector<uint8_t>& binary_content = this->datahandler_->content();
-  return {binary_content.data() + node.offset(), binary_content.data() + node.offset() + node.size()};
+  return this->datahandler_->read(node.offset(), node.size());
+}
+
+span<const uint8_t> Section::content_view() const {
+  if (this->size() == 0) {
+    return {};
+  }
+
+  if (this->datahandler_ == nullptr) {
+    return this->content_c_;
+  }
+
+  if (this->size() > Parser::MAX_SECTION_SIZE) {
+    return {};
+  }
+
+  const uint8_t* data = this->datahandler_->view(this->offset(), this->size());
+  if (data == nullptr) {
+    return {};
+  }
+  return {data, static_cast<size_t>(this->size())};
+}
+
+DigestCache::key_t Section::digest_key() const {
+  if (this->datahandler_ == nullptr) {
+    return LIEF::Section::digest_key();
+  }
+  // The content may be modified through the data handler by another
+  // section or by a segment
+  DigestCache::key_t key;
+  key.source  = this->datahandler_;
+  key.version = this->datahandler_->version();
+  key.offset  = this->offset();
+  key.size    = this->size();
+  return key;
 }
 
 uint32_t Section::link() const {
@@ -290,6 +327,7 @@ void Section::content(const std::vector<uint8_t>& content) {
     LIEF_DEBUG("Set 0x{:x} bytes in the cache of section '{}'", content.size(), this->name());
     this->content_c_ = content;
     this->size(content.size());
+    this->content_changed();
     return;
   }
 
@@ -302,8 +340,7 @@ void Section::content(const std::vector<uint8_t>& content) {
       this->size(),
       DataHandler::Node::SECTION);
 
-  std::vector<uint8_t>& binary_content = this->datahandler_->content();
-  this->datahandler_->reserve(node.offset(), content.size());
+  uint8_t* binary_content = this->datahandler_->writable(node.offset(), content.size());
 
   if (node.size() < content.size()) {
     LIEF_INFO("You inserted 0x{:x} bytes in the section '{}' which is 0x{:x} wide",
@@ -315,7 +352,7 @@ void Section::content(const std::vector<uint8_t>& content) {
   std::copy(
       std::begin(content),
       std::end(content),
-      std::begin(binary_content) + node.offset());
+      binary_content);
 
 }
 
@@ -330,6 +367,7 @@ void Section::content(std::vector<uint8_t>&& content) {
     LIEF_DEBUG("Set 0x{:x} bytes in the cache of section '{}'", content.size(), this->name());
     this->size(content.size());
     this->content_c_ = std::move(content);
+    this->content_changed();
     return;
   }
 
@@ -343,8 +381,7 @@ void Section::content(std::vector<uint8_t>&& content) {
       this->size(),
       DataHandler::Node::SECTION);
 
-  std::vector<uint8_t>& binary_content = this->datahandler_->content();
-  this->datahandler_->reserve(node.offset(), content.size());
+  uint8_t* binary_content = this->datahandler_->writable(node.offset(), content.size());
 
   if (node.size() < content.size()) {
     LIEF_INFO("You inserted 0x{:x} bytes in the section '{}' which is 0x{:x} wide",
@@ -356,10 +393,11 @@ void Section::content(std::vector<uint8_t>&& content) {
   std::move(
       std::begin(content),
       std::end(content),
-      std::begin(binary_content) + node.offset());
+      binary_content);
 }
 
 void Section::type(ELF_SECTION_TYPES type) {
+  this->index_changed();
   this->type_ = type;
 }
 
@@ -416,16 +454,16 @@ Section& Section::clear(uint8_t value) {
         std::begin(this->content_c_),
         std::end(this->content_c_),
         value);
+    this->content_changed();
     return *this;
   }
 
-  std::vector<uint8_t>& binary_content = this->datahandler_->content();
   DataHandler::Node& node = this->datahandler_->get(
       this->file_offset(),
       this->size(),
       DataHandler::Node::SECTION);
 
-  std::fill_n(std::begin(binary_content) + node.offset(), this->size(), value);
+  std::fill_n(this->datahandler_->writable(node.offset(), this->size()), this->size(), value);
   return *this;
 
 }
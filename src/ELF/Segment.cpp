@@ -36,6 +36,7 @@ namespace ELF {
 Segment::~Segment() = default;
 Segment::Segment(const Segment& other) :
   Object{other},
+  Indexed{},
   type_{other.type_},
   flags_{other.flags_},
   file_offset_{other.file_offset_},
@@ -94,6 +95,8 @@ Segment::Segment() :
 {}
 
 void Segment::swap(Segment& other) {
+  this->index_changed();
+  other.index_changed();
   std::swap(this->type_,             other.type_);
   std::swap(this->flags_,            other.flags_);
   std::swap(this->file_offset_,      other.file_offset_);
@@ -183,14 +186,71 @@ std::vector<uint8_t> Segment::content() const {
       this->physical_size(),
       DataHandler::Node::SEGMENT);
 
-  const std::vector<uint8_t>& binary_content = this->datahandler_->content();
-  const size_t size = binary_content.size();
-  if (node.offset() >= size || (node.offset() + node.size()) >= size) {
+  const uint64_t size = this->datahandler_->size();
+  if (node.offset() >= size || (node.offset() + node.size()) > size) {
     LIEF_ERR("Corrupted data");
     return {};
   }
 
-  return {binary_content.data() + node.offset(), binary_content.data() + node.offset() + node.size()};
+  return this->datahandler_->read(node.offset(), node.size());
+}
+
+span<const uint8_t> Segment::content_view() const {
+  if (this->datahandler_ == nullptr) {
+    return this->content_c_;
+  }
+
+  const uint8_t* data = this->datahandler_->view(this->file_offset(), this->physical_size());
+  if (data == nullptr) {
+    return {};
+  }
+  return {data, static_cast<size_t>(this->physical_size())};
+}
+
+size_t Segment::content_digest() const {
+  return this->digest_.get(this->digest_key(), [this] {
+    std::vector<uint8_t> buffer;
+    return LIEF::Hash::hash(this->view_or_copy(buffer));
+  });
+}
+
+DigestCache::key_t Segment::digest_key() const {
+  DigestCache::key_t key;
+  key.size = this->physical_size();
+  if (this->datahandler_ == nullptr) {
+    key.version = this->content_version_;
+    return key;
+  }
+  // The content may be modified through the data handler by a section
+  // or by another segment
+  key.source  = this->datahandler_;
+  key.version = this->datahandler_->version();
+  key.offset  = this->file_offset();
+  return key;
+}
+
+span<const uint8_t> Segment::view_or_copy(std::vector<uint8_t>& buffer) const {
+  span<const uint8_t> view = this->content_view();
+  if (not view.empty()) {
+    return view;
+  }
+  buffer = this->content();
+  return buffer;
+}
+
+double Segment::entropy() const {
+  std::vector<uint8_t> buffer;
+  return LIEF::entropy(this->view_or_copy(buffer));
+}
+
+histogram_t Segment::histogram(size_t nb_threads) const {
+  std::vector<uint8_t> buffer;
+  return LIEF::histogram(this->view_or_copy(buffer), nb_threads);
+}
+
+std::vector<double> Segment::entropy_curve(size_t block_size, size_t step) const {
+  std::vector<uint8_t> buffer;
+  return LIEF::entropy_curve(this->view_or_copy(buffer), block_size, step);
 }
 
 size_t Segment::get_content_size() const {
@@ -211,8 +271,12 @@ template<typename T> T Segment::get_content_value(size_t offset) const {
         this->file_offset(),
         this->physical_size(),
         DataHandler::Node::SEGMENT);
-    const std::vector<uint8_t>& binary_content = this->datahandler_->content();
-    memcpy(&ret, binary_content.data() + node.offset() + offset, sizeof(T));
+    const std::vector<uint8_t> raw = this->datahandler_->read(node.offset() + offset, sizeof(T));
+    if (raw.size() != sizeof(T)) {
+      LIEF_ERR("Can't read 0x{:x} bytes at offset 0x{:x}", sizeof(T), offset);
+      return 0;
+    }
+    memcpy(&ret, raw.data(), sizeof(T));
   }
   return ret;
 }
@@ -231,21 +295,19 @@ template<typename T> void Segment::set_content_value(size_t offset, T value) {
       this->physical_size(offset + sizeof(T));
     }
     memcpy(this->content_c_.data() + offset, &value, sizeof(T));
+    ++this->content_version_;
   } else {
     DataHandler::Node& node = this->datahandler_->get(
         this->file_offset(),
         this->physical_size(),
         DataHandler::Node::SEGMENT);
-    std::vector<uint8_t>& binary_content = this->datahandler_->content();
-
-    if (offset + sizeof(T) > binary_content.size()) {
-      this->datahandler_->reserve(node.offset(), offset + sizeof(T));
-
+    if (offset + sizeof(T) > this->datahandler_->size()) {
       LIEF_INFO("You up to bytes in the segment {}@0x{:x} which is 0x{:x} wide",
-        offset + sizeof(T), to_string(this->type()), this->virtual_size(), binary_content.size());
+        offset + sizeof(T), to_string(this->type()), this->virtual_size(), this->datahandler_->size());
     }
+    uint8_t* binary_content = this->datahandler_->writable(node.offset() + offset, sizeof(T));
     this->physical_size(node.size());
-    memcpy(binary_content.data() + node.offset() + offset, &value, sizeof(T));
+    memcpy(binary_content, &value, sizeof(T));
   }
 }
 template void Segment::set_content_value<unsigned short>(size_t offset, unsigned short value);
@@ -311,17 +373,19 @@ void Segment::clear_flags() {
 
 
 void Segment::file_offset(uint64_t file_offset) {
+  this->index_changed();
   if (this->datahandler_ != nullptr) {
     DataHandler::Node& node = this->datahandler_->get(
         this->file_offset(), this->physical_size(),
         DataHandler::Node::SEGMENT);
-    node.offset(file_offset);
+    this->datahandler_->move(node, file_offset, node.size());
   }
   this->file_offset_ = file_offset;
 }
 
 
 void Segment::virtual_address(uint64_t virtualAddress) {
+  this->index_changed();
   this->virtual_address_ = virtualAddress;
 }
 
@@ -332,17 +396,19 @@ void Segment::physical_address(uint64_t physicalAddress) {
 
 
 void Segment::physical_size(uint64_t physicalSize) {
+  this->index_changed();
   if (this->datahandler_ != nullptr) {
     DataHandler::Node& node = this->datahandler_->get(
         this->file_offset(), this->physical_size(),
         DataHandler::Node::SEGMENT);
-    node.size(physicalSize);
+    this->datahandler_->move(node, node.offset(), physicalSize);
   }
   this->size_ = physicalSize;
 }
 
 
 void Segment::virtual_size(uint64_t virtualSize) {
+  this->index_changed();
   this->virtual_size_ = virtualSize;
 }
 
@@ -352,6 +418,7 @@ void Segment::alignment(uint64_t alignment) {
 }
 
 void Segment::type(SEGMENT_TYPES type) {
+  this->index_changed();
   this->type_ = type;
 }
 
@@ -360,6 +427,7 @@ void Segment::content(const std::vector<uint8_t>& content) {
     LIEF_DEBUG("Set content of segment {}@0x{:x} in cache (0x{:x} bytes)",
         to_string(this->type()), this->virtual_address(), content.size());
     this->content_c_ = content;
+    ++this->content_version_;
 
     this->physical_size(content.size());
     return;
@@ -373,8 +441,7 @@ void Segment::content(const std::vector<uint8_t>& content) {
       this->physical_size(),
       DataHandler::Node::SEGMENT);
 
-  std::vector<uint8_t>& binary_content = this->datahandler_->content();
-  this->datahandler_->reserve(node.offset(), content.size());
+  uint8_t* binary_content = this->datahandler_->writable(node.offset(), content.size());
 
   if (node.size() < content.size()) {
       LIEF_INFO("You inserted 0x{:x} bytes in the segment {}@0x{:x} which is 0x{:x} wide",
@@ -386,7 +453,7 @@ void Segment::content(const std::vector<uint8_t>& content) {
   std::copy(
       std::begin(content),
       std::end(content),
-      std::begin(binary_content) + node.offset());
+      binary_content);
 }
 
 
@@ -395,6 +462,7 @@ void Segment::content(std::vector<uint8_t>&& content) {
     LIEF_DEBUG("Set content of segment {}@0x{:x} in cache (0x{:x} bytes)",
         to_string(this->type()), this->virtual_address(), content.size());
     this->content_c_ = std::move(content);
+    ++this->content_version_;
 
     this->physical_size(content.size());
     return;
@@ -408,8 +476,7 @@ void Segment::content(std::vector<uint8_t>&& content) {
       this->physical_size(),
       DataHandler::Node::SEGMENT);
 
-  std::vector<uint8_t>& binary_content = this->datahandler_->content();
-  this->datahandler_->reserve(node.offset(), content.size());
+  uint8_t* binary_content = this->datahandler_->writable(node.offset(), content.size());
 
   if (node.size() < content.size()) {
       LIEF_INFO("You inserted 0x{:x} bytes in the segment {}@0x{:x} which is 0x{:x} wide",
@@ -421,7 +488,7 @@ void Segment::content(std::vector<uint8_t>&& content) {
   std::move(
       std::begin(content),
       std::end(content),
-      std::begin(binary_content) + node.offset());
+      binary_content);
 }
 
 void Segment::accept(Visitor& visitor) const {
@@ -72,7 +72,7 @@ void Hash::visit(const Header& header) {
 void Hash::visit(const Section& section) {
   process(section.name());
   process(section.size());
-  process(section.content());
+  process_digest(section.content_digest());
   process(section.virtual_address());
   process(section.offset());
 
@@ -93,7 +93,7 @@ void Hash::visit(const Segment& segment) {
   process(segment.physical_size());
   process(segment.virtual_size());
   process(segment.alignment());
-  process(segment.content());
+  process_digest(segment.content_digest());
 }
 
 void Hash::visit(const DynamicEntry& entry) {
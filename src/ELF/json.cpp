@@ -37,143 +37,65 @@ std::string to_json_str(const Object& v) {
 }
 
 
-void JsonVisitor::visit(const Binary& binary) {
+JsonMembers JsonVisitor::members(const Binary& binary) {
+  JsonMembers members;
+
   JsonVisitor header_visitor;
   header_visitor(binary.header());
 
-  // Sections
-  std::vector<json> sections;
-  for (const Section& section : binary.sections()) {
-    JsonVisitor visitor;
-    visitor(section);
-    sections.emplace_back(visitor.get());
-  }
-
-  // Segments
-  std::vector<json> segments;
-  for (const Segment& segment : binary.segments()) {
-    JsonVisitor visitor;
-    visitor(segment);
-    segments.emplace_back(visitor.get());
-  }
-
-  // Dynamic entries
-  std::vector<json> dynamic_entries;
-  for (const DynamicEntry& entry : binary.dynamic_entries()) {
-    JsonVisitor visitor;
-    entry.accept(visitor);
-    dynamic_entries.emplace_back(visitor.get());
-  }
-
-
-  // Dynamic symbols
-  std::vector<json> dynamic_symbols;
-  for (const Symbol& symbol : binary.dynamic_symbols()) {
-    JsonVisitor visitor;
-    visitor(symbol);
-    dynamic_symbols.emplace_back(visitor.get());
-  }
-
-
-  // Static symbols
-  std::vector<json> static_symbols;
-  for (const Symbol& symbol : binary.static_symbols()) {
-    JsonVisitor visitor;
-    visitor(symbol);
-    static_symbols.emplace_back(visitor.get());
-  }
-
-
-  // Dynamic relocations
-  std::vector<json> dynamic_relocations;
-  for (const Relocation& reloc : binary.dynamic_relocations()) {
-    JsonVisitor visitor;
-    visitor(reloc);
-    dynamic_relocations.emplace_back(visitor.get());
-  }
-
+  members.set("name",         binary.name());
+  members.set("entrypoint",   binary.entrypoint());
+  members.set("imagebase",    binary.imagebase());
+  members.set("virtual_size", binary.virtual_size());
+  members.set("is_pie",       binary.is_pie());
 
-  // pltgot relocations
-  std::vector<json> pltgot_relocations;
-  for (const Relocation& reloc : binary.pltgot_relocations()) {
-    JsonVisitor visitor;
-    visitor(reloc);
-    pltgot_relocations.emplace_back(visitor.get());
-  }
-
-
-  // Symbol version
-  std::vector<json> symbols_version;
-  for (const SymbolVersion& s : binary.symbols_version()) {
-    JsonVisitor visitor;
-    visitor(s);
-    symbols_version.emplace_back(visitor.get());
-  }
-
-
-  // Symbols version requirement
-  std::vector<json> symbols_version_requirement;
-  for (const SymbolVersionRequirement& s : binary.symbols_version_requirement()) {
-    JsonVisitor visitor;
-    visitor(s);
-    symbols_version_requirement.emplace_back(visitor.get());
-  }
-
-
-  // Symbols version definition
-  std::vector<json> symbols_version_definition;
-  for (const SymbolVersionDefinition& s : binary.symbols_version_definition()) {
-    JsonVisitor visitor;
-    visitor(s);
-    symbols_version_definition.emplace_back(visitor.get());
+  if (binary.has_interpreter()) {
+    members.set("interpreter", binary.interpreter());
   }
 
+  members.set("header", header_visitor.get());
 
-  // Notes
-  std::vector<json> notes;
-  for (const Note& note : binary.notes()) {
-    JsonVisitor visitor;
-    visitor(note);
-    notes.emplace_back(visitor.get());
-  }
-
-  this->node_["name"]         = binary.name();
-  this->node_["entrypoint"]   = binary.entrypoint();
-  this->node_["imagebase"]    = binary.imagebase();
-  this->node_["virtual_size"] = binary.virtual_size();
-  this->node_["is_pie"]       = binary.is_pie();
+  members.set_array<JsonVisitor>("sections", binary.sections());
+  members.set_array<JsonVisitor>("segments", binary.segments());
 
-  if (binary.has_interpreter()) {
-    this->node_["interpreter"] = binary.interpreter();
-  }
+  // Dynamic entries
+  it_const_dynamic_entries dynamic_entries = binary.dynamic_entries();
+  members.set_array("dynamic_entries", [dynamic_entries] (const JsonMembers::sink_t& sink) {
+    for (const DynamicEntry& entry : dynamic_entries) {
+      JsonVisitor visitor;
+      entry.accept(visitor);
+      sink(visitor.get());
+    }
+  });
 
-  this->node_["header"]                      = header_visitor.get();
-  this->node_["sections"]                    = sections;
-  this->node_["segments"]                    = segments;
-  this->node_["dynamic_entries"]             = dynamic_entries;
-  this->node_["dynamic_symbols"]             = dynamic_symbols;
-  this->node_["static_symbols"]              = static_symbols;
-  this->node_["dynamic_relocations"]         = dynamic_relocations;
-  this->node_["pltgot_relocations"]          = pltgot_relocations;
-  this->node_["symbols_version"]             = symbols_version;
-  this->node_["symbols_version_requirement"] = symbols_version_requirement;
-  this->node_["symbols_version_definition"]  = symbols_version_definition;
-  this->node_["notes"]                       = notes;
+  members.set_array<JsonVisitor>("dynamic_symbols",             binary.dynamic_symbols());
+  members.set_array<JsonVisitor>("static_symbols",              binary.static_symbols());
+  members.set_array<JsonVisitor>("dynamic_relocations",         binary.dynamic_relocations());
+  members.set_array<JsonVisitor>("pltgot_relocations",          binary.pltgot_relocations());
+  members.set_array<JsonVisitor>("symbols_version",             binary.symbols_version());
+  members.set_array<JsonVisitor>("symbols_version_requirement", binary.symbols_version_requirement());
+  members.set_array<JsonVisitor>("symbols_version_definition",  binary.symbols_version_definition());
+  members.set_array<JsonVisitor>("notes",                       binary.notes());
 
   if (binary.use_gnu_hash()) {
     JsonVisitor gnu_hash_visitor;
     gnu_hash_visitor(binary.gnu_hash());
 
-    this->node_["gnu_hash"] = gnu_hash_visitor.get();
+    members.set("gnu_hash", gnu_hash_visitor.get());
   }
 
   if (binary.use_sysv_hash()) {
     JsonVisitor sysv_hash_visitor;
     sysv_hash_visitor(binary.sysv_hash());
 
-    this->node_["sysv_hash"] = sysv_hash_visitor.get();
+    members.set("sysv_hash", sysv_hash_visitor.get());
   }
+  return members;
+}
+
 
+void JsonVisitor::visit(const Binary& binary) {
+  JsonVisitor::members(binary).update(this->node_);
 }
 
 
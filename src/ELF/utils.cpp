@@ -42,6 +42,10 @@ bool is_elf(const std::string& file) {
 }
 
 bool is_elf(const std::vector<uint8_t>& raw) {
+  return is_elf(span<const uint8_t>{raw});
+}
+
+bool is_elf(span<const uint8_t> raw) {
 
   char magic[sizeof(ElfMagic)];
 
@@ -62,7 +66,7 @@ bool is_elf(const std::vector<uint8_t>& raw) {
 unsigned long hash32(const char* name) {
   unsigned long h = 0, g;
   while (*name) {
-    h = (h << 4) + *name++;
+    h = (h << 4) + static_cast<unsigned char>(*name++);
     if ((g = h & 0xf0000000)) {
       h ^= g >> 24;
     }
@@ -181,6 +181,10 @@ LIEF::symbols_t Binary::get_abstract_symbols() {
   return {std::begin(this->symbols_), std::end(this->symbols_)};
 }
 
+const LIEF::Symbol* Binary::get_abstract_symbol(const std::string& name) const {
+  return this->get_symbol(name);
+}
+
 
 LIEF::Binary::functions_t Binary::get_abstract_exported_functions() const {
   LIEF::Binary::functions_t result;
@@ -387,17 +391,7 @@ bool Binary::has_symbol(const std::string& name) const {
 }
 
 const Symbol* Binary::get_symbol(const std::string& name) const {
-  const auto it_symbol = std::find_if(
-      std::begin(this->symbols_), std::end(this->symbols_),
-      [&name] (const Symbol* sym) {
-        return sym->name() == name;
-      });
-
-  if (it_symbol == std::end(this->symbols_)) {
-    return nullptr;
-  }
-
-  return *it_symbol;
+  return this->symbols_index_.find(this->symbols_, name);
 }
 
 Symbol* Binary::get_symbol(const std::string& name) {
@@ -413,19 +407,10 @@ void Binary::write(const std::string& filename) {
 
 
 const Section* Binary::section_from_offset(uint64_t offset) const {
-  it_const_sections sections = this->sections();
-  const auto it_section = std::find_if(
-      sections.cbegin(), sections.cend(),
-      [offset] (const Section& section) {
-        return ((section.offset() <= offset) and
-            offset < (section.offset() + section.size()));
+  return this->sections_offset_index_.find(this->sections_, offset,
+      [] (const Section& section) {
+        return std::make_pair(section.offset(), section.size());
       });
-
-  if (it_section == sections.cend()) {
-    return nullptr;
-  }
-
-  return &(*it_section);
 }
 
 Section* Binary::section_from_offset(uint64_t offset) {
@@ -454,19 +439,10 @@ Section* Binary::section_from_virtual_address(uint64_t address) {
 }
 
 const SegmentCommand* Binary::segment_from_virtual_address(uint64_t virtual_address) const {
-  it_const_segments segments = this->segments();
-  auto it_segment = std::find_if(
-      std::begin(segments), std::end(segments),
-      [virtual_address] (const SegmentCommand& segment) {
-        return ((segment.virtual_address() <= virtual_address) and
-            virtual_address < (segment.virtual_address() + segment.virtual_size()));
+  return this->segments_va_index_.find(this->segments_, virtual_address,
+      [] (const SegmentCommand& segment) {
+        return std::make_pair(segment.virtual_address(), segment.virtual_size());
       });
-
-  if (it_segment == std::end(segments)) {
-    return nullptr;
-  }
-
-  return &(*it_segment);
 }
 
 size_t Binary::segment_index(const SegmentCommand& segment) const {
@@ -895,6 +871,7 @@ bool Binary::remove(const LoadCommand& command) {
         (*it)->index_--;
       }
       this->segments_.erase(it_cache);
+      this->layout_version_.changed();
     }
     auto it_offset = this->offset_seg_.find(seg->file_offset());
     if (it_offset != std::end(this->offset_seg_)) {
@@ -1049,6 +1026,7 @@ bool Binary::extend_segment(const SegmentCommand& segment, size_t size) {
   target_segment.virtual_size(target_segment.virtual_size() + size_aligned);
   target_segment.file_size(target_segment.file_size() + size_aligned);
   target_segment.data_.resize(target_segment.file_size());
+  ++target_segment.content_version_;
   return true;
 }
 
@@ -1098,6 +1076,7 @@ void Binary::remove_section(const std::string& name, bool clear) {
               section->name());
   } else {
     this->sections_.erase(it_cache);
+    this->layout_version_.changed();
   }
 
   delete section;
@@ -1180,6 +1159,7 @@ Section* Binary::add_section(const SegmentCommand& segment, const Section& secti
   std::move(
       std::begin(content), std::end(content),
       std::begin(target_segment.data_) + relative_offset);
+  ++target_segment.content_version_;
 
   return new_section;
 }
@@ -1429,6 +1409,7 @@ bool Binary::remove(const Symbol& sym) {
   // ------------------------
   delete symbol_to_remove;
   this->symbols_.erase(it_symbol);
+  this->symbols_index_.invalidate();
   symbol_to_remove = nullptr;
   return true;
 }
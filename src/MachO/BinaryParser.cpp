@@ -22,6 +22,7 @@
 #include "BinaryParser.tcc"
 
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
 #include "LIEF/exception.hpp"
 
 #include "LIEF/MachO/BinaryParser.hpp"
@@ -36,8 +37,10 @@
 #include "LIEF/MachO/Symbol.hpp"
 #include "LIEF/MachO/EnumToString.hpp"
 #include "LIEF/MachO/ExportInfo.hpp"
+#include "LIEF/MachO/FilesetCommand.hpp"
 
 #include "filesystem/filesystem.h"
+#include "parallel.hpp"
 
 namespace LIEF {
 namespace MachO {
@@ -79,7 +82,7 @@ BinaryParser::BinaryParser(const std::string& file, const ParserConfig& conf) :
     throw bad_file("'" + file + "' is a FAT MachO, this parser takes fit binary");
   }
 
-  this->stream_ = std::unique_ptr<VectorStream>(new VectorStream{file});
+  this->stream_ = BinaryStream::from_file(file);
 
   this->binary_ = new Binary{};
   this->binary_->name_ = filesystem::path(file).filename();
@@ -271,6 +274,55 @@ void BinaryParser::parse_dyldinfo_export() {
   this->parse_export_trie(offset, end_offset, "");
 }
 
+void BinaryParser::parse_filesets(const std::vector<FilesetCommand*>& filesets) {
+  if (filesets.empty()) {
+    return;
+  }
+
+  // The offsets of the entries are relative to the beginning of the
+  // stream: each entry is parsed from its own view on the whole stream
+  const uint64_t size = this->stream_->size();
+  const uint8_t* raw = this->stream_->peek_array<uint8_t>(0, size, /* check */ false);
+  if (raw == nullptr) {
+    LIEF_ERR("Can't access the content of the fileset entries");
+    return;
+  }
+
+  // The entries don't have nested filesets
+  ParserConfig config = this->config_;
+  config.nb_threads = 1;
+
+  std::vector<std::unique_ptr<Binary>> binaries(filesets.size());
+  parallel_for(filesets.size(), this->config_.nb_threads, [&] (size_t i) {
+    const FilesetCommand& fset = *filesets[i];
+    try {
+      LIEF_DEBUG("Parsing fileset '{}' @ {:x}", fset.name(), fset.file_offset());
+      std::unique_ptr<BinaryStream> stream{new SpanStream{{raw, static_cast<size_t>(size)}}};
+      const auto type = static_cast<MACHO_TYPES>(stream->peek<uint32_t>(fset.file_offset()));
+
+      if (type == MACHO_TYPES::FAT_MAGIC or
+          type == MACHO_TYPES::FAT_CIGAM) {
+        throw corrupted("Mach-O is corrupted with a FAT Mach-O inside a fileset ?");
+      }
+
+      stream->setpos(fset.file_offset());
+      std::unique_ptr<Binary> binary{BinaryParser{std::move(stream), 0, config}.get_binary()};
+      binary->name_ = fset.name();
+      binaries[i] = std::move(binary);
+    } catch (const std::exception& e) {
+      LIEF_DEBUG("{}", e.what());
+    }
+  });
+
+  for (size_t i = 0; i < filesets.size(); ++i) {
+    if (binaries[i] == nullptr) {
+      continue;
+    }
+    filesets[i]->binary_ = binaries[i].get();
+    this->binary_->filesets_.push_back(std::move(binaries[i]));
+  }
+}
+
 Binary* BinaryParser::get_binary() {
   return this->binary_;
 }
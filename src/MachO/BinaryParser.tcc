@@ -141,6 +141,7 @@ void BinaryParser::parse_load_commands() {
   }
 
   uint32_t low_fileoff = -1U;
+  std::vector<FilesetCommand*> filesets;
   for (size_t i = 0; i < nbcmds; ++i) {
     if (not this->stream_->can_read<load_command>(loadcommands_offset)) {
       break;
@@ -485,6 +486,7 @@ void BinaryParser::parse_load_commands() {
           const uint8_t* content = this->stream_->peek_array<uint8_t>(sig->data_offset(), sig->data_size(), /* check */ false);
           if (content != nullptr) {
             sig->raw_signature_ = {content, content + sig->data_size()};
+            sig->parse_blobs();
           }
 
           break;
@@ -632,32 +634,8 @@ void BinaryParser::parse_load_commands() {
           auto* fset = reinterpret_cast<FilesetCommand*>(load_command.get());
           fset->name(entry_name);
 
-          try {
-            LIEF_DEBUG("Parsing fileset '{}' @ {:x} (size: {:x})", entry_name, cmd.fileoff, cmd.cmdsize);
-            MACHO_TYPES type = static_cast<MACHO_TYPES>(this->stream_->peek<uint32_t>(cmd.fileoff));
-
-            // Fat binary
-            if (type == MACHO_TYPES::FAT_MAGIC or
-                type == MACHO_TYPES::FAT_CIGAM) {
-                throw corrupted("Mach-O is corrupted with a FAT Mach-O inside a fileset ?");
-            } else { // fit binary
-
-              // not ideal: we need to move the stream ref for the new BinaryParser then move it back
-              const size_t current_pos = this->stream_->pos();
-              this->stream_->setpos(cmd.fileoff);
-              BinaryParser bp(std::move(this->stream_), 0, this->config_);
-
-              std::unique_ptr<Binary> binary{bp.get_binary()};
-              binary->name_ = entry_name;
-              this->stream_ = std::move(bp.stream_);
-              fset->binary_ = binary.get();
-              this->binary_->filesets_.push_back(std::move(binary));
-              this->stream_->setpos(current_pos);
-            }
-          } catch (const std::exception& e) {
-            LIEF_DEBUG("{}", e.what());
-          }
-
+          // The binaries of the entries are parsed once all the commands are known
+          filesets.push_back(fset);
           break;
         }
 
@@ -685,6 +663,7 @@ void BinaryParser::parse_load_commands() {
     loadcommands_offset += command.cmdsize;
   }
   this->binary_->available_command_space_ = low_fileoff - loadcommands_offset;
+  this->parse_filesets(filesets);
 }
 
 
@@ -22,6 +22,7 @@
 
 #include "LIEF/exception.hpp"
 #include "LIEF/BinaryStream/BinaryStream.hpp"
+#include "LIEF/file_ostream.hpp"
 
 #include "LIEF/MachO/Builder.hpp"
 #include "LIEF/MachO/FatBinary.hpp"
@@ -61,6 +62,16 @@ Builder::Builder(FatBinary* fat) :
   this->build_fat();
 }
 
+Builder::Builder(FatBinary* fat, file_ostream& output) :
+  binaries_{fat->binaries_},
+  binary_{nullptr},
+  raw_{},
+  output_{&output}
+{
+  this->build_fat();
+  output.flush();
+}
+
 
 std::vector<uint8_t> Builder::operator()() {
   return this->get_build();
@@ -179,22 +190,40 @@ void Builder::build_fat() {
   // If there is only one binary don't build a FAT
   if (this->binaries_.size() == 1) {
     Builder builder{this->binaries_.back()};
-    this->raw_.write(builder());
+    if (this->output_ != nullptr) {
+      this->output_->write(builder.get_build());
+    } else {
+      this->raw_.write(builder());
+    }
     return;
   }
   this->build_fat_header();
 
+  // When the output is a file, raw_ only contains the FAT headers and
+  // only one slice is in memory at a time
   for (size_t i = 0; i < this->binaries_.size(); ++i) {
     fat_arch* arch = reinterpret_cast<fat_arch*>(this->raw_.raw().data() + sizeof(fat_header) + i * sizeof(fat_arch));
     Builder builder{this->binaries_[i]};
-    std::vector<uint8_t> raw = builder();
+    const std::vector<uint8_t>& raw = builder.get_build();
     uint32_t alignment = BinaryStream::swap_endian<uint32_t>(arch->align);
-    uint32_t offset = align(this->raw_.size(), 1 << alignment);
+    uint64_t end = this->raw_.size();
+    if (this->output_ != nullptr) {
+      end = std::max<uint64_t>(end, this->output_->size());
+    }
+    uint32_t offset = align(end, 1 << alignment);
 
     arch->offset = BinaryStream::swap_endian<uint32_t>(offset);
     arch->size   = BinaryStream::swap_endian<uint32_t>(raw.size());
-    this->raw_.seekp(offset);
-    this->raw_.write(std::move(raw));
+    if (this->output_ != nullptr) {
+      this->output_->seekp(offset).write(raw);
+    } else {
+      this->raw_.seekp(offset);
+      this->raw_.write(raw);
+    }
+  }
+
+  if (this->output_ != nullptr) {
+    this->output_->seekp(0).write(this->raw_.raw());
   }
 }
 
@@ -331,22 +360,22 @@ void Builder::write(MachO::Binary *binary, const std::string& filename) {
 }
 
 void Builder::write(FatBinary* fatbinary, const std::string& filename) {
-  Builder builder{fatbinary};
-  builder.write(filename);
+  try {
+    file_ostream output{filename};
+    Builder builder{fatbinary, output};
+    output.commit();
+  } catch (const bad_file& e) {
+    LIEF_ERR("Fail to write binary file: {}", e.what());
+  }
 }
 
 void Builder::write(const std::string& filename) const {
-
-  std::ofstream output_file{filename, std::ios::out | std::ios::binary | std::ios::trunc};
-  if (output_file) {
-    std::vector<uint8_t> content;
-    this->raw_.get(content);
-
-    std::copy(
-        std::begin(content), std::end(content),
-        std::ostreambuf_iterator<char>(output_file));
-  } else {
-    LIEF_ERR("Fail to write binary file");
+  try {
+    file_ostream output{filename};
+    output.write(this->raw_.raw());
+    output.commit();
+  } catch (const bad_file& e) {
+    LIEF_ERR("Fail to write binary file: {}", e.what());
   }
 
 }
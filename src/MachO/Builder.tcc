@@ -15,6 +15,7 @@
  */
 #include "logging.hpp"
 #include "LIEF/utils.hpp"
+#include "LIEF/string_table.hpp"
 
 #include "LIEF/MachO/Builder.hpp"
 #include "LIEF/MachO/Binary.hpp"
@@ -549,95 +550,6 @@ void Builder::build(FunctionStarts* function_starts) {
   function_starts->originalData_.insert(std::end(function_starts->originalData_), struct_padding, 0);
 }
 
-template<typename T, typename HANDLER>
-std::vector<std::string> Builder::optimize(const HANDLER& container,
-                                           std::function<std::string(const typename HANDLER::value_type)> getter,
-                                           std::unordered_map<std::string, size_t> *of_map_p) {
-  // TODO(romain): This function is also used in the ELF's builder -> move it in the 'utils' part
-
-  std::set<std::string> string_table;
-  std::vector<std::string> string_table_optimized;
-  string_table_optimized.reserve(container.size());
-
-  // reverse all symbol names and sort them so we can merge then in the linear time:
-  // aaa, aadd, aaaa, cca, ca -> aaaa, aaa, acc, ac ddaa
-  std::transform(
-    std::begin(container), std::end(container),
-    std::inserter(string_table, std::end(string_table)),
-    getter);
-
-  for (auto &val: string_table) {
-    string_table_optimized.emplace_back(std::move(val));
-    std::reverse(std::begin(string_table_optimized.back()), std::end(string_table_optimized.back()));
-  }
-
-  std::sort(std::begin(string_table_optimized), std::end(string_table_optimized),
-      [] (const std::string& lhs, const std::string& rhs) {
-          bool ret = false;
-          if (lhs.size() > rhs.size()) {
-              auto res = lhs.compare(0, rhs.size(), rhs);
-              ret = (res <= 0);
-          } else {
-              auto res = rhs.compare(0, lhs.size(), lhs);
-              ret = (res > 0);
-          }
-          return ret;
-  });
-
-  // as all elements that can be merged are adjacent we can just go through the list once
-  // and memorize one we merged to calculate the offsets later
-  std::unordered_map<std::string, std::string> merged_map;
-  size_t to_set_idx = 0, cur_elm_idx = 1;
-  for (; cur_elm_idx < string_table_optimized.size(); ++cur_elm_idx) {
-      auto &cur_elm = string_table_optimized[cur_elm_idx];
-      auto &to_set_elm = string_table_optimized[to_set_idx];
-      if (to_set_elm.size() >= cur_elm.size()) {
-          auto ret = to_set_elm.compare(0, cur_elm.size(), cur_elm);
-          if (ret == 0) {
-              // when memorizing reverse back symbol names
-              std::string rev_cur_elm = cur_elm;
-              std::string rev_to_set_elm = to_set_elm;
-              std::reverse(std::begin(rev_cur_elm), std::end(rev_cur_elm));
-              std::reverse(std::begin(rev_to_set_elm), std::end(rev_to_set_elm));
-              merged_map[rev_cur_elm] = rev_to_set_elm;
-              continue;
-          }
-      }
-      ++to_set_idx;
-      std::swap(string_table_optimized[to_set_idx], cur_elm);
-  }
-  // if the first one is empty
-  if (string_table_optimized[0].size() == 0) {
-    std::swap(string_table_optimized[0], string_table_optimized[to_set_idx]);
-    --to_set_idx;
-  }
-  string_table_optimized.resize(to_set_idx + 1);
-
-  //reverse symbols back and sort them again
-  for (auto &val: string_table_optimized) {
-      std::reverse(std::begin(val), std::end(val));
-  }
-  std::sort(std::begin(string_table_optimized), std::end(string_table_optimized));
-
-  if (of_map_p) {
-    std::unordered_map<std::string, size_t> offset_map;
-    offset_map[""] = 0;
-    size_t offset_counter = 1;
-    for (const auto &v : string_table_optimized) {
-        offset_map[v] = offset_counter;
-        offset_counter += v.size() + 1;
-    }
-    for (const auto &kv : merged_map) {
-        offset_map[kv.first] = offset_map[kv.second] + (kv.second.size() - kv.first.size());
-    }
-    *of_map_p = std::move(offset_map);
-  }
-
-  return string_table_optimized;
-}
-
-
-
 template<class T>
 void Builder::build(SymbolCommand* symbol_command) {
 
@@ -681,16 +593,17 @@ void Builder::build(SymbolCommand* symbol_command) {
     }
   }
 
-  std::unordered_map<std::string, size_t> offset_name_map;
-  std::vector<std::string> string_table_opt = optimize<Symbol, decltype(symbols)>(
-                                                symbols, [] (const Symbol* sym) { return sym->name(); },
-                                                &offset_name_map);
   // 0 index is reserved
   vector_iostream raw_symbol_names;
   raw_symbol_names.write<uint8_t>(0);
-  for (std::string name : string_table_opt) {
-    raw_symbol_names.write(name);
+
+  StringTable string_table;
+  string_table.reserve(symbols.size());
+  for (const Symbol* sym : symbols) {
+    string_table.add(sym->name());
   }
+  string_table.finalize(raw_symbol_names.tellp());
+  string_table.write(raw_symbol_names);
 
   // If the table is smaller than th original one, fill with 0
   if (raw_symbol_names.size() < symbol_command->strings_size()) {
@@ -724,15 +637,15 @@ void Builder::build(SymbolCommand* symbol_command) {
   nlist_table.reserve(symbols.size() * sizeof(nlist_t));
   for (Symbol* sym : symbols) {
     const std::string& name = sym->name();
-    const auto it_name = offset_name_map.find(name);
+    const size_t name_offset = string_table.offset(name);
 
-    if (it_name == std::end(offset_name_map)) {
+    if (name_offset == StringTable::npos) {
       LIEF_WARN("Can't find name offset for symbol {}", sym->name());
       continue;
     }
 
     nlist_t nl;
-    nl.n_strx  = static_cast<uint32_t>(it_name->second);
+    nl.n_strx  = static_cast<uint32_t>(name_offset);
     nl.n_type  = static_cast<uint8_t>(sym->type());
     nl.n_sect  = static_cast<uint32_t>(sym->numberof_sections());
     nl.n_desc  = static_cast<uint16_t>(sym->description());
@@ -0,0 +1,127 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iomanip>
+#include <algorithm>
+
+#include "LIEF/MachO/CodeDirectory.hpp"
+#include "LIEF/MachO/EnumToString.hpp"
+
+namespace LIEF {
+namespace MachO {
+
+constexpr uint32_t CodeDirectory::MAGIC;
+
+CodeDirectory::CodeDirectory() = default;
+CodeDirectory& CodeDirectory::operator=(const CodeDirectory&) = default;
+CodeDirectory::CodeDirectory(const CodeDirectory&) = default;
+CodeDirectory::~CodeDirectory() = default;
+
+uint32_t CodeDirectory::slot_type() const {
+  return this->slot_type_;
+}
+
+uint32_t CodeDirectory::offset() const {
+  return this->offset_;
+}
+
+uint32_t CodeDirectory::version() const {
+  return this->version_;
+}
+
+uint32_t CodeDirectory::flags() const {
+  return this->flags_;
+}
+
+CodeDirectory::HASH_TYPES CodeDirectory::hash_type() const {
+  return this->hash_type_;
+}
+
+uint8_t CodeDirectory::hash_size() const {
+  return this->hash_size_;
+}
+
+uint32_t CodeDirectory::page_size() const {
+  return this->page_size_;
+}
+
+uint64_t CodeDirectory::code_limit() const {
+  return this->code_limit_;
+}
+
+const std::string& CodeDirectory::identifier() const {
+  return this->identifier_;
+}
+
+const std::string& CodeDirectory::team_id() const {
+  return this->team_id_;
+}
+
+uint32_t CodeDirectory::nb_code_slots() const {
+  return this->nb_code_slots_;
+}
+
+uint32_t CodeDirectory::nb_special_slots() const {
+  return this->nb_special_slots_;
+}
+
+span<const uint8_t> CodeDirectory::code_hash(size_t idx) const {
+  if (idx >= this->nb_code_slots_) {
+    return {};
+  }
+  const size_t offset = (this->nb_special_slots_ + idx) * this->hash_size_;
+  return {this->hashes_.data() + offset, this->hash_size_};
+}
+
+span<const uint8_t> CodeDirectory::special_hash(size_t slot) const {
+  if (slot == 0 or slot > this->nb_special_slots_) {
+    return {};
+  }
+  const size_t offset = (this->nb_special_slots_ - slot) * this->hash_size_;
+  return {this->hashes_.data() + offset, this->hash_size_};
+}
+
+CodeDirectory::range_t CodeDirectory::page_range(size_t idx) const {
+  if (idx >= this->nb_code_slots_) {
+    return {0, 0};
+  }
+  if (this->page_size_ == 0) {
+    return {0, this->code_limit_};
+  }
+  const uint64_t start = static_cast<uint64_t>(idx) * this->page_size_;
+  const uint64_t end   = std::min<uint64_t>(start + this->page_size_, this->code_limit_);
+  return {std::min(start, end), end};
+}
+
+
+std::ostream& operator<<(std::ostream& os, const CodeDirectory& cd) {
+  os << std::hex << std::left;
+  os << std::setw(16) << "Identifier"    << ": " << cd.identifier()             << std::endl;
+  if (not cd.team_id().empty()) {
+    os << std::setw(16) << "Team ID"     << ": " << cd.team_id()                << std::endl;
+  }
+  os << std::setw(16) << "Version"       << ": 0x" << cd.version()              << std::endl;
+  os << std::setw(16) << "Flags"         << ": 0x" << cd.flags()                << std::endl;
+  os << std::setw(16) << "Hash type"     << ": " << to_string(cd.hash_type())   << std::endl;
+  os << std::setw(16) << "Page size"     << ": 0x" << cd.page_size()            << std::endl;
+  os << std::setw(16) << "Code limit"    << ": 0x" << cd.code_limit()           << std::endl;
+  os << std::dec;
+  os << std::setw(16) << "Code slots"    << ": " << cd.nb_code_slots()          << std::endl;
+  os << std::setw(16) << "Special slots" << ": " << cd.nb_special_slots()       << std::endl;
+  return os;
+}
+
+}
+}
@@ -13,17 +13,76 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <numeric>
 #include <iomanip>
+#include <cstring>
+#include <cstddef>
+#include <array>
+
+#include <mbedtls/sha1.h>
+#include <mbedtls/sha256.h>
+#include <mbedtls/sha512.h>
+
+#include "logging.hpp"
+#include "parallel.hpp"
+
+#include "LIEF/exception.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
 
 #include "LIEF/MachO/hash.hpp"
 
 #include "LIEF/MachO/Structures.hpp"
+#include "LIEF/MachO/EnumToString.hpp"
 #include "LIEF/MachO/CodeSignature.hpp"
 
 namespace LIEF {
 namespace MachO {
 
+namespace {
+// Slots of the SuperBlob (from cs_blobs.h)
+constexpr uint32_t CSSLOT_CODEDIRECTORY                 = 0;
+constexpr uint32_t CSSLOT_INFOSLOT                      = 1;
+constexpr uint32_t CSSLOT_RESOURCEDIR                   = 3;
+constexpr uint32_t CSSLOT_APPLICATION                   = 4;
+constexpr uint32_t CSSLOT_ALTERNATE_CODEDIRECTORIES     = 0x1000;
+constexpr uint32_t CSSLOT_ALTERNATE_CODEDIRECTORY_LIMIT = 5;
+constexpr uint32_t CSSLOT_SIGNATURESLOT                 = 0x10000;
+
+constexpr uint32_t CS_SUPPORTSSCATTER     = 0x20100;
+constexpr uint32_t CS_SUPPORTSTEAMID      = 0x20200;
+constexpr uint32_t CS_SUPPORTSCODELIMIT64 = 0x20300;
+
+using digest_t = std::array<uint8_t, 64>;
+
+//! Hash ``size`` bytes of ``data`` with ``type``. Return false if the algorithm is not supported
+bool digest(CodeDirectory::HASH_TYPES type, const uint8_t* data, size_t size, digest_t& out) {
+  switch (type) {
+    case CodeDirectory::HASH_TYPES::SHA1:
+      return mbedtls_sha1(data, size, out.data()) == 0;
+
+    case CodeDirectory::HASH_TYPES::SHA256:
+    case CodeDirectory::HASH_TYPES::SHA256_TRUNCATED:
+      return mbedtls_sha256(data, size, out.data(), /* is224 */ false) == 0;
+
+    case CodeDirectory::HASH_TYPES::SHA384:
+      return mbedtls_sha512(data, size, out.data(), /* is384 */ true) == 0;
+
+    case CodeDirectory::HASH_TYPES::NONE:
+    default:
+      return false;
+  }
+}
+
+bool is_code_directory(uint32_t slot) {
+  return slot == CSSLOT_CODEDIRECTORY or
+         (slot >= CSSLOT_ALTERNATE_CODEDIRECTORIES and
+          slot <  CSSLOT_ALTERNATE_CODEDIRECTORIES + CSSLOT_ALTERNATE_CODEDIRECTORY_LIMIT);
+}
+}
+
+constexpr uint32_t CodeSignature::SUPERBLOB_MAGIC;
+
 CodeSignature::CodeSignature() = default;
 CodeSignature& CodeSignature::operator=(const CodeSignature&) = default;
 CodeSignature::CodeSignature(const CodeSignature&) = default;
@@ -55,6 +114,270 @@ void CodeSignature::data_offset(uint32_t offset) {
 void CodeSignature::data_size(uint32_t size) {
   this->data_size_ = size;
 }
+
+const std::vector<uint8_t>& CodeSignature::content() const {
+  return this->raw_signature_;
+}
+
+CodeSignature::it_const_code_directories CodeSignature::code_directories() const {
+  return this->code_directories_;
+}
+
+
+void CodeSignature::parse_blobs() {
+  this->blobs_.clear();
+  this->code_directories_.clear();
+
+  // The blobs are big-endian
+  SpanStream stream{this->raw_signature_};
+  stream.set_endian_swap(true);
+
+  if (not stream.can_read<uint32_t>(8)) {
+    return;
+  }
+
+  const uint32_t magic = stream.peek_conv<uint32_t>(0);
+  if (magic != SUPERBLOB_MAGIC) {
+    LIEF_DEBUG("Unknown code signature magic: 0x{:x}", magic);
+    return;
+  }
+
+  const uint32_t count = stream.peek_conv<uint32_t>(8);
+  if (12 + static_cast<uint64_t>(count) * 2 * sizeof(uint32_t) > stream.size()) {
+    LIEF_WARN("The SuperBlob index is corrupted ({:d} entries)", count);
+    return;
+  }
+
+  this->blobs_.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t type   = stream.peek_conv<uint32_t>(12 + i * 8);
+    const uint32_t offset = stream.peek_conv<uint32_t>(12 + i * 8 + 4);
+    this->blobs_.emplace_back(type, offset);
+  }
+
+  for (const std::pair<uint32_t, uint32_t>& blob : this->blobs_) {
+    if (not is_code_directory(blob.first)) {
+      continue;
+    }
+    const uint32_t offset = blob.second;
+    try {
+      if (stream.peek_conv<uint32_t>(offset) != CodeDirectory::MAGIC) {
+        LIEF_WARN("Bad CodeDirectory magic at offset 0x{:x}", offset);
+        continue;
+      }
+
+      CodeDirectory cd;
+      cd.slot_type_        = blob.first;
+      cd.offset_           = offset;
+      cd.version_          = stream.peek_conv<uint32_t>(offset + 8);
+      cd.flags_            = stream.peek_conv<uint32_t>(offset + 12);
+      cd.nb_special_slots_ = stream.peek_conv<uint32_t>(offset + 24);
+      cd.nb_code_slots_    = stream.peek_conv<uint32_t>(offset + 28);
+      cd.code_limit_       = stream.peek_conv<uint32_t>(offset + 32);
+      cd.hash_size_        = stream.peek<uint8_t>(offset + 36);
+      cd.hash_type_        = static_cast<CodeDirectory::HASH_TYPES>(stream.peek<uint8_t>(offset + 37));
+
+      const uint8_t page_size = stream.peek<uint8_t>(offset + 39);
+      cd.page_size_ = page_size == 0 ? 0 : (1u << std::min<uint8_t>(page_size, 31));
+
+      const uint32_t hash_offset  = stream.peek_conv<uint32_t>(offset + 16);
+      const uint32_t ident_offset = stream.peek_conv<uint32_t>(offset + 20);
+
+      if (ident_offset > 0) {
+        cd.identifier_ = stream.peek_string_at(offset + ident_offset);
+      }
+
+      if (cd.version_ >= CS_SUPPORTSTEAMID) {
+        const uint32_t team_offset = stream.peek_conv<uint32_t>(offset + 48);
+        if (team_offset > 0) {
+          cd.team_id_ = stream.peek_string_at(offset + team_offset);
+        }
+      }
+
+      if (cd.version_ >= CS_SUPPORTSCODELIMIT64) {
+        const uint64_t code_limit64 = stream.peek_conv<uint64_t>(offset + 56);
+        if (code_limit64 > 0) {
+          cd.code_limit_ = code_limit64;
+        }
+      }
+
+      if (cd.version_ >= CS_SUPPORTSSCATTER and stream.peek_conv<uint32_t>(offset + 44) > 0) {
+        LIEF_WARN("Scatter vectors are not supported: the page hashes of '{}' are not checked", cd.identifier_);
+      }
+
+      const uint64_t special_size = static_cast<uint64_t>(cd.nb_special_slots_) * cd.hash_size_;
+      const uint64_t hashes_size  = special_size + static_cast<uint64_t>(cd.nb_code_slots_) * cd.hash_size_;
+      if (special_size > hash_offset) {
+        LIEF_WARN("The special slots of '{}' are corrupted", cd.identifier_);
+        continue;
+      }
+
+      const uint64_t hashes_offset = offset + hash_offset - special_size;
+      const uint8_t* hashes = stream.peek_array<uint8_t>(hashes_offset, hashes_size, /* check */ false);
+      if (hashes == nullptr) {
+        LIEF_WARN("The hashes of '{}' are out of the signature", cd.identifier_);
+        continue;
+      }
+      cd.hashes_ = {hashes, hashes + hashes_size};
+      this->code_directories_.push_back(std::move(cd));
+    } catch (const LIEF::exception& e) {
+      LIEF_WARN("Can't parse the CodeDirectory at offset 0x{:x}: {}", offset, e.what());
+    }
+  }
+}
+
+
+CodeSignature::verification_t CodeSignature::verify(span<const uint8_t> raw, size_t nb_threads) const {
+  verification_t result;
+  result.reserve(this->code_directories_.size());
+
+  SpanStream stream{this->raw_signature_};
+  stream.set_endian_swap(true);
+
+  for (size_t i = 0; i < this->code_directories_.size(); ++i) {
+    const CodeDirectory& cd = this->code_directories_[i];
+    const auto start = std::chrono::steady_clock::now();
+
+    if (cd.hash_type() == CodeDirectory::HASH_TYPES::NONE or
+        cd.hash_type() >  CodeDirectory::HASH_TYPES::SHA384 or
+        cd.hash_size() >  sizeof(digest_t))
+    {
+      LIEF_WARN("Hash type {} is not supported ('{}')", to_string(cd.hash_type()), cd.identifier());
+      continue;
+    }
+
+    directory_verification_t check;
+    check.index    = i;
+    check.nb_pages = cd.nb_code_slots();
+
+    if (cd.code_limit() > raw.size()) {
+      LIEF_WARN("The code limit of '{}' (0x{:x}) is beyond the end of the binary",
+                cd.identifier(), cd.code_limit());
+    }
+
+    // The code slots must cover the whole code: [0, code_limit)
+    uint64_t covered = 0;
+    if (cd.nb_code_slots() > 0) {
+      covered = cd.page_size() == 0 ? cd.code_limit() :
+                std::min<uint64_t>(static_cast<uint64_t>(cd.nb_code_slots()) * cd.page_size(), cd.code_limit());
+    }
+    check.uncovered_size = cd.code_limit() - covered;
+    if (check.uncovered_size > 0) {
+      LIEF_WARN("The code slots of '{}' don't cover the last 0x{:x} bytes of the code",
+                cd.identifier(), check.uncovered_size);
+    }
+
+    // One flag per page so that the workers don't have to synchronize
+    std::vector<uint8_t> mismatches(cd.nb_code_slots(), 0);
+    parallel_for(cd.nb_code_slots(), nb_threads,
+      [&] (size_t page) {
+        const CodeDirectory::range_t range = cd.page_range(page);
+        if (range.second > raw.size()) {
+          mismatches[page] = 1;
+          return;
+        }
+        digest_t hash;
+        digest(cd.hash_type(), raw.data() + range.first, range.second - range.first, hash);
+        mismatches[page] = std::memcmp(hash.data(), cd.code_hash(page).data(), cd.hash_size()) != 0;
+      });
+
+    for (size_t page = 0; page < mismatches.size(); ++page) {
+      if (mismatches[page] != 0) {
+        check.mismatched_pages.push_back(page);
+      }
+    }
+
+    // The special slots hash the other blobs of the SuperBlob (requirements, entitlements, ...)
+    for (const std::pair<uint32_t, uint32_t>& blob : this->blobs_) {
+      const uint32_t slot = blob.first;
+      if (slot == CSSLOT_CODEDIRECTORY or slot > cd.nb_special_slots() or slot >= CSSLOT_SIGNATURESLOT) {
+        continue;
+      }
+      const uint8_t* content = nullptr;
+      uint32_t size = 0;
+      if (stream.can_read<uint32_t>(blob.second + 4)) {
+        size    = stream.peek_conv<uint32_t>(blob.second + 4);
+        content = stream.peek_array<uint8_t>(blob.second, size, /* check */ false);
+      }
+      digest_t hash;
+      if (content == nullptr or
+          not digest(cd.hash_type(), content, size, hash) or
+          std::memcmp(hash.data(), cd.special_hash(slot).data(), cd.hash_size()) != 0)
+      {
+        check.mismatched_special_slots.push_back(slot);
+      }
+    }
+
+    // A special slot which is set must have its blob, except the slots that
+    // hash files outside of the binary (Info.plist, CodeResources, ...)
+    static const std::vector<uint8_t> EMPTY_HASH(sizeof(digest_t), 0);
+    for (uint32_t slot = 1; slot <= cd.nb_special_slots(); ++slot) {
+      if (slot == CSSLOT_INFOSLOT or slot == CSSLOT_RESOURCEDIR or slot == CSSLOT_APPLICATION) {
+        continue;
+      }
+      const span<const uint8_t> hash = cd.special_hash(slot);
+      if (hash.empty() or std::memcmp(hash.data(), EMPTY_HASH.data(), hash.size()) == 0) {
+        continue;
+      }
+      auto it_blob = std::find_if(std::begin(this->blobs_), std::end(this->blobs_),
+          [slot] (const std::pair<uint32_t, uint32_t>& blob) {
+            return blob.first == slot;
+          });
+      if (it_blob == std::end(this->blobs_)) {
+        check.missing_special_slots.push_back(slot);
+      }
+    }
+
+    check.elapsed = duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    LIEF_DEBUG("CodeDirectory '{}': {:d} pages checked in {}", cd.identifier(), check.nb_pages,
+               duration_cast<milliseconds>(check.elapsed));
+    result.push_back(std::move(check));
+  }
+  return result;
+}
+
+
+CodeSignature::verification_t CodeSignature::verify(const std::string& filename, size_t nb_threads) const {
+  std::unique_ptr<BinaryStream> stream = BinaryStream::from_file(filename);
+  const uint64_t size = stream->size();
+  const uint8_t* raw  = stream->peek_array<uint8_t>(0, size, /* check */ false);
+  if (raw == nullptr or size < sizeof(uint32_t)) {
+    throw bad_file("Can't read '" + filename + "'");
+  }
+
+  uint32_t magic = 0;
+  std::memcpy(&magic, raw, sizeof(magic));
+  if (magic != static_cast<uint32_t>(MACHO_TYPES::FAT_MAGIC) and
+      magic != static_cast<uint32_t>(MACHO_TYPES::FAT_CIGAM))
+  {
+    return this->verify(span<const uint8_t>{raw, size}, nb_threads);
+  }
+
+  // Look for the slice that embeds this signature
+  SpanStream fat{span<const uint8_t>{raw, size}};
+  fat.set_endian_swap(magic == static_cast<uint32_t>(MACHO_TYPES::FAT_CIGAM));
+  const uint32_t nb_arch = fat.peek_conv<uint32_t>(sizeof(uint32_t));
+  for (size_t i = 0; i < nb_arch; ++i) {
+    const uint64_t arch_offset = sizeof(fat_header) + i * sizeof(fat_arch);
+    if (not fat.can_read<fat_arch>(arch_offset)) {
+      break;
+    }
+    const uint32_t slice_offset = fat.peek_conv<uint32_t>(arch_offset + offsetof(fat_arch, offset));
+    const uint32_t slice_size   = fat.peek_conv<uint32_t>(arch_offset + offsetof(fat_arch, size));
+    if (static_cast<uint64_t>(slice_offset) + slice_size > size or
+        static_cast<uint64_t>(this->data_offset()) + this->raw_signature_.size() > slice_size)
+    {
+      continue;
+    }
+    const uint8_t* slice = raw + slice_offset;
+    if (std::memcmp(slice + this->data_offset(), this->raw_signature_.data(), this->raw_signature_.size()) == 0) {
+      return this->verify(span<const uint8_t>{slice, slice_size}, nb_threads);
+    }
+  }
+  throw not_found("Can't find the slice of '" + filename + "' that embeds the signature");
+}
+
+
 void CodeSignature::accept(Visitor& visitor) const {
   visitor.visit(*this);
 }
@@ -78,6 +401,11 @@ std::ostream& CodeSignature::print(std::ostream& os) const {
   os << "Code Signature location:" << std::endl;
   os << std::setw(8) << "Offset" << ": 0x" << this->data_offset() << std::endl;
   os << std::setw(8) << "Size"   << ": 0x" << this->data_size()   << std::endl;
+  for (const CodeDirectory& cd : this->code_directories()) {
+    os << std::endl;
+    os << "Code Directory:" << std::endl;
+    os << cd;
+  }
   return os;
 }
 
@@ -533,5 +533,17 @@ const char* to_string(BuildToolVersion::TOOLS e) {
   return it == enumStrings.end() ? "UNKNOWN" : it->second;
 }
 
+const char* to_string(CodeDirectory::HASH_TYPES e) {
+  CONST_MAP(CodeDirectory::HASH_TYPES, const char*, 5) enumStrings {
+    { CodeDirectory::HASH_TYPES::NONE,             "NONE"             },
+    { CodeDirectory::HASH_TYPES::SHA1,             "SHA1"             },
+    { CodeDirectory::HASH_TYPES::SHA256,           "SHA256"           },
+    { CodeDirectory::HASH_TYPES::SHA256_TRUNCATED, "SHA256_TRUNCATED" },
+    { CodeDirectory::HASH_TYPES::SHA384,           "SHA384"           },
+  };
+  auto   it  = enumStrings.find(e);
+  return it == enumStrings.end() ? "UNKNOWN" : it->second;
+}
+
 }
 }
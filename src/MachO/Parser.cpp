@@ -25,6 +25,7 @@
 
 #include "LIEF/exception.hpp"
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
 
 #include "LIEF/MachO/Structures.hpp"
 #include "LIEF/MachO/FatBinary.hpp"
@@ -34,6 +35,7 @@
 #include "LIEF/MachO/utils.hpp"
 
 #include "filesystem/filesystem.h"
+#include "parallel.hpp"
 
 namespace LIEF {
 namespace MachO {
@@ -44,7 +46,7 @@ Parser::~Parser() = default;
 // From File
 Parser::Parser(const std::string& file, const ParserConfig& conf) :
   LIEF::Parser{file},
-  stream_{std::unique_ptr<VectorStream>(new VectorStream{file})},
+  stream_{BinaryStream::from_file(file)},
   binaries_{},
   config_{conf}
 {
@@ -88,6 +90,53 @@ std::unique_ptr<FatBinary> Parser::parse(const std::vector<uint8_t>& data, const
   return std::unique_ptr<FatBinary>{new FatBinary{parser.binaries_}};
 }
 
+// From a buffer owned by the caller
+Parser::Parser(span<const uint8_t> data, const std::string& name, const ParserConfig& conf) :
+  stream_{std::unique_ptr<SpanStream>(new SpanStream{data})},
+  binaries_{},
+  config_{conf}
+{
+  this->build();
+
+  for (Binary* binary : this->binaries_) {
+    binary->name(name);
+  }
+}
+
+
+std::unique_ptr<FatBinary> Parser::parse(span<const uint8_t> data, const std::string& name, const ParserConfig& conf) {
+  if (not is_macho(data)) {
+    throw bad_file("'" + name + "' is not a MachO binary");
+  }
+
+  Parser parser{data, name, conf};
+  return std::unique_ptr<FatBinary>{new FatBinary{parser.binaries_}};
+}
+
+
+// From a stream opened by the caller
+Parser::Parser(std::unique_ptr<BinaryStream> stream, const std::string& name, const ParserConfig& conf) :
+  stream_{std::move(stream)},
+  binaries_{},
+  config_{conf}
+{
+  this->build();
+
+  for (Binary* binary : this->binaries_) {
+    binary->name(name);
+  }
+}
+
+
+std::unique_ptr<FatBinary> Parser::parse(std::unique_ptr<BinaryStream> stream, const std::string& name, const ParserConfig& conf) {
+  const uint8_t* magic = stream->peek_array<uint8_t>(0, sizeof(uint32_t), /* check */ false);
+  if (magic == nullptr or not is_macho({magic, sizeof(uint32_t)})) {
+    throw bad_file("'" + name + "' is not a MachO binary");
+  }
+
+  Parser parser{std::move(stream), name, conf};
+  return std::unique_ptr<FatBinary>{new FatBinary{parser.binaries_}};
+}
 
 
 void Parser::build_fat() {
@@ -101,9 +150,19 @@ void Parser::build_fat() {
   }
 
   const fat_arch* arch = this->stream_->peek_array<fat_arch>(sizeof(fat_header), nb_arch, /* check */ false);
+  if (arch == nullptr) {
+    throw corrupted("Can't read the fat architectures");
+  }
 
-  for (size_t i = 0; i < nb_arch; ++i) {
+  // The slices are parsed concurrently from views on the input stream:
+  // there is no copy of their content.
+  ParserConfig config = this->config_;
+  if (nb_arch > 1) {
+    config.nb_threads = 1;
+  }
 
+  std::vector<std::unique_ptr<Binary>> binaries(nb_arch);
+  parallel_for(nb_arch, this->config_.nb_threads, [&] (size_t i) {
     const uint32_t offset = BinaryStream::swap_endian(arch[i].offset);
     const uint32_t size   = BinaryStream::swap_endian(arch[i].size);
 
@@ -115,13 +174,17 @@ void Parser::build_fat() {
 
     if (raw == nullptr) {
       LIEF_ERR("MachO #{:d} is corrupted!", i);
-      continue;
+      return;
     }
 
-    std::vector<uint8_t> data = {raw, raw + size};
+    std::unique_ptr<BinaryStream> slice{new SpanStream{{raw, size}}};
+    binaries[i].reset(BinaryParser{std::move(slice), offset, config}.get_binary());
+  });
 
-    Binary *binary = BinaryParser{std::move(data), offset, this->config_}.get_binary();
-    this->binaries_.push_back(binary);
+  for (std::unique_ptr<Binary>& binary : binaries) {
+    if (binary != nullptr) {
+      this->binaries_.push_back(binary.release());
+    }
   }
 }
 
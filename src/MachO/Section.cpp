@@ -123,6 +123,8 @@ Section::Section(const section_64 *sectionCmd) :
 
 
 void Section::swap(Section& other) {
+  this->index_changed();
+  other.index_changed();
   std::swap(this->name_,            other.name_);
   std::swap(this->virtual_address_, other.virtual_address_);
   std::swap(this->size_,            other.size_);
@@ -177,9 +179,27 @@ Section::content_t Section::content() const {
   return section_content;
 }
 
+span<const uint8_t> Section::content_view() const {
+  if (this->segment_ == nullptr) {
+    return this->content_;
+  }
+
+  if (this->size_ == 0 or this->offset_ == 0) { // bss section for instance
+    return {};
+  }
+
+  uint64_t relative_offset = this->offset_ - this->segment_->file_offset();
+  const std::vector<uint8_t>& content = this->segment_->content();
+  if ((relative_offset + this->size_) > content.size()) {
+    throw LIEF::corrupted("Section's size is bigger than segment's size");
+  }
+  return {content.data() + relative_offset, static_cast<size_t>(this->size_)};
+}
+
 void Section::content(const Section::content_t& data) {
   if (this->segment_ == nullptr) {
     this->content_ = data;
+    this->content_changed();
     return;
   }
 
@@ -202,6 +222,19 @@ void Section::content(const Section::content_t& data) {
   this->segment_->content(content);
 }
 
+DigestCache::key_t Section::digest_key() const {
+  if (this->segment_ == nullptr) {
+    return LIEF::Section::digest_key();
+  }
+  // The content is owned by the segment
+  DigestCache::key_t key;
+  key.source  = this->segment_;
+  key.version = this->segment_->content_version_;
+  key.offset  = this->offset_ - this->segment_->file_offset();
+  key.size    = this->size_;
+  return key;
+}
+
 const std::string& Section::segment_name() const {
   if (this->segment_ != nullptr) {
     return this->segment_->name();
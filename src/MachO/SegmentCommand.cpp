@@ -34,6 +34,7 @@ SegmentCommand& SegmentCommand::operator=(SegmentCommand other) {
 
 SegmentCommand::SegmentCommand(const SegmentCommand& other) :
   LoadCommand{other},
+  Indexed{},
   name_{other.name_},
   virtualAddress_{other.virtualAddress_},
   virtualSize_{other.virtualSize_},
@@ -109,6 +110,8 @@ SegmentCommand::SegmentCommand(const segment_command_64 *segmentCmd) :
 
 void SegmentCommand::swap(SegmentCommand& other) {
   LoadCommand::swap(other);
+  this->index_changed();
+  other.index_changed();
 
   std::swap(this->virtualAddress_, other.virtualAddress_);
   std::swap(this->virtualSize_,    other.virtualSize_);
@@ -121,6 +124,11 @@ void SegmentCommand::swap(SegmentCommand& other) {
   std::swap(this->data_,           other.data_);
   std::swap(this->sections_,       other.sections_);
   std::swap(this->relocations_,    other.relocations_);
+  // The contents have been exchanged
+  ++this->content_version_;
+  ++other.content_version_;
+  this->digest_.clear();
+  other.digest_.clear();
 }
 
 SegmentCommand* SegmentCommand::clone() const {
@@ -200,23 +208,35 @@ const SegmentCommand::content_t& SegmentCommand::content() const {
   return this->data_;
 }
 
+size_t SegmentCommand::content_digest() const {
+  DigestCache::key_t key;
+  key.version = this->content_version_;
+  return this->digest_.get(key, [this] {
+    return LIEF::Hash::hash(this->data_);
+  });
+}
+
 void SegmentCommand::name(const std::string& name) {
   this->name_ = name;
 }
 
 void SegmentCommand::virtual_address(uint64_t virtualAddress) {
+  this->index_changed();
   this->virtualAddress_ = virtualAddress;
 }
 
 void SegmentCommand::virtual_size(uint64_t virtualSize) {
+  this->index_changed();
   this->virtualSize_ = virtualSize;
 }
 
 void SegmentCommand::file_size(uint64_t fileSize) {
+  this->index_changed();
   this->fileSize_ = fileSize;
 }
 
 void SegmentCommand::file_offset(uint64_t fileOffset) {
+  this->index_changed();
   this->fileOffset_ = fileOffset;
 }
 
@@ -239,6 +259,7 @@ void SegmentCommand::flags(uint32_t flags) {
 
 void SegmentCommand::content(const SegmentCommand::content_t& data) {
   this->data_ = data;
+  ++this->content_version_;
 }
 
 
@@ -273,6 +294,7 @@ Section& SegmentCommand::add_section(const Section& section) {
       std::begin(content),
       std::end(content),
       std::begin(this->data_) + relative_offset);
+  ++this->content_version_;
 
   this->file_size(this->data_.size());
   this->sections_.push_back(new_section.release());
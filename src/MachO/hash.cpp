@@ -78,12 +78,12 @@ void Hash::visit(const SegmentCommand& segment) {
   this->process(segment.init_protection());
   this->process(segment.numberof_sections());
   this->process(segment.flags());
-  this->process(segment.content());
+  this->process_digest(segment.content_digest());
   this->process(std::begin(segment.sections()), std::end(segment.sections()));
 }
 
 void Hash::visit(const Section& section) {
-  this->process(section.content());
+  this->process_digest(section.content_digest());
   this->process(section.segment_name());
   this->process(section.address());
   this->process(section.alignment());
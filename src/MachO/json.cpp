@@ -39,146 +39,114 @@ std::string to_json_str(const Object& v) {
 }
 
 
-void JsonVisitor::visit(const Binary& binary) {
+JsonMembers JsonVisitor::members(const Binary& binary) {
+  JsonMembers members;
+
   JsonVisitor header_visitor;
   header_visitor(binary.header());
 
-  // Sections
-  std::vector<json> sections;
-  for (const Section& section : binary.sections()) {
-    JsonVisitor visitor;
-    visitor(section);
-    sections.emplace_back(visitor.get());
-  }
-
-  // Segments
-  std::vector<json> segments;
-  for (const SegmentCommand& segment : binary.segments()) {
-    JsonVisitor visitor;
-    visitor(segment);
-    segments.emplace_back(visitor.get());
-  }
-
-  // Symbols
-  std::vector<json> symbols;
-  for (const Symbol& sym : binary.symbols()) {
-    JsonVisitor visitor;
-    visitor(sym);
-    symbols.emplace_back(visitor.get());
-  }
-
-  // Relocations
-  std::vector<json> relocations;
-  for (const Relocation& r : binary.relocations()) {
-    JsonVisitor visitor;
-    visitor(r);
-    relocations.emplace_back(visitor.get());
-  }
-
-  std::vector<json> libraries;
-  for (const DylibCommand& lib : binary.libraries()) {
-    JsonVisitor visitor;
-    visitor(lib);
-    libraries.emplace_back(visitor.get());
-  }
-
-
-  this->node_["header"]      = header_visitor.get();
-  this->node_["sections"]    = sections;
-  this->node_["segments"]    = segments;
-  this->node_["symbols"]     = symbols;
-  this->node_["relocations"] = relocations;
-  this->node_["libraries"]   = libraries;
+  members.set("header", header_visitor.get());
+  members.set_array<JsonVisitor>("sections",    binary.sections());
+  members.set_array<JsonVisitor>("segments",    binary.segments());
+  members.set_array<JsonVisitor>("symbols",     binary.symbols());
+  members.set_array<JsonVisitor>("relocations", binary.relocations());
+  members.set_array<JsonVisitor>("libraries",   binary.libraries());
 
   if (binary.has_uuid()) {
     JsonVisitor v;
     v(binary.uuid());
-    this->node_["uuid"] = v.get();
+    members.set("uuid", v.get());
   }
 
   if (binary.has_main_command()) {
     JsonVisitor v;
     v(binary.main_command());
-    this->node_["main_command"] = v.get();
+    members.set("main_command", v.get());
   }
 
   if (binary.has_dylinker()) {
     JsonVisitor v;
     v(binary.dylinker());
-    this->node_["dylinker"] = v.get();
+    members.set("dylinker", v.get());
   }
 
   if (binary.has_dyld_info()) {
     JsonVisitor v;
     v(binary.dyld_info());
-    this->node_["dyld_info"] = v.get();
+    members.set("dyld_info", v.get());
   }
 
   if (binary.has_function_starts()) {
     JsonVisitor v;
     v(binary.function_starts());
-    this->node_["function_starts"] = v.get();
+    members.set("function_starts", v.get());
   }
 
   if (binary.has_source_version()) {
     JsonVisitor v;
     v(binary.source_version());
-    this->node_["source_version"] = v.get();
+    members.set("source_version", v.get());
   }
 
   if (binary.has_version_min()) {
     JsonVisitor v;
     v(binary.version_min());
-    this->node_["version_min"] = v.get();
+    members.set("version_min", v.get());
   }
 
   if (binary.has_thread_command()) {
     JsonVisitor v;
     v(binary.thread_command());
-    this->node_["thread_command"] = v.get();
+    members.set("thread_command", v.get());
   }
 
   if (binary.has_rpath()) {
     JsonVisitor v;
     v(binary.rpath());
-    this->node_["rpath"] = v.get();
+    members.set("rpath", v.get());
   }
 
   if (binary.has_symbol_command()) {
     JsonVisitor v;
     v(binary.symbol_command());
-    this->node_["symbol_command"] = v.get();
+    members.set("symbol_command", v.get());
   }
 
   if (binary.has_dynamic_symbol_command()) {
     JsonVisitor v;
     v(binary.dynamic_symbol_command());
-    this->node_["dynamic_symbol_command"] = v.get();
+    members.set("dynamic_symbol_command", v.get());
   }
 
   if (binary.has_code_signature()) {
     JsonVisitor v;
     v(binary.code_signature());
-    this->node_["code_signature"] = v.get();
+    members.set("code_signature", v.get());
   }
 
   if (binary.has_data_in_code()) {
     JsonVisitor v;
     v(binary.data_in_code());
-    this->node_["data_in_code"] = v.get();
+    members.set("data_in_code", v.get());
   }
 
   if (binary.has_encryption_info()) {
     JsonVisitor v;
     v(binary.encryption_info());
-    this->node_["encryption_info"] = v.get();
+    members.set("encryption_info", v.get());
   }
 
   if (binary.has_build_version()) {
     JsonVisitor v;
     v(binary.build_version());
-    this->node_["build_version"] = v.get();
+    members.set("build_version", v.get());
   }
+  return members;
+}
+
+
+void JsonVisitor::visit(const Binary& binary) {
+  JsonVisitor::members(binary).update(this->node_);
 }
 
 
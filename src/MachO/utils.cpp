@@ -58,6 +58,10 @@ bool is_macho(const std::string& file) {
 }
 
 bool is_macho(const std::vector<uint8_t>& raw) {
+  return is_macho(span<const uint8_t>{raw});
+}
+
+bool is_macho(span<const uint8_t> raw) {
 
   if (raw.size() < sizeof(MACHO_TYPES)) {
     return false;
@@ -67,6 +67,18 @@ std::unique_ptr<Binary> Parser::parse(const std::vector<uint8_t>& data, const st
 }
 
 
+std::unique_ptr<Binary> Parser::parse(std::unique_ptr<BinaryStream> stream, const std::string& name) {
+  if (not is_oat(*stream)) {
+    LIEF_ERR("{} is not an OAT", name);
+    return nullptr;
+  }
+
+  Parser parser{std::move(stream), name};
+  parser.init(name);
+  return std::unique_ptr<Binary>{parser.oat_binary_};
+}
+
+
 Parser::Parser(const std::vector<uint8_t>& data, const std::string& name) :
   oat_binary_{new Binary{}},
   stream_{nullptr}
@@ -74,6 +86,13 @@ Parser::Parser(const std::vector<uint8_t>& data, const std::string& name) :
   LIEF::ELF::Parser{data, name, LIEF::ELF::DYNSYM_COUNT_METHODS::COUNT_AUTO, this->oat_binary_};
 }
 
+Parser::Parser(std::unique_ptr<BinaryStream> stream, const std::string& name) :
+  oat_binary_{new Binary{}},
+  stream_{nullptr}
+{
+  LIEF::ELF::Parser{std::move(stream), name, LIEF::ELF::ParserConfig::deep(), this->oat_binary_};
+}
+
 Parser::Parser(const std::string& file) :
   LIEF::Parser{file},
   oat_binary_{new Binary{}},
@@ -14,48 +14,145 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstring>
 #include <string>
 #include "LIEF/OAT/utils.hpp"
 #include "LIEF/OAT/Structures.hpp"
 
+#include "LIEF/BinaryStream/SpanStream.hpp"
 #include "LIEF/ELF.hpp"
+#include "LIEF/ELF/Structures.hpp"
 
 
 namespace LIEF {
 namespace OAT {
 
-bool is_oat(const std::string& file) {
-  if (not LIEF::ELF::is_elf(file)) {
+//! Look for the ``oatdata`` symbol in the ``.dynsym`` section and check that
+//! it points to the OAT magic, without parsing the whole ELF.
+template<class ELF_T>
+static bool probe_oatdata(const BinaryStream& stream) {
+  using Elf_Ehdr = typename ELF_T::Elf_Ehdr;
+  using Elf_Shdr = typename ELF_T::Elf_Shdr;
+  using Elf_Sym  = typename ELF_T::Elf_Sym;
+  static constexpr char OATDATA[] = "oatdata";
+
+  if (not stream.can_read<Elf_Ehdr>(0)) {
     return false;
   }
-
-  std::unique_ptr<const LIEF::ELF::Binary> elf_binary;
-  try {
-    elf_binary = std::unique_ptr<const LIEF::ELF::Binary>{LIEF::ELF::Parser::parse(file)};
-  } catch (const LIEF::exception&) {
+  const auto hdr = stream.peek_conv<Elf_Ehdr>(0);
+  if (hdr.e_shnum == 0 or hdr.e_shentsize != sizeof(Elf_Shdr)) {
     return false;
   }
 
-  if (elf_binary == nullptr) {
+  std::unique_ptr<Elf_Shdr[]> sections = stream.peek_conv_array<Elf_Shdr>(hdr.e_shoff, hdr.e_shnum, /* check */ false);
+  if (sections == nullptr) {
     return false;
   }
 
-  return is_oat(*elf_binary);
-
+  for (size_t i = 0; i < hdr.e_shnum; ++i) {
+    const Elf_Shdr& dynsym = sections[i];
+    if (static_cast<ELF::ELF_SECTION_TYPES>(dynsym.sh_type) != ELF::ELF_SECTION_TYPES::SHT_DYNSYM or
+        dynsym.sh_link >= hdr.e_shnum)
+    {
+      continue;
+    }
+
+    const Elf_Shdr& dynstr = sections[dynsym.sh_link];
+    const char* strtab = stream.peek_array<char>(dynstr.sh_offset, dynstr.sh_size, /* check */ false);
+    if (strtab == nullptr) {
+      return false;
+    }
+
+    const size_t nb_symbols = dynsym.sh_size / sizeof(Elf_Sym);
+    for (size_t j = 0; j < nb_symbols; ++j) {
+      const uint64_t offset = dynsym.sh_offset + j * sizeof(Elf_Sym);
+      if (not stream.can_read<Elf_Sym>(offset)) {
+        return false;
+      }
+      const auto sym = stream.peek_conv<Elf_Sym>(offset);
+      if (sym.st_name >= dynstr.sh_size or dynstr.sh_size - sym.st_name < sizeof(OATDATA) or
+          std::memcmp(strtab + sym.st_name, OATDATA, sizeof(OATDATA)) != 0)
+      {
+        continue;
+      }
+
+      // Translate the address of oatdata into an offset
+      for (size_t k = 0; k < hdr.e_shnum; ++k) {
+        const Elf_Shdr& section = sections[k];
+        if (static_cast<ELF::ELF_SECTION_TYPES>(section.sh_type) == ELF::ELF_SECTION_TYPES::SHT_NOBITS or
+            sym.st_value < section.sh_addr or sym.st_value >= section.sh_addr + section.sh_size)
+        {
+          continue;
+        }
+        const uint8_t* magic = stream.peek_array<uint8_t>(section.sh_offset + (sym.st_value - section.sh_addr),
+                                                          sizeof(oat_magic), /* check */ false);
+        return magic != nullptr and std::equal(magic, magic + sizeof(oat_magic), std::begin(oat_magic));
+      }
+      return false;
+    }
+  }
+  return false;
 }
 
+bool is_oat(BinaryStream& stream) {
+  const uint8_t* ident = stream.peek_array<uint8_t>(0, static_cast<size_t>(ELF::IDENTITY::EI_NIDENT), /* check */ false);
+  if (ident == nullptr or not ELF::is_elf({ident, static_cast<size_t>(ELF::IDENTITY::EI_NIDENT)})) {
+    return false;
+  }
 
-bool is_oat(const std::vector<uint8_t>& raw) {
-  std::unique_ptr<const LIEF::ELF::Binary> elf_binary;
+  const bool swap = stream.endian_swap();
+  const auto endian = static_cast<ELF::ELF_DATA>(ident[static_cast<size_t>(ELF::IDENTITY::EI_DATA)]);
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  stream.set_endian_swap(endian == ELF::ELF_DATA::ELFDATA2LSB);
+#else
+  stream.set_endian_swap(endian == ELF::ELF_DATA::ELFDATA2MSB);
+#endif
+
+  bool found = false;
   try {
-    elf_binary = std::unique_ptr<const LIEF::ELF::Binary>{LIEF::ELF::Parser::parse(raw)};
+    switch (static_cast<ELF::ELF_CLASS>(ident[static_cast<size_t>(ELF::IDENTITY::EI_CLASS)])) {
+      case ELF::ELF_CLASS::ELFCLASS32:
+        {
+          found = probe_oatdata<ELF::ELF32>(stream);
+          break;
+        }
+
+      case ELF::ELF_CLASS::ELFCLASS64:
+        {
+          found = probe_oatdata<ELF::ELF64>(stream);
+          break;
+        }
+
+      default:
+        {
+          found = false;
+        }
+    }
   } catch (const LIEF::exception&) {
+    found = false;
+  }
+  stream.set_endian_swap(swap);
+  return found;
+}
+
+bool is_oat(const std::string& file) {
+  if (not LIEF::ELF::is_elf(file)) {
     return false;
   }
-  if (elf_binary == nullptr) {
+
+  std::unique_ptr<BinaryStream> stream;
+  try {
+    stream = BinaryStream::from_file(file);
+  } catch (const LIEF::exception&) {
     return false;
   }
-  return is_oat(*elf_binary);
+  return is_oat(*stream);
+}
+
+
+bool is_oat(const std::vector<uint8_t>& raw) {
+  SpanStream stream{raw};
+  return is_oat(stream);
 }
 
 bool is_oat(const ELF::Binary& elf_binary) {
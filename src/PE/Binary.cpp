@@ -22,11 +22,15 @@
 
 #include "logging.hpp"
 #include "hash_stream.hpp"
+#include "parallel.hpp"
+#include "ResourcesParser.hpp"
 
 #include "LIEF/exception.hpp"
 #include "LIEF/utils.hpp"
+#include "LIEF/entropy.hpp"
 #include "LIEF/BinaryStream/VectorStream.hpp"
 #include "LIEF/iostream.hpp"
+#include "LIEF/file_ostream.hpp"
 
 #include "LIEF/Abstract/Relocation.hpp"
 
@@ -114,6 +118,7 @@ Binary::Binary() :
   strings_table_{},
   relocations_{},
   resources_{nullptr},
+  resources_cache_{ResourcesManager::make_cache()},
   imports_{},
   export_{},
   debug_{},
@@ -211,8 +216,19 @@ void Binary::write(const std::string& filename) {
     build_tls(false).
     build_resources(true);
 
-  builder.build();
-  builder.write(filename);
+  // The resources not decoded yet are read from the input file which
+  // may be the output: decode them before the output is created
+  if (this->resources_ != nullptr) {
+    ResourcesParser::load(*this->resources_);
+  }
+
+  try {
+    file_ostream output{filename};
+    builder.build(output);
+    output.commit();
+  } catch (const bad_file& e) {
+    LIEF_ERR("{}", e.what());
+  }
 }
 
 TLS& Binary::tls() {
@@ -241,21 +257,17 @@ uint64_t Binary::imagebase() const {
 }
 
 uint64_t Binary::offset_to_virtual_address(uint64_t offset, uint64_t slide) const {
-  const auto it_section = std::find_if(
-      std::begin(this->sections_), std::end(this->sections_),
-      [offset] (const Section* section)
-      {
-        return (offset >= section->offset() and
-            offset < (section->offset() + section->sizeof_raw_data()));
+  const Section* section = this->sections_offset_index_.find(this->sections_, offset,
+      [] (const Section& section) {
+        return std::make_pair(section.pointerto_raw_data(), section.sizeof_raw_data());
       });
 
-  if (it_section == std::end(sections_)) {
+  if (section == nullptr) {
     if (slide > 0) {
       return slide + offset;
     }
     return offset;
   }
-  const Section* section = *it_section;
   const uint64_t base_rva = section->virtual_address() - section->offset();
   if (slide > 0) {
     return slide + base_rva + offset;
@@ -265,20 +277,17 @@ uint64_t Binary::offset_to_virtual_address(uint64_t offset, uint64_t slide) cons
 }
 
 uint64_t Binary::rva_to_offset(uint64_t RVA) {
-  const auto it_section = std::find_if(
-      std::begin(this->sections_), std::end(this->sections_),
-      [RVA] (const Section* section) {
-        const uint64_t vsize_adj = std::max<uint64_t>(section->virtual_size(), section->sizeof_raw_data());
-        return (RVA >= section->virtual_address() and
-                RVA < (section->virtual_address() + vsize_adj));
+  const Section* section = this->sections_mapped_rva_index_.find(this->sections_, RVA,
+      [] (const Section& section) {
+        const uint64_t vsize_adj = std::max<uint64_t>(section.virtual_size(), section.sizeof_raw_data());
+        return std::make_pair(section.virtual_address(), vsize_adj);
       });
 
-  if (it_section == std::end(sections_)) {
+  if (section == nullptr) {
     // If not found within a section,
     // we assume that rva == offset
     return RVA;
   }
-  const Section* section = *it_section;
 
   // rva - virtual_address + pointer_to_raw_data
   uint32_t section_alignment = this->optional_header().section_alignment();
@@ -296,58 +305,46 @@ uint64_t Binary::rva_to_offset(uint64_t RVA) {
 }
 
 const Section& Binary::section_from_offset(uint64_t offset) const {
-  auto&& it_section = std::find_if(
-      std::begin(this->sections_),
-      std::end(this->sections_),
-      [&offset] (const Section* section) {
-        if (section == nullptr) {
-          return false;
-        }
-        return (
-            offset >= section->pointerto_raw_data() and
-            offset < (section->pointerto_raw_data() + section->sizeof_raw_data()));
+  const Section* section = this->sections_offset_index_.find(this->sections_, offset,
+      [] (const Section& section) {
+        return std::make_pair(section.pointerto_raw_data(), section.sizeof_raw_data());
       });
 
-  if (it_section == std::end(this->sections_)) {
+  if (section == nullptr) {
     throw LIEF::not_found("Section not found");
   }
 
-  return **it_section;
+  return *section;
 }
 
 Section& Binary::section_from_offset(uint64_t offset) {
+  this->authentihash_cache_.clear();
   return const_cast<Section&>(static_cast<const Binary*>(this)->section_from_offset(offset));
 }
 
 
 const Section& Binary::section_from_rva(uint64_t virtual_address) const {
-  auto&& it_section = std::find_if(
-      std::begin(this->sections_),
-      std::end(this->sections_),
-      [&virtual_address] (const Section* section) {
-        if (section == nullptr) {
-          return false;
-        }
-        return (
-            virtual_address >= section->virtual_address() and
-            virtual_address < (section->virtual_address() + section->virtual_size()));
+  const Section* section = this->sections_rva_index_.find(this->sections_, virtual_address,
+      [] (const Section& section) {
+        return std::make_pair(section.virtual_address(), section.virtual_size());
       });
 
-  if (it_section == std::end(this->sections_)) {
+  if (section == nullptr) {
     throw LIEF::not_found("Section not found");
   }
 
-
-  return **it_section;
+  return *section;
 }
 
 Section& Binary::section_from_rva(uint64_t virtual_address) {
+  this->authentihash_cache_.clear();
   return const_cast<Section&>(static_cast<const Binary*>(this)->section_from_rva(virtual_address));
 }
 
 
 
 DataDirectory& Binary::data_directory(DATA_DIRECTORY index) {
+  this->authentihash_cache_.clear();
   return const_cast<DataDirectory&>(static_cast<const Binary*>(this)->data_directory(index));
 }
 
@@ -382,6 +379,10 @@ bool Binary::has_imports() const {
   return this->has_imports_;
 }
 
+const SkippedStructures& Binary::skipped() const {
+  return this->skipped_;
+}
+
 bool Binary::has_signatures() const {
   return not this->signatures_.empty();
 }
@@ -448,11 +449,24 @@ LIEF::symbols_t Binary::get_abstract_symbols() {
   return lief_symbols;
 }
 
+const LIEF::Symbol* Binary::get_abstract_symbol(const std::string& name) const {
+  size_t nb_symbols = this->symbols_.size() + this->export_.entries().size();
+  for (const Import& imp : this->imports_) {
+    nb_symbols += imp.entries().size();
+  }
+
+  if (this->symbols_index_.is_valid(nb_symbols)) {
+    return this->symbols_index_.get(name);
+  }
+  return this->symbols_index_.find(const_cast<Binary*>(this)->get_abstract_symbols(), name);
+}
+
 
 // Sections
 // ========
 
 it_sections Binary::sections() {
+  this->authentihash_cache_.clear();
   return this->sections_;
 }
 
@@ -462,11 +476,13 @@ it_const_sections Binary::sections() const {
 }
 
 LIEF::sections_t Binary::get_abstract_sections() {
+  this->authentihash_cache_.clear();
   return {std::begin(this->sections_), std::end(this->sections_)};
 }
 
 
 Section& Binary::get_section(const std::string& name) {
+  this->authentihash_cache_.clear();
   return const_cast<Section&>(static_cast<const Binary*>(this)->get_section(name));
 }
 
@@ -496,6 +512,7 @@ const Section& Binary::import_section() const {
 
 
 Section& Binary::import_section() {
+  this->authentihash_cache_.clear();
   return const_cast<Section&>(static_cast<const Binary*>(this)->import_section());
 }
 
@@ -505,6 +522,7 @@ Section& Binary::import_section() {
 // Dos Header
 // ----------
 DosHeader& Binary::dos_header() {
+  this->authentihash_cache_.clear();
   return const_cast<DosHeader&>(static_cast<const Binary*>(this)->dos_header());
 }
 
@@ -517,6 +535,7 @@ const DosHeader& Binary::dos_header() const {
 // Standard header
 // ---------------
 Header& Binary::header() {
+  this->authentihash_cache_.clear();
   return const_cast<Header&>(static_cast<const Binary*>(this)->header());
 }
 
@@ -533,6 +552,7 @@ const OptionalHeader& Binary::optional_header() const {
 
 
 OptionalHeader& Binary::optional_header() {
+  this->authentihash_cache_.clear();
   return const_cast<OptionalHeader&>(static_cast<const Binary*>(this)->optional_header());
 }
 
@@ -574,7 +594,7 @@ uint32_t Binary::sizeof_headers() const {
 }
 
 void Binary::remove_section(const std::string& name, bool clear) {
-
+  this->authentihash_cache_.clear();
 
   auto&& it_section = std::find_if(
       std::begin(this->sections_),
@@ -593,6 +613,7 @@ void Binary::remove_section(const std::string& name, bool clear) {
 
 
 void Binary::remove(const Section& section, bool clear) {
+  this->authentihash_cache_.clear();
   auto&& it_section = std::find_if(
       std::begin(this->sections_),
       std::end(this->sections_),
@@ -623,6 +644,7 @@ void Binary::remove(const Section& section, bool clear) {
 
   delete to_remove;
   this->sections_.erase(it_section);
+  this->layout_version_.changed();
 
   this->header().numberof_sections(this->header().numberof_sections() - 1);
 
@@ -644,6 +666,7 @@ void Binary::make_space_for_new_section() {
 }
 
 Section& Binary::add_section(const Section& section, PE_SECTION_TYPES type) {
+  this->authentihash_cache_.clear();
 
   if (this->available_sections_space_ < 0) {
     this->make_space_for_new_section();
@@ -856,6 +879,8 @@ ImportEntry& Binary::add_import_function(const std::string& library, const std::
 
 Import& Binary::add_library(const std::string& name) {
   this->imports_.emplace_back(name);
+  // The entries of the other imports may have been moved
+  this->symbols_index_.invalidate();
   if (this->imports_.size() > 0) {
     this->has_imports_ = true;
   }
@@ -868,6 +893,7 @@ void Binary::remove_library(const std::string&) {
 
 void Binary::remove_all_libraries() {
   this->imports_ = {};
+  this->symbols_index_.invalidate();
 }
 
 uint32_t Binary::predict_function_rva(const std::string& library, const std::string& function) {
@@ -1006,12 +1032,16 @@ const Export& Binary::get_export() const {
 void Binary::set_resources(const ResourceDirectory& resource) {
   delete this->resources_;
   this->resources_ = new ResourceDirectory{resource};
+  this->resources_->attach(this->resources_version_);
+  this->resources_version_.changed();
 }
 
 
 void Binary::set_resources(const ResourceData& resource) {
   delete this->resources_;
   this->resources_ = new ResourceData{resource};
+  this->resources_->attach(this->resources_version_);
+  this->resources_version_.changed();
 }
 
 ResourceNode& Binary::resources() {
@@ -1033,6 +1063,7 @@ const ResourceNode& Binary::resources() const {
 //
 /////////////////////////////////////
 it_data_directories Binary::data_directories() {
+  this->authentihash_cache_.clear();
   return it_data_directories{this->data_directories_};
 }
 
@@ -1061,6 +1092,15 @@ it_const_signatures Binary::signatures() const {
 }
 
 std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
+  std::map<ALGORITHMS, std::vector<uint8_t>> hashes = this->authentihash(std::vector<ALGORITHMS>{algo});
+  auto it_hash = hashes.find(algo);
+  if (it_hash == std::end(hashes)) {
+    return {};
+  }
+  return it_hash->second;
+}
+
+std::map<ALGORITHMS, std::vector<uint8_t>> Binary::authentihash(const std::vector<ALGORITHMS>& algos) const {
   static const std::map<ALGORITHMS, hashstream::HASH> HMAP = {
     {ALGORITHMS::MD5,     hashstream::HASH::MD5},
     {ALGORITHMS::SHA_1,   hashstream::HASH::SHA1},
@@ -1068,15 +1108,43 @@ std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
     {ALGORITHMS::SHA_384, hashstream::HASH::SHA384},
     {ALGORITHMS::SHA_512, hashstream::HASH::SHA512},
   };
-  auto it_hash = HMAP.find(algo);
-  if (it_hash == std::end(HMAP)) {
-    LIEF_WARN("Unsupported hash algorithm: {}", to_string(algo));
-    return {};
+  std::map<ALGORITHMS, std::vector<uint8_t>> result;
+
+  // The cache is also invalidated by the modifications of the sections
+  // done through references taken before the previous computation
+  std::vector<uint64_t> key = this->authentihash_key();
+  if (key != this->authentihash_key_) {
+    this->authentihash_cache_.clear();
+    this->authentihash_key_ = std::move(key);
+  }
+
+  // Algorithms that are not in the cache
+  std::vector<ALGORITHMS> missing;
+  std::vector<hashstream::HASH> hash_types;
+  for (ALGORITHMS algo : algos) {
+    auto it_cache = this->authentihash_cache_.find(algo);
+    if (it_cache != std::end(this->authentihash_cache_)) {
+      result[algo] = it_cache->second;
+      continue;
+    }
+    auto it_hash = HMAP.find(algo);
+    if (it_hash == std::end(HMAP)) {
+      LIEF_WARN("Unsupported hash algorithm: {}", to_string(algo));
+      continue;
+    }
+    if (std::find(std::begin(missing), std::end(missing), algo) == std::end(missing)) {
+      missing.push_back(algo);
+      hash_types.push_back(it_hash->second);
+    }
+  }
+
+  if (missing.empty()) {
+    return result;
   }
+
   const size_t sizeof_ptr = this->type_ == PE_TYPE::PE32 ? sizeof(uint32_t) : sizeof(uint64_t);
-  const hashstream::HASH hash_type = it_hash->second;
-  hashstream ios(hash_type);
-  //vector_iostream ios;
+  // All the algorithms are fed with a single traversal of the binary
+  multi_hashstream ios(hash_types);
   ios // Hash dos header
     .write(this->dos_header_.magic())
     .write(this->dos_header_.used_bytes_in_the_last_page())
@@ -1188,8 +1256,9 @@ std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
     if (sec->sizeof_raw_data() == 0) {
       continue;
     }
-    const std::vector<uint8_t>& pad     = sec->padding();
-    const std::vector<uint8_t>& content = sec->content();
+    const std::vector<uint8_t>& pad = sec->padding();
+    // Hash the content in place instead of a copy (Section::content)
+    const span<const uint8_t> content = sec->content_view();
     LIEF_DEBUG("Authentihash:  Append section {:<8}: [0x{:04x}, 0x{:04x}] + [0x{:04x}] = [0x{:04x}, 0x{:04x}]",
         sec->name(),
         sec->offset(), sec->offset() + content.size(), pad.size(),
@@ -1207,7 +1276,7 @@ std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
       }
     } else {
       ios
-        .write(content)
+        .write(content.data(), content.size())
         .write(pad);
     }
     position = sec->offset() + content.size() + pad.size();
@@ -1227,10 +1296,10 @@ std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
           .write(this->overlay_.data(), start_cert_offset)
           .write(this->overlay_.data() + end_cert_offset, this->overlay_.size() - end_cert_offset);
       } else {
-        ios.write(this->overlay());
+        ios.write(this->overlay_);
       }
     } else {
-      ios.write(this->overlay());
+      ios.write(this->overlay_);
     }
   }
   // When something gets wrong with the hash:
@@ -1244,30 +1313,63 @@ std::vector<uint8_t> Binary::authentihash(ALGORITHMS algo) const {
   // }
   // std::vector<uint8_t> hash = hashstream(hash_type).write(out).raw();
 
-  std::vector<uint8_t> hash = ios.raw();
-  LIEF_DEBUG("{}", hex_dump(hash));
-  return hash;
+  for (size_t i = 0; i < missing.size(); ++i) {
+    const std::vector<uint8_t>& hash = ios.raw(i);
+    LIEF_DEBUG("{}: {}", to_string(missing[i]), hex_dump(hash));
+    this->authentihash_cache_[missing[i]] = hash;
+    result[missing[i]] = hash;
+  }
+  return result;
+}
+
+std::vector<uint64_t> Binary::authentihash_key() const {
+  std::vector<uint64_t> key;
+  key.reserve(this->sections_.size() + 1);
+  key.push_back(this->layout_version_.value());
+  for (const Section* section : this->sections_) {
+    key.push_back(section->content_version_);
+  }
+  return key;
 }
 
-Signature::VERIFICATION_FLAGS Binary::verify_signature(Signature::VERIFICATION_CHECKS checks) const {
+Signature::VERIFICATION_FLAGS Binary::verify_signature(Signature::VERIFICATION_CHECKS checks, size_t nb_threads) const {
   if (not this->has_signatures()) {
     return Signature::VERIFICATION_FLAGS::NO_SIGNATURE;
   }
 
-  Signature::VERIFICATION_FLAGS flags = Signature::VERIFICATION_FLAGS::OK;
+  // Compute the authentihashes of all the signatures with a single traversal
+  std::vector<ALGORITHMS> algos;
+  algos.reserve(this->signatures_.size());
+  for (const Signature& sig : this->signatures_) {
+    algos.push_back(sig.digest_algorithm());
+  }
+  const std::map<ALGORITHMS, std::vector<uint8_t>> hashes = this->authentihash(algos);
 
-  for (size_t i = 0; i < this->signatures_.size(); ++i) {
+  // The signatures don't share any certificate so that they can be checked concurrently.
+  // The result is the one of the first signature that fails, as if they were checked in order.
+  std::vector<Signature::VERIFICATION_FLAGS> results(this->signatures_.size(), Signature::VERIFICATION_FLAGS::OK);
+  parallel_for(this->signatures_.size(), nb_threads, [&] (size_t i) {
     const Signature& sig = this->signatures_[i];
-    flags |= this->verify_signature(sig, checks);
-    if (flags != Signature::VERIFICATION_FLAGS::OK) {
-      LIEF_INFO("Verification failed for signature #{:d} (0b{:b})", i, static_cast<uintptr_t>(flags));
-      break;
+    auto it_hash = hashes.find(sig.digest_algorithm());
+    static const std::vector<uint8_t> NO_HASH;
+    results[i] = this->verify_signature(sig, checks, it_hash != std::end(hashes) ? it_hash->second : NO_HASH);
+  });
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (results[i] != Signature::VERIFICATION_FLAGS::OK) {
+      LIEF_INFO("Verification failed for signature #{:d} (0b{:b})", i, static_cast<uintptr_t>(results[i]));
+      return results[i];
     }
   }
-  return flags;
+  return Signature::VERIFICATION_FLAGS::OK;
 }
 
 Signature::VERIFICATION_FLAGS Binary::verify_signature(const Signature& sig, Signature::VERIFICATION_CHECKS checks) const {
+  return this->verify_signature(sig, checks, this->authentihash(sig.digest_algorithm()));
+}
+
+Signature::VERIFICATION_FLAGS Binary::verify_signature(const Signature& sig, Signature::VERIFICATION_CHECKS checks,
+                                                       const std::vector<uint8_t>& authhash) const {
   Signature::VERIFICATION_FLAGS flags = Signature::VERIFICATION_FLAGS::OK;
   if (not is_true(checks & Signature::VERIFICATION_CHECKS::HASH_ONLY)) {
     const Signature::VERIFICATION_FLAGS value = sig.check(checks);
@@ -1278,7 +1380,6 @@ Signature::VERIFICATION_FLAGS Binary::verify_signature(const Signature& sig, Sig
   }
 
   // Check that the authentihash matches Content Info's digest
-  const std::vector<uint8_t>& authhash = this->authentihash(sig.digest_algorithm());
   const std::vector<uint8_t>& chash = sig.content_info().digest();
   if (authhash != chash) {
     LIEF_INFO("Authentihash and Content info's digest does not match:\n  {}\n  {}",
@@ -1398,6 +1499,7 @@ uint64_t Binary::entrypoint() const {
 }
 
 void Binary::patch_address(uint64_t address, const std::vector<uint8_t>& patch_value, LIEF::Binary::VA_TYPES addr_type) {
+  this->authentihash_cache_.clear();
   uint64_t rva = address;
 
   if (addr_type == LIEF::Binary::VA_TYPES::VA or addr_type == LIEF::Binary::VA_TYPES::AUTO) {
@@ -1416,10 +1518,12 @@ void Binary::patch_address(uint64_t address, const std::vector<uint8_t>& patch_v
       std::begin(patch_value),
       std::end(patch_value),
       content.data() + offset);
+  section_topatch.content_changed();
 
 }
 
 void Binary::patch_address(uint64_t address, uint64_t patch_value, size_t size, LIEF::Binary::VA_TYPES addr_type) {
+  this->authentihash_cache_.clear();
   if (size > sizeof(patch_value)) {
     LIEF_ERR("Invalid size (0x{:x})", size);
     return;
@@ -1443,6 +1547,7 @@ void Binary::patch_address(uint64_t address, uint64_t patch_value, size_t size,
       reinterpret_cast<uint8_t*>(&patch_value),
       reinterpret_cast<uint8_t*>(&patch_value) + size,
       content.data() + offset);
+  section_topatch.content_changed();
 
 }
 
@@ -1484,9 +1589,18 @@ const std::vector<uint8_t>& Binary::overlay() const {
 }
 
 std::vector<uint8_t>& Binary::overlay() {
+  this->authentihash_cache_.clear();
   return const_cast<std::vector<uint8_t>&>(static_cast<const Binary*>(this)->overlay());
 }
 
+double Binary::overlay_entropy() const {
+  return LIEF::entropy(this->overlay_);
+}
+
+std::vector<double> Binary::overlay_entropy_curve(size_t block_size, size_t step) const {
+  return LIEF::entropy_curve(this->overlay_, block_size, step);
+}
+
 // Dos stub
 // ========
 
@@ -1495,11 +1609,13 @@ const std::vector<uint8_t>& Binary::dos_stub() const {
 }
 
 std::vector<uint8_t>& Binary::dos_stub() {
+  this->authentihash_cache_.clear();
   return const_cast<std::vector<uint8_t>&>(static_cast<const Binary*>(this)->dos_stub());
 }
 
 
 void Binary::dos_stub(const std::vector<uint8_t>& content) {
+  this->authentihash_cache_.clear();
   this->dos_stub_ = content;
 }
 
@@ -1525,14 +1641,14 @@ ResourcesManager Binary::resources_manager() {
   if (this->resources_ == nullptr or not this->has_resources()) {
     throw not_found("There is no resources in the binary");
   }
-  return ResourcesManager{this->resources_};
+  return ResourcesManager{this->resources_, this->resources_cache_.get()};
 }
 
 const ResourcesManager Binary::resources_manager() const {
   if (this->resources_ == nullptr or not this->has_resources()) {
     throw not_found("There is no resources in the binary");
   }
-  return ResourcesManager{this->resources_};
+  return ResourcesManager{this->resources_, this->resources_cache_.get()};
 }
 
 
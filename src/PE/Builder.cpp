@@ -23,6 +23,7 @@
 
 #include "LIEF/third-party/utfcpp/utf8.h"
 #include "LIEF/exception.hpp"
+#include "LIEF/file_ostream.hpp"
 
 #include "LIEF/PE/Builder.hpp"
 #include "LIEF/PE/ResourceData.hpp"
@@ -93,14 +94,14 @@ Builder& Builder::build_dos_stub(bool flag) {
 
 
 void Builder::write(const std::string& filename) const {
-  std::ofstream output_file{filename, std::ios::out | std::ios::binary | std::ios::trunc};
-  if (output_file) {
-    std::vector<uint8_t> content;
-    this->ios_.get(content);
-    std::copy(
-        std::begin(content),
-        std::end(content),
-        std::ostreambuf_iterator<char>(output_file));
+  std::vector<uint8_t> content;
+  this->ios_.get(content);
+  try {
+    file_ostream output{filename};
+    output.write(content);
+    output.commit();
+  } catch (const bad_file& e) {
+    LIEF_ERR("Can't write {}: {}", filename, e.what());
   }
 }
 
@@ -109,6 +110,12 @@ void Builder::build() {
 
   LIEF_DEBUG("Build process started");
 
+  // The output would be truncated: the overlay (and the certificate table it usually contains) is missing
+  if (this->binary_->skipped().overlay and this->build_overlay_) {
+    throw builder_error("The overlay of the input has not been parsed (ParserConfig::parse_overlay): "
+                        "parse it or disable Builder::build_overlay");
+  }
+
   if (this->binary_->has_tls() and this->build_tls_) {
     LIEF_DEBUG("[+] TLS");
     if (this->binary_->type() == PE_TYPE::PE32) {
@@ -172,6 +179,49 @@ void Builder::build() {
 
 }
 
+void Builder::build(file_ostream& output) {
+  this->output_ = &output;
+  try {
+    this->build();
+  } catch (...) {
+    this->output_ = nullptr;
+    throw;
+  }
+  this->output_ = nullptr;
+  output.flush();
+}
+
+
+uint64_t Builder::tellp() {
+  if (this->output_ != nullptr) {
+    return this->output_->tellp();
+  }
+  return static_cast<uint64_t>(this->ios_.tellp());
+}
+
+
+void Builder::seekp(uint64_t offset) {
+  if (this->output_ != nullptr) {
+    this->output_->seekp(offset);
+    return;
+  }
+  this->ios_.seekp(offset);
+}
+
+
+void Builder::write_raw(const uint8_t* data, size_t size) {
+  if (this->output_ != nullptr) {
+    this->output_->write(data, size);
+    return;
+  }
+  this->ios_.write(data, size);
+}
+
+
+void Builder::write_raw(span<const uint8_t> data) {
+  this->write_raw(data.data(), data.size());
+}
+
 const std::vector<uint8_t>& Builder::get_build() {
   return this->ios_.raw();
 }
@@ -430,10 +480,10 @@ void Builder::build_overlay() {
   LIEF_DEBUG("Overlay offset: 0x{:x}", last_section_offset);
   LIEF_DEBUG("Overlay size: 0x{:x}", this->binary_->overlay().size());
 
-  const size_t saved_offset = this->ios_.tellp();
-  this->ios_.seekp(last_section_offset);
-  this->ios_.write(this->binary_->overlay());
-  this->ios_.seekp(saved_offset);
+  const uint64_t saved_offset = this->tellp();
+  this->seekp(last_section_offset);
+  this->write_raw(this->binary_->overlay());
+  this->seekp(saved_offset);
 }
 
 Builder& Builder::operator<<(const DosHeader& dos_header) {
@@ -463,14 +513,14 @@ Builder& Builder::operator<<(const DosHeader& dos_header) {
   std::copy(std::begin(reserved),  std::end(reserved),  std::begin(raw_dos_header.Reserved));
   std::copy(std::begin(reserved2), std::end(reserved2), std::begin(raw_dos_header.Reserved2));
 
-  this->ios_.seekp(0);
-  this->ios_.write(reinterpret_cast<const uint8_t*>(&raw_dos_header), sizeof(pe_dos_header));
+  this->seekp(0);
+  this->write_raw(reinterpret_cast<const uint8_t*>(&raw_dos_header), sizeof(pe_dos_header));
   if (this->binary_->dos_stub().size() > 0 and this->build_dos_stub_) {
 
     if (sizeof(pe_dos_header) + this->binary_->dos_stub().size() > dos_header.addressof_new_exeheader()) {
       LIEF_WARN("Inconsistent 'addressof_new_exeheader': 0x{:x}", dos_header.addressof_new_exeheader());
     }
-    this->ios_.write(this->binary_->dos_stub());
+    this->write_raw(this->binary_->dos_stub());
   }
 
   return *this;
@@ -495,8 +545,8 @@ Builder& Builder::operator<<(const Header& bHeader) {
 
   const uint32_t address_next_header = this->binary_->dos_header().addressof_new_exeheader();
 
-  this->ios_.seekp(address_next_header);
-  this->ios_.write(reinterpret_cast<const uint8_t*>(&header), sizeof(pe_header));
+  this->seekp(address_next_header);
+  this->write_raw(reinterpret_cast<const uint8_t*>(&header), sizeof(pe_header));
   return *this;
 }
 
@@ -518,7 +568,7 @@ Builder& Builder::operator<<(const DataDirectory& data_directory) {
   header.RelativeVirtualAddress = data_directory.RVA();
   header.Size                   = data_directory.size();
 
-  this->ios_.write(reinterpret_cast<uint8_t*>(&header), sizeof(pe_data_directory));
+  this->write_raw(reinterpret_cast<uint8_t*>(&header), sizeof(pe_data_directory));
   return *this;
 }
 
@@ -545,24 +595,25 @@ Builder& Builder::operator<<(const Section& section) {
   uint32_t name_length = std::min<uint32_t>(sec_name.size() + 1, sizeof(header.Name));
   std::copy(sec_name.c_str(), sec_name.c_str() + name_length, std::begin(header.Name));
 
-  this->ios_.write(reinterpret_cast<uint8_t*>(&header), sizeof(pe_section));
+  this->write_raw(reinterpret_cast<uint8_t*>(&header), sizeof(pe_section));
 
+  const span<const uint8_t> content = section.content_view();
   size_t pad_length = 0;
-  if (section.content().size() > section.size()) {
+  if (content.size() > section.size()) {
     LIEF_WARN("{} content size is bigger than section's header size", section.name());
   }
   else {
-    pad_length = section.size() - section.content().size();
+    pad_length = section.size() - content.size();
   }
 
   // Pad section content with zeroes
   std::vector<uint8_t> zero_pad (pad_length, 0);
 
-  const size_t saved_offset = this->ios_.tellp();
-  this->ios_.seekp(section.offset());
-  this->ios_.write(section.content());
-  this->ios_.write(zero_pad);
-  this->ios_.seekp(saved_offset);
+  const uint64_t saved_offset = this->tellp();
+  this->seekp(section.offset());
+  this->write_raw(content);
+  this->write_raw(zero_pad);
+  this->seekp(saved_offset);
   return *this;
 }
 
@@ -391,8 +391,8 @@ void Builder::build_optional_header(const OptionalHeader& optional_header) {
 
 
   const uint32_t address_next_header = this->binary_->dos_header().addressof_new_exeheader() + sizeof(pe_header);
-  this->ios_.seekp(address_next_header);
-  this->ios_.write(reinterpret_cast<const uint8_t*>(&optional_header_raw), sizeof(pe_optional_header));
+  this->seekp(address_next_header);
+  this->write_raw(reinterpret_cast<const uint8_t*>(&optional_header_raw), sizeof(pe_optional_header));
 
 }
 
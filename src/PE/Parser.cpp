@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <fstream>
 #include <iterator>
 #include <iostream>
@@ -30,6 +31,7 @@
 #include "LIEF/exception.hpp"
 
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
 #include "LIEF/Abstract/Relocation.hpp"
 #include "LIEF/PE/signature/Signature.hpp"
 #include "LIEF/PE/signature/SignatureParser.hpp"
@@ -55,6 +57,7 @@
 #include "LIEF/PE/EnumToString.hpp"
 
 #include "signature/pkcs7.h"
+#include "ResourcesParser.hpp"
 #include "Parser.tcc"
 
 // Issue with VS2017
@@ -72,8 +75,9 @@ Parser::Parser() = default;
 //
 // CTOR
 //
-Parser::Parser(const std::string& file) :
-  LIEF::Parser{file}
+Parser::Parser(const std::string& file, const ParserConfig& conf) :
+  LIEF::Parser{file},
+  config_{conf}
 {
 
   if (not is_pe(file)) {
@@ -81,16 +85,33 @@ Parser::Parser(const std::string& file) :
   }
 
   // Read from file
-  this->stream_ = std::unique_ptr<VectorStream>(new VectorStream{file});
+  this->stream_ = BinaryStream::from_file(file);
   this->init(filesystem::path(file).filename());
 }
 
-Parser::Parser(const std::vector<uint8_t>& data, const std::string& name) :
-  stream_{std::unique_ptr<VectorStream>(new VectorStream{data})}
+Parser::Parser(const std::vector<uint8_t>& data, const std::string& name, const ParserConfig& conf) :
+  stream_{std::unique_ptr<VectorStream>(new VectorStream{data})},
+  config_{conf}
 {
   this->init(name);
 }
 
+Parser::Parser(span<const uint8_t> data, const std::string& name, const ParserConfig& conf) :
+  stream_{std::unique_ptr<SpanStream>(new SpanStream{data})},
+  config_{conf}
+{
+  this->init(name);
+}
+
+Parser::Parser(std::unique_ptr<BinaryStream> stream, const std::string& name, const ParserConfig& conf) :
+  stream_{std::move(stream)},
+  config_{conf}
+{
+  this->binary_size_ = this->stream_->size();
+  this->binary_name_ = name;
+  this->init(name);
+}
+
 
 void Parser::init(const std::string& name) {
   stream_->setpos(0);
@@ -359,123 +380,16 @@ void Parser::parse_resources() {
     return;
   }
 
-  const pe_resource_directory_table& directory_table = this->stream_->peek<pe_resource_directory_table>(offset);
+  // The resource tree is decoded on demand (see: ResourcesParser) unless the
+  // stream is a span over a buffer that may not outlive the binary
+  const BinaryStream::STREAM_TYPE type = this->stream_->type();
+  const bool lazy = type == BinaryStream::STREAM_TYPE::FILE or type == BinaryStream::STREAM_TYPE::MMAP;
 
-  this->binary_->resources_     = this->parse_resource_node(&directory_table, offset, offset);
+  this->binary_->resources_     = ResourcesParser::parse(this->stream_, *this->binary_, offset, lazy);
   this->binary_->has_resources_ = (this->binary_->resources_ != nullptr);
-}
-
-
-//
-// parse the resources tree
-//
-ResourceNode* Parser::parse_resource_node(
-    const pe_resource_directory_table *directory_table,
-    uint32_t base_offset,
-    uint32_t current_offset,
-    uint32_t depth) {
-
-  const uint32_t numberof_ID_entries   = directory_table->NumberOfIDEntries;
-  const uint32_t numberof_name_entries = directory_table->NumberOfNameEntries;
-
-  //const pe_resource_directory_entries* entries_array = reinterpret_cast<const pe_resource_directory_entries*>(directory_table + 1);
-  size_t directory_array_offset = current_offset + sizeof(pe_resource_directory_table);
-
-  if (not this->stream_->can_read<pe_resource_directory_entries>(directory_array_offset)) {
-    return nullptr;
-  }
-  pe_resource_directory_entries entries_array = this->stream_->peek<pe_resource_directory_entries>(directory_array_offset);
-
-  std::unique_ptr<ResourceDirectory> directory{new ResourceDirectory{directory_table}};
-
-  directory->depth_ = depth;
-
-  // Iterate over the childs
-  for (uint32_t idx = 0; idx < (numberof_name_entries + numberof_ID_entries); ++idx) {
-
-    uint32_t data_rva = entries_array.RVA;
-    uint32_t id       = entries_array.NameID.IntegerID;
-
-    directory_array_offset += sizeof(pe_resource_directory_entries);
-    if (not this->stream_->can_read<pe_resource_directory_entries>(directory_array_offset)) {
-      break;
-    }
-    entries_array = this->stream_->peek<pe_resource_directory_entries>(directory_array_offset);
-
-    std::u16string name;
-
-    // Get the resource name
-    if (id & 0x80000000) {
-      uint32_t offset        = id & (~ 0x80000000);
-      uint32_t string_offset = base_offset + offset;
-
-      if (this->stream_->can_read<uint16_t>(string_offset)) {
-        const uint16_t length = this->stream_->peek<uint16_t>(string_offset);
-        if (length <= 100) {
-          name = this->stream_->peek_u16string_at(string_offset + sizeof(uint16_t), length);
-        }
-
-      }
-    }
-
-    if ((0x80000000 & data_rva) == 0) { // We are on a leaf
-      uint32_t offset = base_offset + data_rva;
-
-      if (not this->stream_->can_read<pe_resource_data_entry>(offset)) {
-        break;
-      }
-
-      const pe_resource_data_entry& data_entry = this->stream_->peek<pe_resource_data_entry>(offset);
-
-      uint32_t content_offset = this->binary_->rva_to_offset(data_entry.DataRVA);
-      uint32_t content_size   = data_entry.Size;
-      uint32_t code_page      = data_entry.Codepage;
-
-      const uint8_t* content_ptr = this->stream_->peek_array<uint8_t>(content_offset, content_size, /* check */false);
-      if (content_ptr != nullptr) {
-
-        std::vector<uint8_t> content = {
-          content_ptr,
-          content_ptr + content_size};
-
-        std::unique_ptr<ResourceData> node{new ResourceData{content, code_page}};
-
-        node->depth_ = depth + 1;
-        node->id(id);
-        node->name(name);
-        node->offset_ = content_offset;
-
-        directory->childs_.push_back(node.release());
-      } else {
-        LIEF_WARN("The leaf is corrupted");
-        break;
-      }
-    } else { // We are on a directory
-      const uint32_t directory_rva = data_rva & (~ 0x80000000);
-      const uint32_t offset        = base_offset + directory_rva;
-      if (this->stream_->can_read<pe_resource_directory_table>(offset)) {
-        const pe_resource_directory_table& nextDirectoryTable = this->stream_->peek<pe_resource_directory_table>(offset);
-        if (this->resource_visited_.count(offset) > 0) {
-          LIEF_WARN("Infinite loop detected on resources");
-          break;
-        }
-        this->resource_visited_.insert(offset);
-
-        std::unique_ptr<ResourceNode> node{this->parse_resource_node(&nextDirectoryTable, base_offset, offset, depth + 1)};
-        if (node) {
-          node->id(id);
-          node->name(name);
-          directory->childs_.push_back(node.release());
-        }
-      } else { // Corrupted
-        LIEF_WARN("The directory is corrupted");
-        break;
-      }
-    }
-
+  if (this->binary_->resources_ != nullptr) {
+    this->binary_->resources_->attach(this->binary_->resources_version_);
   }
-
-  return directory.release();
 }
 
 //
@@ -933,6 +847,18 @@ void Parser::parse_signature() {
 }
 
 
+bool Parser::must_parse(bool ParserConfig::* structure, bool SkippedStructures::* skipped, bool present) {
+  if (not present) {
+    return false;
+  }
+  if (this->config_.*structure) {
+    return true;
+  }
+  this->binary_->skipped_.*skipped = true;
+  return false;
+}
+
+
 void Parser::parse_overlay() {
   LIEF_DEBUG("== Parsing Overlay ==");
   const uint64_t last_section_offset = std::accumulate(
@@ -944,35 +870,47 @@ void Parser::parse_overlay() {
 
   LIEF_DEBUG("Overlay offset: 0x{:x}", last_section_offset);
 
-  if (last_section_offset < this->stream_->size()) {
-    const uint64_t overlay_size = this->stream_->size() - last_section_offset;
+  if (not this->must_parse(&ParserConfig::parse_overlay, &SkippedStructures::overlay, last_section_offset < this->stream_->size())) {
+    return;
+  }
 
-    LIEF_DEBUG("Overlay size: 0x{:x}", overlay_size);
+  const uint64_t overlay_size = this->stream_->size() - last_section_offset;
 
-    const uint8_t* ptr_to_overlay = this->stream_->peek_array<uint8_t>(last_section_offset, overlay_size, /* check */false);
-    if (ptr_to_overlay != nullptr) {
-      this->binary_->overlay_ = {
-          ptr_to_overlay,
-          ptr_to_overlay + overlay_size
-        };
-      this->binary_->overlay_offset_ = last_section_offset;
-    }
-  } else {
-    this->binary_->overlay_ = {};
+  LIEF_DEBUG("Overlay size: 0x{:x}", overlay_size);
+
+  const uint8_t* ptr_to_overlay = this->stream_->peek_array<uint8_t>(last_section_offset, overlay_size, /* check */false);
+  if (ptr_to_overlay != nullptr) {
+    this->binary_->overlay_ = {
+        ptr_to_overlay,
+        ptr_to_overlay + overlay_size
+      };
+    this->binary_->overlay_offset_ = last_section_offset;
   }
 }
 
 //
 // Return the Binary constructed
 //
-std::unique_ptr<Binary> Parser::parse(const std::string& filename) {
-  Parser parser{filename};
+std::unique_ptr<Binary> Parser::parse(const std::string& filename, const ParserConfig& conf) {
+  Parser parser{filename, conf};
+  return std::unique_ptr<Binary>{parser.binary_};
+}
+
+
+std::unique_ptr<Binary> Parser::parse(const std::vector<uint8_t>& data, const std::string& name, const ParserConfig& conf) {
+  Parser parser{data, name, conf};
+  return std::unique_ptr<Binary>{parser.binary_};
+}
+
+
+std::unique_ptr<Binary> Parser::parse(span<const uint8_t> data, const std::string& name, const ParserConfig& conf) {
+  Parser parser{data, name, conf};
   return std::unique_ptr<Binary>{parser.binary_};
 }
 
 
-std::unique_ptr<Binary> Parser::parse(const std::vector<uint8_t>& data, const std::string& name) {
-  Parser parser{data, name};
+std::unique_ptr<Binary> Parser::parse(std::unique_ptr<BinaryStream> stream, const std::string& name, const ParserConfig& conf) {
+  Parser parser{std::move(stream), name, conf};
   return std::unique_ptr<Binary>{parser.binary_};
 }
 
@@ -31,7 +31,12 @@ void Parser::parse() {
   LIEF_DEBUG("[+] Processing DOS stub & Rich header");
 
   this->parse_dos_stub();
-  this->parse_rich_header();
+  const std::vector<uint8_t>& dos_stub = this->binary_->dos_stub();
+  const bool has_rich_header = std::search(std::begin(dos_stub), std::end(dos_stub),
+                                           std::begin(Rich_Magic), std::end(Rich_Magic)) != std::end(dos_stub);
+  if (this->must_parse(&ParserConfig::parse_rich_header, &SkippedStructures::rich_header, has_rich_header)) {
+    this->parse_rich_header();
+  }
 
   LIEF_DEBUG("[+] Processing sections");
 
@@ -49,10 +54,13 @@ void Parser::parse() {
     LIEF_WARN("{}", e.what());
   }
 
-  try {
-    this->parse_symbols();
-  } catch (const corrupted& e) {
-    LIEF_WARN("{}", e.what());
+  const Header& header = this->binary_->header();
+  if (this->must_parse(&ParserConfig::parse_symbols, &SkippedStructures::symbols, header.pointerto_symbol_table() > 0 and header.numberof_symbols() > 0)) {
+    try {
+      this->parse_symbols();
+    } catch (const corrupted& e) {
+      LIEF_WARN("{}", e.what());
+    }
   }
 
   this->parse_overlay();
@@ -135,7 +143,7 @@ void Parser::parse_data_directories() {
 
   try {
     // Import Table
-    if (this->binary_->data_directory(DATA_DIRECTORY::IMPORT_TABLE).RVA() > 0) {
+    if (this->must_parse(&ParserConfig::parse_imports, &SkippedStructures::imports, this->binary_->data_directory(DATA_DIRECTORY::IMPORT_TABLE).RVA() > 0)) {
       LIEF_DEBUG("Processing Import Table");
       const uint32_t import_rva = this->binary_->data_directory(DATA_DIRECTORY::IMPORT_TABLE).RVA();
       const uint64_t offset     = this->binary_->rva_to_offset(import_rva);
@@ -153,7 +161,7 @@ void Parser::parse_data_directories() {
   }
 
   // Exports
-  if (this->binary_->data_directory(DATA_DIRECTORY::EXPORT_TABLE).RVA() > 0) {
+  if (this->must_parse(&ParserConfig::parse_exports, &SkippedStructures::exports, this->binary_->data_directory(DATA_DIRECTORY::EXPORT_TABLE).RVA() > 0)) {
     LIEF_DEBUG("[+] Processing Exports");
 
     try {
@@ -164,7 +172,7 @@ void Parser::parse_data_directories() {
   }
 
   // Signature
-  if (this->binary_->data_directory(DATA_DIRECTORY::CERTIFICATE_TABLE).RVA() > 0) {
+  if (this->must_parse(&ParserConfig::parse_signature, &SkippedStructures::signature, this->binary_->data_directory(DATA_DIRECTORY::CERTIFICATE_TABLE).RVA() > 0)) {
     try {
       this->parse_signature();
     } catch (const exception& e) {
@@ -174,7 +182,7 @@ void Parser::parse_data_directories() {
 
 
   // TLS
-  if (this->binary_->data_directory(DATA_DIRECTORY::TLS_TABLE).RVA() > 0) {
+  if (this->must_parse(&ParserConfig::parse_tls, &SkippedStructures::tls, this->binary_->data_directory(DATA_DIRECTORY::TLS_TABLE).RVA() > 0)) {
     LIEF_DEBUG("[+] Decomposing TLS");
 
     const uint32_t tls_rva = this->binary_->data_directory(DATA_DIRECTORY::TLS_TABLE).RVA();
@@ -191,7 +199,7 @@ void Parser::parse_data_directories() {
   }
 
   // Load Config
-  if (this->binary_->data_directory(DATA_DIRECTORY::LOAD_CONFIG_TABLE).RVA() > 0) {
+  if (this->must_parse(&ParserConfig::parse_load_config, &SkippedStructures::load_config, this->binary_->data_directory(DATA_DIRECTORY::LOAD_CONFIG_TABLE).RVA() > 0)) {
 
     const uint32_t load_config_rva = this->binary_->data_directory(DATA_DIRECTORY::LOAD_CONFIG_TABLE).RVA();
     const uint64_t offset          = this->binary_->rva_to_offset(load_config_rva);
@@ -208,7 +216,7 @@ void Parser::parse_data_directories() {
 
 
   // Relocations
-  if (this->binary_->data_directory(DATA_DIRECTORY::BASE_RELOCATION_TABLE).RVA() > 0) {
+  if (this->must_parse(&ParserConfig::parse_relocations, &SkippedStructures::relocations, this->binary_->data_directory(DATA_DIRECTORY::BASE_RELOCATION_TABLE).RVA() > 0)) {
 
     LIEF_DEBUG("[+] Decomposing relocations");
     const uint32_t relocation_rva = this->binary_->data_directory(DATA_DIRECTORY::BASE_RELOCATION_TABLE).RVA();
@@ -226,7 +234,7 @@ void Parser::parse_data_directories() {
 
 
   // Debug
-  if (this->binary_->data_directory(DATA_DIRECTORY::DEBUG).RVA() > 0) {
+  if (this->must_parse(&ParserConfig::parse_debug, &SkippedStructures::debug, this->binary_->data_directory(DATA_DIRECTORY::DEBUG).RVA() > 0)) {
 
     LIEF_DEBUG("[+] Decomposing debug");
     const uint32_t rva    = this->binary_->data_directory(DATA_DIRECTORY::DEBUG).RVA();
@@ -244,7 +252,7 @@ void Parser::parse_data_directories() {
 
 
   // Resources
-  if (this->binary_->data_directory(DATA_DIRECTORY::RESOURCE_TABLE).RVA() > 0) {
+  if (this->must_parse(&ParserConfig::parse_resources, &SkippedStructures::resources, this->binary_->data_directory(DATA_DIRECTORY::RESOURCE_TABLE).RVA() > 0)) {
 
     LIEF_DEBUG("[+] Decomposing resources");
     const uint32_t resources_rva = this->binary_->data_directory(DATA_DIRECTORY::RESOURCE_TABLE).RVA();
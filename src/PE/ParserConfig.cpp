@@ -0,0 +1,58 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LIEF/PE/ParserConfig.hpp"
+
+namespace LIEF {
+namespace PE {
+
+ParserConfig ParserConfig::deep() {
+  return ParserConfig{};
+}
+
+ParserConfig ParserConfig::quick() {
+  ParserConfig conf;
+  conf.parse_rich_header = false;
+  conf.parse_imports     = true;
+  conf.parse_exports     = true;
+  conf.parse_relocations = false;
+  conf.parse_resources   = false;
+  conf.parse_debug       = false;
+  conf.parse_tls         = false;
+  conf.parse_load_config = false;
+  conf.parse_signature   = false;
+  conf.parse_symbols     = false;
+  conf.parse_overlay     = false;
+  return conf;
+}
+
+ParserConfig ParserConfig::none() {
+  ParserConfig conf;
+  conf.parse_rich_header = false;
+  conf.parse_imports     = false;
+  conf.parse_exports     = false;
+  conf.parse_relocations = false;
+  conf.parse_resources   = false;
+  conf.parse_debug       = false;
+  conf.parse_tls         = false;
+  conf.parse_load_config = false;
+  conf.parse_signature   = false;
+  conf.parse_symbols     = false;
+  conf.parse_overlay     = false;
+  return conf;
+}
+
+} // namespace PE
+} // namespace LIEF
@@ -14,11 +14,14 @@
  * limitations under the License.
  */
 #include <iomanip>
+#include <mutex>
 
 #include "LIEF/PE/hash.hpp"
 
 #include "LIEF/PE/ResourceData.hpp"
 
+#include "ResourcesParser.hpp"
+
 namespace LIEF {
 namespace PE {
 ResourceData::~ResourceData() = default;
@@ -29,10 +32,21 @@ ResourceData& ResourceData::operator=(ResourceData other) {
 
 ResourceData::ResourceData(const ResourceData& other) :
   ResourceNode{static_cast<const ResourceNode&>(other)},
-  content_{other.content_},
   code_page_{other.code_page_},
-  reserved_{other.reserved_}
-{}
+  reserved_{other.reserved_},
+  offset_{other.offset_},
+  size_{other.size_}
+{
+  // The content of other may be read concurrently (see: ResourceData::content)
+  std::shared_ptr<ResourcesParser> parser = std::atomic_load(&other.parser_);
+  if (parser == nullptr) {
+    this->content_ = other.content_;
+    return;
+  }
+  std::lock_guard<std::mutex> lock{parser->mutex()};
+  this->content_ = other.content_;
+  this->parser_  = std::atomic_load(&other.parser_);
+}
 
 ResourceData* ResourceData::clone() const {
   return new ResourceData{*this};
@@ -44,20 +58,25 @@ void ResourceData::swap(ResourceData& other) {
   std::swap(this->content_,    other.content_);
   std::swap(this->code_page_,  other.code_page_);
   std::swap(this->reserved_,   other.reserved_);
+  std::swap(this->offset_,     other.offset_);
+  std::swap(this->parser_,     other.parser_);
+  std::swap(this->size_,       other.size_);
 }
 
 
 ResourceData::ResourceData() :
   content_{},
   code_page_{0},
-  reserved_{0}
+  reserved_{0},
+  offset_{0}
 {}
 
 
 ResourceData::ResourceData(const std::vector<uint8_t>& content, uint32_t code_page) :
   content_{content},
   code_page_{code_page},
-  reserved_{0}
+  reserved_{0},
+  offset_{0}
 {}
 
 
@@ -68,6 +87,14 @@ uint32_t ResourceData::code_page() const {
 
 
 const std::vector<uint8_t>& ResourceData::content() const {
+  std::shared_ptr<ResourcesParser> parser = std::atomic_load(&this->parser_);
+  if (parser != nullptr) {
+    std::lock_guard<std::mutex> lock{parser->mutex()};
+    if (std::atomic_load(&this->parser_) != nullptr) { // Not read by another thread
+      this->content_ = parser->read_content(this->offset_, this->size_);
+      std::atomic_store(&this->parser_, std::shared_ptr<ResourcesParser>{});
+    }
+  }
   return this->content_;
 }
 
@@ -83,16 +110,20 @@ uint32_t ResourceData::offset() const {
 
 void ResourceData::code_page(uint32_t code_page) {
   this->code_page_ = code_page;
+  this->changed();
 }
 
 
 void ResourceData::content(const std::vector<uint8_t>& content) {
   this->content_ = content;
+  this->parser_  = nullptr;
+  this->changed();
 }
 
 
 void ResourceData::reserved(uint32_t value) {
   this->reserved_ = value;
+  this->changed();
 }
 
 void ResourceData::accept(Visitor& visitor) const {
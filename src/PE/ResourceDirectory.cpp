@@ -111,26 +111,32 @@ uint16_t ResourceDirectory::numberof_id_entries() const {
 
 void ResourceDirectory::characteristics(uint32_t characteristics) {
   this->characteristics_ = characteristics;
+  this->changed();
 }
 
 void ResourceDirectory::time_date_stamp(uint32_t time_date_stamp) {
   this->timeDateStamp_ = time_date_stamp;
+  this->changed();
 }
 
 void ResourceDirectory::major_version(uint16_t major_version) {
   this->majorVersion_ = major_version;
+  this->changed();
 }
 
 void ResourceDirectory::minor_version(uint16_t minor_version) {
   this->minorVersion_ = minor_version;
+  this->changed();
 }
 
 void ResourceDirectory::numberof_name_entries(uint16_t numberof_name_entries) {
   this->numberOfNameEntries_ = numberof_name_entries;
+  this->changed();
 }
 
 void ResourceDirectory::numberof_id_entries(uint16_t numberof_id_entries) {
   this->numberOfIDEntries_ = numberof_id_entries;
+  this->changed();
 }
 
 void ResourceDirectory::accept(Visitor& visitor) const {
@@ -15,6 +15,7 @@
  */
 #include <sstream>
 #include <iomanip>
+#include <mutex>
 
 #include "LIEF/PE/hash.hpp"
 
@@ -24,6 +25,8 @@
 #include "LIEF/PE/ResourceDirectory.hpp"
 #include "LIEF/PE/ResourceData.hpp"
 
+#include "ResourcesParser.hpp"
+
 namespace LIEF {
 namespace PE {
 
@@ -42,10 +45,12 @@ ResourceNode::ResourceNode() :
 
 ResourceNode::ResourceNode(const ResourceNode& other) :
   Object{other},
+  Indexed{},
   id_{other.id_},
   name_{other.name_},
   depth_{other.depth_}
 {
+  other.load();
   this->childs_.reserve(other.childs_.size());
   for (const ResourceNode* node : other.childs_) {
     this->childs_.push_back(node->clone());
@@ -54,10 +59,22 @@ ResourceNode::ResourceNode(const ResourceNode& other) :
 
 
 void ResourceNode::swap(ResourceNode& other) {
+  this->load();
+  other.load();
   std::swap(this->id_,     other.id_);
   std::swap(this->name_,   other.name_);
   std::swap(this->childs_, other.childs_);
   std::swap(this->depth_,  other.depth_);
+
+  // The childs follow the counter of their new parent
+  if (const IndexVersion* version = this->index_version()) {
+    this->attach(*version);
+  }
+  if (const IndexVersion* version = other.index_version()) {
+    other.attach(*version);
+  }
+  this->changed();
+  other.changed();
 }
 
 ResourceNode::~ResourceNode() {
@@ -72,12 +89,42 @@ uint32_t ResourceNode::id() const {
 }
 
 
+void ResourceNode::attach(const IndexVersion& version) const {
+  this->index_attach(version);
+  for (const ResourceNode* node : this->childs_) {
+    node->attach(version);
+  }
+}
+
+
+void ResourceNode::load_childs() const {
+  std::shared_ptr<ResourcesParser> parser = std::atomic_load(&this->childs_parser_);
+  if (parser == nullptr) {
+    return;
+  }
+
+  // The nodes of a tree share the parser whose mutex serializes the decoding
+  std::lock_guard<std::mutex> lock{parser->mutex()};
+  if (std::atomic_load(&this->childs_parser_) == nullptr) {
+    return; // Decoded by another thread
+  }
+
+  parser->parse_childs(const_cast<ResourceNode&>(*this));
+  if (const IndexVersion* version = this->index_version()) {
+    this->attach(*version);
+  }
+  std::atomic_store(&this->childs_parser_, std::shared_ptr<ResourcesParser>{});
+}
+
+
 it_childs ResourceNode::childs() {
+  this->load();
   return {this->childs_};
 }
 
 
 it_const_childs ResourceNode::childs() const {
+  this->load();
   return {this->childs_};
 }
 
@@ -106,11 +153,16 @@ uint32_t ResourceNode::depth() const {
 
 
 ResourceNode& ResourceNode::add_child(const ResourceDirectory& child) {
+  this->load();
 
   ResourceDirectory* new_node = new ResourceDirectory{child};
   new_node->depth_ = this->depth_ + 1;
 
+  if (const IndexVersion* version = this->index_version()) {
+    new_node->attach(*version);
+  }
   this->childs_.push_back(new_node);
+  this->changed();
 
   if (ResourceDirectory* dir = dynamic_cast<ResourceDirectory*>(this)) {
     if (child.has_name()) {
@@ -124,10 +176,15 @@ ResourceNode& ResourceNode::add_child(const ResourceDirectory& child) {
 }
 
 ResourceNode& ResourceNode::add_child(const ResourceData& child) {
+  this->load();
   ResourceData* new_node = new ResourceData{child};
   new_node->depth_ = this->depth_ + 1;
 
+  if (const IndexVersion* version = this->index_version()) {
+    new_node->attach(*version);
+  }
   this->childs_.push_back(new_node);
+  this->changed();
 
   if (ResourceDirectory* dir = dynamic_cast<ResourceDirectory*>(this)) {
     if (child.has_name()) {
@@ -140,6 +197,7 @@ ResourceNode& ResourceNode::add_child(const ResourceData& child) {
 }
 
 void ResourceNode::delete_child(uint32_t id) {
+  this->load();
 
   auto&& it_node = std::find_if(
       std::begin(this->childs_),
@@ -156,6 +214,7 @@ void ResourceNode::delete_child(uint32_t id) {
 }
 
 void ResourceNode::delete_child(const ResourceNode& node) {
+  this->load();
   auto&& it_node = std::find_if(
       std::begin(this->childs_),
       std::end(this->childs_),
@@ -180,11 +239,13 @@ void ResourceNode::delete_child(const ResourceNode& node) {
 
   delete *it_node;
   this->childs_.erase(it_node);
+  this->changed();
 
 }
 
 void ResourceNode::id(uint32_t id) {
   this->id_ = id;
+  this->changed();
 }
 
 void ResourceNode::name(const std::string& name) {
@@ -193,16 +254,19 @@ void ResourceNode::name(const std::string& name) {
 
 void ResourceNode::name(const std::u16string& name) {
   this->name_ = name;
+  this->changed();
 }
 
 
 void ResourceNode::sort_by_id() {
+  this->load();
   std::sort(
       std::begin(this->childs_),
       std::end(this->childs_),
       [] (const ResourceNode* lhs, const ResourceNode* rhs) {
         return lhs->id() < rhs->id();
       });
+  this->changed();
 }
 
 void ResourceNode::accept(Visitor& visitor) const {
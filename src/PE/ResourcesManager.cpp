@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <iomanip>
 #include <numeric>
+#include <mutex>
 
 #include "logging.hpp"
 
@@ -44,10 +45,62 @@ ResourcesManager::ResourcesManager(const ResourcesManager&) = default;
 ResourcesManager& ResourcesManager::operator=(const ResourcesManager&) = default;
 ResourcesManager::~ResourcesManager() = default;
 
+//! Results memoized by the ResourcesManager for a given state of the tree
+struct ResourcesCache {
+  void clear() {
+    this->manifest     = nullptr;
+    this->version      = nullptr;
+    this->icons        = nullptr;
+    this->dialogs      = nullptr;
+    this->string_table = nullptr;
+    this->html         = nullptr;
+    this->accelerator  = nullptr;
+  }
+
+  // Held while the results are accessed (the const queries can be called concurrently)
+  std::recursive_mutex mutex;
+
+  const ResourceNode* resources = nullptr;
+  uint64_t            tree_version = 0;
+
+  std::unique_ptr<std::string>                      manifest;
+  std::unique_ptr<ResourceVersion>                  version;
+  std::unique_ptr<std::vector<ResourceIcon>>        icons;
+  std::unique_ptr<std::vector<ResourceDialog>>      dialogs;
+  std::unique_ptr<std::vector<ResourceStringTable>> string_table;
+  std::unique_ptr<std::vector<std::string>>         html;
+  std::unique_ptr<std::vector<ResourceAccelerator>> accelerator;
+};
+
 ResourcesManager::ResourcesManager(ResourceNode *rsrc) :
-  resources_{rsrc}
+  resources_{rsrc},
+  own_cache_{std::make_shared<ResourcesCache>()}
+{
+  this->cache_ = this->own_cache_.get();
+}
+
+ResourcesManager::ResourcesManager(ResourceNode *rsrc, ResourcesCache* cache) :
+  resources_{rsrc},
+  cache_{cache}
 {}
 
+std::shared_ptr<ResourcesCache> ResourcesManager::make_cache() {
+  return std::make_shared<ResourcesCache>();
+}
+
+ResourcesCache& ResourcesManager::cache() const {
+  ResourcesCache& cache = *this->cache_;
+  // The modifications of a tree which is not attached to a binary are not tracked
+  const IndexVersion* tree = this->resources_->index_version();
+  const uint64_t tree_version = tree != nullptr ? tree->value() : 0;
+  if (tree == nullptr or cache.resources != this->resources_ or cache.tree_version != tree_version) {
+    cache.clear();
+    cache.resources    = this->resources_;
+    cache.tree_version = tree_version;
+  }
+  return cache;
+}
+
 RESOURCE_LANGS ResourcesManager::lang_from_id(size_t id) {
   return static_cast<RESOURCE_LANGS>(id & 0x3ff);
 }
@@ -334,6 +387,15 @@ bool ResourcesManager::has_manifest() const {
 }
 
 std::string ResourcesManager::manifest() const {
+  std::lock_guard<std::recursive_mutex> lock{this->cache_->mutex};
+  ResourcesCache& cache = this->cache();
+  if (cache.manifest == nullptr) {
+    cache.manifest.reset(new std::string(this->parse_manifest()));
+  }
+  return *cache.manifest;
+}
+
+std::string ResourcesManager::parse_manifest() const {
   if (not this->has_manifest()) {
     throw not_found("No manifest found in the resources");
   }
@@ -398,6 +460,15 @@ bool ResourcesManager::has_version() const {
 }
 
 ResourceVersion ResourcesManager::version() const {
+  std::lock_guard<std::recursive_mutex> lock{this->cache_->mutex};
+  ResourcesCache& cache = this->cache();
+  if (cache.version == nullptr) {
+    cache.version.reset(new ResourceVersion(this->parse_version()));
+  }
+  return *cache.version;
+}
+
+ResourceVersion ResourcesManager::parse_version() const {
   if (not this->has_version()) {
     throw not_found("Resource version not found");
   }
@@ -755,6 +826,15 @@ bool ResourcesManager::has_icons() const {
 }
 
 std::vector<ResourceIcon> ResourcesManager::icons() const {
+  std::lock_guard<std::recursive_mutex> lock{this->cache_->mutex};
+  ResourcesCache& cache = this->cache();
+  if (cache.icons == nullptr) {
+    cache.icons.reset(new std::vector<ResourceIcon>(this->parse_icons()));
+  }
+  return *cache.icons;
+}
+
+std::vector<ResourceIcon> ResourcesManager::parse_icons() const {
 
   it_childs nodes = this->resources_->childs();
   auto&& it_icon = std::find_if(
@@ -1034,6 +1114,15 @@ void ResourcesManager::change_icon(const ResourceIcon& original, const ResourceI
 // * Extra count
 // ====================================================================
 std::vector<ResourceDialog> ResourcesManager::dialogs() const {
+  std::lock_guard<std::recursive_mutex> lock{this->cache_->mutex};
+  ResourcesCache& cache = this->cache();
+  if (cache.dialogs == nullptr) {
+    cache.dialogs.reset(new std::vector<ResourceDialog>(this->parse_dialogs()));
+  }
+  return *cache.dialogs;
+}
+
+std::vector<ResourceDialog> ResourcesManager::parse_dialogs() const {
   if (not this->has_dialogs()) {
     return {};
   }
@@ -1232,6 +1321,15 @@ bool ResourcesManager::has_dialogs() const {
 
 // String table entry
 std::vector<ResourceStringTable> ResourcesManager::string_table() const {
+  std::lock_guard<std::recursive_mutex> lock{this->cache_->mutex};
+  ResourcesCache& cache = this->cache();
+  if (cache.string_table == nullptr) {
+    cache.string_table.reset(new std::vector<ResourceStringTable>(this->parse_string_table()));
+  }
+  return *cache.string_table;
+}
+
+std::vector<ResourceStringTable> ResourcesManager::parse_string_table() const {
   it_childs nodes = this->resources_->childs();
   auto&& it_string_table = std::find_if(
     std::begin(nodes),
@@ -1286,6 +1384,15 @@ bool ResourcesManager::has_string_table() const {
 }
 
 std::vector<std::string> ResourcesManager::html() const {
+  std::lock_guard<std::recursive_mutex> lock{this->cache_->mutex};
+  ResourcesCache& cache = this->cache();
+  if (cache.html == nullptr) {
+    cache.html.reset(new std::vector<std::string>(this->parse_html()));
+  }
+  return *cache.html;
+}
+
+std::vector<std::string> ResourcesManager::parse_html() const {
   it_childs nodes = this->resources_->childs();
   auto&& it_html = std::find_if(
     std::begin(nodes),
@@ -1330,6 +1437,15 @@ bool ResourcesManager::has_accelerator() const {
 }
 
 std::vector<ResourceAccelerator> ResourcesManager::accelerator() const {
+  std::lock_guard<std::recursive_mutex> lock{this->cache_->mutex};
+  ResourcesCache& cache = this->cache();
+  if (cache.accelerator == nullptr) {
+    cache.accelerator.reset(new std::vector<ResourceAccelerator>(this->parse_accelerator()));
+  }
+  return *cache.accelerator;
+}
+
+std::vector<ResourceAccelerator> ResourcesManager::parse_accelerator() const {
   it_childs nodes = this->resources_->childs();
   auto&& it_accelerator = std::find_if(
     std::begin(nodes),
@@ -0,0 +1,228 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+
+#include "logging.hpp"
+
+#include "LIEF/utils.hpp"
+#include "LIEF/BinaryStream/BinaryStream.hpp"
+
+#include "LIEF/PE/Structures.hpp"
+#include "LIEF/PE/Binary.hpp"
+#include "LIEF/PE/Section.hpp"
+#include "LIEF/PE/ResourceDirectory.hpp"
+#include "LIEF/PE/ResourceData.hpp"
+
+#include "ResourcesParser.hpp"
+
+namespace LIEF {
+namespace PE {
+
+ResourceNode* ResourcesParser::parse(std::shared_ptr<BinaryStream> stream, const Binary& binary,
+                                     uint32_t offset, bool lazy) {
+  if (not stream->can_read<pe_resource_directory_table>(offset)) {
+    return nullptr;
+  }
+  const pe_resource_directory_table directory_table = stream->peek<pe_resource_directory_table>(offset);
+
+  if (not stream->can_read<pe_resource_directory_entries>(offset + sizeof(pe_resource_directory_table))) {
+    return nullptr;
+  }
+
+  std::unique_ptr<ResourceDirectory> root{new ResourceDirectory{&directory_table}};
+  root->childs_offset_ = offset;
+
+  auto parser = std::make_shared<ResourcesParser>(std::move(stream), binary, offset);
+  parser->parse_childs(*root);
+
+  if (not lazy) {
+    ResourcesParser::load(*root);
+  }
+  return root.release();
+}
+
+
+ResourcesParser::ResourcesParser(std::shared_ptr<BinaryStream> stream, const Binary& binary, uint32_t base_offset) :
+  stream_{std::move(stream)},
+  base_offset_{base_offset}
+{
+  uint32_t section_alignment = binary.optional_header().section_alignment();
+  uint32_t file_alignment    = binary.optional_header().file_alignment();
+  if (section_alignment < 0x1000) {
+    section_alignment = file_alignment;
+  }
+
+  it_const_sections sections = binary.sections();
+  this->sections_.reserve(sections.size());
+  for (const Section& section : sections) {
+    this->sections_.push_back({
+        section.virtual_address(),
+        std::max<uint64_t>(section.virtual_size(), section.sizeof_raw_data()),
+        align(section.virtual_address(), section_alignment),
+        align(section.pointerto_raw_data(), file_alignment),
+    });
+  }
+
+  this->sections_ptr_.reserve(this->sections_.size());
+  for (section_t& section : this->sections_) {
+    this->sections_ptr_.push_back(&section);
+  }
+}
+
+
+uint64_t ResourcesParser::rva_to_offset(uint64_t rva) const {
+  const section_t* section = this->sections_index_.find(this->sections_ptr_, rva,
+      [] (const section_t& section) {
+        return std::make_pair(section.virtual_address, section.virtual_size);
+      });
+
+  if (section == nullptr) {
+    // Same assumption as Binary::rva_to_offset: rva == offset
+    return rva;
+  }
+  return (rva - section->aligned_va) + section->aligned_offset;
+}
+
+
+void ResourcesParser::parse_childs(ResourceNode& directory) {
+  const uint32_t current_offset = directory.childs_offset_;
+  if (not this->stream_->can_read<pe_resource_directory_table>(current_offset)) {
+    return;
+  }
+  const pe_resource_directory_table directory_table = this->stream_->peek<pe_resource_directory_table>(current_offset);
+
+  const uint32_t numberof_ID_entries   = directory_table.NumberOfIDEntries;
+  const uint32_t numberof_name_entries = directory_table.NumberOfNameEntries;
+
+  size_t directory_array_offset = current_offset + sizeof(pe_resource_directory_table);
+
+  if (not this->stream_->can_read<pe_resource_directory_entries>(directory_array_offset)) {
+    return;
+  }
+  pe_resource_directory_entries entries_array = this->stream_->peek<pe_resource_directory_entries>(directory_array_offset);
+
+  // Iterate over the childs
+  for (uint32_t idx = 0; idx < (numberof_name_entries + numberof_ID_entries); ++idx) {
+
+    uint32_t data_rva = entries_array.RVA;
+    uint32_t id       = entries_array.NameID.IntegerID;
+
+    directory_array_offset += sizeof(pe_resource_directory_entries);
+    if (not this->stream_->can_read<pe_resource_directory_entries>(directory_array_offset)) {
+      break;
+    }
+    entries_array = this->stream_->peek<pe_resource_directory_entries>(directory_array_offset);
+
+    std::u16string name;
+
+    // Get the resource name
+    if (id & 0x80000000) {
+      uint32_t offset        = id & (~ 0x80000000);
+      uint32_t string_offset = this->base_offset_ + offset;
+
+      if (this->stream_->can_read<uint16_t>(string_offset)) {
+        const uint16_t length = this->stream_->peek<uint16_t>(string_offset);
+        if (length <= 100) {
+          name = this->stream_->peek_u16string_at(string_offset + sizeof(uint16_t), length);
+        }
+
+      }
+    }
+
+    // The attributes are set directly as the nodes are not modified (see: ResourceNode::changed)
+    if ((0x80000000 & data_rva) == 0) { // We are on a leaf
+      uint32_t offset = this->base_offset_ + data_rva;
+
+      if (not this->stream_->can_read<pe_resource_data_entry>(offset)) {
+        break;
+      }
+
+      const pe_resource_data_entry data_entry = this->stream_->peek<pe_resource_data_entry>(offset);
+
+      uint32_t content_offset = this->rva_to_offset(data_entry.DataRVA);
+      uint32_t content_size   = data_entry.Size;
+
+      // The content is only checked here. It is copied by ResourceData::content()
+      const uint8_t* content_ptr = this->stream_->peek_array<uint8_t>(content_offset, content_size, /* check */false);
+      if (content_ptr == nullptr) {
+        LIEF_WARN("The leaf is corrupted");
+        break;
+      }
+
+      std::unique_ptr<ResourceData> node{new ResourceData{}};
+      node->code_page_ = data_entry.Codepage;
+      node->depth_     = directory.depth_ + 1;
+      node->id_        = id;
+      node->name_      = std::move(name);
+      node->offset_    = content_offset;
+      node->size_      = content_size;
+      node->parser_    = this->shared_from_this();
+
+      directory.childs_.push_back(node.release());
+    } else { // We are on a directory
+      const uint32_t directory_rva = data_rva & (~ 0x80000000);
+      const uint32_t offset        = this->base_offset_ + directory_rva;
+      if (not this->stream_->can_read<pe_resource_directory_table>(offset)) {
+        LIEF_WARN("The directory is corrupted");
+        break;
+      }
+
+      if (this->visited_.count(offset) > 0) {
+        LIEF_WARN("Infinite loop detected on resources");
+        break;
+      }
+      this->visited_.insert(offset);
+
+      if (not this->stream_->can_read<pe_resource_directory_entries>(offset + sizeof(pe_resource_directory_table))) {
+        continue;
+      }
+
+      const pe_resource_directory_table next_directory_table = this->stream_->peek<pe_resource_directory_table>(offset);
+
+      std::unique_ptr<ResourceDirectory> node{new ResourceDirectory{&next_directory_table}};
+      node->depth_         = directory.depth_ + 1;
+      node->id_            = id;
+      node->name_          = std::move(name);
+      node->childs_offset_ = offset;
+      node->childs_parser_ = this->shared_from_this();
+
+      directory.childs_.push_back(node.release());
+    }
+  }
+}
+
+
+std::vector<uint8_t> ResourcesParser::read_content(uint32_t offset, uint32_t size) const {
+  const uint8_t* content_ptr = this->stream_->peek_array<uint8_t>(offset, size, /* check */false);
+  if (content_ptr == nullptr) {
+    return {};
+  }
+  return {content_ptr, content_ptr + size};
+}
+
+
+void ResourcesParser::load(ResourceNode& node) {
+  if (ResourceData* data = dynamic_cast<ResourceData*>(&node)) {
+    data->content();
+    return;
+  }
+  for (ResourceNode& child : node.childs()) {
+    ResourcesParser::load(child);
+  }
+}
+
+}
+}
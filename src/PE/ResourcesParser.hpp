@@ -0,0 +1,96 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_PE_RESOURCES_PARSER_H_
+#define LIEF_PE_RESOURCES_PARSER_H_
+#include <memory>
+#include <set>
+#include <vector>
+#include <mutex>
+
+#include "LIEF/types.hpp"
+#include "LIEF/range_index.hpp"
+
+namespace LIEF {
+class BinaryStream;
+
+namespace PE {
+class Binary;
+class ResourceNode;
+class ResourceDirectory;
+
+//! Decode the resource tree of a PE binary on demand.
+//!
+//! Only the root directory is decoded when the binary is parsed. The entries of
+//! the other directories are decoded the first time they are accessed
+//! (ResourceNode::childs) and the content of a ResourceData is copied from the
+//! input the first time ResourceData::content is called.
+//!
+//! The nodes that are not decoded yet share this object, which keeps the input
+//! stream alive. Its mutex serializes the decoding of the tree.
+class ResourcesParser : public std::enable_shared_from_this<ResourcesParser> {
+  public:
+  //! Decode the resource tree whose root directory is located at ``offset``.
+  //!
+  //! If ``lazy`` is false, the whole tree is decoded before returning and the
+  //! stream is no longer referenced (e.g. when the stream doesn't own its buffer).
+  static ResourceNode* parse(std::shared_ptr<BinaryStream> stream, const Binary& binary,
+                             uint32_t offset, bool lazy);
+
+  ResourcesParser(std::shared_ptr<BinaryStream> stream, const Binary& binary, uint32_t base_offset);
+
+  ResourcesParser& operator=(const ResourcesParser&) = delete;
+  ResourcesParser(const ResourcesParser&) = delete;
+
+  //! Decode the entries of the given directory
+  void parse_childs(ResourceNode& directory);
+
+  //! Copy ``size`` bytes of resource content located at ``offset``
+  std::vector<uint8_t> read_content(uint32_t offset, uint32_t size) const;
+
+  //! Decode the whole subtree of ``node`` and read the content of its
+  //! ResourceData such as it no longer references the input stream
+  static void load(ResourceNode& node);
+
+  //! Must be held while a node is decoded by this parser
+  std::mutex& mutex() {
+    return this->mutex_;
+  }
+
+  private:
+  // Mapping of a section, as computed by Binary::rva_to_offset
+  struct section_t {
+    uint64_t virtual_address;
+    uint64_t virtual_size;
+    uint64_t aligned_va;
+    uint64_t aligned_offset;
+  };
+
+  // The layout of the binary may change before the whole tree is decoded:
+  // the RVA are resolved with the sections of the parsed binary
+  uint64_t rva_to_offset(uint64_t rva) const;
+
+  std::shared_ptr<BinaryStream> stream_;
+  uint32_t                      base_offset_;
+  std::set<uint32_t>            visited_;
+  std::vector<section_t>        sections_;
+  std::vector<section_t*>       sections_ptr_;
+  RangeIndex<section_t>         sections_index_;
+  std::mutex                    mutex_;
+};
+
+}
+}
+#endif
@@ -82,6 +82,10 @@ std::vector<uint8_t> Section::content() const {
   return this->content_;
 }
 
+span<const uint8_t> Section::content_view() const {
+  return this->content_;
+}
+
 std::vector<uint8_t>& Section::content_ref() {
   return this->content_;
 }
@@ -149,10 +153,12 @@ std::set<SECTION_CHARACTERISTICS> Section::characteristics_list() const {
 
 void Section::content(const std::vector<uint8_t>& data) {
   this->content_ = data;
+  this->content_changed();
 }
 
 
 void Section::virtual_size(uint32_t virtualSize) {
+  this->index_changed();
   this->virtual_size_ = virtualSize;
 }
 
@@ -225,6 +231,7 @@ void Section::clear(uint8_t c) {
       std::begin(this->content_),
       std::end(this->content_),
       c);
+  this->content_changed();
 }
 
 bool Section::operator==(const Section& rhs) const {
@@ -157,7 +157,7 @@ void Hash::visit(const Section& section) {
   this->process(section.numberof_relocations());
   this->process(section.numberof_line_numbers());
   this->process(section.characteristics());
-  this->process(section.content());
+  this->process_digest(section.content_digest());
 
 }
 
@@ -57,11 +57,12 @@ std::string to_json_str(const Object& v) {
   return PE::to_json(v).dump();
 }
 
-void JsonVisitor::visit(const Binary& binary) {
+JsonMembers JsonVisitor::members(const Binary& binary) {
+  JsonMembers members;
 
-  this->node_["name"]         = binary.name();
-  this->node_["entrypoint"]   = binary.entrypoint();
-  this->node_["virtual_size"] = binary.virtual_size();
+  members.set("name",         binary.name());
+  members.set("entrypoint",   binary.entrypoint());
+  members.set("virtual_size", binary.virtual_size());
 
   // DOS Header
   JsonVisitor dos_header_visitor;
@@ -71,7 +72,7 @@ void JsonVisitor::visit(const Binary& binary) {
   if (binary.has_rich_header()) {
     JsonVisitor visitor;
     visitor(binary.rich_header());
-    this->node_["rich_header"] = visitor.get();
+    members.set("rich_header", visitor.get());
   }
 
   // PE header
@@ -82,45 +83,22 @@ void JsonVisitor::visit(const Binary& binary) {
   JsonVisitor optional_header_visitor;
   optional_header_visitor(binary.optional_header());
 
-  this->node_["dos_header"]      = dos_header_visitor.get();
-  this->node_["header"]          = header_visitor.get();
-  this->node_["optional_header"] = optional_header_visitor.get();
-
-  // Data directories
-  std::vector<json> data_directories;
-  for (const DataDirectory& data_directory : binary.data_directories()) {
-    JsonVisitor visitor;
-    visitor(data_directory);
-    data_directories.emplace_back(visitor.get());
-  }
-  this->node_["data_directories"] = data_directories;
+  members.set("dos_header",      dos_header_visitor.get());
+  members.set("header",          header_visitor.get());
+  members.set("optional_header", optional_header_visitor.get());
 
+  members.set_array<JsonVisitor>("data_directories", binary.data_directories());
+  members.set_array<JsonVisitor>("sections",         binary.sections());
 
-  // Section
-  std::vector<json> sections;
-  for (const Section& section : binary.sections()) {
-    JsonVisitor visitor;
-    visitor(section);
-    sections.emplace_back(visitor.get());
-  }
-  this->node_["sections"] = sections;
-
-  // Relocations
   if (binary.has_relocations()) {
-    std::vector<json> relocations;
-    for (const Relocation& relocation : binary.relocations()) {
-      JsonVisitor visitor;
-      visitor(relocation);
-      relocations.emplace_back(visitor.get());
-    }
-    this->node_["relocations"] = relocations;
+    members.set_array<JsonVisitor>("relocations", binary.relocations());
   }
 
   // TLS
   if (binary.has_tls()) {
     JsonVisitor visitor;
     visitor(binary.tls());
-    this->node_["tls"] = visitor.get();
+    members.set("tls", visitor.get());
   }
 
 
@@ -128,30 +106,15 @@ void JsonVisitor::visit(const Binary& binary) {
   if (binary.has_exports()) {
     JsonVisitor visitor;
     visitor(binary.get_export());
-    this->node_["export"] = visitor.get();
+    members.set("export", visitor.get());
   }
 
-
-  // Debug
   if (binary.has_debug()) {
-    std::vector<json> debug_entries;
-    for (const Debug& debug : binary.debug()) {
-      JsonVisitor visitor;
-      visitor(debug);
-      debug_entries.emplace_back(visitor.get());
-    }
-    this->node_["debug"] = debug_entries;
+    members.set_array<JsonVisitor>("debug", binary.debug());
   }
 
-  // Imports
   if (binary.has_imports()) {
-    std::vector<json> imports;
-    for (const Import& import : binary.imports()) {
-      JsonVisitor visitor;
-      visitor(import);
-      imports.emplace_back(visitor.get());
-    }
-    this->node_["imports"] = imports;
+    members.set_array<JsonVisitor>("imports", binary.imports());
   }
 
   // Resources
@@ -162,30 +125,16 @@ void JsonVisitor::visit(const Binary& binary) {
     JsonVisitor manager_visitor;
     binary.resources_manager().accept(manager_visitor);
 
-    this->node_["resources_tree"]    = visitor.get();
-    this->node_["resources_manager"] = manager_visitor.get();
+    members.set("resources_tree",    visitor.get());
+    members.set("resources_manager", manager_visitor.get());
   }
 
-
-  // Signatures
-  std::vector<json> sigs;
   if (binary.has_signatures()) {
-    for (const Signature& sig : binary.signatures()) {
-      JsonVisitor visitor;
-      visitor(sig);
-      sigs.push_back(std::move(visitor.get()));
-    }
-    this->node_["signatures"] = sigs;
+    members.set_array<JsonVisitor>("signatures", binary.signatures());
   }
 
-  std::vector<json> symbols;
-  for (const Symbol& symbol : binary.symbols()) {
-    JsonVisitor visitor;
-    visitor(symbol);
-    symbols.emplace_back(visitor.get());
-  }
-  if (!symbols.empty()) {
-    this->node_["symbols"] = symbols;
+  if (binary.symbols().size() > 0) {
+    members.set_array<JsonVisitor>("symbols", binary.symbols());
   }
 
   // Load Configuration
@@ -193,9 +142,14 @@ void JsonVisitor::visit(const Binary& binary) {
     JsonVisitor visitor;
     const LoadConfiguration& config = binary.load_configuration();
     config.accept(visitor);
-    this->node_["load_configuration"] = visitor.get();
+    members.set("load_configuration", visitor.get());
   }
+  return members;
+}
 
+
+void JsonVisitor::visit(const Binary& binary) {
+  JsonVisitor::members(binary).update(this->node_);
 }
 
 
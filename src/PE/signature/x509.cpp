@@ -19,11 +19,18 @@
 #include <sstream>
 #include <map>
 #include <fstream>
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "mbedtls/x509_crt.h"
 #include "mbedtls/asn1.h"
 #include "mbedtls/oid.h"
 #include "mbedtls/error.h"
+#include "mbedtls/sha256.h"
 
 #include "logging.hpp"
 
@@ -441,19 +448,252 @@ bool x509::check_signature(const std::vector<uint8_t>& hash, const std::vector<u
 }
 
 
+namespace {
+// SHA-256 of the DER encoding of a certificate
+using der_hash_t = std::array<uint8_t, 32>;
+
+der_hash_t der_hash(const mbedtls_x509_crt& crt) {
+  der_hash_t hash;
+  mbedtls_sha256(crt.raw.p, crt.raw.len, hash.data(), /* is224 */ 0);
+  return hash;
+}
+
+struct der_hash_hasher {
+  size_t operator()(const der_hash_t& hash) const {
+    size_t value = 0;
+    std::memcpy(&value, hash.data(), sizeof(value));
+    return value;
+  }
+};
+
+struct der_hash_pair_hasher {
+  size_t operator()(const std::pair<der_hash_t, der_hash_t>& hashes) const {
+    return der_hash_hasher{}(hashes.first) ^ (der_hash_hasher{}(hashes.second) << 1);
+  }
+};
+
+// The results with flags that depend on the current time are not cached
+inline bool is_cacheable(x509::VERIFICATION_FLAGS result) {
+  static const x509::VERIFICATION_FLAGS TIME_FLAGS =
+    x509::VERIFICATION_FLAGS::BADCERT_EXPIRED | x509::VERIFICATION_FLAGS::BADCERT_FUTURE |
+    x509::VERIFICATION_FLAGS::BADCRL_EXPIRED  | x509::VERIFICATION_FLAGS::BADCRL_FUTURE;
+  return (result & TIME_FLAGS) == x509::VERIFICATION_FLAGS::OK;
+}
+
+//! Map bounded to ``capacity`` entries which evicts the least recently used ones
+//! (as the LibraryCache of the ELF DependencyResolver). It is not synchronized.
+template<class K, class V, class H>
+class lru_map {
+  public:
+  explicit lru_map(size_t capacity) :
+    capacity_{capacity}
+  {}
+
+  //! Value associated with ``key`` (which becomes the most recently used) or a nullptr
+  V* get(const K& key) {
+    auto it = this->index_.find(key);
+    if (it == std::end(this->index_)) {
+      return nullptr;
+    }
+    this->lru_.splice(std::begin(this->lru_), this->lru_, it->second);
+    return &it->second->second;
+  }
+
+  void put(const K& key, V value) {
+    auto it = this->index_.find(key);
+    if (it != std::end(this->index_)) {
+      it->second->second = std::move(value);
+      this->lru_.splice(std::begin(this->lru_), this->lru_, it->second);
+      return;
+    }
+    this->lru_.emplace_front(key, std::move(value));
+    this->index_.emplace(key, std::begin(this->lru_));
+    while (this->lru_.size() > this->capacity_) {
+      this->index_.erase(this->lru_.back().first);
+      this->lru_.pop_back();
+    }
+  }
+
+  size_t size() const {
+    return this->lru_.size();
+  }
+
+  template<class F>
+  void for_each(F&& func) const {
+    for (const entry_t& entry : this->lru_) {
+      func(entry.second);
+    }
+  }
+
+  void clear() {
+    this->index_.clear();
+    this->lru_.clear();
+  }
+
+  private:
+  using entry_t = std::pair<K, V>;
+  std::list<entry_t> lru_;
+  std::unordered_map<K, typename std::list<entry_t>::iterator, H> index_;
+  size_t capacity_;
+};
+
+// CA list parsed once as a mbedtls chain with the results of the certificates verified against it
+struct trust_chain_t {
+  trust_chain_t() {
+    mbedtls_x509_crt_init(&this->head);
+  }
+
+  ~trust_chain_t() {
+    mbedtls_x509_crt_free(&this->head);
+  }
+
+  mbedtls_x509_crt head;
+
+  // mbedtls lazily updates the public keys of the CA (e.g. the RSA's RN) while
+  // verifying a certificate: the verifications against the chain are serialized
+  std::mutex mutex;
+  lru_map<der_hash_t, x509::VERIFICATION_FLAGS, der_hash_hasher> results{MAX_CHAIN_RESULTS};
+
+  static constexpr size_t MAX_CHAIN_RESULTS = 100000;
+};
+
+//! Process-wide cache of the parsed CA lists (keyed by the DER hashes of their certificates)
+//! and of the results of x509::verify. The results that depend on the current time
+//! (expired certificates, ...) are not cached (see: is_cacheable).
+//! The least recently used CA lists and results are evicted when the cache is full.
+class CertificateCache {
+  public:
+  static constexpr size_t MAX_CHAINS  = 64;
+  static constexpr size_t MAX_RESULTS = 100000;
+
+  static CertificateCache& instance() {
+    static CertificateCache cache;
+    return cache;
+  }
+
+  std::shared_ptr<trust_chain_t> chain(const std::vector<const mbedtls_x509_crt*>& ca) {
+    std::vector<uint8_t> hashes;
+    hashes.reserve(ca.size() * sizeof(der_hash_t));
+    for (const mbedtls_x509_crt* crt : ca) {
+      const der_hash_t hash = der_hash(*crt);
+      hashes.insert(std::end(hashes), std::begin(hash), std::end(hash));
+    }
+    der_hash_t key;
+    mbedtls_sha256(hashes.data(), hashes.size(), key.data(), /* is224 */ 0);
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    if (std::shared_ptr<trust_chain_t>* chain = this->chains_.get(key)) {
+      return *chain;
+    }
+
+    auto chain = std::make_shared<trust_chain_t>();
+    for (const mbedtls_x509_crt* crt : ca) {
+      const int ret = mbedtls_x509_crt_parse_der(&chain->head, crt->raw.p, crt->raw.len);
+      if (ret != 0) {
+        LIEF_WARN("Failed to parse a CA certificate (0x{:x})", ret);
+        return nullptr;
+      }
+    }
+
+    this->chains_.put(key, chain);
+    return chain;
+  }
+
+  bool get_result(const der_hash_t& ca, const der_hash_t& child, x509::VERIFICATION_FLAGS& result) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    const x509::VERIFICATION_FLAGS* cached = this->results_.get({ca, child});
+    if (cached == nullptr) {
+      return false;
+    }
+    result = *cached;
+    return true;
+  }
+
+  void set_result(const der_hash_t& ca, const der_hash_t& child, x509::VERIFICATION_FLAGS result) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->results_.put({ca, child}, result);
+  }
+
+  //! Count a lookup of a verification result
+  void lookup(bool hit) {
+    ++(hit ? this->hits_ : this->misses_);
+  }
+
+  x509::cache_stats_t stats() {
+    x509::cache_stats_t stats;
+    stats.hits   = this->hits_;
+    stats.misses = this->misses_;
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    stats.nb_ca_lists = this->chains_.size();
+    stats.nb_results  = this->results_.size();
+    this->chains_.for_each([&stats] (const std::shared_ptr<trust_chain_t>& chain) {
+      std::lock_guard<std::mutex> chain_lock(chain->mutex);
+      stats.nb_results += chain->results.size();
+    });
+    return stats;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->chains_.clear();
+    this->results_.clear();
+    this->hits_   = 0;
+    this->misses_ = 0;
+  }
+
+  private:
+  std::mutex mutex_;
+  lru_map<der_hash_t, std::shared_ptr<trust_chain_t>, der_hash_hasher> chains_{MAX_CHAINS};
+  lru_map<std::pair<der_hash_t, der_hash_t>, x509::VERIFICATION_FLAGS, der_hash_pair_hasher> results_{MAX_RESULTS};
+  std::atomic<size_t> hits_{0};
+  std::atomic<size_t> misses_{0};
+};
+
+x509::VERIFICATION_FLAGS verify_crt(mbedtls_x509_crt* crt, mbedtls_x509_crt* trust_ca,
+                                    const mbedtls_x509_crt_profile& profile) {
+  uint32_t flags = 0;
+  int ret = mbedtls_x509_crt_verify_with_profile(
+      /* crt          */ crt,
+      /* Trusted CA   */ trust_ca,
+      /* CA's CRLs    */ nullptr,
+      /* profile      */ &profile,
+      /* Common Name  */ nullptr,
+      /* Verification */ &flags,
+      /* verification function */ nullptr,
+      /* verification params   */ nullptr);
+
+  if (ret != 0) {
+    std::string strerr(1024, 0);
+    mbedtls_strerror(ret, const_cast<char*>(strerr.data()), strerr.size());
+    std::string out(1024, 0);
+    mbedtls_x509_crt_verify_info(const_cast<char*>(out.data()), out.size(), "", flags);
+    LIEF_WARN("X509 verify failed with: {} (0x{:x})\n{}", strerr, ret, out);
+    return from_mbedtls_err(flags);
+  }
+  return x509::VERIFICATION_FLAGS::OK;
+}
+}
+
+
 x509::VERIFICATION_FLAGS x509::is_trusted_by(const std::vector<x509>& ca) const {
   if (ca.empty()) {
     LIEF_WARN("Certificate chain is empty");
     return VERIFICATION_FLAGS::BADCERT_MISSING;
   }
-  std::vector<x509> ca_list = ca; // Explicit copy since we will modify mbedtls_x509_crt->next
-  for (size_t i = 0; i < ca_list.size() - 1; ++i) {
-    ca_list[i].x509_cert_->next = ca_list[i + 1].x509_cert_;
+
+  std::vector<const mbedtls_x509_crt*> ca_list;
+  ca_list.reserve(ca.size());
+  for (const x509& crt : ca) {
+    ca_list.push_back(crt.x509_cert_);
+  }
+
+  std::shared_ptr<trust_chain_t> chain = CertificateCache::instance().chain(ca_list);
+  if (chain == nullptr) {
+    return VERIFICATION_FLAGS::BADCERT_OTHER;
   }
 
-  VERIFICATION_FLAGS result = VERIFICATION_FLAGS::OK;
-  uint32_t flags = 0;
-  mbedtls_x509_crt_profile profile = {
+  static const mbedtls_x509_crt_profile profile = {
     MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_MD5)   |
     MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA1)   |
     MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA224) |
@@ -465,36 +705,42 @@ x509::VERIFICATION_FLAGS x509::is_trusted_by(const std::vector<x509>& ca) const
     1          /* Min RSA key   */,
   };
 
-  int ret = mbedtls_x509_crt_verify_with_profile(
-      /* crt          */ this->x509_cert_,
-      /* Trusted CA   */ ca_list.front().x509_cert_,
-      /* CA's CRLs    */ nullptr,
-      /* profile      */ &profile,
-      /* Common Name  */ nullptr,
-      /* Verification */ &flags,
-      /* verification function */ nullptr,
-      /* verification params   */ nullptr);
+  // A cached result no longer holds once one of the certificates has expired
+  bool expired = time_is_past(this->valid_to());
+  for (const x509& crt : ca) {
+    expired = expired or time_is_past(crt.valid_to());
+  }
 
-  if (ret != 0) {
-    std::string strerr(1024, 0);
-    mbedtls_strerror(ret, const_cast<char*>(strerr.data()), strerr.size());
-    std::string out(1024, 0);
-    mbedtls_x509_crt_verify_info(const_cast<char*>(out.data()), out.size(), "", flags);
-    LIEF_WARN("X509 verify failed with: {} (0x{:x})\n{}", strerr, ret, out);
-    result = from_mbedtls_err(flags);
+  const der_hash_t id = der_hash(*this->x509_cert_);
+  std::lock_guard<std::mutex> lock(chain->mutex);
+  const VERIFICATION_FLAGS* cached = expired ? nullptr : chain->results.get(id);
+  CertificateCache::instance().lookup(cached != nullptr);
+  if (cached != nullptr) {
+    return *cached;
   }
 
-  // Clear the chain since ~x509() will delete each object
-  for (size_t i = 0; i < ca_list.size(); ++i) {
-    ca_list[i].x509_cert_->next = nullptr;
+  const VERIFICATION_FLAGS result = verify_crt(this->x509_cert_, &chain->head, profile);
+  if (is_cacheable(result)) {
+    chain->results.put(id, result);
   }
   return result;
 }
 
-x509::VERIFICATION_FLAGS x509::verify(const x509& ca) const {
-  uint32_t flags = 0;
+x509::VERIFICATION_FLAGS x509::verify(const x509& child) const {
+  const der_hash_t ca_id    = der_hash(*this->x509_cert_);
+  const der_hash_t child_id = der_hash(*child.x509_cert_);
+
+  // A cached result no longer holds once one of the certificates has expired
+  const bool expired = time_is_past(this->valid_to()) or time_is_past(child.valid_to());
+
   VERIFICATION_FLAGS result = VERIFICATION_FLAGS::OK;
-  mbedtls_x509_crt_profile profile = {
+  const bool hit = not expired and CertificateCache::instance().get_result(ca_id, child_id, result);
+  CertificateCache::instance().lookup(hit);
+  if (hit) {
+    return result;
+  }
+
+  static const mbedtls_x509_crt_profile profile = {
     MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA1)   |
     MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA224) |
     MBEDTLS_X509_ID_FLAG(MBEDTLS_MD_SHA256) |
@@ -505,27 +751,21 @@ x509::VERIFICATION_FLAGS x509::verify(const x509& ca) const {
     1          /* Min RSA key */,
   };
 
-  int ret = mbedtls_x509_crt_verify_with_profile(
-      /* crt          */ ca.x509_cert_,
-      /* Trusted CA   */ this->x509_cert_,
-      /* CA's CRLs    */ nullptr,
-      /* profile      */ &profile,
-      /* Common Name  */ nullptr,
-      /* Verification */ &flags,
-      /* verification function */ nullptr,
-      /* verification params   */ nullptr);
-
-  if (ret != 0) {
-    std::string strerr(1024, 0);
-    mbedtls_strerror(ret, const_cast<char*>(strerr.data()), strerr.size());
-    std::string out(1024, 0);
-    mbedtls_x509_crt_verify_info(const_cast<char*>(out.data()), out.size(), "", flags);
-    LIEF_WARN("X509 verify failed with: {} (0x{:x})\n{}", strerr, ret, out);
-    result = from_mbedtls_err(flags);
+  result = verify_crt(child.x509_cert_, this->x509_cert_, profile);
+  if (is_cacheable(result)) {
+    CertificateCache::instance().set_result(ca_id, child_id, result);
   }
   return result;
 }
 
+void x509::clear_cache() {
+  CertificateCache::instance().clear();
+}
+
+x509::cache_stats_t x509::cache_stats() {
+  return CertificateCache::instance().stats();
+}
+
 std::vector<oid_t> x509::ext_key_usage() const {
   if ((this->x509_cert_->private_ext_types & MBEDTLS_X509_EXT_EXTENDED_KEY_USAGE) == 0) {
     return {};
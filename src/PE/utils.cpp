@@ -34,6 +34,7 @@
 #include "LIEF/PE/Import.hpp"
 #include "LIEF/PE/ImportEntry.hpp"
 #include "LIEF/BinaryStream/VectorStream.hpp"
+#include "LIEF/BinaryStream/SpanStream.hpp"
 
 #include "LIEF/utils.hpp"
 
@@ -94,6 +95,10 @@ bool is_pe(const std::string& file) {
 
 
 bool is_pe(const std::vector<uint8_t>& raw) {
+  return is_pe(span<const uint8_t>{raw});
+}
+
+bool is_pe(span<const uint8_t> raw) {
 
   if (raw.size() < sizeof(pe_dos_header)) {
     return false;
@@ -108,7 +113,7 @@ bool is_pe(const std::vector<uint8_t>& raw) {
     return false;
   }
 
-  VectorStream raw_stream(raw);
+  SpanStream raw_stream(raw);
   raw_stream.setpos(dos_header->AddressOfNewExeHeader);
   auto signature = raw_stream.read_array<char>(sizeof(PE_Magic), /* check bounds */ true);
 
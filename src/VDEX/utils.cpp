@@ -40,6 +40,10 @@ bool is_vdex(const std::string& file) {
 }
 
 bool is_vdex(const std::vector<uint8_t>& raw) {
+  return is_vdex(span<const uint8_t>{raw});
+}
+
+bool is_vdex(span<const uint8_t> raw) {
   if (raw.size() < sizeof(VDEX::magic)) {
     return false;
   }
@@ -17,6 +17,28 @@
 #include "LIEF/Object.hpp"
 
 namespace LIEF {
+
+namespace {
+//! Visitor which only records the format of the visited object.
+//! As it doesn't handle any object, the visit stops at the first one.
+class FormatProbe : public Visitor {
+  public:
+  using Visitor::visit;
+
+  FORMAT format() const {
+    return this->format_;
+  }
+
+  protected:
+  virtual void unhandled(FORMAT format) override {
+    this->format_ = format;
+  }
+
+  private:
+  FORMAT format_ = FORMAT::ABSTRACT;
+};
+}
+
 Visitor::Visitor() = default;
 Visitor::~Visitor() = default;
 
@@ -28,6 +50,15 @@ void Visitor::visit(const Object& v) {
   v.accept(*this);
 }
 
+void Visitor::unhandled(FORMAT) {
+}
+
+Visitor::FORMAT Visitor::format_of(const Object& obj) {
+  FormatProbe probe;
+  obj.accept(probe);
+  return probe.format();
+}
+
 
 
 }
@@ -0,0 +1,248 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define LIEF_ENTROPY_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define LIEF_ENTROPY_SSE2
+#endif
+
+#include "LIEF/entropy.hpp"
+
+namespace LIEF {
+
+// Number of histogram tables used by histogram_block(). Consecutive bytes
+// are often identical (padding, zero-filled areas, ...) and with a single table,
+// each increment would have to wait for the previous store on the same counter.
+static constexpr size_t NB_TABLES = 4;
+
+// The counters of the tables are 32 bits: the buffer is processed
+// by chunks so that they can't overflow
+static constexpr size_t MAX_CHUNK_SIZE = 1llu << 30;
+
+// Minimal amount of data processed by a thread in histogram()
+static constexpr size_t MIN_THREAD_SIZE = 1llu << 20;
+
+// Windows up to this size use a lookup table for c * log2(c)
+static constexpr size_t MAX_CURVE_TABLE = 1llu << 16;
+
+//! Sum the NB_TABLES tables in ``out``
+static void reduce_tables(const uint32_t (&tables)[NB_TABLES][256], histogram_t& out) {
+  alignas(32) uint32_t sum[256];
+#if defined(LIEF_ENTROPY_AVX2)
+  for (size_t i = 0; i < 256; i += 8) {
+    __m256i acc = _mm256_load_si256(reinterpret_cast<const __m256i*>(&tables[0][i]));
+    for (size_t t = 1; t < NB_TABLES; ++t) {
+      acc = _mm256_add_epi32(acc, _mm256_load_si256(reinterpret_cast<const __m256i*>(&tables[t][i])));
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i*>(&sum[i]), acc);
+  }
+#elif defined(LIEF_ENTROPY_SSE2)
+  for (size_t i = 0; i < 256; i += 4) {
+    __m128i acc = _mm_load_si128(reinterpret_cast<const __m128i*>(&tables[0][i]));
+    for (size_t t = 1; t < NB_TABLES; ++t) {
+      acc = _mm_add_epi32(acc, _mm_load_si128(reinterpret_cast<const __m128i*>(&tables[t][i])));
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(&sum[i]), acc);
+  }
+#else
+  for (size_t i = 0; i < 256; ++i) {
+    sum[i] = tables[0][i];
+    for (size_t t = 1; t < NB_TABLES; ++t) {
+      sum[i] += tables[t][i];
+    }
+  }
+#endif
+  for (size_t i = 0; i < 256; ++i) {
+    out[i] += sum[i];
+  }
+}
+
+
+//! Single-threaded histogram
+static void histogram_block(const uint8_t* data, size_t size, histogram_t& out) {
+  alignas(32) uint32_t tables[NB_TABLES][256];
+
+  while (size > 0) {
+    const size_t chunk_size = std::min(size, MAX_CHUNK_SIZE);
+    std::memset(tables, 0, sizeof(tables));
+
+    const uint8_t* ptr = data;
+    const uint8_t* end = data + chunk_size;
+    for (; ptr + sizeof(uint64_t) <= end; ptr += sizeof(uint64_t)) {
+      uint64_t value = 0;
+      std::memcpy(&value, ptr, sizeof(value));
+      ++tables[0][(value >>  0) & 0xFF];
+      ++tables[1][(value >>  8) & 0xFF];
+      ++tables[2][(value >> 16) & 0xFF];
+      ++tables[3][(value >> 24) & 0xFF];
+      ++tables[0][(value >> 32) & 0xFF];
+      ++tables[1][(value >> 40) & 0xFF];
+      ++tables[2][(value >> 48) & 0xFF];
+      ++tables[3][(value >> 56) & 0xFF];
+    }
+    for (; ptr < end; ++ptr) {
+      ++tables[0][*ptr];
+    }
+
+    reduce_tables(tables, out);
+    data += chunk_size;
+    size -= chunk_size;
+  }
+}
+
+
+histogram_t histogram(span<const uint8_t> data, size_t nb_threads) {
+  histogram_t result = {{0}};
+
+  if (nb_threads == 0) {
+    nb_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  nb_threads = std::min(nb_threads, std::max<size_t>(data.size() / MIN_THREAD_SIZE, 1));
+
+  if (nb_threads <= 1) {
+    histogram_block(data.data(), data.size(), result);
+    return result;
+  }
+
+  const size_t chunk_size = (data.size() + nb_threads - 1) / nb_threads;
+  std::vector<histogram_t> histograms(nb_threads, histogram_t{{0}});
+  std::vector<std::thread> threads;
+  threads.reserve(nb_threads);
+  for (size_t i = 0; i < nb_threads; ++i) {
+    const span<const uint8_t> chunk = data.subspan(i * chunk_size, chunk_size);
+    histogram_t& hist = histograms[i];
+    threads.emplace_back([chunk, &hist] () {
+      histogram_block(chunk.data(), chunk.size(), hist);
+    });
+  }
+
+  for (size_t i = 0; i < nb_threads; ++i) {
+    threads[i].join();
+    for (size_t b = 0; b < result.size(); ++b) {
+      result[b] += histograms[i][b];
+    }
+  }
+  return result;
+}
+
+
+double entropy(const histogram_t& histogram) {
+  uint64_t total = 0;
+  for (uint64_t count : histogram) {
+    total += count;
+  }
+  if (total == 0) {
+    return 0.0;
+  }
+
+  double entropy = 0.0;
+  for (uint64_t count : histogram) {
+    if (count > 0) {
+      const double freq = static_cast<double>(count) / static_cast<double>(total);
+      entropy += freq * std::log2(freq);
+    }
+  }
+  return -entropy;
+}
+
+
+double entropy(span<const uint8_t> data, size_t nb_threads) {
+  return entropy(histogram(data, nb_threads));
+}
+
+
+std::vector<double> entropy_curve(span<const uint8_t> data, size_t block_size, size_t step) {
+  if (data.empty() or block_size == 0) {
+    return {};
+  }
+
+  if (data.size() <= block_size) {
+    return {entropy(data)};
+  }
+
+  if (step == 0) {
+    step = block_size;
+  }
+
+  const size_t nb_windows = (data.size() - block_size) / step + 1;
+  std::vector<double> curve;
+  curve.reserve(nb_windows);
+
+  // Non-overlapping windows: each window is computed from scratch
+  if (step >= block_size) {
+    for (size_t i = 0; i < nb_windows; ++i) {
+      curve.push_back(entropy(data.subspan(i * step, block_size)));
+    }
+    return curve;
+  }
+
+  // Sliding windows: the histogram and the sum of c * log2(c) are updated
+  // with the bytes that leave and enter the window, and:
+  //   H = log2(N) - sum(c * log2(c)) / N
+  std::vector<double> table;
+  if (block_size <= MAX_CURVE_TABLE) {
+    table.resize(block_size + 1);
+    for (size_t c = 1; c <= block_size; ++c) {
+      table[c] = c * std::log2(static_cast<double>(c));
+    }
+  }
+
+  auto&& clog = [&table] (uint64_t c) {
+    if (c < table.size()) {
+      return table[c];
+    }
+    return c == 0 ? 0.0 : c * std::log2(static_cast<double>(c));
+  };
+
+  std::array<uint64_t, 256> counts = {{0}};
+  for (size_t i = 0; i < block_size; ++i) {
+    ++counts[data[i]];
+  }
+
+  double sum = 0.0;
+  for (uint64_t c : counts) {
+    sum += clog(c);
+  }
+
+  const double log_n = std::log2(static_cast<double>(block_size));
+  const double n     = static_cast<double>(block_size);
+  curve.push_back(std::max(0.0, log_n - sum / n));
+
+  for (size_t i = 1; i < nb_windows; ++i) {
+    const size_t start = i * step;
+    for (size_t j = start - step; j < start; ++j) {
+      uint64_t& c = counts[data[j]];
+      sum += clog(c - 1) - clog(c);
+      --c;
+    }
+    for (size_t j = start - step + block_size; j < start + block_size; ++j) {
+      uint64_t& c = counts[data[j]];
+      sum += clog(c + 1) - clog(c);
+      ++c;
+    }
+    curve.push_back(std::max(0.0, log_n - sum / n));
+  }
+  return curve;
+}
+
+}
@@ -0,0 +1,446 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+  #include <io.h>
+  #include <process.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <cerrno>
+#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <cerrno>
+  #define LIEF_FILE_POSIX
+  #if defined(__linux__)
+    #include <sys/sendfile.h>
+  #endif
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <atomic>
+
+#include "logging.hpp"
+
+#include "LIEF/file_ostream.hpp"
+#include "LIEF/exception.hpp"
+#include "LIEF/utils.hpp"
+
+#if defined(__linux__) && defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+  #define LIEF_HAS_COPY_FILE_RANGE
+#endif
+
+namespace LIEF {
+
+#if defined(_WIN32)
+//! Create a new file next to ``path``
+inline int create_tmp_file(const std::string& path, std::string& tmp_path) {
+  static std::atomic<uint32_t> counter{0};
+  for (size_t i = 0; i < 16; ++i) {
+    tmp_path = path + ".lief-" + std::to_string(::_getpid()) + "-" + std::to_string(counter++);
+    const int fd = ::_open(tmp_path.c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY,
+                           _S_IREAD | _S_IWRITE);
+    if (fd >= 0 or errno != EEXIST) {
+      return fd;
+    }
+  }
+  return -1;
+}
+
+inline bool replace_file(const std::string& from, const std::string& to) {
+  return ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+//! Extend the file up to ``size`` bytes
+inline bool extend_file(int fd, uint64_t size) {
+  struct _stati64 st;
+  if (::_fstati64(fd, &st) != 0) {
+    return false;
+  }
+  if (static_cast<uint64_t>(st.st_size) >= size) {
+    return true;
+  }
+  return ::_chsize_s(fd, static_cast<__int64>(size)) == 0;
+}
+
+inline bool pwrite_all(int fd, const uint8_t* data, size_t size, uint64_t offset) {
+  if (::_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0) {
+    return false;
+  }
+  while (size > 0) {
+    const unsigned chunk = static_cast<unsigned>(std::min<size_t>(size, 1u << 30));
+    const int written = ::_write(fd, data, chunk);
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+inline int64_t pread_some(int fd, uint8_t* data, size_t size, uint64_t offset) {
+  if (::_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0) {
+    return -1;
+  }
+  return ::_read(fd, data, static_cast<unsigned>(size));
+}
+#elif defined(LIEF_FILE_POSIX)
+//! Create a new file next to ``path`` (with the permissions of a new file)
+inline int create_tmp_file(const std::string& path, std::string& tmp_path) {
+  static std::atomic<uint32_t> counter{0};
+  for (size_t i = 0; i < 16; ++i) {
+    tmp_path = path + ".lief-" + std::to_string(::getpid()) + "-" + std::to_string(counter++);
+    const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+    if (fd >= 0 or errno != EEXIST) {
+      return fd;
+    }
+  }
+  return -1;
+}
+
+inline bool replace_file(const std::string& from, const std::string& to) {
+  return std::rename(from.c_str(), to.c_str()) == 0;
+}
+
+//! Extend the file up to ``size`` bytes
+inline bool extend_file(int fd, uint64_t size) {
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    return false;
+  }
+  if (static_cast<uint64_t>(st.st_size) >= size) {
+    return true;
+  }
+  int ret = 0;
+  do {
+    ret = ::ftruncate(fd, static_cast<off_t>(size));
+  } while (ret < 0 and errno == EINTR);
+  return ret == 0;
+}
+
+inline bool pwrite_all(int fd, const uint8_t* data, size_t size, uint64_t offset) {
+  while (size > 0) {
+    const ssize_t written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+    if (written < 0 and errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    data   += written;
+    size   -= written;
+    offset += written;
+  }
+  return true;
+}
+
+inline int64_t pread_some(int fd, uint8_t* data, size_t size, uint64_t offset) {
+  ssize_t nread = 0;
+  do {
+    nread = ::pread(fd, data, size, static_cast<off_t>(offset));
+  } while (nread < 0 and errno == EINTR);
+  return nread;
+}
+#endif
+
+
+constexpr size_t file_ostream::BUFFER_SIZE;
+
+file_ostream::file_ostream(const std::string& filename, bool endian_swap) :
+  path_{filename},
+  endian_swap_{endian_swap}
+{
+#if defined(_WIN32)
+  // The output is written next to the final file so that MoveFileEx() doesn't copy it
+  std::string tmp_path;
+  this->fd_ = create_tmp_file(this->path_, tmp_path);
+  if (this->fd_ >= 0) {
+    this->tmp_path_ = std::move(tmp_path);
+  } else {
+    LIEF_DEBUG("Can't create a temporary file for {}: write it in place", this->path_);
+    this->fd_ = ::_open(this->path_.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+                        _S_IREAD | _S_IWRITE);
+  }
+#elif defined(LIEF_FILE_POSIX)
+  // Replace the target of a symbolic link rather than the link itself
+  struct stat st;
+  if (::lstat(filename.c_str(), &st) == 0 and S_ISLNK(st.st_mode)) {
+    char target[PATH_MAX];
+    if (::realpath(filename.c_str(), target) != nullptr) {
+      this->path_ = target;
+    }
+  }
+
+  // The output is written next to the final file so that rename() is atomic
+  std::string tmp_path;
+  this->fd_ = create_tmp_file(this->path_, tmp_path);
+  if (this->fd_ >= 0) {
+    this->tmp_path_ = std::move(tmp_path);
+    // Keep the owner and the permissions of the file that is replaced.
+    // The owner is set first as fchown() clears the set-user-ID bits
+    if (::stat(this->path_.c_str(), &st) == 0) {
+      if (::fchown(this->fd_, st.st_uid, st.st_gid) != 0) {
+        LIEF_DEBUG("Can't keep the owner of {}", this->path_);
+      }
+      ::fchmod(this->fd_, st.st_mode & 07777);
+    }
+  } else {
+    LIEF_DEBUG("Can't create a temporary file for {}: write it in place", this->path_);
+    this->fd_ = ::open(this->path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  }
+#endif
+  if (this->fd_ < 0) {
+    throw LIEF::bad_file("Unable to open " + filename);
+  }
+  this->owned_ = true;
+  this->buffer_.reserve(BUFFER_SIZE);
+}
+
+
+file_ostream::file_ostream(int fd, bool endian_swap) :
+  fd_{fd},
+  endian_swap_{endian_swap}
+{
+  if (this->fd_ < 0) {
+    throw LIEF::bad_file("Invalid file descriptor");
+  }
+  this->buffer_.reserve(BUFFER_SIZE);
+}
+
+
+file_ostream::~file_ostream() {
+  if (not this->tmp_path_.empty()) {
+    // Not committed: discard the output
+    this->close();
+    std::remove(this->tmp_path_.c_str());
+    return;
+  }
+
+  if (this->fd_ < 0) {
+    // Already committed
+    return;
+  }
+
+  try {
+    this->flush();
+  } catch (const LIEF::exception& e) {
+    LIEF_ERR("{}", e.what());
+  }
+  this->close();
+}
+
+
+void file_ostream::commit() {
+  this->flush();
+  this->close();
+  if (this->tmp_path_.empty()) {
+    return;
+  }
+
+  const std::string tmp_path = std::move(this->tmp_path_);
+  this->tmp_path_.clear();
+  if (not replace_file(tmp_path, this->path_)) {
+    std::remove(tmp_path.c_str());
+    throw LIEF::bad_file("Unable to replace " + this->path_);
+  }
+}
+
+
+void file_ostream::close() {
+  if (not this->owned_ or this->fd_ < 0) {
+    return;
+  }
+#if defined(_WIN32)
+  ::_close(this->fd_);
+#elif defined(LIEF_FILE_POSIX)
+  ::close(this->fd_);
+#endif
+  this->fd_ = -1;
+}
+
+
+uint64_t file_ostream::tellp() const {
+  return this->pos_;
+}
+
+
+file_ostream& file_ostream::seekp(uint64_t offset) {
+  this->pos_  = offset;
+  this->size_ = std::max(this->size_, this->pos_);
+  return *this;
+}
+
+
+file_ostream& file_ostream::write(const uint8_t* data, size_t size) {
+  if (size == 0) {
+    return *this;
+  }
+
+  const bool contiguous = this->pos_ == this->buffer_offset_ + this->buffer_.size();
+  if (not contiguous or (this->buffer_.size() + size) > BUFFER_SIZE) {
+    this->flush_buffer();
+  }
+
+  if (size >= BUFFER_SIZE) {
+    this->write_at(this->pos_, data, size);
+  } else {
+    if (this->buffer_.empty()) {
+      this->buffer_offset_ = this->pos_;
+    }
+    this->buffer_.insert(std::end(this->buffer_), data, data + size);
+  }
+
+  this->pos_ += size;
+  this->size_ = std::max(this->size_, this->pos_);
+  return *this;
+}
+
+
+file_ostream& file_ostream::write(span<const uint8_t> data) {
+  return this->write(data.data(), data.size());
+}
+
+
+file_ostream& file_ostream::write(const std::vector<uint8_t>& data) {
+  return this->write(data.data(), data.size());
+}
+
+
+file_ostream& file_ostream::write(size_t count, uint8_t value) {
+  const std::vector<uint8_t> chunk(std::min(count, BUFFER_SIZE), value);
+  while (count > 0) {
+    const size_t size = std::min(count, chunk.size());
+    this->write(chunk.data(), size);
+    count -= size;
+  }
+  return *this;
+}
+
+
+file_ostream& file_ostream::copy_from(int fd, uint64_t offset, uint64_t size) {
+  if (size == 0) {
+    return *this;
+  }
+  // The pending writes must reach the file before the kernel copy
+  this->flush_buffer();
+
+  uint64_t done = this->copy_range(fd, offset, size);
+  if (done < size) {
+    LIEF_DEBUG("Copy the remaining 0x{:x} bytes with read/write", size - done);
+    std::vector<uint8_t> chunk(static_cast<size_t>(std::min<uint64_t>(size - done, 1_MB)));
+    while (done < size) {
+      const size_t count = static_cast<size_t>(std::min<uint64_t>(size - done, chunk.size()));
+      const int64_t nread = pread_some(fd, chunk.data(), count, offset + done);
+      if (nread <= 0) {
+        throw LIEF::bad_file("Can't read the input file at offset " + std::to_string(offset + done));
+      }
+      this->write_at(this->pos_ + done, chunk.data(), static_cast<size_t>(nread));
+      done += static_cast<uint64_t>(nread);
+    }
+  }
+
+  this->pos_ += size;
+  this->size_ = std::max(this->size_, this->pos_);
+  return *this;
+}
+
+
+uint64_t file_ostream::copy_range(int fd, uint64_t offset, uint64_t size) {
+  uint64_t done = 0;
+#if defined(LIEF_HAS_COPY_FILE_RANGE)
+  loff_t off_in  = static_cast<loff_t>(offset);
+  loff_t off_out = static_cast<loff_t>(this->pos_);
+  while (done < size) {
+    const ssize_t copied = ::copy_file_range(fd, &off_in, this->fd_, &off_out, size - done, 0);
+    if (copied < 0 and errno == EINTR) {
+      continue;
+    }
+    if (copied <= 0) {
+      // e.g. EXDEV on kernels older than 5.3: try with sendfile()
+      break;
+    }
+    done += static_cast<uint64_t>(copied);
+  }
+#endif
+
+#if defined(__linux__)
+  // sendfile() writes at the current offset of the output
+  if (done < size and ::lseek(this->fd_, static_cast<off_t>(this->pos_ + done), SEEK_SET) >= 0) {
+    off_t off_in = static_cast<off_t>(offset + done);
+    while (done < size) {
+      const ssize_t copied = ::sendfile(this->fd_, fd, &off_in, size - done);
+      if (copied < 0 and errno == EINTR) {
+        continue;
+      }
+      if (copied <= 0) {
+        break;
+      }
+      done += static_cast<uint64_t>(copied);
+    }
+  }
+#else
+  (void)fd;
+  (void)offset;
+#endif
+  return done;
+}
+
+
+file_ostream& file_ostream::flush() {
+  this->flush_buffer();
+  // The file ends with a hole if nothing was written after the last seekp()
+  if (not extend_file(this->fd_, this->size_)) {
+    throw LIEF::bad_file("Can't extend the output file to " + std::to_string(this->size_) + " bytes");
+  }
+  return *this;
+}
+
+
+void file_ostream::flush_buffer() {
+  if (this->buffer_.empty()) {
+    return;
+  }
+  this->write_at(this->buffer_offset_, this->buffer_.data(), this->buffer_.size());
+  this->buffer_.clear();
+}
+
+
+uint64_t file_ostream::size() const {
+  return this->size_;
+}
+
+
+void file_ostream::set_endian_swap(bool swap) {
+  this->endian_swap_ = swap;
+}
+
+
+void file_ostream::write_at(uint64_t offset, const uint8_t* data, size_t size) {
+  if (not pwrite_all(this->fd_, data, size, offset)) {
+    throw LIEF::bad_file("Can't write " + std::to_string(size) + " bytes in the output file");
+  }
+}
+
+}
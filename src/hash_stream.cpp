@@ -136,6 +136,37 @@ hashstream::~hashstream() {
 }
 
 
+multi_hashstream::multi_hashstream(const std::vector<hashstream::HASH>& types) {
+  this->streams_.reserve(types.size());
+  for (hashstream::HASH type : types) {
+    this->streams_.emplace_back(new hashstream{type});
+  }
+}
+
+multi_hashstream& multi_hashstream::write(const uint8_t* s, size_t n) {
+  for (std::unique_ptr<hashstream>& stream : this->streams_) {
+    stream->write(s, n);
+  }
+  return *this;
+}
+
+multi_hashstream& multi_hashstream::write(const std::vector<uint8_t>& s) {
+  return this->write(s.data(), s.size());
+}
+
+multi_hashstream& multi_hashstream::write_sized_int(uint64_t value, size_t size) {
+  return this->write(reinterpret_cast<const uint8_t*>(&value), size);
+}
+
+size_t multi_hashstream::size() const {
+  return this->streams_.size();
+}
+
+std::vector<uint8_t>& multi_hashstream::raw(size_t idx) {
+  return this->streams_.at(idx)->raw();
+}
+
+
 
 }
 
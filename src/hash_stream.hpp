@@ -74,6 +74,40 @@ class hashstream {
   std::unique_ptr<md_context_t> ctx_;
 };
 
+//! Feed the same data to several hash functions so that
+//! the data is traversed only once
+class multi_hashstream {
+  public:
+  multi_hashstream(const std::vector<hashstream::HASH>& types);
+
+  multi_hashstream& write(const uint8_t* s, size_t n);
+  multi_hashstream& write(const std::vector<uint8_t>& s);
+  multi_hashstream& write_sized_int(uint64_t value, size_t size);
+
+  template<class Integer, typename = typename std::enable_if<std::is_integral<Integer>::value>>
+  multi_hashstream& write(Integer integer) {
+    auto int_p = reinterpret_cast<const uint8_t*>(&integer);
+    return this->write(int_p, sizeof(Integer));
+  }
+
+  template<typename T, size_t size, typename = typename std::enable_if<std::is_integral<T>::value>>
+  multi_hashstream& write(const std::array<T, size>& t) {
+    for (T val : t) {
+      this->write<T>(val);
+    }
+    return *this;
+  }
+
+  //! Number of hash functions
+  size_t size() const;
+
+  //! Digest of the ``idx``-th hash function
+  std::vector<uint8_t>& raw(size_t idx);
+
+  private:
+  std::vector<std::unique_ptr<hashstream>> streams_;
+};
+
 
 }
 #endif
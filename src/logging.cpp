@@ -15,6 +15,7 @@
  */
 
 #include <map>
+#include <mutex>
 #include "LIEF/config.h"
 #include "LIEF/logging.hpp"
 #include "LIEF/platforms.hpp"
@@ -58,10 +59,12 @@ Logger::Logger() {
 }
 
 Logger& Logger::instance() {
-  if (instance_ == nullptr) {
+  // The logger can be first used concurrently (e.g. LIEF::parse_many)
+  static std::once_flag init;
+  std::call_once(init, [] () {
     instance_ = new Logger{};
     std::atexit(destroy);
-  }
+  });
   return *instance_;
 }
 
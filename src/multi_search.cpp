@@ -0,0 +1,278 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define LIEF_MULTISEARCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define LIEF_MULTISEARCH_SSE2
+#endif
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+#include "multi_search.hpp"
+
+namespace LIEF {
+
+inline uint32_t count_trailing_zeros(uint32_t value) {
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanForward(&index, value);
+  return index;
+#else
+  return __builtin_ctz(value);
+#endif
+}
+
+multisearch::multisearch(std::vector<std::vector<uint8_t>> needles) :
+  needles_{std::move(needles)}
+{
+  this->table_first_.fill(false);
+  this->table_second_.fill(false);
+
+  size_t min_len = std::numeric_limits<size_t>::max();
+  for (const std::vector<uint8_t>& needle : this->needles_) {
+    if (not needle.empty()) {
+      min_len = std::min(min_len, needle.size());
+    }
+  }
+
+  if (min_len == std::numeric_limits<size_t>::max()) {
+    // Only empty needles
+    return;
+  }
+  this->prefix_len_ = std::min<size_t>(min_len, sizeof(uint32_t));
+
+  // Distinct bytes found at each position of the prefixes
+  std::array<std::array<bool, 256>, sizeof(uint32_t)> seen;
+  for (std::array<bool, 256>& s : seen) {
+    s.fill(false);
+  }
+
+  for (size_t id = 0; id < this->needles_.size(); ++id) {
+    const std::vector<uint8_t>& needle = this->needles_[id];
+    if (needle.empty()) {
+      continue;
+    }
+    for (size_t i = 0; i < this->prefix_len_; ++i) {
+      seen[i][needle[i]] = true;
+    }
+    const uint32_t k = this->key(needle.data());
+    this->bloom_.set(multisearch::bloom_hash(k));
+    this->prefixes_[k].push_back(id);
+  }
+
+  // Select the two most discriminating positions: few distinct bytes
+  // and preferably not 0x00 or 0xFF as they are very common in binaries
+  std::vector<std::pair<size_t, size_t>> costs; // (cost, position)
+  for (size_t i = 0; i < this->prefix_len_; ++i) {
+    const size_t nb_bytes = std::count(std::begin(seen[i]), std::end(seen[i]), true);
+    size_t cost = nb_bytes;
+    if (seen[i][0x00]) {
+      cost += MAX_SIMD_BYTES;
+    }
+    if (seen[i][0xFF]) {
+      cost += MAX_SIMD_BYTES;
+    }
+    costs.emplace_back(cost, i);
+  }
+  std::sort(std::begin(costs), std::end(costs));
+
+  this->pos_first_ = costs[0].second;
+  for (size_t b = 0; b < 256; ++b) {
+    if (seen[this->pos_first_][b]) {
+      this->table_first_[b] = true;
+      this->bytes_first_.push_back(static_cast<uint8_t>(b));
+    }
+  }
+
+  if (costs.size() > 1) {
+    this->use_second_ = true;
+    this->pos_second_ = costs[1].second;
+    for (size_t b = 0; b < 256; ++b) {
+      if (seen[this->pos_second_][b]) {
+        this->table_second_[b] = true;
+        this->bytes_second_.push_back(static_cast<uint8_t>(b));
+      }
+    }
+  }
+}
+
+
+size_t multisearch::size() const {
+  return this->needles_.size();
+}
+
+
+const std::vector<uint8_t>& multisearch::needle(size_t id) const {
+  return this->needles_.at(id);
+}
+
+
+uint32_t multisearch::key(const uint8_t* ptr) const {
+  uint32_t value = 0;
+  std::memcpy(&value, ptr, this->prefix_len_);
+  return value;
+}
+
+
+size_t multisearch::bloom_hash(uint32_t key) {
+  // Fibonacci hashing on 16 bits
+  return static_cast<uint32_t>(key * 2654435761u) >> 16;
+}
+
+
+void multisearch::confirm(const uint8_t* data, size_t size, size_t pos, matches_t& matches) const {
+  const uint32_t k = this->key(data + pos);
+  if (not this->bloom_.test(multisearch::bloom_hash(k))) {
+    return;
+  }
+
+  auto it = this->prefixes_.find(k);
+  if (it == std::end(this->prefixes_)) {
+    return;
+  }
+
+  for (size_t id : it->second) {
+    const std::vector<uint8_t>& needle = this->needles_[id];
+    if (needle.size() > size - pos) {
+      continue;
+    }
+    if (std::memcmp(data + pos, needle.data(), needle.size()) == 0) {
+      matches[id].push_back(pos);
+    }
+  }
+}
+
+
+void multisearch::scan_scalar(const uint8_t* data, size_t size, size_t from, size_t to, matches_t& matches) const {
+  for (size_t pos = from; pos < to; ++pos) {
+    if (not this->table_first_[data[pos + this->pos_first_]]) {
+      continue;
+    }
+    if (this->use_second_ and not this->table_second_[data[pos + this->pos_second_]]) {
+      continue;
+    }
+    this->confirm(data, size, pos, matches);
+  }
+}
+
+
+size_t multisearch::scan_simd(const uint8_t* data, size_t size, matches_t& matches) const {
+#if defined(LIEF_MULTISEARCH_AVX2) || defined(LIEF_MULTISEARCH_SSE2)
+  if (this->bytes_first_.size() > MAX_SIMD_BYTES) {
+    return 0;
+  }
+
+  const bool use_second = this->use_second_ and this->bytes_second_.size() <= MAX_SIMD_BYTES;
+  const size_t last     = size - this->prefix_len_ + 1;
+  const size_t max_pos  = std::max(this->pos_first_, use_second ? this->pos_second_ : 0);
+
+#if defined(LIEF_MULTISEARCH_AVX2)
+  using vector_t = __m256i;
+  #define LIEF_LOAD(ptr)     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr))
+  #define LIEF_SET1(b)       _mm256_set1_epi8(static_cast<char>(b))
+  #define LIEF_CMPEQ(a, b)   _mm256_cmpeq_epi8(a, b)
+  #define LIEF_OR(a, b)      _mm256_or_si256(a, b)
+  #define LIEF_AND(a, b)     _mm256_and_si256(a, b)
+  #define LIEF_ZERO()        _mm256_setzero_si256()
+  #define LIEF_MOVEMASK(a)   static_cast<uint32_t>(_mm256_movemask_epi8(a))
+#else
+  using vector_t = __m128i;
+  #define LIEF_LOAD(ptr)     _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr))
+  #define LIEF_SET1(b)       _mm_set1_epi8(static_cast<char>(b))
+  #define LIEF_CMPEQ(a, b)   _mm_cmpeq_epi8(a, b)
+  #define LIEF_OR(a, b)      _mm_or_si128(a, b)
+  #define LIEF_AND(a, b)     _mm_and_si128(a, b)
+  #define LIEF_ZERO()        _mm_setzero_si128()
+  #define LIEF_MOVEMASK(a)   static_cast<uint32_t>(_mm_movemask_epi8(a))
+#endif
+  static constexpr size_t width = sizeof(vector_t);
+
+  vector_t first[MAX_SIMD_BYTES];
+  vector_t second[MAX_SIMD_BYTES];
+  for (size_t i = 0; i < this->bytes_first_.size(); ++i) {
+    first[i] = LIEF_SET1(this->bytes_first_[i]);
+  }
+  if (use_second) {
+    for (size_t i = 0; i < this->bytes_second_.size(); ++i) {
+      second[i] = LIEF_SET1(this->bytes_second_[i]);
+    }
+  }
+
+  size_t pos = 0;
+  for (; pos + max_pos + width <= size; pos += width) {
+    const vector_t block_first = LIEF_LOAD(data + pos + this->pos_first_);
+    vector_t eq = LIEF_ZERO();
+    for (size_t i = 0; i < this->bytes_first_.size(); ++i) {
+      eq = LIEF_OR(eq, LIEF_CMPEQ(block_first, first[i]));
+    }
+
+    if (use_second) {
+      const vector_t block_second = LIEF_LOAD(data + pos + this->pos_second_);
+      vector_t eq_second = LIEF_ZERO();
+      for (size_t i = 0; i < this->bytes_second_.size(); ++i) {
+        eq_second = LIEF_OR(eq_second, LIEF_CMPEQ(block_second, second[i]));
+      }
+      eq = LIEF_AND(eq, eq_second);
+    }
+
+    uint32_t mask = LIEF_MOVEMASK(eq);
+    while (mask != 0) {
+      const size_t candidate = pos + count_trailing_zeros(mask);
+      mask &= mask - 1;
+      if (candidate < last) {
+        this->confirm(data, size, candidate, matches);
+      }
+    }
+  }
+
+#undef LIEF_LOAD
+#undef LIEF_SET1
+#undef LIEF_CMPEQ
+#undef LIEF_OR
+#undef LIEF_AND
+#undef LIEF_ZERO
+#undef LIEF_MOVEMASK
+  return std::min(pos, last);
+#else
+  (void)data;
+  (void)size;
+  (void)matches;
+  return 0;
+#endif
+}
+
+
+multisearch::matches_t multisearch::search_all(span<const uint8_t> data) const {
+  matches_t matches(this->needles_.size());
+  if (this->prefix_len_ == 0 or data.size() < this->prefix_len_) {
+    return matches;
+  }
+
+  const size_t last = data.size() - this->prefix_len_ + 1;
+  const size_t from = this->scan_simd(data.data(), data.size(), matches);
+  this->scan_scalar(data.data(), data.size(), from, last, matches);
+  return matches;
+}
+
+}
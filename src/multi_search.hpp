@@ -0,0 +1,87 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_MULTI_SEARCH_H_
+#define LIEF_MULTI_SEARCH_H_
+#include <vector>
+#include <array>
+#include <bitset>
+#include <unordered_map>
+
+#include "LIEF/types.hpp"
+#include "LIEF/span.hpp"
+
+namespace LIEF {
+
+//! Search several patterns (needles) in a single pass over a buffer.
+//!
+//! The candidate positions are selected with a prefilter on one or two
+//! bytes of the needles' prefixes (vectorized with SSE2/AVX2 when available),
+//! then checked with a Bloom filter and a hash table on the prefixes and
+//! finally confirmed with a ``memcmp``.
+//!
+//! The object is immutable once built, so that it can be shared between threads.
+class multisearch {
+  public:
+  //! One vector of offsets per needle (in the order of the needles)
+  using matches_t = std::vector<std::vector<size_t>>;
+
+  //! Maximum number of distinct bytes at a given prefix position
+  //! for the vectorized prefilter
+  static constexpr size_t MAX_SIMD_BYTES = 8;
+
+  multisearch(std::vector<std::vector<uint8_t>> needles);
+
+  //! Number of needles
+  size_t size() const;
+
+  //! Return the needle associated with the given id
+  const std::vector<uint8_t>& needle(size_t id) const;
+
+  //! Return the offsets of **all** the (possibly overlapping) occurrences
+  //! of the needles in ``data``.
+  //!
+  //! Offsets are sorted and empty needles never match.
+  matches_t search_all(span<const uint8_t> data) const;
+
+  private:
+  uint32_t key(const uint8_t* ptr) const;
+  static size_t bloom_hash(uint32_t key);
+  void confirm(const uint8_t* data, size_t size, size_t pos, matches_t& matches) const;
+
+  void scan_scalar(const uint8_t* data, size_t size, size_t from, size_t to, matches_t& matches) const;
+  size_t scan_simd(const uint8_t* data, size_t size, matches_t& matches) const;
+
+  std::vector<std::vector<uint8_t>> needles_;
+
+  // Length of the prefix used by the prefilter (1 to 4 bytes)
+  size_t prefix_len_ = 0;
+
+  // Prefix positions (and the bytes found at these positions) used by the prefilter
+  size_t pos_first_  = 0;
+  size_t pos_second_ = 0;
+  bool   use_second_ = false;
+  std::vector<uint8_t> bytes_first_;
+  std::vector<uint8_t> bytes_second_;
+  std::array<bool, 256> table_first_;
+  std::array<bool, 256> table_second_;
+
+  std::bitset<1 << 16> bloom_;
+  std::unordered_map<uint32_t, std::vector<size_t>> prefixes_;
+};
+
+}
+
+#endif
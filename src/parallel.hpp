@@ -0,0 +1,93 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LIEF_PARALLEL_H_
+#define LIEF_PARALLEL_H_
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LIEF {
+
+//! Call ``func(i)`` for each ``i`` in ``[0, count)`` with ``nb_threads`` threads
+//! (0: number of hardware threads).
+//!
+//! The workers pick the next index when they are done so that a few long tasks don't
+//! stall a thread while the others are idle. If a call throws, the remaining indexes
+//! are skipped and the first exception is rethrown once all the workers are joined.
+//! If the threads can't be created, the calls are done by the current thread.
+template<class F>
+void parallel_for(size_t count, size_t nb_threads, F&& func) {
+  if (nb_threads == 0) {
+    nb_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  nb_threads = std::min(nb_threads, count);
+
+  if (nb_threads <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  std::atomic<bool>   stop{false};
+  std::exception_ptr  error;
+  std::mutex          error_mutex;
+
+  auto&& worker = [&] () {
+    while (not stop) {
+      const size_t idx = next++;
+      if (idx >= count) {
+        return;
+      }
+      try {
+        func(idx);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (not error) {
+          error = std::current_exception();
+        }
+        stop = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  try {
+    threads.reserve(nb_threads - 1);
+    for (size_t i = 1; i < nb_threads; ++i) {
+      threads.emplace_back(worker);
+    }
+  } catch (const std::exception&) {
+    // Can't start more threads (std::system_error, std::bad_alloc):
+    // the indexes are processed by the ones already started and the current thread
+  }
+  worker();
+
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}
+#endif
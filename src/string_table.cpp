@@ -0,0 +1,253 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+
+#include "LIEF/string_table.hpp"
+#include "LIEF/iostream.hpp"
+
+namespace LIEF {
+
+// Ranges smaller than this threshold are sorted with an insertion sort
+static constexpr size_t INSERTION_SORT_THRESHOLD = 16;
+
+inline uint64_t fnv1a(const char* str, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325llu;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 0x100000001b3llu;
+  }
+  return hash;
+}
+
+constexpr size_t StringTable::npos;
+
+StringTable::StringTable() = default;
+StringTable::~StringTable() = default;
+
+void StringTable::reserve(size_t nb_strings, size_t nb_bytes) {
+  this->entries_.reserve(nb_strings);
+  this->arena_.reserve(nb_bytes);
+}
+
+void StringTable::add(const std::string& str) {
+  this->add(str.data(), str.size());
+}
+
+void StringTable::add(const char* str, size_t size) {
+  entry_t entry;
+  entry.start  = this->arena_.size();
+  entry.size   = static_cast<uint32_t>(size);
+  entry.merged = false;
+  entry.offset = 0;
+  this->arena_.insert(std::end(this->arena_), str, str + size);
+  this->entries_.push_back(entry);
+  this->finalized_ = false;
+}
+
+int StringTable::char_at(const entry_t& entry, size_t pos) const {
+  if (pos >= entry.size) {
+    return -1;
+  }
+  return static_cast<uint8_t>(this->arena_[entry.start + entry.size - pos - 1]);
+}
+
+bool StringTable::is_suffix(const entry_t& suffix, const entry_t& str) const {
+  if (suffix.size > str.size) {
+    return false;
+  }
+  const char* end = this->arena_.data() + str.start + str.size;
+  return std::memcmp(end - suffix.size, this->arena_.data() + suffix.start, suffix.size) == 0;
+}
+
+void StringTable::sort() {
+  // Three-way radix quicksort on the reversed strings, in *decreasing* order
+  // such as "barfoo" < "xfoo" < "foo" (a suffix is after the strings that end with it).
+  // Characters past the beginning of a string are read as -1.
+  struct range_t {
+    size_t begin;
+    size_t end;
+    size_t pos;
+  };
+
+  std::vector<range_t> stack;
+  stack.push_back({0, this->entries_.size(), 0});
+
+  while (not stack.empty()) {
+    const range_t range = stack.back();
+    stack.pop_back();
+
+    const size_t nb_elements = range.end - range.begin;
+    if (nb_elements <= 1) {
+      continue;
+    }
+
+    if (nb_elements < INSERTION_SORT_THRESHOLD) {
+      // The strings of the range share their last ``pos`` characters
+      const auto tail_greater = [this, &range] (const entry_t& lhs, const entry_t& rhs) {
+        for (size_t pos = range.pos;; ++pos) {
+          const int lhs_c = this->char_at(lhs, pos);
+          const int rhs_c = this->char_at(rhs, pos);
+          if (lhs_c != rhs_c) {
+            return lhs_c > rhs_c;
+          }
+          if (lhs_c == -1) {
+            return false;
+          }
+        }
+      };
+      for (size_t i = range.begin + 1; i < range.end; ++i) {
+        for (size_t j = i; j > range.begin and tail_greater(this->entries_[j], this->entries_[j - 1]); --j) {
+          std::swap(this->entries_[j], this->entries_[j - 1]);
+        }
+      }
+      continue;
+    }
+
+    // Middle element as pivot (the symbols are often already sorted)
+    std::swap(this->entries_[range.begin], this->entries_[range.begin + nb_elements / 2]);
+    const int pivot = this->char_at(this->entries_[range.begin], range.pos);
+
+    // [begin, i) > pivot, [i, j) == pivot, [j, end) < pivot
+    size_t i = range.begin;
+    size_t j = range.end;
+    for (size_t k = range.begin + 1; k < j;) {
+      const int c = this->char_at(this->entries_[k], range.pos);
+      if (c > pivot) {
+        std::swap(this->entries_[i++], this->entries_[k++]);
+      } else if (c < pivot) {
+        std::swap(this->entries_[--j], this->entries_[k]);
+      } else {
+        ++k;
+      }
+    }
+
+    stack.push_back({range.begin, i, range.pos});
+    stack.push_back({j, range.end, range.pos});
+    // If the pivot is -1, the strings of [i, j) are equal
+    if (pivot != -1) {
+      stack.push_back({i, j, range.pos + 1});
+    }
+  }
+}
+
+void StringTable::finalize(size_t base) {
+  this->sort();
+
+  size_t offset = base;
+  const entry_t* previous = nullptr;
+  for (entry_t& entry : this->entries_) {
+    if (entry.size == 0) {
+      // Points to the leading null byte of the table
+      entry.merged = true;
+      entry.offset = 0;
+      continue;
+    }
+
+    if (previous != nullptr and this->is_suffix(entry, *previous)) {
+      entry.merged = true;
+      entry.offset = previous->offset + previous->size - entry.size;
+      continue;
+    }
+
+    entry.merged = false;
+    entry.offset = offset;
+    offset += entry.size + 1;
+    previous = &entry;
+  }
+
+  this->size_      = offset - base;
+  this->build_index();
+  this->finalized_ = true;
+}
+
+void StringTable::build_index() {
+  size_t capacity = 16;
+  while (capacity < 2 * this->entries_.size()) {
+    capacity <<= 1;
+  }
+  const size_t mask = capacity - 1;
+
+  this->index_.assign(capacity, 0);
+  this->nb_strings_ = 0;
+
+  for (size_t i = 0; i < this->entries_.size(); ++i) {
+    const entry_t& entry = this->entries_[i];
+    if (entry.size == 0) {
+      continue;
+    }
+    const char* str = this->arena_.data() + entry.start;
+    for (size_t slot = fnv1a(str, entry.size) & mask;; slot = (slot + 1) & mask) {
+      const uint32_t idx = this->index_[slot];
+      if (idx == 0) {
+        this->index_[slot] = static_cast<uint32_t>(i + 1);
+        ++this->nb_strings_;
+        break;
+      }
+      const entry_t& other = this->entries_[idx - 1];
+      if (other.size == entry.size and std::memcmp(this->arena_.data() + other.start, str, entry.size) == 0) {
+        // Duplicate: same offset
+        break;
+      }
+    }
+  }
+}
+
+size_t StringTable::size() const {
+  return this->size_;
+}
+
+size_t StringTable::nb_strings() const {
+  return this->nb_strings_;
+}
+
+size_t StringTable::offset(const std::string& str) const {
+  return this->offset(str.data(), str.size());
+}
+
+size_t StringTable::offset(const char* str, size_t size) const {
+  if (size == 0) {
+    return 0;
+  }
+
+  if (not this->finalized_) {
+    return npos;
+  }
+
+  const size_t mask = this->index_.size() - 1;
+  for (size_t slot = fnv1a(str, size) & mask;; slot = (slot + 1) & mask) {
+    const uint32_t idx = this->index_[slot];
+    if (idx == 0) {
+      return npos;
+    }
+    const entry_t& entry = this->entries_[idx - 1];
+    if (entry.size == size and std::memcmp(this->arena_.data() + entry.start, str, size) == 0) {
+      return entry.offset;
+    }
+  }
+}
+
+void StringTable::write(vector_iostream& os) const {
+  for (const entry_t& entry : this->entries_) {
+    if (entry.merged) {
+      continue;
+    }
+    os.write(reinterpret_cast<const uint8_t*>(this->arena_.data() + entry.start), entry.size);
+    os.put(0);
+  }
+}
+
+}
@@ -15,6 +15,7 @@
  */
 #include <functional>
 #include <numeric>
+#include <array>
 
 #include "mbedtls/sha256.h"
 
@@ -52,34 +53,39 @@
 namespace LIEF {
 
 size_t hash(const Object& v) {
+  // Only the hasher of the object's format can produce a non-null value:
+  // the object is traversed once with this hasher and the other formats are
+  // combined with 0 such as the result is the same as combining all the hashers.
+  const Visitor::FORMAT format = Visitor::format_of(v);
+
   size_t value = 0;
 
 #if defined(LIEF_PE_SUPPORT)
-  value = Hash::combine(value, Hash::hash<PE::Hash>(v));
+  value = Hash::combine(value, format == Visitor::FORMAT::PE ? Hash::hash<PE::Hash>(v) : 0);
 #endif
 
 #if defined(LIEF_ELF_SUPPORT)
-  value = Hash::combine(value, Hash::hash<ELF::Hash>(v));
+  value = Hash::combine(value, format == Visitor::FORMAT::ELF ? Hash::hash<ELF::Hash>(v) : 0);
 #endif
 
 #if defined(LIEF_MACHO_SUPPORT)
-  value = Hash::combine(value, Hash::hash<MachO::Hash>(v));
+  value = Hash::combine(value, format == Visitor::FORMAT::MACHO ? Hash::hash<MachO::Hash>(v) : 0);
 #endif
 
 #if defined(LIEF_OAT_SUPPORT)
-  value = Hash::combine(value, Hash::hash<OAT::Hash>(v));
+  value = Hash::combine(value, format == Visitor::FORMAT::OAT ? Hash::hash<OAT::Hash>(v) : 0);
 #endif
 
 #if defined(LIEF_ART_SUPPORT)
-  value = Hash::combine(value, Hash::hash<ART::Hash>(v));
+  value = Hash::combine(value, format == Visitor::FORMAT::ART ? Hash::hash<ART::Hash>(v) : 0);
 #endif
 
 #if defined(LIEF_DEX_SUPPORT)
-  value = Hash::combine(value, Hash::hash<DEX::Hash>(v));
+  value = Hash::combine(value, format == Visitor::FORMAT::DEX ? Hash::hash<DEX::Hash>(v) : 0);
 #endif
 
 #if defined(LIEF_VDEX_SUPPORT)
-  value = Hash::combine(value, Hash::hash<VDEX::Hash>(v));
+  value = Hash::combine(value, format == Visitor::FORMAT::VDEX ? Hash::hash<VDEX::Hash>(v) : 0);
 #endif
 
   return value;
@@ -129,6 +135,11 @@ Hash& Hash::process(const std::vector<uint8_t>& raw) {
   return *this;
 }
 
+Hash& Hash::process_digest(size_t digest) {
+  this->value_ = combine(this->value_, digest);
+  return *this;
+}
+
 size_t Hash::value() const {
   return this->value_;
 }
@@ -137,8 +148,18 @@ size_t Hash::value() const {
 // Static methods
 // ==============
 size_t Hash::hash(const std::vector<uint8_t>& raw) {
-  std::vector<uint8_t> sha256(32, 0);
-  mbedtls_sha256(raw.data(), raw.size(), sha256.data(), 0);
+  return Hash::hash(raw.data(), raw.size());
+}
+
+
+size_t Hash::hash(span<const uint8_t> raw) {
+  return Hash::hash(raw.data(), raw.size());
+}
+
+
+size_t Hash::hash(const void* raw, size_t size) {
+  std::array<uint8_t, 32> sha256;
+  mbedtls_sha256(reinterpret_cast<const uint8_t*>(raw), size, sha256.data(), 0);
 
   return std::accumulate(
      std::begin(sha256),
@@ -149,10 +170,21 @@ size_t Hash::hash(const std::vector<uint8_t>& raw) {
      });
 }
 
+// DigestCache
+// ===========
+DigestCache::DigestCache() = default;
 
-size_t Hash::hash(const void* raw, size_t size) {
-  const uint8_t* start = reinterpret_cast<const uint8_t*>(raw);
-  return Hash::hash(std::vector<uint8_t>{start, start + size});
+DigestCache::DigestCache(const DigestCache&) :
+  DigestCache{}
+{}
+
+DigestCache& DigestCache::operator=(const DigestCache&) {
+  this->clear();
+  return *this;
+}
+
+void DigestCache::clear() {
+  this->cached_ = false;
 }
 
 }
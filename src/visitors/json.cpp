@@ -14,19 +14,23 @@
  * limitations under the License.
  */
 #include "LIEF/Abstract.hpp"
+#include "LIEF/exception.hpp"
 #include "LIEF/visitors/json.hpp"
 #include "LIEF/Abstract/EnumToString.hpp"
 
 #if defined(LIEF_PE_SUPPORT)
 #include "LIEF/PE/json.hpp"
+#include "LIEF/PE/Binary.hpp"
 #endif
 
 #if defined(LIEF_ELF_SUPPORT)
 #include "LIEF/ELF/json.hpp"
+#include "LIEF/ELF/Binary.hpp"
 #endif
 
 #if defined(LIEF_MACHO_SUPPORT)
 #include "LIEF/MachO/json.hpp"
+#include "LIEF/MachO/Binary.hpp"
 #endif
 
 #if defined(LIEF_OAT_SUPPORT)
@@ -125,6 +129,228 @@ std::string to_json_str(const Object& v) {
   return to_json(v).dump();
 }
 
+void to_json(const Object& v, std::ostream& os, JsonStream::FORMAT format) {
+  JsonStream stream{os, format};
+
+  switch (Visitor::format_of(v)) {
+#if defined(LIEF_PE_SUPPORT)
+    case Visitor::FORMAT::PE:
+      {
+        if (const auto* binary = dynamic_cast<const PE::Binary*>(&v)) {
+          PE::JsonVisitor::members(*binary).write(stream);
+          return;
+        }
+        break;
+      }
+#endif
+
+#if defined(LIEF_ELF_SUPPORT)
+    case Visitor::FORMAT::ELF:
+      {
+        if (const auto* binary = dynamic_cast<const ELF::Binary*>(&v)) {
+          ELF::JsonVisitor::members(*binary).write(stream);
+          return;
+        }
+        break;
+      }
+#endif
+
+#if defined(LIEF_MACHO_SUPPORT)
+    case Visitor::FORMAT::MACHO:
+      {
+        if (const auto* binary = dynamic_cast<const MachO::Binary*>(&v)) {
+          MachO::JsonVisitor::members(*binary).write(stream);
+          return;
+        }
+        break;
+      }
+#endif
+
+    default:
+      {
+        break;
+      }
+  }
+
+  // The other objects are small enough to go through the json tree
+  stream.value(to_json(v));
+}
+
+// JsonStream
+// ==========
+JsonStream::JsonStream(std::ostream& os, FORMAT format) :
+  os_{os},
+  format_{format}
+{}
+
+JsonStream::FORMAT JsonStream::format() const {
+  return this->format_;
+}
+
+void JsonStream::separator() {
+  if (this->format_ != FORMAT::JSON) {
+    return;
+  }
+
+  if (this->after_key_) {
+    this->after_key_ = false;
+    return;
+  }
+
+  if (not this->first_.empty()) {
+    if (not this->first_.back()) {
+      this->os_.put(',');
+    }
+    this->first_.back() = false;
+  }
+}
+
+void JsonStream::write(const json& node) {
+  if (this->format_ == FORMAT::CBOR) {
+    json::to_cbor(node, this->os_);
+    return;
+  }
+  const std::string& raw = node.dump();
+  this->os_.write(raw.data(), raw.size());
+}
+
+JsonStream& JsonStream::begin_object() {
+  if (this->format_ == FORMAT::NDJSON and not this->first_.empty()) {
+    throw not_supported("NDJSON: only the top-level object can be opened");
+  }
+  this->separator();
+  if (this->format_ == FORMAT::JSON) {
+    this->os_.put('{');
+  } else if (this->format_ == FORMAT::CBOR) {
+    this->os_.put(static_cast<char>(0xBF));
+  }
+  this->first_.push_back(true);
+  return *this;
+}
+
+JsonStream& JsonStream::end_object() {
+  this->first_.pop_back();
+  if (this->format_ == FORMAT::JSON) {
+    this->os_.put('}');
+  } else if (this->format_ == FORMAT::CBOR) {
+    this->os_.put(static_cast<char>(0xFF));
+  }
+  return *this;
+}
+
+JsonStream& JsonStream::begin_array() {
+  if (this->format_ == FORMAT::NDJSON and this->first_.size() != 1) {
+    throw not_supported("NDJSON: only the members of the top-level object can be arrays");
+  }
+  this->separator();
+  if (this->format_ == FORMAT::JSON) {
+    this->os_.put('[');
+  } else if (this->format_ == FORMAT::CBOR) {
+    this->os_.put(static_cast<char>(0x9F));
+  } else {
+    // NDJSON: {"key": []} announces the array such as the
+    // key is also written when the array is empty
+    this->value(json::array());
+  }
+  this->first_.push_back(true);
+  return *this;
+}
+
+JsonStream& JsonStream::end_array() {
+  this->first_.pop_back();
+  if (this->format_ == FORMAT::JSON) {
+    this->os_.put(']');
+  } else if (this->format_ == FORMAT::CBOR) {
+    this->os_.put(static_cast<char>(0xFF));
+  }
+  return *this;
+}
+
+JsonStream& JsonStream::key(const std::string& key) {
+  if (this->format_ == FORMAT::NDJSON) {
+    this->ndjson_key_ = key;
+    return *this;
+  }
+  this->separator();
+  this->write(key);
+  if (this->format_ == FORMAT::JSON) {
+    this->os_.put(':');
+  }
+  this->after_key_ = true;
+  return *this;
+}
+
+JsonStream& JsonStream::value(const json& node) {
+  if (this->format_ != FORMAT::NDJSON) {
+    this->separator();
+    this->write(node);
+    return *this;
+  }
+
+  // NDJSON: the values nested in the top-level object are
+  // written as {"key": value}
+  if (this->first_.empty()) {
+    this->write(node);
+  } else {
+    this->os_.put('{');
+    this->write(this->ndjson_key_);
+    this->os_.put(':');
+    this->write(node);
+    this->os_.put('}');
+  }
+  this->os_.put('\n');
+  return *this;
+}
+
+// JsonMembers
+// ===========
+JsonMembers& JsonMembers::set(const std::string& key, json value) {
+  member_t& member = this->members_[key];
+  member.value = std::move(value);
+  member.array = nullptr;
+  return *this;
+}
+
+JsonMembers& JsonMembers::set_array(const std::string& key, array_t array) {
+  member_t& member = this->members_[key];
+  member.value = nullptr;
+  member.array = std::move(array);
+  return *this;
+}
+
+void JsonMembers::update(json& node) const {
+  for (const auto& p : this->members_) {
+    const member_t& member = p.second;
+    if (not member.array) {
+      node[p.first] = member.value;
+      continue;
+    }
+    json elements = json::array();
+    member.array([&elements] (const json& element) {
+      elements.push_back(element);
+    });
+    node[p.first] = std::move(elements);
+  }
+}
+
+void JsonMembers::write(JsonStream& stream) const {
+  stream.begin_object();
+  for (const auto& p : this->members_) {
+    const member_t& member = p.second;
+    stream.key(p.first);
+    if (not member.array) {
+      stream.value(member.value);
+      continue;
+    }
+    stream.begin_array();
+    member.array([&stream] (const json& element) {
+      stream.value(element);
+    });
+    stream.end_array();
+  }
+  stream.end_object();
+}
+
 JsonVisitor::JsonVisitor() :
   node_{}
 {}
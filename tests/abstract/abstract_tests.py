@@ -7,7 +7,10 @@ import subprocess
 import stat
 import os
 import logging
+import json
+import math
 import random
+import struct
 
 from subprocess import Popen
 
@@ -112,6 +115,560 @@ class TestAbstract(TestCase):
     #    self.assertTrue(isinstance(binary, lief.PE.Binary))
 
 
+class TestContentView(TestCase):
+    """
+    Non-copying views on the content of the sections
+    """
+
+    SAMPLES = [
+        'ELF/ELF64_x86-64_binary_ls.bin',
+        'ELF/ELF64_x86-64_library_libadd.so',
+        'MachO/MachO64_x86-64_binary_id.bin',
+        'PE/PE64_x86-64_binary_ConsoleApplication1.exe',
+    ]
+
+    def test_views(self):
+        for sample in TestContentView.SAMPLES:
+            binary = lief.parse(get_sample(sample))
+            nb_views = 0
+            for section in binary.sections:
+                view = section.content_view
+                self.assertTrue(view.readonly, section.name)
+                # An empty view means that the content can't be borrowed
+                if len(view) > 0:
+                    nb_views += 1
+                    self.assertEqual(bytes(view), bytes(section.content), "{}: {}".format(sample, section.name))
+            self.assertGreater(nb_views, 0, sample)
+
+    def test_modified(self):
+        for sample in TestContentView.SAMPLES:
+            binary  = lief.parse(get_sample(sample))
+            section = next(s for s in binary.sections if len(s.content_view) >= 0x10)
+            content = [0xcc] * len(section.content_view)
+
+            # The views are taken again after a modification
+            section.content = content
+            self.assertEqual(bytes(section.content), bytes(content), sample)
+            self.assertEqual(bytes(section.content_view), bytes(content), sample)
+
+
+class TestHash(TestCase):
+    """
+    lief.hash() and the cached digests of the contents
+    """
+
+    SAMPLES = [
+        'ELF/ELF64_x86-64_binary_ls.bin',
+        'MachO/MachO64_x86-64_binary_id.bin',
+        'PE/PE64_x86-64_binary_ConsoleApplication1.exe',
+    ]
+
+    def test_stable(self):
+        hashes = set()
+        for sample in TestHash.SAMPLES:
+            path = get_sample(sample)
+            with open(path, 'rb') as f:
+                raw = f.read()
+            value = lief.hash(lief.parse(path))
+            self.assertEqual(lief.hash(lief.parse(path)), value, sample)
+            self.assertEqual(lief.hash(lief.parse(raw)), value, sample)
+            self.assertEqual([lief.hash(s) for s in lief.parse(raw).sections],
+                             [lief.hash(s) for s in lief.parse(path).sections], sample)
+            hashes.add(value)
+        self.assertEqual(len(hashes), len(TestHash.SAMPLES))
+
+    def test_modified_section(self):
+        for sample in TestHash.SAMPLES:
+            binary  = lief.parse(get_sample(sample))
+            section = next(s for s in binary.sections if len(s.content) >= 0x10)
+            content = list(section.content)
+            section_hash = lief.hash(section)
+            binary_hash  = lief.hash(binary)
+
+            # The digest of the content is computed again after a modification
+            section.content = [0xcc] * len(content)
+            self.assertNotEqual(lief.hash(section), section_hash, sample)
+            self.assertNotEqual(lief.hash(binary), binary_hash, sample)
+
+            section.content = content
+            self.assertEqual(lief.hash(section), section_hash, sample)
+            self.assertEqual(lief.hash(binary), binary_hash, sample)
+
+    def test_modified_segment(self):
+        # The content of the sections is owned by the ELF data handler or by the Mach-O segment
+        for sample in ('ELF/ELF64_x86-64_binary_ls.bin', 'MachO/MachO64_x86-64_binary_id.bin'):
+            binary  = lief.parse(get_sample(sample))
+            section = next(s for s in binary.sections if s.name in (".text", "__text"))
+            segment = binary.segment_from_virtual_address(section.virtual_address)
+            section_hash = lief.hash(section)
+
+            content = list(segment.content)
+            start   = section.offset - segment.file_offset
+            content[start:start + 0x10] = [0xcc] * 0x10
+            segment.content = content
+            self.assertNotEqual(lief.hash(section), section_hash, sample)
+            self.assertEqual(bytes(section.content)[:0x10], b"\xcc" * 0x10, sample)
+
+
+def naive_search_all(data, needle):
+    """
+    Offsets of all the (overlapping) occurrences of ``needle`` in ``data``
+    """
+    if len(needle) == 0:
+        return []
+    return [i for i in range(len(data) - len(needle) + 1) if data[i:i + len(needle)] == needle]
+
+class TestSearch(TestCase):
+    ALPHABET = [0x00, 0xFF, 0x41, 0x42]
+
+    def setUp(self):
+        self.logger = logging.getLogger(__name__)
+        self.rng = random.Random(1337)
+
+    def random_bytes(self, size, alphabet=None):
+        if alphabet is None:
+            return [self.rng.randrange(256) for _ in range(size)]
+        return [self.rng.choice(alphabet) for _ in range(size)]
+
+    def check(self, data, needles):
+        section = lief.ELF.Section(".test")
+        section.content = data
+        matches = section.search_all(needles)
+        self.assertEqual(len(matches), len(needles))
+        for needle, offsets in zip(needles, matches):
+            self.assertEqual(offsets, naive_search_all(data, needle), needle)
+
+    def test_block_boundary(self):
+        # The vectorized prefilter scans blocks of 16 (SSE2) or 32 (AVX2) bytes
+        needle = [0x41, 0x42, 0x43, 0x44, 0x45]
+        for size in (16, 32, 64, 128):
+            for pos in range(size - 8, size + 8):
+                data = [0] * 160
+                data[pos:pos + len(needle)] = needle
+                self.check(data, [needle, needle[:1], needle[:2], needle[1:4]])
+
+    def test_tail(self):
+        # The last bytes (less than a block) are scanned by the scalar loop
+        needles = [[0x41], [0x41, 0x42], [0x42, 0x41, 0x42], [0xFF, 0x41, 0x42, 0x41]]
+        for size in list(range(0, 80)) + [255, 256, 257]:
+            data = self.random_bytes(size, TestSearch.ALPHABET)
+            self.check(data, needles)
+            # Occurrence in the very last bytes
+            if size >= 4:
+                self.check(data, [data[-4:], data[-3:], data[-1:]])
+
+    def test_mixed_lengths(self):
+        data = self.random_bytes(4096, TestSearch.ALPHABET)
+        for _ in range(20):
+            needles = [self.random_bytes(self.rng.randint(1, 9), TestSearch.ALPHABET)
+                       for _ in range(self.rng.randint(1, 12))]
+            self.check(data, needles)
+
+        # Duplicated needles and needles that are prefixes of each other
+        self.check(data, [[0x41, 0x42], [0x41], [0x41, 0x42], [0x41, 0x42, 0x00, 0xFF]])
+
+        # More distinct bytes than the vectorized prefilter supports
+        data = self.random_bytes(4096)
+        needles = [data[i:i + self.rng.randint(1, 6)] for i in self.rng.sample(range(4000), 40)]
+        self.check(data, needles)
+
+    def test_empty_needles(self):
+        data = self.random_bytes(300, TestSearch.ALPHABET)
+        self.check(data, [[]])
+        self.check(data, [[], [0x41], [], [0x42, 0x41]])
+        self.check([], [[], [0x41]])
+        self.check(data, [])
+
+        # A needle longer than the data
+        self.check(data[:3], [data[:4] + [0x41], data[:3]])
+
+def naive_histogram(data):
+    histogram = [0] * 256
+    for byte in data:
+        histogram[byte] += 1
+    return histogram
+
+def naive_entropy(data):
+    if len(data) == 0:
+        return 0.0
+    entropy = 0.0
+    for count in naive_histogram(data):
+        if count > 0:
+            freq = count / len(data)
+            entropy -= freq * math.log2(freq)
+    return entropy
+
+class TestEntropy(TestCase):
+
+    def setUp(self):
+        self.logger = logging.getLogger(__name__)
+        self.rng = random.Random(1337)
+
+    def make_section(self, data):
+        section = lief.ELF.Section(".test")
+        section.content = data
+        return section
+
+    def random_bytes(self, size):
+        # Skewed distribution with long runs such as the counters are not uniform
+        data = []
+        while len(data) < size:
+            byte = self.rng.randrange(256) if self.rng.random() < 0.2 else self.rng.randrange(4)
+            data += [byte] * self.rng.randint(1, 16)
+        return data[:size]
+
+    def test_histogram_threads(self):
+        # Large enough to be split between several threads (1MB per thread)
+        # and not a multiple of the chunk size
+        data    = self.random_bytes((3 << 20) + 12345)
+        section = self.make_section(data)
+
+        single = section.histogram(1)
+        self.assertEqual(single, naive_histogram(data))
+        for nb_threads in (2, 3, 4, 0):
+            self.assertEqual(section.histogram(nb_threads), single, nb_threads)
+
+        self.assertAlmostEqual(section.entropy, naive_entropy(data), places=9)
+
+    def test_histogram_small(self):
+        for size in (0, 1, 7, 8, 9, 63, 64, 65, 1000):
+            data    = self.random_bytes(size)
+            section = self.make_section(data)
+            self.assertEqual(section.histogram(), naive_histogram(data))
+            self.assertEqual(section.histogram(4), naive_histogram(data))
+
+    def check_curve(self, data, block_size, step):
+        curve = self.make_section(data).entropy_curve(block_size, step)
+        if len(data) <= block_size:
+            self.assertEqual(len(curve), 1)
+            self.assertAlmostEqual(curve[0], naive_entropy(data), places=9)
+            return
+
+        stride = block_size if step == 0 else step
+        windows = [data[i:i + block_size] for i in range(0, len(data) - block_size + 1, stride)]
+        self.assertEqual(len(curve), len(windows))
+        for value, window in zip(curve, windows):
+            self.assertAlmostEqual(value, naive_entropy(window), places=9)
+
+    def test_entropy_curve(self):
+        data = self.random_bytes(5000)
+
+        # Sliding windows (incremental update)
+        for block_size, step in ((64, 1), (64, 7), (256, 100), (1000, 999)):
+            self.check_curve(data, block_size, step)
+
+        # Consecutive and disjoint windows
+        for block_size, step in ((64, 0), (64, 64), (100, 250), (4999, 0)):
+            self.check_curve(data, block_size, step)
+
+        # Data smaller than a window
+        self.check_curve(data[:50], 64, 3)
+        self.assertEqual(self.make_section([]).entropy_curve(64, 1), [])
+
+        # Sliding windows larger than the c * log2(c) lookup table
+        data = self.random_bytes(200000)
+        self.check_curve(data, 70000, 9999)
+
+class TestNameIndex(TestCase):
+    """
+    Symbol lookups by name (LIEF::NameIndex) against a linear search
+    """
+
+    SAMPLES = [
+        'ELF/ELF32_x86_binary_ls.bin',
+        'ELF/ELF64_x86-64_library_libadd.so',
+        'MachO/MachO64_x86-64_binary_id.bin',
+        'PE/PE64_x86-64_binary_ConsoleApplication1.exe',
+    ]
+
+    @staticmethod
+    def naive_lookup(symbols, name):
+        for symbol in symbols:
+            if symbol.name == name:
+                return symbol
+        return None
+
+    def check_lookups(self, binary, names):
+        symbols = list(binary.abstract.symbols)
+        for name in names:
+            expected = TestNameIndex.naive_lookup(symbols, name)
+            self.assertEqual(binary.abstract.has_symbol(name), expected is not None, name)
+            if expected is not None:
+                symbol = binary.abstract.get_symbol(name)
+                self.assertEqual(symbol.name, expected.name)
+                self.assertEqual(symbol.value, expected.value)
+
+    def test_lookups(self):
+        for sample in TestNameIndex.SAMPLES:
+            binary = lief.parse(get_sample(sample))
+            names  = {s.name for s in binary.abstract.symbols}
+            self.assertGreater(len(names), 0, sample)
+            self.check_lookups(binary, names | {"", "this_symbol_does_not_exist"})
+
+    def test_rename(self):
+        path   = get_sample('ELF/ELF32_x86_binary_all.bin')
+        binary = lief.parse(path)
+        symbol = next(s for s in binary.dynamic_symbols if len(s.name) > 0)
+        name   = symbol.name
+        self.assertTrue(binary.has_dynamic_symbol(name))
+
+        # Renaming a symbol invalidates the index of its binary
+        symbol.name = "renamed_" + name
+        self.assertTrue(binary.has_dynamic_symbol("renamed_" + name))
+        self.assertEqual(binary.get_dynamic_symbol("renamed_" + name).value, symbol.value)
+        self.assertEqual(binary.has_dynamic_symbol(name),
+                         any(s.name == name for s in binary.dynamic_symbols))
+
+        # ... but not the index of another binary
+        other = lief.parse(path)
+        self.assertTrue(other.has_dynamic_symbol(name))
+        self.assertFalse(other.has_dynamic_symbol("renamed_" + name))
+
+    def test_add_remove(self):
+        binary = lief.parse(get_sample('ELF/ELF32_x86_binary_all.bin'))
+
+        symbol = lief.ELF.Symbol()
+        symbol.name  = "lief_new_symbol"
+        symbol.value = 0x1234
+        binary.add_static_symbol(symbol)
+        self.assertTrue(binary.has_static_symbol("lief_new_symbol"))
+        self.assertEqual(binary.get_static_symbol("lief_new_symbol").value, 0x1234)
+
+        binary.remove_static_symbol("lief_new_symbol")
+        self.assertFalse(binary.has_static_symbol("lief_new_symbol"))
+        self.check_lookups(binary, {s.name for s in binary.static_symbols})
+
+
+def cbor_loads(raw):
+    """
+    Minimal CBOR decoder for the output of LIEF::JsonStream
+    (definite and indefinite-length maps and arrays)
+    """
+    def argument(info, pos):
+        if info < 24:
+            return info, pos
+        size = 1 << (info - 24)
+        return int.from_bytes(raw[pos:pos + size], "big"), pos + size
+
+    def item(pos):
+        major, info = raw[pos] >> 5, raw[pos] & 0x1F
+        pos += 1
+        if major == 7:
+            if info in (20, 21):
+                return info == 21, pos
+            if info == 22:
+                return None, pos
+            fmt, size = {25: (">e", 2), 26: (">f", 4), 27: (">d", 8)}[info]
+            return struct.unpack(fmt, raw[pos:pos + size])[0], pos + size
+
+        if major in (4, 5) and info == 31:
+            result = [] if major == 4 else {}
+            while raw[pos] != 0xFF:
+                element, pos = item(pos)
+                if major == 5:
+                    result[element], pos = item(pos)
+                else:
+                    result.append(element)
+            return result, pos + 1
+
+        value, pos = argument(info, pos)
+        if major == 0:
+            return value, pos
+        if major == 1:
+            return -1 - value, pos
+        if major in (2, 3):
+            data = raw[pos:pos + value]
+            return (bytes(data) if major == 2 else data.decode("utf-8")), pos + value
+        if major == 4:
+            result = []
+            for _ in range(value):
+                element, pos = item(pos)
+                result.append(element)
+            return result, pos
+        if major == 5:
+            result = {}
+            for _ in range(value):
+                key, pos = item(pos)
+                result[key], pos = item(pos)
+            return result, pos
+        raise ValueError("Unsupported CBOR item: 0x{:x}".format(raw[pos - 1]))
+
+    result, pos = item(0)
+    assert pos == len(raw)
+    return result
+
+def ndjson_loads(raw):
+    """
+    Object written by LIEF::JsonStream in the NDJSON format: one {"key": value}
+    line per member, an array starts with a {"key": []} line followed by one
+    line per element
+    """
+    result = {}
+    for line in raw.decode("utf-8").splitlines():
+        (key, value), = json.loads(line).items()
+        if key in result:
+            result[key].append(value)
+        else:
+            result[key] = value
+    return result
+
+
+
+class TestIdentify(TestCase):
+    """
+    Format identification (lief.identify) used by lief.parse
+    """
+
+    SAMPLES = {
+        'ELF/ELF64_x86-64_library_libadd.so':             lief.FILE_FORMATS.ELF,
+        'OAT/OAT_079_x86-64_CallDeviceId.oat':            lief.FILE_FORMATS.OAT,
+        'PE/PE64_x86-64_binary_ConsoleApplication1.exe':  lief.FILE_FORMATS.PE,
+        'MachO/MachO64_x86-64_binary_id.bin':             lief.FILE_FORMATS.MACHO,
+        'MachO/FAT_MachO_x86-x86-64-binary_fatall.bin':   lief.FILE_FORMATS.MACHO_FAT,
+        'DEX/DEX35_kik.android.12.8.0.dex':               lief.FILE_FORMATS.DEX,
+        'VDEX/VDEX_10_AArch64_Telecom.vdex':              lief.FILE_FORMATS.VDEX,
+        'ART/ART_056_AArch64_boot.art':                   lief.FILE_FORMATS.ART,
+    }
+
+    def test_formats(self):
+        for sample, fmt in TestIdentify.SAMPLES.items():
+            path = get_sample(sample)
+            with open(path, "rb") as f:
+                raw = f.read()
+            self.assertEqual(lief.identify(path), fmt, sample)
+            self.assertEqual(lief.identify(list(raw)), fmt, sample)
+
+    def test_oat(self):
+        # The OAT files are ELF files told apart by their .dynsym
+        path = get_sample('OAT/OAT_079_x86-64_CallDeviceId.oat')
+        self.assertIsInstance(lief.parse(path), lief.OAT.Binary)
+        self.assertNotIsInstance(lief.parse(get_sample('ELF/ELF64_x86-64_library_libadd.so')), lief.OAT.Binary)
+
+        # ... but a truncated OAT is still an ELF
+        with open(path, "rb") as f:
+            header = f.read(0x40)
+        self.assertEqual(lief.identify(list(header)), lief.FILE_FORMATS.ELF)
+
+    def test_unknown(self):
+        for raw in (b"", b"\x7fEL", b"MZ", bytes(range(256)) * 4):
+            self.assertEqual(lief.identify(list(raw)), lief.FILE_FORMATS.UNKNOWN, raw[:4])
+            self.assertIsNone(lief.parse(list(raw)))
+            self.assertIsNone(lief.parse(raw))
+
+    def test_parse(self):
+        # The file, the vector and the buffer are given to the same parser
+        for sample in ('ELF/ELF64_x86-64_library_libadd.so',
+                       'OAT/OAT_079_x86-64_CallDeviceId.oat',
+                       'PE/PE64_x86-64_binary_ConsoleApplication1.exe',
+                       'MachO/FAT_MachO_x86-x86-64-binary_fatall.bin'):
+            path = get_sample(sample)
+            with open(path, "rb") as f:
+                raw = f.read()
+            expected = lief.parse(path)
+            for binary in (lief.parse(list(raw), expected.name), lief.parse(raw, expected.name)):
+                self.assertEqual(type(binary), type(expected), sample)
+                self.assertEqual(lief.hash(binary), lief.hash(expected), sample)
+
+
+class TestParseMany(TestCase):
+    """
+    Batch parsing (lief.parse_many) against lief.parse
+    """
+
+    SAMPLES = [
+        'ELF/ELF64_x86-64_library_libadd.so',
+        'PE/PE64_x86-64_binary_ConsoleApplication1.exe',
+        'MachO/MachO64_x86-64_binary_id.bin',
+        'ELF/ELF32_x86_binary_ls.bin',
+        'PE/PE32_x86_binary_HelloWorld.exe',
+        'MachO/FAT_MachO_x86-x86-64-binary_fatall.bin',
+    ]
+
+    def setUp(self):
+        self.tmp_dir = tempfile.mkdtemp(suffix='_lief_test_parse_many')
+
+    def test_order(self):
+        paths    = [get_sample(s) for s in TestParseMany.SAMPLES] * 3
+        expected = [lief.parse(p) for p in paths]
+        for nb_threads in (0, 1, 2, 8):
+            binaries = lief.parse_many(paths, nb_threads=nb_threads)
+            self.assertEqual([lief.hash(b) for b in binaries], [lief.hash(b) for b in expected], nb_threads)
+            self.assertEqual([b.name for b in binaries], [b.name for b in expected])
+
+    def test_errors(self):
+        unknown = os.path.join(self.tmp_dir, "unknown.bin")
+        with open(unknown, "wb") as f:
+            f.write(b"\x00" * 0x100)
+
+        paths = [
+            get_sample(TestParseMany.SAMPLES[0]),
+            os.path.join(self.tmp_dir, "missing.bin"),
+            unknown,
+            get_sample(TestParseMany.SAMPLES[1]),
+        ]
+        binaries = lief.parse_many(paths, nb_threads=2)
+        self.assertEqual(len(binaries), len(paths))
+        self.assertIsNotNone(binaries[0])
+        self.assertIsNone(binaries[1])
+        self.assertIsNone(binaries[2])
+        self.assertIsNotNone(binaries[3])
+        self.assertEqual(lief.hash(binaries[3]), lief.hash(lief.parse(paths[3])))
+
+    def test_config(self):
+        path   = get_sample('PE/PE64_x86-64_binary_ConsoleApplication1.exe')
+        config = lief.BatchConfig()
+        config.pe.parse_imports = False
+
+        binary, = lief.parse_many([path], config, 1)
+        self.assertFalse(binary.has_imports)
+        self.assertTrue(lief.parse(path).has_imports)
+
+@unittest.skipUnless(hasattr(lief, "to_json_file"), "requires the JSON support")
+class TestJsonStream(TestCase):
+    """
+    Incremental JSON output (lief.to_json_file) against lief.to_json
+    """
+
+    SAMPLES = [
+        'ELF/ELF64_x86-64_library_libadd.so',
+        'ELF/ELF64_x86-64_object_builder.o',
+        'MachO/MachO64_x86-64_binary_id.bin',
+        'PE/PE64_x86-64_binary_ConsoleApplication1.exe',
+    ]
+
+    def setUp(self):
+        self.tmp_dir = tempfile.mkdtemp(suffix='_lief_test_json')
+
+    def to_json_file(self, binary, fmt):
+        path = os.path.join(self.tmp_dir, "output")
+        lief.to_json_file(binary, path, fmt)
+        with open(path, "rb") as f:
+            return f.read()
+
+    def test_formats(self):
+        for sample in TestJsonStream.SAMPLES:
+            binary   = lief.parse(get_sample(sample))
+            expected = lief.to_json(binary)
+
+            output = self.to_json_file(binary, lief.JSON_FORMAT.JSON)
+            self.assertEqual(output.decode("utf-8"), expected, sample)
+
+            output = self.to_json_file(binary, lief.JSON_FORMAT.NDJSON)
+            self.assertEqual(ndjson_loads(output), json.loads(expected), sample)
+
+            output = self.to_json_file(binary, lief.JSON_FORMAT.CBOR)
+            self.assertEqual(cbor_loads(output), json.loads(expected), sample)
+
+    def test_ndjson_empty_array(self):
+        # The object file has no dynamic symbols: the key of the array is still written
+        binary = lief.parse(get_sample('ELF/ELF64_x86-64_object_builder.o'))
+        self.assertEqual(len(binary.dynamic_symbols), 0)
+
+        output = ndjson_loads(self.to_json_file(binary, lief.JSON_FORMAT.NDJSON))
+        self.assertEqual(output["dynamic_symbols"], [])
+        self.assertEqual(set(output.keys()), set(json.loads(lief.to_json(binary)).keys()))
+
+
 if __name__ == '__main__':
 
     root_logger = logging.getLogger()
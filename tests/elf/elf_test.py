@@ -4,6 +4,7 @@ import logging
 import os
 import random
 import stat
+import struct
 import subprocess
 import sys
 import tempfile
@@ -16,6 +17,24 @@ from utils import get_sample, has_recent_glibc, is_linux, is_x86_64
 
 lief.logging.set_level(lief.logging.LOGGING_LEVEL.INFO)
 
+def make_mips_exec(endian):
+    """
+    Minimal sectionless MIPS32 executable: one PT_LOAD segment mapped at 0x400000
+    whose file content (0x80 bytes) is followed by 0x80 bytes of padding
+    """
+    fmt = ">" if endian == lief.ELF.ELF_DATA.MSB else "<"
+    ident = b"\x7fELF" + bytes([1, int(endian), 1, 0]) + bytes(8)
+    header = ident + struct.pack(fmt + "HHIIIIIHHHHHH",
+            2, 8, 1,           # ET_EXEC, EM_MIPS, EV_CURRENT
+            0x400040, 52, 0,   # entrypoint, phoff, shoff
+            0, 52, 32, 1,      # flags, ehsize, phentsize, phnum
+            40, 0, 0)          # shentsize, shnum, shstrndx
+    phdr = struct.pack(fmt + "IIIIIIII",
+            1, 0, 0x400000, 0x400000,  # PT_LOAD, offset, vaddr, paddr
+            0x80, 0x200, 5, 0x1000)    # filesz, memsz, R+X, align
+    raw = header + phdr
+    return list(raw + bytes(0x100 - len(raw)))
+
 class TestELF(TestCase):
 
     def setUp(self):
@@ -275,6 +294,24 @@ class TestELF(TestCase):
         self.assertTrue(ld.has_section_with_offset(text.offset + 10))
         self.assertTrue(ld.has_section_with_va(text.virtual_address + 10))
 
+    def test_patch_address_endianness(self):
+        for endian, fmt in ((lief.ELF.ELF_DATA.MSB, ">"), (lief.ELF.ELF_DATA.LSB, "<")):
+            binary = lief.ELF.parse(make_mips_exec(endian))
+            self.assertEqual(binary.header.identity_data, endian)
+
+            binary.patch_address(0x400060, 0x11223344, 4)
+            self.assertEqual(binary.get_content_from_virtual_address(0x400060, 4),
+                             list(struct.pack(fmt + "I", 0x11223344)))
+
+            binary.patch_address(0x400070, 0x5566, 2)
+            self.assertEqual(binary.get_content_from_virtual_address(0x400070, 2),
+                             list(struct.pack(fmt + "H", 0x5566)))
+
+            # The patch goes past the end of the segment's content
+            binary.patch_address(0x40007E, 0xAABBCCDD, 4)
+            content = binary.segments[0].content
+            self.assertEqual(list(content[0x7E:0x80]), list(struct.pack(fmt + "I", 0xAABBCCDD))[:2])
+
 
 if __name__ == '__main__':
 
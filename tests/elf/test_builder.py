@@ -41,6 +41,56 @@ class TestBuilder(TestCase):
     def test_gcc(self):
         binall = lief.parse(get_sample('ELF/ELF32_x86_binary_gcc.bin'))
 
+    def test_write_in_place(self):
+        tmp_dir = tempfile.mkdtemp(suffix='_lief_test_builder')
+        path = os.path.join(tmp_dir, "ls.bin")
+        with open(get_sample('ELF/ELF64_x86-64_binary_ls.bin'), 'rb') as f:
+            original = f.read()
+        with open(path, 'wb') as f:
+            f.write(original)
+        os.chmod(path, 0o750)
+
+        ls = lief.parse(path)
+        text = bytes(ls.get_section(".text").content)
+        ls.write(path)
+
+        # The binary still reads its original input
+        self.assertEqual(bytes(ls.get_section(".text").content), text)
+        self.assertEqual(stat.S_IMODE(os.stat(path).st_mode), 0o750)
+
+        new = lief.parse(path)
+        self.assertEqual(bytes(new.get_section(".text").content), text)
+        self.assertEqual(len(new.dynamic_symbols), len(ls.dynamic_symbols))
+
+        # A second write reads the input through the same (replaced) file
+        new.write(path)
+        self.assertEqual(bytes(lief.parse(path).get_section(".text").content), text)
+        self.assertEqual(os.listdir(tmp_dir), ["ls.bin"])
+
+    def test_string_tables(self):
+        tmp_dir = tempfile.mkdtemp(suffix='_lief_test_builder')
+        path = os.path.join(tmp_dir, "ls.bin")
+
+        ls = lief.parse(get_sample('ELF/ELF64_x86-64_binary_ls.bin'))
+        ls.write(path)
+        new = lief.parse(path)
+
+        # The names are read at the offsets computed by the string tables
+        self.assertEqual([s.name for s in new.dynamic_symbols], [s.name for s in ls.dynamic_symbols])
+        self.assertEqual([s.name for s in new.sections], [s.name for s in ls.sections])
+        self.assertEqual(new.libraries, ls.libraries)
+        self.assertEqual([r.name for r in new.symbols_version_requirement],
+                         [r.name for r in ls.symbols_version_requirement])
+        self.assertEqual([aux.name for r in new.symbols_version_requirement for aux in r.get_auxiliary_symbols()],
+                         [aux.name for r in ls.symbols_version_requirement for aux in r.get_auxiliary_symbols()])
+
+        # Each string is stored once and the suffixes are merged
+        dynstr  = bytes(new.get_section(".dynstr").content)
+        strings = [s for s in dynstr.split(b"\0") if len(s) > 0]
+        self.assertEqual(len(strings), len(set(strings)))
+        for string in strings:
+            self.assertFalse(any(len(other) > len(string) and other.endswith(string) for other in strings), string)
+
 
 if __name__ == '__main__':
 
@@ -0,0 +1,226 @@
+#!/usr/bin/env python
+import logging
+import os
+import shutil
+import struct
+import tempfile
+import unittest
+from unittest import TestCase
+
+import lief
+
+lief.logging.set_level(lief.logging.LOGGING_LEVEL.INFO)
+
+Resolver = lief.ELF.DependencyResolver
+
+DT_NULL    = 0
+DT_NEEDED  = 1
+DT_STRTAB  = 5
+DT_STRSZ   = 10
+DT_SONAME  = 14
+DT_RPATH   = 15
+DT_RUNPATH = 29
+
+def build_elf(needed=(), soname=None, rpath=None, runpath=None):
+    """
+    Minimal x86-64 shared object whose dynamic table only contains
+    the ``DT_NEEDED``, ``DT_SONAME``, ``DT_RPATH`` and ``DT_RUNPATH`` entries given
+    """
+    strtab = bytearray(b"\0")
+    def string(value):
+        offset = len(strtab)
+        strtab.extend(value.encode("utf8") + b"\0")
+        return offset
+
+    entries = [(DT_NEEDED, string(name)) for name in needed]
+    for tag, value in ((DT_SONAME, soname), (DT_RPATH, rpath), (DT_RUNPATH, runpath)):
+        if value is not None:
+            entries.append((tag, string(value)))
+
+    # ELF header and the PT_LOAD / PT_DYNAMIC segments followed by .dynstr and .dynamic
+    strtab_offset  = 64 + 2 * 56
+    dynamic_offset = (strtab_offset + len(strtab) + 7) & ~7
+    entries += [(DT_STRTAB, strtab_offset), (DT_STRSZ, len(strtab)), (DT_NULL, 0)]
+    dynamic = b"".join(struct.pack("<QQ", tag, value) for tag, value in entries)
+    size = dynamic_offset + len(dynamic)
+
+    header = struct.pack("<16sHHIQQQIHHHHHH",
+                         b"\x7fELF\x02\x01\x01", 3, 62, 1, 0, 64, 0, 0, 64, 56, 2, 64, 0, 0)
+    load    = struct.pack("<IIQQQQQQ", 1, 6, 0, 0, 0, size, size, 0x1000)
+    dynamic_segment = struct.pack("<IIQQQQQQ", 2, 6, dynamic_offset, dynamic_offset, dynamic_offset,
+                                  len(dynamic), len(dynamic), 8)
+
+    raw = bytearray(header + load + dynamic_segment + strtab)
+    raw.extend(b"\0" * (dynamic_offset - len(raw)))
+    raw.extend(dynamic)
+    return bytes(raw)
+
+def paths(closure):
+    return [library.path for library in closure.libraries]
+
+class TestDependencyResolver(TestCase):
+
+    def setUp(self):
+        self.logger  = logging.getLogger(__name__)
+        self.sysroot = tempfile.mkdtemp(suffix='_lief_test_resolver')
+        Resolver.clear_cache()
+
+    def tearDown(self):
+        Resolver.cache_size = 256
+        Resolver.clear_cache()
+        shutil.rmtree(self.sysroot, ignore_errors=True)
+
+    def host(self, path):
+        return os.path.join(self.sysroot, path.lstrip("/"))
+
+    def install(self, path, raw=None, **kwargs):
+        """
+        Write a binary at ``path`` in the sysroot (through a rename such as
+        a file which is replaced gets a new inode)
+        """
+        host = self.host(path)
+        os.makedirs(os.path.dirname(host), exist_ok=True)
+        with open(host + ".tmp", 'wb') as f:
+            f.write(build_elf(**kwargs) if raw is None else raw)
+        os.replace(host + ".tmp", host)
+        return path
+
+    def resolver(self, default_paths=(), library_paths=()):
+        resolver = Resolver()
+        resolver.sysroot       = self.sysroot
+        resolver.default_paths = list(default_paths)
+        resolver.library_paths = list(library_paths)
+        return resolver
+
+    def test_rpath_runpath(self):
+        for directory in ("/rpath", "/runpath", "/lpath"):
+            self.install(directory + "/libfoo.so")
+
+        rpath = self.install("/bin/rpath", needed=["libfoo.so"], rpath="/rpath")
+        both  = self.install("/bin/both",  needed=["libfoo.so"], rpath="/rpath", runpath="/runpath")
+
+        # The DT_RPATH is ignored when there is a DT_RUNPATH
+        resolver = self.resolver()
+        self.assertEqual(paths(resolver.resolve(rpath)), [rpath, "/rpath/libfoo.so"])
+        self.assertEqual(paths(resolver.resolve(both)),  [both,  "/runpath/libfoo.so"])
+
+        # The library paths come after the DT_RPATH but before the DT_RUNPATH
+        resolver = self.resolver(library_paths=["/lpath"])
+        self.assertEqual(paths(resolver.resolve(rpath)), [rpath, "/rpath/libfoo.so"])
+        self.assertEqual(paths(resolver.resolve(both)),  [both,  "/lpath/libfoo.so"])
+
+        # The DT_RPATH of the loaders is used for the dependencies of a library
+        # while the DT_RUNPATH only applies to the DT_NEEDED of its own binary
+        for directory in ("/rpath", "/runpath"):
+            self.install(directory + "/liba.so", needed=["libb.so"])
+            self.install(directory + "/libb.so")
+        rpath   = self.install("/bin/rpath_a",   needed=["liba.so"], rpath="/rpath")
+        runpath = self.install("/bin/runpath_a", needed=["liba.so"], runpath="/runpath")
+
+        resolver = self.resolver()
+        closure  = resolver.resolve(rpath)
+        self.assertEqual(paths(closure), [rpath, "/rpath/liba.so", "/rpath/libb.so"])
+        self.assertEqual(closure.missing, [])
+
+        closure = resolver.resolve(runpath)
+        self.assertEqual(paths(closure), [runpath, "/runpath/liba.so"])
+        self.assertEqual(closure.missing, ["libb.so"])
+
+    def test_origin(self):
+        self.install("/opt/app/lib/libfoo.so")
+        binaries = [
+            self.install("/opt/app/bin/runpath", needed=["libfoo.so"], runpath="$ORIGIN/../lib"),
+            self.install("/opt/app/bin/rpath",   needed=["libfoo.so"], rpath="${ORIGIN}/../lib"),
+            self.install("/opt/app/bin/needed",  needed=["$ORIGIN/../lib/libfoo.so"]),
+        ]
+
+        # The default paths would find another library
+        self.install("/lib/libfoo.so")
+        resolver = self.resolver(default_paths=["/lib"])
+        for binary in binaries:
+            closure = resolver.resolve(binary)
+            self.assertEqual(closure.missing, [], binary)
+            self.assertEqual(len(closure.libraries), 2, binary)
+            self.assertEqual(os.path.normpath(closure.libraries[1].path), "/opt/app/lib/libfoo.so", binary)
+
+    def test_symlinks(self):
+        # libfoo.so has no SONAME: only the identity of the file tells that
+        # libfoo.so and libfoo.so.1 are the same library
+        self.install("/lib/libfoo.so.1")
+        os.symlink("libfoo.so.1", self.host("/lib/libfoo.so"))
+        self.install("/lib/libbar.so", needed=["libfoo.so.1"])
+        main = self.install("/bin/main", needed=["libfoo.so", "libbar.so"])
+
+        closure = self.resolver(default_paths=["/lib"]).resolve(main)
+        self.assertEqual(paths(closure), [main, "/lib/libfoo.so", "/lib/libbar.so"])
+        self.assertEqual(closure.missing, [])
+
+    def test_missing(self):
+        # Files which are not ELF binaries are skipped
+        self.install("/first/liba.so", raw=b"This is not an ELF binary")
+        self.install("/lib/liba.so", needed=["libmissing.so"])
+        main = self.install("/bin/main", needed=["liba.so", "libmissing.so"])
+
+        closure = self.resolver(default_paths=["/first", "/lib"]).resolve(main)
+        self.assertEqual(paths(closure), [main, "/lib/liba.so"])
+
+        # A name needed by several libraries is reported once
+        self.assertEqual(closure.missing, ["libmissing.so"])
+
+        with self.assertRaises(lief.bad_file):
+            self.resolver().resolve("/bin/does_not_exist")
+
+    def test_cache(self):
+        self.install("/lib/libfoo.so")
+        main = self.install("/bin/main", needed=["libfoo.so"])
+        resolver = self.resolver(default_paths=["/lib"])
+
+        def binaries(closure):
+            return [library.binary for library in closure.libraries]
+
+        def same(lhs, rhs):
+            return all(l is r for l, r in zip(binaries(lhs), binaries(rhs)))
+
+        def different(lhs, rhs):
+            return all(l is not r for l, r in zip(binaries(lhs), binaries(rhs)))
+
+        Resolver.cache_size = 2
+        self.assertEqual(Resolver.cache_size, 2)
+        first = resolver.resolve(main)
+        self.assertTrue(same(resolver.resolve(main), first))
+
+        # Both binaries are evicted by the other one while resolving the closure
+        Resolver.cache_size = 1
+        second = resolver.resolve(main)
+        self.assertTrue(different(second, first))
+        self.assertTrue(different(resolver.resolve(main), second))
+
+        # Nothing is cached
+        Resolver.cache_size = 0
+        self.assertTrue(different(resolver.resolve(main), resolver.resolve(main)))
+
+        Resolver.cache_size = 2
+        third = resolver.resolve(main)
+        self.assertTrue(same(resolver.resolve(main), third))
+
+        # A library replaced on the disk is parsed again
+        self.install("/lib/libfoo.so", soname="libfoo.so")
+        fourth = resolver.resolve(main)
+        self.assertIs(binaries(fourth)[0], binaries(third)[0])
+        self.assertIsNot(binaries(fourth)[1], binaries(third)[1])
+        self.assertTrue(binaries(fourth)[1].has(lief.ELF.DYNAMIC_TAGS.SONAME))
+
+        Resolver.clear_cache()
+        self.assertTrue(different(resolver.resolve(main), fourth))
+
+
+if __name__ == '__main__':
+
+    root_logger = logging.getLogger()
+    root_logger.setLevel(logging.DEBUG)
+
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.DEBUG)
+    root_logger.addHandler(ch)
+
+    unittest.main(verbosity=2)
@@ -0,0 +1,128 @@
+#!/usr/bin/env python
+import logging
+import os
+import shutil
+import tempfile
+import unittest
+from unittest import TestCase
+
+import lief
+from utils import get_sample
+
+lief.logging.set_level(lief.logging.LOGGING_LEVEL.INFO)
+
+SAMPLES = [
+    'ELF/ELF32_x86_binary_all.bin',
+    'ELF/ELF64_x86-64_binary_ls.bin',
+    'ELF/ELF64_x86-64_library_libadd.so',
+    'ELF/ELF64_x86-64_object_builder.o',
+    'ELF/ELF64_x86-64_binary_rvs.bin',
+]
+
+# Accessors of the tables whose parsing can be deferred
+ACCESSORS = {
+    "static_symbols":              lambda b: [lief.hash(s) for s in b.static_symbols],
+    "dynamic_symbols":             lambda b: [lief.hash(s) for s in b.dynamic_symbols],
+    "symbols_version":             lambda b: [lief.hash(s) for s in b.symbols_version],
+    "symbols_version_definition":  lambda b: [lief.hash(s) for s in b.symbols_version_definition],
+    "symbols_version_requirement": lambda b: [lief.hash(s) for s in b.symbols_version_requirement],
+    "relocations":                 lambda b: [lief.hash(r) for r in b.relocations],
+    "dynamic_relocations":         lambda b: [lief.hash(r) for r in b.dynamic_relocations],
+    "pltgot_relocations":          lambda b: [lief.hash(r) for r in b.pltgot_relocations],
+    "object_relocations":          lambda b: [lief.hash(r) for r in b.object_relocations],
+    "gnu_hash":                    lambda b: lief.hash(b.gnu_hash),
+    "sysv_hash":                   lambda b: lief.hash(b.sysv_hash),
+    "notes":                       lambda b: [lief.hash(n) for n in b.notes],
+    "overlay":                     lambda b: bytes(b.overlay),
+}
+
+def parse_lazy(path):
+    config = lief.ELF.ParserConfig()
+    config.lazy(True)
+    return lief.ELF.parse(path, config)
+
+class TestLazy(TestCase):
+
+    def setUp(self):
+        self.logger = logging.getLogger(__name__)
+        self.tmp_dir = tempfile.mkdtemp(suffix='_lief_test_lazy')
+
+    def tearDown(self):
+        shutil.rmtree(self.tmp_dir, ignore_errors=True)
+
+    def test_accessors(self):
+        for sample in SAMPLES:
+            path  = get_sample(sample)
+            eager = lief.parse(path)
+            for name, accessor in ACCESSORS.items():
+                # A fresh binary such as the accessor triggers the parsing of its table
+                lazy = parse_lazy(path)
+                self.assertEqual(accessor(lazy), accessor(eager), "{}: {}".format(sample, name))
+
+    def test_hash(self):
+        for sample in SAMPLES:
+            path = get_sample(sample)
+            self.assertEqual(lief.hash(parse_lazy(path)), lief.hash(lief.parse(path)), sample)
+
+            # Loading the tables explicitly gives the same binary
+            lazy = parse_lazy(path)
+            lazy.load_all()
+            self.assertEqual(lief.hash(lazy), lief.hash(lief.parse(path)), sample)
+
+    @unittest.skipUnless(hasattr(lief, "to_json"), "requires the JSON support")
+    def test_json(self):
+        for sample in SAMPLES:
+            path = get_sample(sample)
+            self.assertEqual(lief.to_json(parse_lazy(path)), lief.to_json(lief.parse(path)), sample)
+
+    def test_write(self):
+        for sample in SAMPLES:
+            path = get_sample(sample)
+            name = os.path.basename(sample)
+
+            eager_path = os.path.join(self.tmp_dir, name + ".eager")
+            lazy_path  = os.path.join(self.tmp_dir, name + ".lazy")
+
+            lief.parse(path).write(eager_path)
+            parse_lazy(path).write(lazy_path)
+
+            with open(eager_path, 'rb') as eager, open(lazy_path, 'rb') as lazy:
+                self.assertEqual(lazy.read(), eager.read(), sample)
+
+    def test_modify_static_symbols(self):
+        path = get_sample('ELF/ELF64_x86-64_object_builder.o')
+
+        # A symbol that no relocation references, located before referenced ones
+        eager = lief.parse(path)
+        referenced = {r.symbol.name for r in eager.relocations if r.has_symbol}
+        names      = [s.name for s in eager.static_symbols]
+        last_ref   = max(i for i, name in enumerate(names) if name in referenced)
+        removed    = next(name for name in names[:last_ref]
+                          if len(name) > 0 and name not in referenced and names.count(name) == 1)
+
+        def relocations(binary):
+            return [(r.address, r.symbol.name if r.has_symbol else None) for r in binary.relocations]
+
+        # The relocations are resolved before the static symbols are modified
+        lazy = parse_lazy(path)
+        lazy.remove_static_symbol(removed)
+        eager.remove_static_symbol(removed)
+        self.assertEqual(relocations(lazy), relocations(eager))
+
+        symbol = lief.ELF.Symbol()
+        symbol.name = "lief_new_symbol"
+        for binary in (parse_lazy(path), lief.parse(path)):
+            binary.add_static_symbol(symbol)
+            self.assertEqual(relocations(binary), relocations(lief.parse(path)))
+
+
+if __name__ == '__main__':
+
+    root_logger = logging.getLogger()
+    root_logger.setLevel(logging.DEBUG)
+
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.DEBUG)
+    root_logger.addHandler(ch)
+
+    unittest.main(verbosity=2)
@@ -0,0 +1,159 @@
+#!/usr/bin/env python
+import logging
+import unittest
+from unittest import TestCase
+
+import lief
+from utils import get_sample
+
+lief.logging.set_level(lief.logging.LOGGING_LEVEL.INFO)
+
+BINDINGS = (
+    lief.ELF.SYMBOL_BINDINGS.GLOBAL,
+    lief.ELF.SYMBOL_BINDINGS.WEAK,
+    lief.ELF.SYMBOL_BINDINGS.GNU_UNIQUE,
+)
+
+TYPES = (
+    lief.ELF.SYMBOL_TYPES.NOTYPE,
+    lief.ELF.SYMBOL_TYPES.OBJECT,
+    lief.ELF.SYMBOL_TYPES.FUNC,
+    lief.ELF.SYMBOL_TYPES.COMMON,
+    lief.ELF.SYMBOL_TYPES.TLS,
+    lief.ELF.SYMBOL_TYPES.GNU_IFUNC,
+)
+
+def is_versioned(symbol):
+    return symbol.has_version and (symbol.symbol_version.value & 0x7fff) >= 2
+
+def naive_lookup(binary, name):
+    """
+    Linear search of the unversioned definition of ``name``
+    """
+    for symbol in binary.dynamic_symbols:
+        if symbol.name != name or symbol.shndx == 0:
+            continue
+        if symbol.binding not in BINDINGS or symbol.type not in TYPES:
+            continue
+        if is_versioned(symbol):
+            continue
+        return symbol
+    return None
+
+def corrupt_gnu_hash(path, index, value):
+    """
+    Raw content of the binary at ``path`` where the ``index``-th word
+    of the .gnu.hash header is replaced with ``value``
+    """
+    binary = lief.parse(path)
+    offset = binary.get_section(".gnu.hash").offset + 4 * index
+    with open(path, 'rb') as f:
+        raw = bytearray(f.read())
+    raw[offset:offset + 4] = value.to_bytes(4, byteorder="little")
+    return list(raw)
+
+class TestLookup(TestCase):
+
+    def setUp(self):
+        self.logger = logging.getLogger(__name__)
+
+    def check_unversioned(self, binary):
+        names = {s.name for s in binary.dynamic_symbols if len(s.name) > 0}
+        # Names with versioned definitions are checked in test_versioned
+        names -= {s.name for s in binary.dynamic_symbols if is_versioned(s)}
+        self.assertGreater(len(names), 0)
+
+        for name in names:
+            expected = naive_lookup(binary, name)
+            symbol   = binary.lookup_dynamic_symbol(name)
+            if expected is None:
+                self.assertIsNone(symbol, name)
+            else:
+                self.assertIsNotNone(symbol, name)
+                self.assertEqual(symbol.name, expected.name)
+                self.assertEqual(symbol.value, expected.value)
+
+    def test_unversioned(self):
+        libadd = lief.parse(get_sample('ELF/ELF64_x86-64_library_libadd.so'))
+        self.assertTrue(libadd.use_gnu_hash)
+        self.check_unversioned(libadd)
+
+        add = libadd.lookup_dynamic_symbol("add")
+        self.assertIsNotNone(add)
+        self.assertEqual(add.name, "add")
+        self.assertIsNone(libadd.lookup_dynamic_symbol("this_symbol_does_not_exist"))
+
+        # Imports are never returned
+        for symbol in libadd.dynamic_symbols:
+            if symbol.imported and naive_lookup(libadd, symbol.name) is None:
+                self.assertIsNone(libadd.lookup_dynamic_symbol(symbol.name))
+
+        # An unversioned reference is the same as an empty version
+        self.assertEqual(libadd.lookup_dynamic_symbol("add", "").value, add.value)
+
+    def test_versioned(self):
+        binall = lief.parse(get_sample('ELF/ELF32_x86_binary_all.bin'))
+
+        # first@LIBSIMPLE_1.0 is a hidden version
+        first = binall.lookup_dynamic_symbol("first", "LIBSIMPLE_1.0")
+        self.assertIsNotNone(first)
+        self.assertEqual(first.name, "first")
+        self.assertEqual(first.value, 0x000008a9)
+
+        self.assertIsNone(binall.lookup_dynamic_symbol("first", "LIBSIMPLE_2.0"))
+        self.assertIsNone(binall.lookup_dynamic_symbol("first"))
+
+        # A binary that is not versioned matches any version
+        libadd = lief.parse(get_sample('ELF/ELF64_x86-64_library_libadd.so'))
+        if not any(s.has_version for s in libadd.dynamic_symbols):
+            self.assertIsNotNone(libadd.lookup_dynamic_symbol("add", "LIBADD_1.0"))
+
+    def test_scope(self):
+        ls     = lief.parse(get_sample('ELF/ELF64_x86-64_binary_ls.bin'))
+        libadd = lief.parse(get_sample('ELF/ELF64_x86-64_library_libadd.so'))
+
+        resolved = lief.ELF.Binary.lookup_dynamic_symbols([ls, libadd], ["add", "this_symbol_does_not_exist"])
+        self.assertEqual(len(resolved), 2)
+
+        binary, symbol = resolved[0]
+        self.assertEqual(symbol.name, "add")
+        self.assertEqual(binary.name, libadd.name)
+
+        self.assertEqual(resolved[1], (None, None))
+
+    def test_corrupted(self):
+        path = get_sample('ELF/ELF64_x86-64_library_libadd.so')
+
+        # 1: symndx, 3: shift2
+        for index, value in ((1, 0xFFFF), (3, 0xFF)):
+            # Don't count the dynamic symbols with the (corrupted) hash table
+            libadd = lief.ELF.parse(corrupt_gnu_hash(path, index, value), "libadd.so",
+                                    lief.ELF.DYNSYM_COUNT_METHODS.SECTION)
+            self.check_unversioned(libadd)
+            self.assertIsNotNone(libadd.lookup_dynamic_symbol("add"))
+
+    def test_renamed(self):
+        libadd = lief.parse(get_sample('ELF/ELF64_x86-64_library_libadd.so'))
+        self.assertIsNotNone(libadd.lookup_dynamic_symbol("add"))
+
+        libadd.get_dynamic_symbol("add").name = "renamed_add"
+
+        # The .gnu.hash no longer describes the dynamic symbols:
+        # the lookup falls back to the symbol names
+        symbol = libadd.lookup_dynamic_symbol("renamed_add")
+        self.assertIsNotNone(symbol)
+        self.assertEqual(symbol.name, "renamed_add")
+        self.assertIsNone(libadd.lookup_dynamic_symbol("add"))
+        self.check_unversioned(libadd)
+
+
+if __name__ == '__main__':
+
+    root_logger = logging.getLogger()
+    root_logger.setLevel(logging.DEBUG)
+
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.DEBUG)
+    root_logger.addHandler(ch)
+
+    unittest.main(verbosity=2)
@@ -237,6 +237,56 @@ class TestAllRelocs(TestCase):
         self.assertTrue(relocations[30].has_section)
         self.assertEqual(relocations[30].address,0x2068)
 
+class TestBuffer(TestCase):
+    """
+    Test binaries parsed from a Python buffer
+    """
+
+    def setUp(self):
+        self.logger = logging.getLogger(__name__)
+
+    def test_content_view(self):
+        with open(get_sample('ELF/ELF64_x86-64_binary_ls.bin'), 'rb') as f:
+            raw = bytearray(f.read())
+        ls = lief.ELF.parse(raw)
+        text = ls.get_section(".text")
+        segment = ls.segment_from_virtual_address(text.virtual_address)
+
+        text_view    = text.content_view
+        segment_view = segment.content_view
+        original     = bytes(segment_view)
+        self.assertEqual(bytes(text_view), bytes(text.content))
+        self.assertEqual(original, bytes(segment.content))
+
+        # The modification copies the content borrowed from the buffer:
+        # the views are not affected and remain valid without the binary
+        segment.content = [0xcc] * len(original)
+        del ls, text, segment
+        self.assertEqual(bytes(segment_view), original)
+        self.assertEqual(len(text_view), len(text_view.tobytes()))
+
+    def test_content_view_partial(self):
+        path = get_sample('ELF/ELF64_x86-64_binary_ls.bin')
+        ls = lief.parse(path)
+        index   = [s.name for s in ls.sections].index(".comment")
+        comment = ls.sections[index]
+
+        # Extend .comment beyond the end of the file
+        with open(path, 'rb') as f:
+            raw = bytearray(f.read())
+        size = len(raw) - comment.offset + 0x100
+        entry = ls.header.section_header_offset + index * ls.header.section_header_size
+        raw[entry + 0x20:entry + 0x28] = size.to_bytes(8, byteorder="little")
+
+        binary  = lief.ELF.parse(raw)
+        comment = binary.get_section(".comment")
+        self.assertEqual(comment.size, size)
+        self.assertEqual(len(comment.content), size)
+        self.assertEqual(bytes(comment.content_view), bytes(comment.content))
+
+        for segment in binary.segments:
+            self.assertEqual(bytes(segment.content_view), bytes(segment.content))
+
 if __name__ == '__main__':
 
     root_logger = logging.getLogger()
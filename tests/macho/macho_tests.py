@@ -9,12 +9,76 @@ import os
 import logging
 import random
 import itertools
+import struct
+import hashlib
 
 from subprocess import Popen
 
 from unittest import TestCase
 from utils import get_sample
 
+def build_fileset(nb_entries):
+    """
+    MH_FILESET whose entries are minimal Mach-O (one __TEXT segment and a LC_UUID)
+    """
+    ENTRY_ALIGN = 0x1000
+    names = ["com.lief.entry{}".format(i).encode() + b"\x00" for i in range(nb_entries)]
+    cmds  = b""
+    for i, name in enumerate(names):
+        name    = name.ljust((len(name) + 7) & ~7, b"\x00")
+        fileoff = ENTRY_ALIGN * (i + 1)
+        # LC_FILESET_ENTRY: cmd, cmdsize, vmaddr, fileoff, entry_id, reserved
+        cmds += struct.pack("<IIQQII", 0x80000035, 32 + len(name), 0xfffffe0000000000 + fileoff, fileoff, 32, 0) + name
+
+    # CPU_TYPE_X86_64, MH_FILESET
+    raw = bytearray(struct.pack("<IIIIIIII", 0xFEEDFACF, 0x01000007, 3, 0xC, len(names), len(cmds), 0, 0) + cmds)
+    rng = random.Random(1337)
+    for i in range(nb_entries):
+        fileoff = ENTRY_ALIGN * (i + 1)
+        # LC_SEGMENT_64 (__TEXT) which covers the entry and LC_UUID
+        segment = struct.pack("<II16sQQQQiiII", 0x19, 72, b"__TEXT", 0xfffffe0000000000 + fileoff, ENTRY_ALIGN,
+                              fileoff, ENTRY_ALIGN, 5, 5, 0, 0)
+        uuid    = struct.pack("<II", 0x1B, 24) + bytes(rng.getrandbits(8) for _ in range(16))
+        header  = struct.pack("<IIIIIIII", 0xFEEDFACF, 0x01000007, 3, 0x2, 2, len(segment) + len(uuid), 0, 0)
+        entry   = header + segment + uuid
+        entry  += bytes(rng.getrandbits(8) for _ in range(ENTRY_ALIGN - len(entry)))
+        raw    += b"\x00" * (fileoff - len(raw)) + entry
+    return bytes(raw)
+
+def build_signed(nb_pages, page_size=0x1000):
+    """
+    Mach-O with an ad-hoc signature: a SHA-256 CodeDirectory whose code slots
+    hash the pages of the code (the last page is partial)
+    """
+    code_limit = (nb_pages - 1) * page_size + page_size // 2
+    identifier = b"com.lief.signed\x00"
+
+    # LC_SEGMENT_64 (__TEXT, __LINKEDIT) and LC_CODE_SIGNATURE
+    signature_size = 20 + 48 + len(identifier) + 32 * nb_pages
+    signature_size = (signature_size + 15) & ~15
+    text     = struct.pack("<II16sQQQQiiII", 0x19, 72, b"__TEXT", 0x100000000, code_limit, 0, code_limit, 5, 5, 0, 0)
+    linkedit = struct.pack("<II16sQQQQiiII", 0x19, 72, b"__LINKEDIT", 0x100000000 + nb_pages * page_size,
+                           page_size, code_limit, signature_size, 1, 1, 0, 0)
+    codesig  = struct.pack("<IIII", 0x1D, 16, code_limit, signature_size)
+    cmds     = text + linkedit + codesig
+    # CPU_TYPE_X86_64, MH_EXECUTE
+    header   = struct.pack("<IIIIIIII", 0xFEEDFACF, 0x01000007, 3, 0x2, 3, len(cmds), 0, 0)
+
+    rng  = random.Random(1337)
+    code = header + cmds
+    code += bytes(rng.getrandbits(8) for _ in range(code_limit - len(code)))
+
+    hashes = b"".join(hashlib.sha256(code[i:i + page_size]).digest() for i in range(0, code_limit, page_size))
+    # CodeDirectory (version 0x20100): magic, length, version, flags (adhoc), hashOffset, identOffset,
+    # nSpecialSlots, nCodeSlots, codeLimit, hashSize, hashType, platform, pageSize, spare2, scatterOffset
+    cd_size = 48 + len(identifier) + len(hashes)
+    cd = struct.pack(">IIIIIIIIIBBBBII", 0xfade0c02, cd_size, 0x20100, 0x2, 48 + len(identifier), 48,
+                     0, nb_pages, code_limit, 32, 2, 0, page_size.bit_length() - 1, 0, 0)
+    cd += identifier + hashes
+    # SuperBlob with the CodeDirectory only
+    superblob = struct.pack(">IIIII", 0xfade0cc0, 20 + len(cd), 1, 0, 20) + cd
+    return code + superblob.ljust(signature_size, b"\x00")
+
 class TestMachO(TestCase):
 
     def setUp(self):
@@ -235,6 +299,82 @@ class TestMachO(TestCase):
 
 
 
+    def test_parallel_fat(self):
+        for sample in ('MachO/FAT_MachO_x86-x86-64-binary_fatall.bin',
+                       'MachO/FAT_MachO_x86_x86-64_library_libdyld.dylib',
+                       'MachO/FAT_MachO_arm-arm64-binary-helloworld.bin'):
+            path = get_sample(sample)
+            config = lief.MachO.ParserConfig.deep
+            config.nb_threads = 1
+            expected = [lief.hash(b) for b in lief.MachO.parse(path, config)]
+            self.assertGreater(len(expected), 1)
+
+            for nb_threads in (0, 2, 8):
+                config.nb_threads = nb_threads
+                fat = lief.MachO.parse(path, config)
+                self.assertEqual([lief.hash(b) for b in fat], expected, "{}: {}".format(sample, nb_threads))
+
+    def test_parallel_fileset(self):
+        raw = build_fileset(16)
+
+        def filesets(nb_threads):
+            config = lief.MachO.ParserConfig.deep
+            config.nb_threads = nb_threads
+            fileset, = lief.MachO.parse(raw, "fileset", config)
+            return [(b.name, bytes(b.uuid.uuid), lief.hash(b)) for b in fileset.filesets]
+
+        expected = filesets(1)
+        self.assertEqual([name for name, _, _ in expected], ["com.lief.entry{}".format(i) for i in range(16)])
+        self.assertEqual(len({uuid for _, uuid, _ in expected}), 16)
+        for nb_threads in (0, 2, 8):
+            self.assertEqual(filesets(nb_threads), expected, nb_threads)
+
+    def test_code_signature_verify(self):
+        NB_PAGES = 8
+        raw = build_signed(NB_PAGES)
+        binary, = lief.MachO.parse(raw, "signed")
+        self.assertTrue(binary.has_code_signature)
+
+        signature = binary.code_signature
+        cd, = signature.code_directories
+        self.assertEqual(cd.identifier, "com.lief.signed")
+        self.assertEqual(cd.hash_type, lief.MachO.CodeDirectory.HASH_TYPES.SHA256)
+        self.assertEqual(cd.page_size, 0x1000)
+        self.assertEqual(len(cd.code_hashes), NB_PAGES)
+
+        for nb_threads in (0, 1, 4):
+            check, = signature.verify(raw, nb_threads)
+            self.assertTrue(check.is_valid, nb_threads)
+            self.assertEqual(check.nb_pages, NB_PAGES)
+            self.assertEqual(check.mismatched_pages, [])
+            self.assertEqual(check.uncovered_size, 0)
+
+        # One byte of the second page and one of the last (partial) page are modified
+        tampered = bytearray(raw)
+        for offset in (0x1800, cd.code_limit - 1):
+            tampered[offset] ^= 0xFF
+        tampered = bytes(tampered)
+        for nb_threads in (0, 1, 4):
+            check, = signature.verify(tampered, nb_threads)
+            self.assertFalse(check.is_valid, nb_threads)
+            self.assertEqual(check.mismatched_pages, [1, NB_PAGES - 1])
+
+        # The bytes after the code limit (i.e. the signature) are not hashed
+        padded = raw + b"\xFF" * 0x10
+        self.assertTrue(signature.verify(padded)[0].is_valid)
+
+        # Same checks through a file
+        tmp_dir = tempfile.mkdtemp(suffix='_lief_test_codesign')
+        path = os.path.join(tmp_dir, "signed")
+        for content, pages in ((raw, []), (tampered, [1, NB_PAGES - 1])):
+            with open(path, 'wb') as f:
+                f.write(content)
+            check, = signature.verify(path)
+            self.assertEqual(check.mismatched_pages, pages)
+        os.remove(path)
+        os.rmdir(tmp_dir)
+
+
 if __name__ == '__main__':
 
     root_logger = logging.getLogger()
@@ -8,6 +8,7 @@ import json
 import subprocess
 import sys
 import tempfile
+import time
 import unittest
 from unittest import TestCase
 
@@ -153,6 +154,24 @@ class TestAuthenticode(TestCase):
         self.assertNotEqual(avast_altered.verify_signature(), lief.PE.Signature.VERIFICATION_FLAGS.OK)
         self.assertNotEqual(avast_altered.signatures[0].check(), lief.PE.Signature.VERIFICATION_FLAGS.OK)
 
+    def test_verify_modified(self):
+        # The verification must reflect the modifications done after a first check
+        avast = lief.PE.parse(get_sample("PE/PE32_x86-64_binary_avast-free-antivirus-setup-online.exe"))
+        optional_header = avast.optional_header
+        self.assertEqual(avast.verify_signature(), lief.PE.Signature.VERIFICATION_FLAGS.OK)
+
+        optional_header.major_image_version += 1
+        self.assertNotEqual(avast.verify_signature(), lief.PE.Signature.VERIFICATION_FLAGS.OK)
+        optional_header.major_image_version -= 1
+        self.assertEqual(avast.verify_signature(), lief.PE.Signature.VERIFICATION_FLAGS.OK)
+
+        entrypoint = avast.entrypoint
+        original = avast.get_content_from_virtual_address(entrypoint, 4)
+        avast.patch_address(entrypoint, [0xcc] * 4)
+        self.assertNotEqual(avast.verify_signature(), lief.PE.Signature.VERIFICATION_FLAGS.OK)
+        avast.patch_address(entrypoint, list(original))
+        self.assertEqual(avast.verify_signature(), lief.PE.Signature.VERIFICATION_FLAGS.OK)
+
     def test_pkcs9_signing_time(self):
         sig = lief.PE.Signature.parse(get_sample("pkcs7/cert0.p7b"))
         attr = sig.signers[0].get_attribute(lief.PE.SIG_ATTRIBUTE_TYPES.PKCS9_SIGNING_TIME)
@@ -271,6 +290,87 @@ class TestAuthenticode(TestCase):
         self.assertEqual(P, 0)
         self.assertEqual(Q, 0)
 
+    def test_x509_cache(self):
+        sig = lief.PE.Signature.parse(get_sample("pkcs7/cert0.p7b"))
+        nested_sig = sig.signers[0].get_attribute(lief.PE.SIG_ATTRIBUTE_TYPES.MS_SPC_NESTED_SIGN).signature
+        nvidia_cert, self_signed_ca, signer_cert = nested_sig.certificates
+        OK      = lief.PE.x509.VERIFICATION_FLAGS.OK
+        EXPIRED = lief.PE.x509.VERIFICATION_FLAGS.BADCERT_EXPIRED
+
+        def stats():
+            stats = lief.PE.x509.cache_stats()
+            return (stats.hits, stats.misses, stats.nb_ca_lists, stats.nb_results)
+
+        lief.PE.x509.clear_cache()
+        self.assertEqual(stats(), (0, 0, 0, 0))
+
+        # The second verification is served from the cache
+        self.assertEqual(self_signed_ca.verify(self_signed_ca), OK)
+        self.assertEqual(stats(), (0, 1, 0, 1))
+        self.assertEqual(self_signed_ca.verify(self_signed_ca), OK)
+        self.assertEqual(stats(), (1, 1, 0, 1))
+
+        # The CA list is parsed once
+        self.assertEqual(self_signed_ca.is_trusted_by([self_signed_ca]), OK)
+        self.assertEqual(stats(), (1, 2, 1, 2))
+        self.assertEqual(self_signed_ca.is_trusted_by([self_signed_ca]), OK)
+        self.assertEqual(stats(), (2, 2, 1, 2))
+
+        # An expired certificate is verified again each time
+        self.assertEqual(signer_cert.verify(nvidia_cert), EXPIRED)
+        self.assertEqual(signer_cert.verify(nvidia_cert), EXPIRED)
+        self.assertEqual(stats(), (2, 4, 1, 2))
+
+        lief.PE.x509.clear_cache()
+        self.assertEqual(stats(), (0, 0, 0, 0))
+        self.assertEqual(self_signed_ca.verify(self_signed_ca), OK)
+        self.assertEqual(stats(), (0, 1, 0, 1))
+
+    def test_authentihash_cache(self):
+        path  = get_sample("PE/PE32_x86-64_binary_avast-free-antivirus-setup-online.exe")
+        algos = [lief.PE.ALGORITHMS.SHA_256, lief.PE.ALGORITHMS.SHA_512]
+
+        def best_time(func, repeat=5):
+            best = float("inf")
+            for _ in range(repeat):
+                start = time.perf_counter()
+                func()
+                best = min(best, time.perf_counter() - start)
+            return best
+
+        def patched(binary, address, value):
+            binary.patch_address(address, [value])
+            return binary.authentihashes(algos)
+
+        avast    = lief.PE.parse(path)
+        text     = avast.sections[0]
+        address  = avast.optional_header.imagebase + text.virtual_address
+        original = avast.authentihashes(algos)
+
+        # The second call is served from the cache: it doesn't traverse the binary
+        self.assertEqual(avast.authentihashes(algos), original)
+        self.assertEqual(avast.authentihash(lief.PE.ALGORITHMS.SHA_256), original[lief.PE.ALGORITHMS.SHA_256])
+        cached   = best_time(lambda: avast.authentihashes(algos))
+        computed = best_time(lambda: patched(avast, address, text.content[0]))
+        self.assertLess(cached * 4, computed)
+
+        # A patch invalidates the cache
+        value   = (text.content[0] + 1) & 0xFF
+        hashes  = patched(avast, address, value)
+        self.assertNotEqual(hashes, original)
+        self.assertEqual(hashes, patched(lief.PE.parse(path), address, value))
+
+        # As a modification of a section through a reference taken before the computation
+        content = list(text.content)
+        content[1] = (content[1] + 1) & 0xFF
+        text.content = content
+        self.assertNotEqual(avast.authentihashes(algos), hashes)
+
+        fresh = lief.PE.parse(path)
+        fresh.patch_address(address, [value])
+        fresh.sections[0].content = content
+        self.assertEqual(avast.authentihashes(algos), fresh.authentihashes(algos))
+
 
 if __name__ == '__main__':
 
@@ -136,6 +136,30 @@ class TestPacker(TestCase):
         pass
 
 
+class TestConfig(TestCase):
+    def test_skipped(self):
+        path = get_sample("PE/PE32_x86-64_binary_avast-free-antivirus-setup-online.exe")
+        deep = lief.PE.parse(path)
+        fields = [attr for attr in dir(lief.PE.SkippedStructures) if not attr.startswith("_")]
+        self.assertEqual(len(fields), 11)
+        self.assertFalse(any(getattr(deep.skipped, attr) for attr in fields))
+
+        quick = lief.PE.parse(path, lief.PE.ParserConfig.quick)
+        self.assertTrue(quick.skipped.signature)
+        self.assertTrue(quick.skipped.overlay)
+        self.assertFalse(quick.skipped.imports)
+        self.assertEqual(len(quick.overlay), 0)
+
+        # The overlay holds the certificate table: the output would be truncated
+        output = os.path.join(tempfile.mkdtemp(suffix='_lief_test_parser'), "avast.exe")
+        with self.assertRaises(lief.builder_error):
+            quick.write(output)
+
+        builder = lief.PE.Builder(quick)
+        builder.build_overlay(False)
+        builder.build()
+
+
 class TestCorrupted(TestCase):
     def test_weird(self):
         pass
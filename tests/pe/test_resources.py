@@ -216,6 +216,30 @@ class TestResource(TestCase):
             self.assertEqual(q.returncode, 0)
 
 
+    def test_write_in_place(self):
+        def contents(node):
+            if isinstance(node, lief.PE.ResourceData):
+                return [bytes(node.content)]
+            return [c for child in node.childs for c in contents(child)]
+
+        output = os.path.join(self.tmp_dir, "mfc_in_place.exe")
+        shutil.copy(get_sample('PE/PE64_x86-64_binary_mfc-application.exe'), output)
+
+        # The resource tree is not decoded before the write
+        mfc = lief.parse(output)
+        mfc.write(output)
+
+        original = lief.parse(get_sample('PE/PE64_x86-64_binary_mfc-application.exe'))
+        expected = contents(original.resources)
+        self.assertGreater(len(expected), 0)
+
+        self.assertEqual(contents(mfc.resources), expected)
+
+        new = lief.parse(output)
+        self.assertTrue(new.has_resources)
+        self.assertEqual(contents(new.resources), expected)
+        self.assertEqual(new.resources_manager.manifest, original.resources_manager.manifest)
+
     #def test_evince_resource_builder(self):
     #    sample_file = get_sample('PE/PE32_x86_binary_EvincePortable.zip')
     #    sample_dir  = os.path.join(self.tmp_dir, "EvincePortable")
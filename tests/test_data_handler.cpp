@@ -0,0 +1,156 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+
+#include <LIEF/ELF/DataHandler/Handler.hpp>
+#include <LIEF/exception.hpp>
+
+using namespace LIEF::ELF::DataHandler;
+
+using ranges_t = std::multiset<std::pair<uint64_t, uint64_t>>;
+
+ranges_t ranges(const std::vector<Node*>& nodes) {
+  ranges_t result;
+  for (const Node* node : nodes) {
+    result.emplace(node->offset(), node->size());
+  }
+  return result;
+}
+
+// Nodes of ``nodes`` which intersect ``[offset, offset + size)``
+std::vector<Node*> naive_overlapping(const std::vector<Node*>& nodes, uint64_t offset, uint64_t size) {
+  std::vector<Node*> result;
+  if (size == 0) {
+    return result;
+  }
+  for (Node* node : nodes) {
+    if (node->offset() < (offset + size) and (node->offset() + node->size()) > offset) {
+      result.push_back(node);
+    }
+  }
+  return result;
+}
+
+void check_overlapping(Handler& handler, const std::vector<Node*>& nodes, Node::Type type,
+                       uint64_t offset, uint64_t size) {
+  const std::vector<Node*> result = handler.overlapping(offset, size, type);
+  CHECK(std::is_sorted(std::begin(result), std::end(result),
+        [] (const Node* lhs, const Node* rhs) {
+          return std::make_pair(lhs->offset(), lhs->size()) < std::make_pair(rhs->offset(), rhs->size());
+        }));
+  CHECK(ranges(result) == ranges(naive_overlapping(nodes, offset, size)));
+}
+
+
+TEST_CASE("data_handler", "[data_handler]") {
+
+  SECTION("Lookups") {
+    Handler handler{std::vector<uint8_t>(0x1000, 0)};
+    Node& text = handler.create(0x100, 0x200, Node::SECTION);
+    Node& data = handler.create(0x300, 0x100, Node::SECTION);
+    Node& load = handler.create(0x0,   0x400, Node::SEGMENT);
+
+    CHECK(handler.has(0x100, 0x200, Node::SECTION));
+    CHECK_FALSE(handler.has(0x100, 0x200, Node::SEGMENT));
+    CHECK(&handler.get(0x300, 0x100, Node::SECTION) == &data);
+    CHECK_THROWS_AS(handler.get(0x300, 0x200, Node::SECTION), LIEF::not_found);
+
+    handler.move(text, 0x80, 0x280);
+    CHECK_FALSE(handler.has(0x100, 0x200, Node::SECTION));
+    CHECK(&handler.get(0x80, 0x280, Node::SECTION) == &text);
+
+    handler.shift(0x200, 0x1000, Node::SECTION);
+    CHECK(data.offset() == 0x1300);
+    CHECK(text.offset() == 0x80);
+    CHECK(load.offset() == 0x0);
+
+    handler.remove(0x1300, 0x100, Node::SECTION);
+    CHECK_FALSE(handler.has(0x1300, 0x100, Node::SECTION));
+    CHECK_THROWS_AS(handler.remove(0x1300, 0x100, Node::SECTION), LIEF::not_found);
+  }
+
+  SECTION("Overlapping") {
+    Handler handler{std::vector<uint8_t>(0x100, 0)};
+    std::vector<Node*> nodes = {
+      &handler.create(0x0,   0x1000, Node::SEGMENT), // Large node that starts first
+      &handler.create(0x100, 0x10,   Node::SEGMENT),
+      &handler.create(0x110, 0x0,    Node::SEGMENT),
+      &handler.create(0x200, 0x100,  Node::SEGMENT),
+    };
+    handler.create(0x100, 0x10, Node::SECTION);
+
+    check_overlapping(handler, nodes, Node::SEGMENT, 0x900, 0x10);
+    check_overlapping(handler, nodes, Node::SEGMENT, 0x100, 0x10);
+    check_overlapping(handler, nodes, Node::SEGMENT, 0x10f, 0x2);
+    check_overlapping(handler, nodes, Node::SEGMENT, 0x110, 0x0);
+    check_overlapping(handler, nodes, Node::SEGMENT, 0x2000, 0x10);
+    CHECK(handler.overlapping(0x100, 0x10, Node::SECTION).size() == 1);
+    CHECK(handler.overlapping(0x0, 0x10, Node::UNKNOWN).empty());
+  }
+
+  SECTION("Random nodes") {
+    std::mt19937 gen{1337};
+    std::uniform_int_distribution<uint64_t> offset_dist{0, 0x10000};
+    std::uniform_int_distribution<uint64_t> size_dist{0, 0x2000};
+    std::uniform_int_distribution<int>      op_dist{0, 9};
+
+    Handler handler{std::vector<uint8_t>(0x100, 0)};
+    std::vector<Node*> nodes;
+
+    for (size_t i = 0; i < 2000; ++i) {
+      const int op = op_dist(gen);
+      // Nodes are identified by their offset and their size: they must be unique
+      const uint64_t node_offset = offset_dist(gen);
+      const uint64_t node_size   = size_dist(gen);
+      const bool exists = handler.has(node_offset, node_size, Node::SEGMENT);
+      if (op < 5 or nodes.empty()) {
+        if (not exists) {
+          nodes.push_back(&handler.create(node_offset, node_size, Node::SEGMENT));
+        }
+      }
+      else if (op < 7) {
+        std::uniform_int_distribution<size_t> idx_dist{0, nodes.size() - 1};
+        Node* node = nodes[idx_dist(gen)];
+        if (not exists) {
+          handler.move(*node, node_offset, node_size);
+        }
+      }
+      else if (op < 9) {
+        std::uniform_int_distribution<size_t> idx_dist{0, nodes.size() - 1};
+        auto it_node = std::begin(nodes) + idx_dist(gen);
+        handler.remove((*it_node)->offset(), (*it_node)->size(), Node::SEGMENT);
+        nodes.erase(it_node);
+      }
+      else {
+        handler.shift(node_offset, node_size, Node::SEGMENT);
+      }
+
+      const uint64_t offset = offset_dist(gen);
+      const uint64_t size   = size_dist(gen);
+      check_overlapping(handler, nodes, Node::SEGMENT, offset, size);
+    }
+
+    for (const Node* node : nodes) {
+      CHECK(handler.has(node->offset(), node->size(), Node::SEGMENT));
+    }
+  }
+}
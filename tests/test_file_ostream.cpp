@@ -0,0 +1,114 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if !defined(_WIN32)
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <LIEF/file_ostream.hpp>
+
+using namespace LIEF;
+
+std::vector<uint8_t> read_file(const std::string& path) {
+  std::ifstream ifs{path, std::ios::binary};
+  return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+}
+
+void write_file(const std::string& path, const std::vector<uint8_t>& content) {
+  std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+  ofs.write(reinterpret_cast<const char*>(content.data()), content.size());
+}
+
+
+TEST_CASE("file_ostream", "[file_ostream]") {
+  const std::string path = "lief_test_file_ostream.bin";
+  write_file(path, {1, 2, 3, 4});
+
+  SECTION("Commit") {
+    {
+      file_ostream output{path};
+      output.write({5, 6});
+      // Not committed yet: the original file is left untouched
+      CHECK(read_file(path) == std::vector<uint8_t>({1, 2, 3, 4}));
+      output.commit();
+    }
+    CHECK(read_file(path) == std::vector<uint8_t>({5, 6}));
+
+    {
+      file_ostream output{path};
+      output.write({7, 8, 9});
+    }
+    // Discarded
+    CHECK(read_file(path) == std::vector<uint8_t>({5, 6}));
+  }
+
+  SECTION("Holes") {
+    {
+      file_ostream output{path};
+      output.seekp(4).write({1, 2});
+      output.seekp(0x10);
+      CHECK(output.size() == 0x10);
+      output.seekp(1).write({3});
+      output.commit();
+    }
+    std::vector<uint8_t> expected(0x10, 0);
+    expected[1] = 3;
+    expected[4] = 1;
+    expected[5] = 2;
+    CHECK(read_file(path) == expected);
+  }
+
+#if !defined(_WIN32)
+  SECTION("Permissions") {
+    ::chmod(path.c_str(), 0750);
+    {
+      file_ostream output{path};
+      output.write({5, 6});
+      output.commit();
+    }
+    struct stat st;
+    REQUIRE(::stat(path.c_str(), &st) == 0);
+    CHECK((st.st_mode & 07777) == 0750);
+    CHECK(st.st_uid == ::getuid());
+  }
+
+  SECTION("Symbolic links") {
+    const std::string link = path + ".link";
+    std::remove(link.c_str());
+    REQUIRE(::symlink(path.c_str(), link.c_str()) == 0);
+    {
+      file_ostream output{link};
+      output.write({5, 6});
+      output.commit();
+    }
+    struct stat st;
+    REQUIRE(::lstat(link.c_str(), &st) == 0);
+    CHECK(S_ISLNK(st.st_mode));
+    CHECK(read_file(path) == std::vector<uint8_t>({5, 6}));
+    std::remove(link.c_str());
+  }
+#endif
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,116 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <LIEF/BinaryStream/MmapStream.hpp>
+#include <LIEF/BinaryStream/VectorStream.hpp>
+#include <LIEF/exception.hpp>
+
+using namespace LIEF;
+
+std::vector<uint8_t> read_file(const std::string& path) {
+  std::ifstream ifs{path, std::ios::binary};
+  return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+}
+
+void write_file(const std::string& path, const std::vector<uint8_t>& content) {
+  std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+  ofs.write(reinterpret_cast<const char*>(content.data()), content.size());
+}
+
+
+TEST_CASE("mmap_stream", "[mmap_stream]") {
+  if (not MmapStream::is_supported()) {
+    return;
+  }
+
+  const std::string path = "lief_test_mmap_stream.bin";
+
+  // A size which is not a multiple of the page size
+  std::mt19937 gen{1337};
+  std::vector<uint8_t> content(3 * 0x1000 + 17);
+  for (uint8_t& x : content) {
+    x = static_cast<uint8_t>(gen());
+  }
+  write_file(path, content);
+
+  SECTION("Read") {
+    MmapStream stream{path};
+    CHECK(stream.type() == BinaryStream::STREAM_TYPE::MMAP);
+    REQUIRE(stream.size() == content.size());
+    CHECK(stream.content() == content);
+    CHECK(stream.fd() >= 0);
+
+    const VectorStream vstream{path};
+    CHECK(stream.peek<uint32_t>(0x1ffe) == vstream.peek<uint32_t>(0x1ffe));
+    CHECK(stream.peek<uint8_t>(content.size() - 1) == content.back());
+
+    // Out of bounds accesses
+    CHECK(stream.can_read<uint8_t>(content.size() - 1));
+    CHECK_FALSE(stream.can_read<uint32_t>(content.size() - 2));
+    CHECK(stream.peek_array<uint8_t>(content.size() - 2, 4, /* check */ false) == nullptr);
+    CHECK_THROWS_AS(stream.peek<uint32_t>(content.size() - 2), read_out_of_bound);
+
+    // Hints only: they don't change the content
+    stream.advise(MmapStream::ADVICE::SEQUENTIAL);
+    stream.advise(MmapStream::ADVICE::WILLNEED, 0x1001, 0x10);
+    stream.advise(MmapStream::ADVICE::NORMAL, content.size() + 1);
+    CHECK(stream.content() == content);
+  }
+
+  SECTION("From file") {
+    std::unique_ptr<BinaryStream> stream = BinaryStream::from_file(path);
+    REQUIRE(stream != nullptr);
+    CHECK(stream->type() == BinaryStream::STREAM_TYPE::MMAP);
+    CHECK(static_cast<const MmapStream&>(*stream).content() == content);
+
+    // An empty file can't be mapped
+    write_file(path, {});
+    CHECK_THROWS_AS(MmapStream{path}, bad_file);
+
+    CHECK_THROWS_AS(MmapStream{"lief_test_mmap_stream.missing"}, bad_file);
+    CHECK_THROWS_AS(BinaryStream::from_file("lief_test_mmap_stream.missing"), bad_file);
+  }
+
+  SECTION("Private copy") {
+    MmapStream stream{path};
+    CHECK(stream.cow_start() == nullptr);
+
+    std::unique_ptr<MmapStream> copy = stream.private_copy();
+    REQUIRE(copy != nullptr);
+    REQUIRE(copy->cow_start() != nullptr);
+    CHECK(copy->content() == content);
+
+    // The writes are neither visible through the original stream nor in the file
+    copy->cow_start()[0] ^= 0xFF;
+    CHECK(copy->peek<uint8_t>(0) == static_cast<uint8_t>(content[0] ^ 0xFF));
+    CHECK(stream.peek<uint8_t>(0) == content[0]);
+    CHECK(read_file(path) == content);
+
+    // The file has been truncated since it has been mapped
+    write_file(path, {1, 2, 3});
+    CHECK(stream.private_copy() == nullptr);
+  }
+
+  std::remove(path.c_str());
+}
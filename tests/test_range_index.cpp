@@ -0,0 +1,201 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+
+#include <LIEF/range_index.hpp>
+
+using namespace LIEF;
+
+// Minimal section: the setters notify the binary such as LIEF::Section does
+class item_t : public Indexed {
+  public:
+  item_t(uint64_t start, uint64_t size) :
+    start_{start},
+    size_{size}
+  {}
+
+  uint64_t start() const {
+    return this->start_;
+  }
+
+  uint64_t size() const {
+    return this->size_;
+  }
+
+  void start(uint64_t start) {
+    this->start_ = start;
+    this->index_changed();
+  }
+
+  void size(uint64_t size) {
+    this->size_ = size;
+    this->index_changed();
+  }
+
+  private:
+  uint64_t start_ = 0;
+  uint64_t size_  = 0;
+};
+
+std::pair<uint64_t, uint64_t> range(const item_t& item) {
+  return {item.start(), item.size()};
+}
+
+// Same lookup as the former std::find_if of the Binary functions
+item_t* naive_find(const std::vector<item_t*>& items, uint64_t value) {
+  auto it = std::find_if(std::begin(items), std::end(items),
+      [value] (const item_t* item) {
+        return item->size() > 0 and item->start() <= value and
+               value - item->start() < item->size();
+      });
+  return it == std::end(items) ? nullptr : *it;
+}
+
+void check(const RangeIndex<item_t>& index, const std::vector<item_t*>& items, uint64_t value) {
+  INFO("value: 0x" << std::hex << value);
+  CHECK(index.find(items, value, range) == naive_find(items, value));
+}
+
+
+TEST_CASE("range_index", "[range_index]") {
+
+  SECTION("Overlapping ranges") {
+    item_t load{0x0, 0x1000};
+    item_t text{0x100, 0x200};
+    item_t data{0x300, 0x100};
+    item_t empty{0x200, 0};
+    item_t bss{0x380, 0x1000};
+    std::vector<item_t*> items = {&text, &empty, &data, &load, &bss};
+
+    RangeIndex<item_t> index;
+    // The first element (in the order of the container) that covers the value
+    CHECK(index.find(items, 0x0,   range) == &load);
+    CHECK(index.find(items, 0x100, range) == &text);
+    CHECK(index.find(items, 0x2ff, range) == &text);
+    CHECK(index.find(items, 0x200, range) == &text);
+    CHECK(index.find(items, 0x380, range) == &data);
+    CHECK(index.find(items, 0x400, range) == &load);
+    CHECK(index.find(items, 0x1000, range) == &bss);
+    CHECK(index.find(items, 0x1380, range) == nullptr);
+    for (uint64_t value = 0; value < 0x1400; value += 0x10) {
+      check(index, items, value);
+    }
+  }
+
+  SECTION("Bounds") {
+    const uint64_t max = std::numeric_limits<uint64_t>::max();
+    item_t last{max - 0x10, 0x100}; // Overflows: clipped to the end of the address space
+    item_t first{0, 1};
+    std::vector<item_t*> items = {&last, nullptr, &first};
+
+    RangeIndex<item_t> index;
+    CHECK(index.find(items, 0, range) == &first);
+    CHECK(index.find(items, 1, range) == nullptr);
+    CHECK(index.find(items, max - 0x10, range) == &last);
+    CHECK(index.find(items, max - 1, range) == &last);
+
+    std::vector<item_t*> none;
+    CHECK(index.find(none, 0, range) == nullptr);
+  }
+
+  SECTION("Invalidation") {
+    IndexVersion version;
+    IndexVersion other_version;
+    item_t text{0x1000, 0x100};
+    item_t data{0x2000, 0x100};
+    std::vector<item_t*> items = {&text, &data};
+
+    RangeIndex<item_t> index{version};
+    RangeIndex<item_t> other{other_version};
+    item_t other_text{0x1000, 0x100};
+    std::vector<item_t*> other_items = {&other_text};
+
+    CHECK(index.find(items, 0x1000, range) == &text);
+    CHECK(other.find(other_items, 0x1000, range) == &other_text);
+    const uint64_t other_value = other_version.value();
+
+    // The setters of an indexed element invalidate the index of its binary only
+    text.start(0x3000);
+    CHECK(index.find(items, 0x1000, range) == nullptr);
+    CHECK(index.find(items, 0x3000, range) == &text);
+    CHECK(other_version.value() == other_value);
+    CHECK(other.find(other_items, 0x1000, range) == &other_text);
+
+    data.size(0);
+    CHECK(index.find(items, 0x2000, range) == nullptr);
+
+    // Elements added or removed
+    item_t bss{0x1000, 0x10};
+    items.push_back(&bss);
+    CHECK(index.find(items, 0x1000, range) == &bss);
+    items.erase(std::begin(items));
+    CHECK(index.find(items, 0x3000, range) == nullptr);
+
+    // Without a version, the index must be explicitly invalidated
+    RangeIndex<item_t> snapshot;
+    item_t item{0x10, 0x10};
+    std::vector<item_t*> snapshot_items = {&item};
+    CHECK(snapshot.find(snapshot_items, 0x10, range) == &item);
+    item.start(0x100);
+    CHECK(snapshot.find(snapshot_items, 0x10, range) == &item);
+    snapshot.invalidate();
+    CHECK(snapshot.find(snapshot_items, 0x10, range) == nullptr);
+    CHECK(snapshot.find(snapshot_items, 0x100, range) == &item);
+  }
+
+  SECTION("Random ranges") {
+    std::mt19937 gen{1337};
+    std::uniform_int_distribution<uint64_t> start_dist{0, 0x10000};
+    std::uniform_int_distribution<uint64_t> size_dist{0, 0x2000};
+    std::uniform_int_distribution<int>      op_dist{0, 9};
+
+    IndexVersion version;
+    RangeIndex<item_t> index{version};
+    std::vector<std::unique_ptr<item_t>> storage;
+    std::vector<item_t*> items;
+
+    for (size_t i = 0; i < 1000; ++i) {
+      const int op = op_dist(gen);
+      if (op < 4 or items.empty()) {
+        storage.emplace_back(new item_t{start_dist(gen), size_dist(gen)});
+        items.push_back(storage.back().get());
+      }
+      else if (op < 6) {
+        std::uniform_int_distribution<size_t> idx_dist{0, items.size() - 1};
+        items[idx_dist(gen)]->start(start_dist(gen));
+      }
+      else if (op < 8) {
+        std::uniform_int_distribution<size_t> idx_dist{0, items.size() - 1};
+        items[idx_dist(gen)]->size(size_dist(gen));
+      }
+      else {
+        std::uniform_int_distribution<size_t> idx_dist{0, items.size() - 1};
+        items.erase(std::begin(items) + idx_dist(gen));
+      }
+
+      for (size_t j = 0; j < 10; ++j) {
+        check(index, items, start_dist(gen));
+      }
+    }
+  }
+}
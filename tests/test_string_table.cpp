@@ -0,0 +1,166 @@
+/* Copyright 2017 - 2021 R. Thomas
+ * Copyright 2017 - 2021 Quarkslab
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include <LIEF/string_table.hpp>
+#include <LIEF/iostream.hpp>
+
+using namespace LIEF;
+
+// Table as written in a binary: ``base`` null bytes followed by the merged strings
+std::vector<uint8_t> build(const StringTable& table, size_t base) {
+  vector_iostream os;
+  for (size_t i = 0; i < base; ++i) {
+    os.put(0);
+  }
+  table.write(os);
+  return os.raw();
+}
+
+// String located at ``offset`` in the table
+std::string read_at(const std::vector<uint8_t>& raw, size_t offset) {
+  REQUIRE(offset < raw.size());
+  return reinterpret_cast<const char*>(raw.data() + offset);
+}
+
+void check_offsets(const StringTable& table, const std::set<std::string>& strings, size_t base) {
+  const std::vector<uint8_t> raw = build(table, base);
+  REQUIRE(raw.size() == base + table.size());
+  REQUIRE(raw.back() == 0);
+
+  for (const std::string& str : strings) {
+    const size_t offset = table.offset(str);
+    REQUIRE(offset != StringTable::npos);
+    CHECK(read_at(raw, offset) == str);
+  }
+}
+
+
+TEST_CASE("string_table", "[string_table]") {
+
+  SECTION("Suffixes") {
+    StringTable table;
+    table.add("barfoo");
+    table.add("foo");
+    table.add("oo");
+    table.add("xfoo");
+    table.finalize(1);
+
+    CHECK(table.nb_strings() == 4);
+    // "barfoo\0xfoo\0"
+    CHECK(table.size() == 12);
+    CHECK(table.offset("foo") == table.offset("barfoo") + 3);
+    CHECK(table.offset("oo")  == table.offset("barfoo") + 4);
+    check_offsets(table, {"barfoo", "foo", "oo", "xfoo"}, 1);
+  }
+
+  SECTION("Duplicates") {
+    StringTable table;
+    table.add("printf");
+    table.add("puts");
+    table.add("printf");
+    table.add("puts");
+    table.add("printf");
+    table.finalize(1);
+
+    CHECK(table.nb_strings() == 2);
+    CHECK(table.size() == 12);
+    check_offsets(table, {"printf", "puts"}, 1);
+  }
+
+  SECTION("Empty strings") {
+    StringTable table;
+    table.add("");
+    table.add("main");
+    table.add("");
+    table.finalize(1);
+
+    CHECK(table.nb_strings() == 1);
+    CHECK(table.size() == 5);
+    CHECK(table.offset("") == 0);
+    CHECK(table.offset(nullptr, 0) == 0);
+    check_offsets(table, {"main"}, 1);
+
+    StringTable empty;
+    empty.add("");
+    empty.finalize(1);
+    CHECK(empty.size() == 0);
+    CHECK(build(empty, 1).size() == 1);
+  }
+
+  SECTION("Missing strings") {
+    StringTable table;
+    table.add("abc");
+    CHECK(table.offset("abc") == StringTable::npos);
+
+    table.finalize();
+    CHECK(table.offset("abc") == 0);
+    CHECK(table.offset("bc")  == StringTable::npos);
+    CHECK(table.offset("abcd") == StringTable::npos);
+
+    // Adding strings requires to finalize the table again
+    table.add("xabc");
+    CHECK(table.offset("abc") == StringTable::npos);
+    table.finalize();
+    check_offsets(table, {"abc", "xabc"}, 0);
+    CHECK(table.size() == 5);
+  }
+
+  SECTION("Random strings") {
+    // Small alphabet and short strings such as there are many
+    // duplicates and suffixes, over the insertion sort threshold
+    std::mt19937 gen{1337};
+    std::uniform_int_distribution<size_t> size_dist{0, 6};
+    std::uniform_int_distribution<int>    char_dist{'a', 'c'};
+
+    for (size_t nb_strings : {1, 10, 100, 5000}) {
+      std::set<std::string> strings;
+      StringTable table;
+      for (size_t i = 0; i < nb_strings; ++i) {
+        std::string str(size_dist(gen), 0);
+        for (char& c : str) {
+          c = static_cast<char>(char_dist(gen));
+        }
+        table.add(str);
+        if (not str.empty()) {
+          strings.insert(str);
+        }
+      }
+      table.finalize(1);
+      CHECK(table.nb_strings() == strings.size());
+      check_offsets(table, strings, 1);
+
+      // The emitted strings are the ones that are not a suffix of another string
+      size_t expected_size = 0;
+      for (const std::string& str : strings) {
+        const bool is_suffix = std::any_of(std::begin(strings), std::end(strings),
+            [&str] (const std::string& other) {
+              return other.size() > str.size() and
+                     other.compare(other.size() - str.size(), str.size(), str) == 0;
+            });
+        if (not is_suffix) {
+          expected_size += str.size() + 1;
+        }
+      }
+      CHECK(table.size() == expected_size);
+    }
+  }
+}